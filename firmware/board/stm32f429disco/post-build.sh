@@ -1 +1,21 @@
 #!/bin/sh
+
+TARGET_DIR="$1"
+IMAGE_DIR="$TARGET_DIR/usr/share/images"
+CONVERTER="$HOST_DIR/bin/png2rgb565"
+
+# Pre-convert slideshow images to RLE RGB565 so the target never decodes PNG
+if [ -x "$CONVERTER" ] && [ -d "$IMAGE_DIR" ]; then
+  echo "==> Converting slideshow images to RGB565..."
+
+  for img in "$IMAGE_DIR"/*.png; do
+    [ -f "$img" ] || continue
+    "$CONVERTER" -r -W 240 -H 320 "$img" "${img%.png}.rgb565" || exit 1
+    rm -f "$img"
+  done
+
+  # GIF copies duplicate the PNGs and are never displayed
+  rm -f "$IMAGE_DIR"/*.gif
+
+  echo "   Image footprint in rootfs: $(du -sk "$IMAGE_DIR" | cut -f1) KiB"
+fi
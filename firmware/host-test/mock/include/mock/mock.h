@@ -0,0 +1,127 @@
+#ifndef MOCK_MOCK_H
+#define MOCK_MOCK_H
+
+/**
+ * @file mock.h
+ * @brief Host emulation of the kernel interfaces used on the board.
+ *
+ * Programs linked with libmock.a and the --wrap options from the host-test
+ * Makefile see an STM32F429 Discovery behind open(), read(), ioctl() and
+ * friends:
+ *
+ * - /dev/gpiochip0..10: GPIO banks A..K, 16 lines each named PA0..PK15,
+ *   GPIO v1 and v2 character device ABIs with edge events.
+ * - /dev/spidev0.0: L3GD20 gyroscope register model (WHO_AM_I 0xD4);
+ *   /dev/spidev1.0 is a loopback device.
+ * - /dev/i2c-0..2: I2C_RDWR against register-model slaves, STMPE811 at 0x41
+ *   on bus 0 by default (MOCK_I2C_DEVICES="bus:addr,..." overrides).
+ * - /dev/ttySTM0..6: pseudo terminals; the other end is mock_serial_peer().
+ *   /dev/ttySTM7 is looped back: the program reads what it writes.
+ * - /dev/mem: a sparse 4 GiB file with the RCC registers of a 180 MHz setup.
+ * - /dev/iio:device0: buffered ADC3 stream while buffer/enable is 1.
+ * - /sys: a fake tree with LEDs, PWM, sysfs GPIO and the IIO device.
+ *
+ * Everything lives under a fake root: $MOCK_ROOT when set (shared by every
+ * process of a test run, the board is created once) or a private temporary
+ * directory removed at exit. Other paths are passed through untouched.
+ * The mock keeps no locks; it is meant for single-threaded use of each
+ * emulated device. Every wrapped call is counted, see mock_syscalls().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Board geometry */
+#define MOCK_GPIO_CHIPS 11
+#define MOCK_GPIO_LINES 16
+#define MOCK_I2C_BUSES 3
+#define MOCK_TTYS 8
+#define MOCK_TTY_LOOPBACK 7
+
+/**
+ * @brief Directory that stands in for / for the emulated /sys and /dev files.
+ */
+const char *mock_root(void);
+
+/**
+ * @brief Number of wrapped calls made so far.
+ *
+ * Counts open, close, read, write, lseek, poll, select, ioctl, stat,
+ * opendir and readlink, whether an emulated device or the real kernel
+ * answered them: the syscalls the program would make on the board.
+ */
+unsigned long mock_syscalls(void);
+
+/**
+ * @brief Drive an input line from the outside world.
+ *
+ * Queues an edge event on the line request when the line is requested with
+ * a matching edge. On a line requested with a debounce period the change
+ * is only seen, and its event queued, once the level has been steady for
+ * that long, as the kernel's debouncer does.
+ *
+ * @return 0 on success, -1 if chip or offset is out of range.
+ */
+int mock_gpio_set_input(unsigned int chip, unsigned int offset, bool level);
+
+/**
+ * @brief Physical level of a line requested as output.
+ *
+ * @return 0 or 1, or -1 if the line is not requested as output.
+ */
+int mock_gpio_get_output(unsigned int chip, unsigned int offset);
+
+/**
+ * @brief Rename a line, as reconfiguring a gpio-sim bank would.
+ *
+ * @param name New name, or NULL for the default "PA0".."PK15" scheme.
+ * @return 0 on success, -1 if chip or offset is out of range.
+ */
+int mock_gpio_set_line_name(unsigned int chip, unsigned int offset, const char *name);
+
+/**
+ * @brief Change the label a chip reports, as binding another driver would.
+ *
+ * @param label New label, or NULL for the default "GPIOA".."GPIOK".
+ * @return 0 on success, -1 if chip is out of range.
+ */
+int mock_gpio_set_chip_label(unsigned int chip, const char *label);
+
+/**
+ * @brief Register file of a register-model SPI device.
+ *
+ * @return 64 registers, or NULL for loopback and missing devices.
+ */
+uint8_t *mock_spi_registers(unsigned int bus, unsigned int cs);
+
+/**
+ * @brief Register file of an I2C slave, attaching it if needed.
+ *
+ * @return 256 registers, or NULL if the bus or address is out of range.
+ */
+uint8_t *mock_i2c_attach(unsigned int bus, uint16_t addr);
+
+/**
+ * @brief Remove an I2C slave so transfers to it fail with ENXIO.
+ */
+void mock_i2c_detach(unsigned int bus, uint16_t addr);
+
+/**
+ * @brief The far end of an emulated tty such as "/dev/ttySTM1".
+ *
+ * Bytes written by the program can be read from it and vice versa.
+ *
+ * @return Master file descriptor of the pty, -1 on error (EBUSY for the
+ *         loopback port, whose far end is the program itself).
+ */
+int mock_serial_peer(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOCK_MOCK_H */
@@ -0,0 +1,390 @@
+/**
+ * @file mock.c
+ * @brief Syscall wrappers and descriptor table of the host mock.
+ *
+ * Programs are linked with -Wl,--wrap=<call> for every call below, so their
+ * references resolve to __wrap_<call> and the real libc function stays
+ * reachable as __real_<call>. Emulated device nodes get a real descriptor
+ * (/dev/null, a pipe, a pty or an eventfd) so poll(), epoll and close()
+ * keep working; the table below says which device stands behind it.
+ * write(), lseek(), poll() and select() are only wrapped so that every call
+ * a program makes into the kernel is counted (mock_syscalls()).
+ */
+
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+
+#include "mock_internal.h"
+
+#define MOCK_MAX_FDS 1024
+
+static mock_fd_t fd_table[MOCK_MAX_FDS];
+static char root[PATH_MAX];
+static pid_t root_owner;
+static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+static unsigned long syscalls;
+
+/*********************************************************************************/
+/* Fake root */
+/*********************************************************************************/
+
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw)
+{
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+static void mock_cleanup(void)
+{
+    /* Only the process that created a private root removes it, not its children */
+    if (root_owner == getpid())
+        nftw(root, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+static void mock_setup(void)
+{
+    const char *env = getenv("MOCK_ROOT");
+
+    if (env && env[0])
+    {
+        snprintf(root, sizeof(root), "%s", env);
+        if (mkdir(root, 0755) < 0 && errno != EEXIST)
+        {
+            fprintf(stderr, "mock: cannot create %s: %s\n", root, strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+    }
+    else
+    {
+        const char *tmp = getenv("TMPDIR");
+
+        snprintf(root, sizeof(root), "%s/mock-XXXXXX", (tmp && tmp[0]) ? tmp : "/tmp");
+        if (mkdtemp(root) == NULL)
+        {
+            fprintf(stderr, "mock: cannot create a temporary root: %s\n", strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+        root_owner = getpid();
+        atexit(mock_cleanup);
+    }
+
+    if (mock_board_create(root) < 0)
+    {
+        fprintf(stderr, "mock: cannot create the board under %s: %s\n", root, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void mock_init(void)
+{
+    pthread_once(&init_once, mock_setup);
+}
+
+const char *mock_root(void)
+{
+    mock_init();
+    return root;
+}
+
+int mock_path(const char *rel, char *buf, size_t len)
+{
+    mock_init();
+
+    if ((size_t)snprintf(buf, len, "%s%s", root, rel) >= len)
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    return 0;
+}
+
+/* /sys is always served from the fake root */
+static const char *remap(const char *path, char *buf, size_t len)
+{
+    if (path && strncmp(path, "/sys/", 5) == 0 && mock_path(path, buf, len) == 0)
+        return buf;
+    return path;
+}
+
+/* Listing /dev shows the emulated device nodes, not the host's */
+static const char *remap_dir(const char *path, char *buf, size_t len)
+{
+    if (path && strcmp(path, "/dev") == 0 && mock_path(path, buf, len) == 0)
+        return buf;
+    return remap(path, buf, len);
+}
+
+/*********************************************************************************/
+/* Descriptor table */
+/*********************************************************************************/
+
+mock_fd_t *mock_fd_get(int fd)
+{
+    if (fd < 0 || fd >= MOCK_MAX_FDS || fd_table[fd].type == MOCK_FD_NONE)
+        return NULL;
+    return &fd_table[fd];
+}
+
+int mock_fd_set(int fd, mock_fd_type_t type, unsigned int index, void *priv)
+{
+    if (fd < 0)
+        return -1;
+
+    if (fd >= MOCK_MAX_FDS)
+    {
+        __real_close(fd);
+        errno = EMFILE;
+        return -1;
+    }
+
+    fd_table[fd].type = type;
+    fd_table[fd].index = index;
+    fd_table[fd].priv = priv;
+    return fd;
+}
+
+int mock_placeholder_fd(void)
+{
+    return __real_open("/dev/null", O_RDWR | O_CLOEXEC);
+}
+
+/*********************************************************************************/
+/* Device nodes */
+/*********************************************************************************/
+
+/* Opens an emulated /dev node. Sets *handled to false for anything else. */
+static int open_device(const char *path, int flags, bool *handled)
+{
+    unsigned int a, b;
+    char tail;
+    int fd;
+
+    *handled = true;
+
+    if (sscanf(path, "/dev/gpiochip%u%c", &a, &tail) == 1)
+    {
+        if (a >= MOCK_GPIO_CHIPS)
+            return errno = ENOENT, -1;
+        return mock_fd_set(mock_placeholder_fd(), MOCK_FD_GPIOCHIP, a, NULL);
+    }
+
+    if (sscanf(path, "/dev/spidev%u.%u%c", &a, &b, &tail) == 2)
+    {
+        if (!mock_spi_exists(a, b))
+            return errno = ENOENT, -1;
+        return mock_fd_set(mock_placeholder_fd(), MOCK_FD_SPI, a << 8 | b, NULL);
+    }
+
+    if (sscanf(path, "/dev/i2c-%u%c", &a, &tail) == 1)
+    {
+        if (a >= MOCK_I2C_BUSES)
+            return errno = ENOENT, -1;
+        return mock_fd_set(mock_placeholder_fd(), MOCK_FD_I2C, a, NULL);
+    }
+
+    if (sscanf(path, "/dev/ttySTM%u%c", &a, &tail) == 1)
+    {
+        if (a >= MOCK_TTYS)
+            return errno = ENOENT, -1;
+        return mock_fd_set(mock_tty_open(a, flags), MOCK_FD_TTY, a, NULL);
+    }
+
+    if (sscanf(path, "/dev/iio:device%u%c", &a, &tail) == 1)
+    {
+        void *priv;
+
+        if ((priv = mock_iio_open(a)) == NULL)
+            return -1;
+
+        /* An eventfd with a count of 1 is always readable, like a busy buffer */
+        fd = eventfd(1, EFD_CLOEXEC | ((flags & O_NONBLOCK) ? EFD_NONBLOCK : 0));
+        if (fd < 0 || mock_fd_set(fd, MOCK_FD_IIO, a, priv) < 0)
+        {
+            mock_iio_close(priv);
+            return -1;
+        }
+        return fd;
+    }
+
+    if (strcmp(path, "/dev/mem") == 0)
+    {
+        char buf[PATH_MAX];
+
+        if (mock_path(path, buf, sizeof(buf)) < 0)
+            return -1;
+        return __real_open(buf, flags & ~O_SYNC);
+    }
+
+    *handled = false;
+    return -1;
+}
+
+/*********************************************************************************/
+/* Wrapped calls */
+/*********************************************************************************/
+
+unsigned long mock_syscalls(void)
+{
+    return syscalls;
+}
+
+int __wrap_open(const char *path, int flags, ...)
+{
+    char buf[PATH_MAX];
+    mode_t mode = 0;
+
+    syscalls++;
+
+    if (flags & (O_CREAT | O_TMPFILE))
+    {
+        va_list ap;
+        va_start(ap, flags);
+        mode = (mode_t)va_arg(ap, int);
+        va_end(ap);
+    }
+
+    if (path && strncmp(path, "/dev/", 5) == 0)
+    {
+        bool handled;
+        int fd = open_device(path, flags, &handled);
+        if (handled)
+            return fd;
+    }
+
+    if (path && strncmp(path, "/sys/", 5) == 0)
+    {
+        /* sysfs attributes are replaced by a write, never appended to;
+         * O_RDWR users such as a GPIO value fd rewind and rewrite in place */
+        if ((flags & O_ACCMODE) == O_WRONLY)
+            flags |= O_TRUNC;
+        path = remap(path, buf, sizeof(buf));
+    }
+
+    return __real_open(path, flags, mode);
+}
+
+int __wrap_close(int fd)
+{
+    mock_fd_t *entry = mock_fd_get(fd);
+
+    syscalls++;
+
+    if (entry)
+    {
+        if (entry->type == MOCK_FD_GPIOLINE)
+            mock_gpio_line_close(entry->priv);
+        else if (entry->type == MOCK_FD_IIO)
+            mock_iio_close(entry->priv);
+        memset(entry, 0, sizeof(*entry));
+    }
+
+    return __real_close(fd);
+}
+
+ssize_t __wrap_read(int fd, void *buf, size_t count)
+{
+    mock_fd_t *entry = mock_fd_get(fd);
+
+    syscalls++;
+
+    if (entry && entry->type == MOCK_FD_IIO)
+        return mock_iio_read(entry->priv, buf, count);
+
+    return __real_read(fd, buf, count);
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t count)
+{
+    syscalls++;
+    return __real_write(fd, buf, count);
+}
+
+off_t __wrap_lseek(int fd, off_t offset, int whence)
+{
+    syscalls++;
+    return __real_lseek(fd, offset, whence);
+}
+
+int __wrap_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    syscalls++;
+    return __real_poll(fds, nfds, timeout);
+}
+
+int __wrap_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout)
+{
+    syscalls++;
+    return __real_select(nfds, readfds, writefds, exceptfds, timeout);
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...)
+{
+    mock_fd_t *entry = mock_fd_get(fd);
+    va_list ap;
+    void *arg;
+
+    va_start(ap, request);
+    arg = va_arg(ap, void *);
+    va_end(ap);
+
+    syscalls++;
+
+    if (!entry)
+        return __real_ioctl(fd, request, arg);
+
+    switch (entry->type)
+    {
+    case MOCK_FD_GPIOCHIP:
+        return mock_gpio_chip_ioctl(entry->index, request, arg);
+    case MOCK_FD_GPIOLINE:
+        return mock_gpio_line_ioctl(entry->priv, request, arg);
+    case MOCK_FD_SPI:
+        return mock_spi_ioctl(entry->index >> 8, entry->index & 0xff, request, arg);
+    case MOCK_FD_I2C:
+        return mock_i2c_ioctl(entry->index, request, arg);
+    case MOCK_FD_TTY:
+        return mock_tty_ioctl(fd, entry->index, request, arg);
+    default:
+        errno = ENOTTY;
+        return -1;
+    }
+}
+
+int __wrap_stat(const char *path, struct stat *st)
+{
+    char buf[PATH_MAX];
+
+    syscalls++;
+    return __real_stat(remap(path, buf, sizeof(buf)), st);
+}
+
+DIR *__wrap_opendir(const char *path)
+{
+    char buf[PATH_MAX];
+
+    syscalls++;
+    return __real_opendir(remap_dir(path, buf, sizeof(buf)));
+}
+
+ssize_t __wrap_readlink(const char *path, char *link, size_t len)
+{
+    char buf[PATH_MAX];
+
+    syscalls++;
+    return __real_readlink(remap(path, buf, sizeof(buf)), link, len);
+}
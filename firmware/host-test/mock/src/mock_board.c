@@ -0,0 +1,260 @@
+/**
+ * @file mock_board.c
+ * @brief Files of the fake root: sysfs attributes and the /dev/mem image.
+ *
+ * The tree mirrors what the board's kernel exposes for the devices the
+ * examples use. Attributes are plain files, so reads return what was last
+ * written; no attribute has side effects.
+ */
+
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "mock_internal.h"
+
+#define MEM_SIZE 0x100000000ULL      /* Whole 32-bit physical address space */
+#define RCC_PLLCFGR 0x40023804UL
+#define RCC_PLLCFGR_180MHZ 0x00405A08 /* HSE 8 MHz, M=8, N=360, P=2 */
+
+static const char *board_root;
+
+/* mkdir -p of the parent directories of root + rel */
+static int make_parents(const char *path)
+{
+    char buf[PATH_MAX];
+    char *p;
+
+    snprintf(buf, sizeof(buf), "%s", path);
+    for (p = buf + strlen(board_root) + 1; (p = strchr(p, '/')) != NULL; p++)
+    {
+        *p = '\0';
+        if (mkdir(buf, 0755) < 0 && errno != EEXIST)
+            return -1;
+        *p = '/';
+    }
+    return 0;
+}
+
+/* Create an attribute file with printf-style content */
+static int put(const char *rel, const char *fmt, ...)
+{
+    char path[PATH_MAX];
+    va_list ap;
+    FILE *file;
+
+    snprintf(path, sizeof(path), "%s%s", board_root, rel);
+    if (make_parents(path) < 0 || (file = fopen(path, "w")) == NULL)
+        return -1;
+
+    va_start(ap, fmt);
+    vfprintf(file, fmt, ap);
+    va_end(ap);
+
+    return fclose(file);
+}
+
+static int put_link(const char *rel, const char *target)
+{
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof(path), "%s%s", board_root, rel);
+    if (make_parents(path) < 0 || (symlink(target, path) < 0 && errno != EEXIST))
+        return -1;
+    return 0;
+}
+
+static int create_leds(void)
+{
+    static const char *const leds[] = {"led-green", "led-red"};
+    char rel[128];
+
+    for (size_t i = 0; i < sizeof(leds) / sizeof(leds[0]); i++)
+    {
+        snprintf(rel, sizeof(rel), "/sys/class/leds/%s/brightness", leds[i]);
+        if (put(rel, "0\n") < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "/sys/class/leds/%s/max_brightness", leds[i]);
+        if (put(rel, "1\n") < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "/sys/class/leds/%s/trigger", leds[i]);
+        if (put(rel, "[none] heartbeat timer default-on\n") < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int create_pwm(void)
+{
+    static const char *const attrs[][2] = {
+        {"period", "0"}, {"duty_cycle", "0"}, {"enable", "0"}, {"polarity", "normal"}};
+    char rel[128];
+
+    if (put("/sys/class/pwm/pwmchip0/npwm", "4\n") < 0 ||
+        put("/sys/class/pwm/pwmchip0/export", "") < 0 ||
+        put("/sys/class/pwm/pwmchip0/unexport", "") < 0)
+        return -1;
+
+    /* Channels are already exported, as udev would leave them */
+    for (unsigned int channel = 0; channel < 4; channel++)
+    {
+        for (size_t i = 0; i < sizeof(attrs) / sizeof(attrs[0]); i++)
+        {
+            snprintf(rel, sizeof(rel), "/sys/class/pwm/pwmchip0/pwm%u/%s", channel, attrs[i][0]);
+            if (put(rel, "%s\n", attrs[i][1]) < 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+static int create_gpio_sysfs(void)
+{
+    char rel[128];
+    char target[32];
+
+    if (put("/sys/class/gpio/export", "") < 0 || put("/sys/class/gpio/unexport", "") < 0)
+        return -1;
+
+    for (unsigned int chip = 0; chip < MOCK_GPIO_CHIPS; chip++)
+    {
+        unsigned int base = chip * MOCK_GPIO_LINES;
+
+        snprintf(rel, sizeof(rel), "/sys/class/gpio/gpiochip%u/base", base);
+        if (put(rel, "%u\n", base) < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "/sys/class/gpio/gpiochip%u/label", base);
+        if (put(rel, "GPIO%c\n", 'A' + chip) < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "/sys/class/gpio/gpiochip%u/ngpio", base);
+        if (put(rel, "%u\n", MOCK_GPIO_LINES) < 0)
+            return -1;
+    }
+
+    /* Lines are pre-exported so gpio_open_sysfs() finds them at once */
+    for (unsigned int line = 0; line < MOCK_GPIO_CHIPS * MOCK_GPIO_LINES; line++)
+    {
+        static const char *const attrs[][2] = {
+            {"value", "0"}, {"direction", "in"}, {"edge", "none"}, {"active_low", "0"}};
+
+        for (size_t i = 0; i < sizeof(attrs) / sizeof(attrs[0]); i++)
+        {
+            snprintf(rel, sizeof(rel), "/sys/class/gpio/gpio%u/%s", line, attrs[i][0]);
+            if (put(rel, "%s\n", attrs[i][1]) < 0)
+                return -1;
+        }
+
+        snprintf(rel, sizeof(rel), "/sys/class/gpio/gpio%u/device", line);
+        snprintf(target, sizeof(target), "../gpiochip%u", line - line % MOCK_GPIO_LINES);
+        if (put_link(rel, target) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int create_iio(void)
+{
+    const char *dev = "/sys/bus/iio/devices/iio:device0";
+    char rel[160];
+
+    if (put("/sys/bus/iio/devices/trigger0/name", "tim2_trgo\n") < 0 ||
+        put("/sys/bus/iio/devices/trigger0/sampling_frequency", "0\n") < 0)
+        return -1;
+
+    snprintf(rel, sizeof(rel), "%s/name", dev);
+    if (put(rel, "40012200.adc:adc@200\n") < 0)
+        return -1;
+    snprintf(rel, sizeof(rel), "%s/in_voltage_scale", dev);
+    if (put(rel, "0.805664062\n") < 0)
+        return -1;
+    snprintf(rel, sizeof(rel), "%s/buffer/enable", dev);
+    if (put(rel, "0\n") < 0)
+        return -1;
+    snprintf(rel, sizeof(rel), "%s/buffer/length", dev);
+    if (put(rel, "2\n") < 0)
+        return -1;
+    snprintf(rel, sizeof(rel), "%s/buffer/watermark", dev);
+    if (put(rel, "1\n") < 0)
+        return -1;
+    snprintf(rel, sizeof(rel), "%s/trigger/current_trigger", dev);
+    if (put(rel, "\n") < 0)
+        return -1;
+
+    for (unsigned int channel = 0; channel < 16; channel++)
+    {
+        snprintf(rel, sizeof(rel), "%s/in_voltage%u_raw", dev, channel);
+        if (put(rel, "2048\n") < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "%s/scan_elements/in_voltage%u_en", dev, channel);
+        if (put(rel, "0\n") < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "%s/scan_elements/in_voltage%u_index", dev, channel);
+        if (put(rel, "%u\n", channel) < 0)
+            return -1;
+        snprintf(rel, sizeof(rel), "%s/scan_elements/in_voltage%u_type", dev, channel);
+        if (put(rel, "le:u12/16>>0\n") < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/* Stand-ins for the chip nodes, so a listing of /dev finds them; opening
+ * one is still served by the emulation */
+static int create_gpio_chips(void)
+{
+    char rel[32];
+
+    for (unsigned int chip = 0; chip < MOCK_GPIO_CHIPS; chip++)
+    {
+        snprintf(rel, sizeof(rel), "/dev/gpiochip%u", chip);
+        if (put(rel, "") < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int create_mem(void)
+{
+    char path[PATH_MAX];
+    uint32_t pllcfgr = RCC_PLLCFGR_180MHZ;
+    int fd;
+
+    snprintf(path, sizeof(path), "%s/dev/mem", board_root);
+    if (make_parents(path) < 0 || (fd = __real_open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) < 0)
+        return -1;
+
+    /* Sparse: only the pages written below take up space */
+    if (ftruncate(fd, (off_t)MEM_SIZE) < 0 ||
+        pwrite(fd, &pllcfgr, sizeof(pllcfgr), RCC_PLLCFGR) != sizeof(pllcfgr))
+    {
+        __real_close(fd);
+        return -1;
+    }
+    return __real_close(fd);
+}
+
+int mock_board_create(const char *root)
+{
+    char stamp[PATH_MAX];
+    struct stat st;
+
+    board_root = root;
+
+    /* A shared root (MOCK_ROOT) is populated by the first process only */
+    snprintf(stamp, sizeof(stamp), "%s/.board", root);
+    if (__real_stat(stamp, &st) == 0)
+        return 0;
+
+    if (create_leds() < 0 || create_pwm() < 0 || create_gpio_sysfs() < 0 ||
+        create_iio() < 0 || create_gpio_chips() < 0 || create_mem() < 0)
+        return -1;
+
+    return put("/.board", "stm32f429disco\n");
+}
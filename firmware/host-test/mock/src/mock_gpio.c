@@ -0,0 +1,669 @@
+/**
+ * @file mock_gpio.c
+ * @brief GPIO character device (uAPI v1 and v2) emulation.
+ *
+ * A line request is backed by a pipe: the program gets the read end as the
+ * request fd, so poll() and read() of edge events work unchanged, and the
+ * mock keeps the write end to queue struct gpio_v2_line_event records, or
+ * struct gpioevent_data for a v1 event request. Line state is kept in v2
+ * flags; v1 requests are translated on the way in and out.
+ *
+ * Debounced lines behave like the kernel's software debouncer: a change
+ * only counts once the input has been steady for the period. A helper
+ * thread, started by the first debounced request, stands in for the
+ * kernel's delayed work; the lines are shared with it under gpio_lock.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+
+#include "mock_internal.h"
+
+typedef struct mock_request mock_request_t;
+
+typedef struct mock_line
+{
+    bool level;               /**< Physical level at the pin */
+    mock_request_t *request;  /**< Owning request, NULL when free */
+    uint64_t flags;           /**< GPIO_V2_LINE_FLAG_* of the request */
+    uint32_t seqno;           /**< Events seen on this line */
+    char consumer[GPIO_MAX_NAME_SIZE];
+    char name[GPIO_MAX_NAME_SIZE];  /**< Set name, empty for the default */
+    uint32_t debounce_us;     /**< Debounce period of the request, 0 for none */
+    bool stable;              /**< Debounced level, what reads and events see */
+    bool settling;            /**< A change is waiting out the period */
+    uint64_t settle_ns;       /**< Monotonic time the change counts as steady */
+} mock_line_t;
+
+struct mock_request
+{
+    unsigned int chip;
+    unsigned int num_lines;
+    unsigned int offsets[GPIO_V2_LINES_MAX];
+    int fd;                   /**< Read end of the event pipe, the request fd */
+    int event_fd;             /**< Write end of the event pipe */
+    uint32_t seqno;           /**< Events seen on the whole request */
+    bool v1;                  /**< Made through the v1 ABI */
+};
+
+static mock_line_t lines[MOCK_GPIO_CHIPS][MOCK_GPIO_LINES];
+static char labels[MOCK_GPIO_CHIPS][GPIO_MAX_NAME_SIZE];  /**< Set labels, empty for the default */
+
+/* Recursive: a failed request is closed from inside the ioctl */
+static pthread_mutex_t gpio_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_cond_t debounce_cond;
+static pthread_once_t debounce_once = PTHREAD_ONCE_INIT;
+
+static bool line_is_active_low(const mock_line_t *line)
+{
+    return (line->flags & GPIO_V2_LINE_FLAG_ACTIVE_LOW) != 0;
+}
+
+/* Physical level as the program reads it, after the debouncer */
+static bool line_level(const mock_line_t *line)
+{
+    return line->debounce_us ? line->stable : line->level;
+}
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Flags of line idx in a request: the last matching flags attribute wins */
+static uint64_t request_line_flags(const struct gpio_v2_line_config *config, unsigned int idx)
+{
+    uint64_t flags = config->flags;
+
+    for (unsigned int i = 0; i < config->num_attrs && i < GPIO_V2_LINE_NUM_ATTRS_MAX; i++)
+    {
+        const struct gpio_v2_line_config_attribute *attr = &config->attrs[i];
+        if (attr->attr.id == GPIO_V2_LINE_ATTR_ID_FLAGS && (attr->mask >> idx) & 1)
+            flags = attr->attr.flags;
+    }
+    return flags;
+}
+
+static int get_line_info(unsigned int chip, struct gpio_v2_line_info *info)
+{
+    unsigned int offset = info->offset;
+    const mock_line_t *line;
+
+    if (offset >= MOCK_GPIO_LINES)
+        return errno = EINVAL, -1;
+
+    line = &lines[chip][offset];
+    memset(info, 0, sizeof(*info));
+    if (line->name[0])
+        snprintf(info->name, sizeof(info->name), "%s", line->name);
+    else
+        snprintf(info->name, sizeof(info->name), "P%c%u", 'A' + chip, offset);
+    info->offset = offset;
+
+    if (line->request)
+    {
+        snprintf(info->consumer, sizeof(info->consumer), "%s", line->consumer);
+        info->flags = line->flags | GPIO_V2_LINE_FLAG_USED;
+        if (line->debounce_us)
+        {
+            info->num_attrs = 1;
+            info->attrs[0].id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+            info->attrs[0].debounce_period_us = line->debounce_us;
+        }
+    }
+    else
+    {
+        info->flags = GPIO_V2_LINE_FLAG_INPUT;
+    }
+    return 0;
+}
+
+/* Claims offsets[0..num_lines) of a chip for a new request; the line flags
+ * and output levels are up to the caller */
+static mock_request_t *new_request(unsigned int chip, const uint32_t *offsets, unsigned int num_lines, const char *consumer, bool v1)
+{
+    mock_request_t *request;
+    int pipe_fds[2];
+
+    if (num_lines == 0 || num_lines > GPIO_V2_LINES_MAX)
+        return errno = EINVAL, NULL;
+
+    for (unsigned int i = 0; i < num_lines; i++)
+    {
+        if (offsets[i] >= MOCK_GPIO_LINES)
+            return errno = EINVAL, NULL;
+        if (lines[chip][offsets[i]].request)
+            return errno = EBUSY, NULL;
+    }
+
+    if ((request = calloc(1, sizeof(*request))) == NULL)
+        return errno = ENOMEM, NULL;
+
+    if (pipe2(pipe_fds, O_CLOEXEC) < 0)
+    {
+        free(request);
+        return NULL;
+    }
+    fcntl(pipe_fds[1], F_SETFL, O_NONBLOCK);
+
+    request->chip = chip;
+    request->num_lines = num_lines;
+    request->v1 = v1;
+    request->fd = pipe_fds[0];
+    request->event_fd = pipe_fds[1];
+
+    for (unsigned int i = 0; i < num_lines; i++)
+    {
+        mock_line_t *line = &lines[chip][offsets[i]];
+
+        request->offsets[i] = offsets[i];
+        line->request = request;
+        line->flags = 0;
+        line->debounce_us = 0;
+        line->settling = false;
+        snprintf(line->consumer, sizeof(line->consumer), "%s", consumer);
+        line->seqno = 0;
+    }
+
+    if (mock_fd_set(pipe_fds[0], MOCK_FD_GPIOLINE, chip, request) < 0)
+    {
+        mock_gpio_line_close(request);
+        return NULL;
+    }
+
+    return request;
+}
+
+/* Queue the event of a line whose (debounced) level just changed, if its
+ * request watches that edge */
+static int emit_edge(unsigned int chip, unsigned int offset)
+{
+    mock_line_t *line = &lines[chip][offset];
+    mock_request_t *req = line->request;
+    struct gpio_v2_line_event event = {0};
+    struct timespec ts;
+    bool active;
+
+    /* Edges are reported on the logical value, after active-low inversion */
+    active = line_level(line) ^ line_is_active_low(line);
+    if (!req || !(line->flags & (active ? GPIO_V2_LINE_FLAG_EDGE_RISING : GPIO_V2_LINE_FLAG_EDGE_FALLING)))
+        return 0;
+
+    if (req->v1)
+    {
+        struct gpioevent_data data = {0};
+
+        /* v1 events are stamped with the monotonic clock since Linux 5.7 */
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        data.timestamp = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+        data.id = active ? GPIOEVENT_EVENT_RISING_EDGE : GPIOEVENT_EVENT_FALLING_EDGE;
+
+        if (__real_write(req->event_fd, &data, sizeof(data)) < 0 && errno != EAGAIN)
+            return -1;
+        return 0;
+    }
+
+    clock_gettime((line->flags & GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME) ? CLOCK_REALTIME : CLOCK_MONOTONIC, &ts);
+    event.timestamp_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    event.id = active ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+    event.offset = offset;
+    event.seqno = ++req->seqno;
+    event.line_seqno = ++line->seqno;
+
+    /* A full kfifo drops events as well */
+    if (__real_write(req->event_fd, &event, sizeof(event)) < 0 && errno != EAGAIN)
+        return -1;
+    return 0;
+}
+
+/* Debounce period of line idx in a request, 0 for none */
+static uint32_t request_line_debounce(const struct gpio_v2_line_config *config, unsigned int idx)
+{
+    uint32_t debounce_us = 0;
+
+    for (unsigned int i = 0; i < config->num_attrs && i < GPIO_V2_LINE_NUM_ATTRS_MAX; i++)
+    {
+        const struct gpio_v2_line_config_attribute *attr = &config->attrs[i];
+        if (attr->attr.id == GPIO_V2_LINE_ATTR_ID_DEBOUNCE && (attr->mask >> idx) & 1)
+            debounce_us = attr->attr.debounce_period_us;
+    }
+    return debounce_us;
+}
+
+static void *debounce_thread(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&gpio_lock);
+    for (;;)
+    {
+        uint64_t now = monotonic_ns(), next = UINT64_MAX;
+
+        for (unsigned int chip = 0; chip < MOCK_GPIO_CHIPS; chip++)
+        {
+            for (unsigned int offset = 0; offset < MOCK_GPIO_LINES; offset++)
+            {
+                mock_line_t *line = &lines[chip][offset];
+
+                if (!line->settling)
+                    continue;
+
+                if (line->settle_ns > now)
+                {
+                    if (line->settle_ns < next)
+                        next = line->settle_ns;
+                    continue;
+                }
+
+                /* A bounce that ended where it started reports nothing */
+                line->settling = false;
+                if (line->stable != line->level)
+                {
+                    line->stable = line->level;
+                    emit_edge(chip, offset);
+                }
+            }
+        }
+
+        if (next == UINT64_MAX)
+        {
+            pthread_cond_wait(&debounce_cond, &gpio_lock);
+        }
+        else
+        {
+            struct timespec ts = {.tv_sec = (time_t)(next / 1000000000ULL), .tv_nsec = (long)(next % 1000000000ULL)};
+            pthread_cond_timedwait(&debounce_cond, &gpio_lock, &ts);
+        }
+    }
+    return NULL;
+}
+
+static void debounce_start(void)
+{
+    pthread_condattr_t attr;
+    sigset_t all, saved;
+    pthread_t thread;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&debounce_cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    /* Signals stay with the program's threads */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &saved);
+    if (pthread_create(&thread, NULL, debounce_thread, NULL) == 0)
+        pthread_detach(thread);
+    pthread_sigmask(SIG_SETMASK, &saved, NULL);
+}
+
+static int get_line(unsigned int chip, struct gpio_v2_line_request *lr)
+{
+    mock_request_t *request;
+
+    /* gpio-sim has no hardware timestamp engine, and without CONFIG_HTE
+     * the kernel refuses the flag outright */
+    for (unsigned int i = 0; i < lr->num_lines && i < GPIO_V2_LINES_MAX; i++)
+    {
+        if (request_line_flags(&lr->config, i) & GPIO_V2_LINE_FLAG_EVENT_CLOCK_HTE)
+            return errno = EOPNOTSUPP, -1;
+    }
+
+    if ((request = new_request(chip, lr->offsets, lr->num_lines, lr->consumer, false)) == NULL)
+        return -1;
+
+    for (unsigned int i = 0; i < lr->num_lines; i++)
+    {
+        mock_line_t *line = &lines[chip][lr->offsets[i]];
+
+        line->flags = request_line_flags(&lr->config, i);
+
+        if (line->flags & GPIO_V2_LINE_FLAG_INPUT)
+        {
+            line->debounce_us = request_line_debounce(&lr->config, i);
+            line->stable = line->level;
+            if (line->debounce_us)
+                pthread_once(&debounce_once, debounce_start);
+        }
+
+        if (line->flags & GPIO_V2_LINE_FLAG_OUTPUT)
+        {
+            bool value = false;
+
+            for (unsigned int a = 0; a < lr->config.num_attrs && a < GPIO_V2_LINE_NUM_ATTRS_MAX; a++)
+            {
+                const struct gpio_v2_line_config_attribute *attr = &lr->config.attrs[a];
+                if (attr->attr.id == GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES && (attr->mask >> i) & 1)
+                    value = (attr->attr.values >> i) & 1;
+            }
+            line->level = value ^ line_is_active_low(line);
+        }
+    }
+
+    lr->fd = request->fd;
+    return 0;
+}
+
+/*********************************************************************************/
+/* uAPI v1 */
+/*********************************************************************************/
+
+/* GPIOHANDLE_REQUEST_* to GPIO_V2_LINE_FLAG_* */
+static uint64_t v1_handle_flags(uint32_t flags)
+{
+    static const struct { uint32_t v1; uint64_t v2; } map[] = {
+        {GPIOHANDLE_REQUEST_INPUT, GPIO_V2_LINE_FLAG_INPUT},
+        {GPIOHANDLE_REQUEST_OUTPUT, GPIO_V2_LINE_FLAG_OUTPUT},
+        {GPIOHANDLE_REQUEST_ACTIVE_LOW, GPIO_V2_LINE_FLAG_ACTIVE_LOW},
+        {GPIOHANDLE_REQUEST_OPEN_DRAIN, GPIO_V2_LINE_FLAG_OPEN_DRAIN},
+        {GPIOHANDLE_REQUEST_OPEN_SOURCE, GPIO_V2_LINE_FLAG_OPEN_SOURCE},
+        {GPIOHANDLE_REQUEST_BIAS_PULL_UP, GPIO_V2_LINE_FLAG_BIAS_PULL_UP},
+        {GPIOHANDLE_REQUEST_BIAS_PULL_DOWN, GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN},
+        {GPIOHANDLE_REQUEST_BIAS_DISABLE, GPIO_V2_LINE_FLAG_BIAS_DISABLED},
+    };
+    uint64_t v2 = 0;
+
+    for (size_t i = 0; i < sizeof(map) / sizeof(map[0]); i++)
+        if (flags & map[i].v1)
+            v2 |= map[i].v2;
+    return v2;
+}
+
+/* GPIO_V2_LINE_FLAG_* to GPIOLINE_FLAG_* */
+static uint32_t v1_line_flags(uint64_t flags)
+{
+    static const struct { uint64_t v2; uint32_t v1; } map[] = {
+        {GPIO_V2_LINE_FLAG_USED, GPIOLINE_FLAG_KERNEL},
+        {GPIO_V2_LINE_FLAG_OUTPUT, GPIOLINE_FLAG_IS_OUT},
+        {GPIO_V2_LINE_FLAG_ACTIVE_LOW, GPIOLINE_FLAG_ACTIVE_LOW},
+        {GPIO_V2_LINE_FLAG_OPEN_DRAIN, GPIOLINE_FLAG_OPEN_DRAIN},
+        {GPIO_V2_LINE_FLAG_OPEN_SOURCE, GPIOLINE_FLAG_OPEN_SOURCE},
+        {GPIO_V2_LINE_FLAG_BIAS_PULL_UP, GPIOLINE_FLAG_BIAS_PULL_UP},
+        {GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN, GPIOLINE_FLAG_BIAS_PULL_DOWN},
+        {GPIO_V2_LINE_FLAG_BIAS_DISABLED, GPIOLINE_FLAG_BIAS_DISABLE},
+    };
+    uint32_t v1 = 0;
+
+    for (size_t i = 0; i < sizeof(map) / sizeof(map[0]); i++)
+        if (flags & map[i].v2)
+            v1 |= map[i].v1;
+    return v1;
+}
+
+static int get_linehandle(unsigned int chip, struct gpiohandle_request *hr)
+{
+    mock_request_t *request;
+
+    if (hr->lines > GPIOHANDLES_MAX)
+        return errno = EINVAL, -1;
+    if ((request = new_request(chip, hr->lineoffsets, hr->lines, hr->consumer_label, true)) == NULL)
+        return -1;
+
+    for (unsigned int i = 0; i < hr->lines; i++)
+    {
+        mock_line_t *line = &lines[chip][hr->lineoffsets[i]];
+
+        line->flags = v1_handle_flags(hr->flags);
+        if (line->flags & GPIO_V2_LINE_FLAG_OUTPUT)
+            line->level = (hr->default_values[i] != 0) ^ line_is_active_low(line);
+    }
+
+    hr->fd = request->fd;
+    return 0;
+}
+
+static int get_lineevent(unsigned int chip, struct gpioevent_request *er)
+{
+    mock_request_t *request;
+    mock_line_t *line;
+
+    if (er->handleflags & GPIOHANDLE_REQUEST_OUTPUT)
+        return errno = EINVAL, -1;
+    if ((request = new_request(chip, &er->lineoffset, 1, er->consumer_label, true)) == NULL)
+        return -1;
+
+    line = &lines[chip][er->lineoffset];
+    line->flags = v1_handle_flags(er->handleflags) | GPIO_V2_LINE_FLAG_INPUT;
+    if (er->eventflags & GPIOEVENT_REQUEST_RISING_EDGE)
+        line->flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+    if (er->eventflags & GPIOEVENT_REQUEST_FALLING_EDGE)
+        line->flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+    er->fd = request->fd;
+    return 0;
+}
+
+static int get_lineinfo_v1(unsigned int chip, struct gpioline_info *info)
+{
+    struct gpio_v2_line_info v2 = {0};
+
+    v2.offset = info->line_offset;
+    if (get_line_info(chip, &v2) < 0)
+        return -1;
+
+    memset(info, 0, sizeof(*info));
+    info->line_offset = v2.offset;
+    info->flags = v1_line_flags(v2.flags);
+    memcpy(info->name, v2.name, sizeof(info->name));
+    memcpy(info->consumer, v2.consumer, sizeof(info->consumer));
+    return 0;
+}
+
+/*********************************************************************************/
+/* Chip and request ioctls */
+/*********************************************************************************/
+
+static int chip_ioctl(unsigned int chip, unsigned long request, void *arg)
+{
+    switch (request)
+    {
+    case GPIO_GET_CHIPINFO_IOCTL:
+    {
+        struct gpiochip_info *info = arg;
+
+        memset(info, 0, sizeof(*info));
+        snprintf(info->name, sizeof(info->name), "gpiochip%u", chip);
+        if (labels[chip][0])
+            snprintf(info->label, sizeof(info->label), "%s", labels[chip]);
+        else
+            snprintf(info->label, sizeof(info->label), "GPIO%c", 'A' + chip);
+        info->lines = MOCK_GPIO_LINES;
+        return 0;
+    }
+    case GPIO_V2_GET_LINEINFO_IOCTL:
+        return get_line_info(chip, arg);
+    case GPIO_V2_GET_LINE_IOCTL:
+        return get_line(chip, arg);
+    case GPIO_GET_LINEINFO_IOCTL:
+        return get_lineinfo_v1(chip, arg);
+    case GPIO_GET_LINEHANDLE_IOCTL:
+        return get_linehandle(chip, arg);
+    case GPIO_GET_LINEEVENT_IOCTL:
+        return get_lineevent(chip, arg);
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+}
+
+int mock_gpio_chip_ioctl(unsigned int chip, unsigned long request, void *arg)
+{
+    int ret;
+
+    pthread_mutex_lock(&gpio_lock);
+    ret = chip_ioctl(chip, request, arg);
+    pthread_mutex_unlock(&gpio_lock);
+    return ret;
+}
+
+static int line_ioctl(void *priv, unsigned long request, void *arg)
+{
+    mock_request_t *req = priv;
+    struct gpio_v2_line_values *values = arg;
+    struct gpiohandle_data *data = arg;
+
+    switch (request)
+    {
+    case GPIOHANDLE_GET_LINE_VALUES_IOCTL:
+        if (!req->v1)
+            return errno = EINVAL, -1;
+        for (unsigned int i = 0; i < req->num_lines; i++)
+        {
+            const mock_line_t *line = &lines[req->chip][req->offsets[i]];
+            data->values[i] = line_level(line) ^ line_is_active_low(line);
+        }
+        return 0;
+    case GPIOHANDLE_SET_LINE_VALUES_IOCTL:
+        if (!req->v1)
+            return errno = EINVAL, -1;
+        for (unsigned int i = 0; i < req->num_lines; i++)
+        {
+            mock_line_t *line = &lines[req->chip][req->offsets[i]];
+
+            if (!(line->flags & GPIO_V2_LINE_FLAG_OUTPUT))
+                return errno = EPERM, -1;
+            line->level = (data->values[i] != 0) ^ line_is_active_low(line);
+        }
+        return 0;
+    case GPIO_V2_LINE_GET_VALUES_IOCTL:
+    {
+        uint64_t bits = 0;
+
+        if (req->v1)
+            return errno = EINVAL, -1;
+
+        for (unsigned int i = 0; i < req->num_lines; i++)
+        {
+            const mock_line_t *line = &lines[req->chip][req->offsets[i]];
+            if ((values->mask >> i) & 1)
+                bits |= (uint64_t)(line_level(line) ^ line_is_active_low(line)) << i;
+        }
+        values->bits = bits;
+        return 0;
+    }
+    case GPIO_V2_LINE_SET_VALUES_IOCTL:
+        if (req->v1)
+            return errno = EINVAL, -1;
+        for (unsigned int i = 0; i < req->num_lines; i++)
+        {
+            mock_line_t *line = &lines[req->chip][req->offsets[i]];
+
+            if (!((values->mask >> i) & 1))
+                continue;
+            if (!(line->flags & GPIO_V2_LINE_FLAG_OUTPUT))
+                return errno = EPERM, -1;
+            line->level = ((values->bits >> i) & 1) ^ line_is_active_low(line);
+        }
+        return 0;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+}
+
+int mock_gpio_line_ioctl(void *priv, unsigned long request, void *arg)
+{
+    int ret;
+
+    pthread_mutex_lock(&gpio_lock);
+    ret = line_ioctl(priv, request, arg);
+    pthread_mutex_unlock(&gpio_lock);
+    return ret;
+}
+
+void mock_gpio_line_close(void *priv)
+{
+    mock_request_t *req = priv;
+
+    pthread_mutex_lock(&gpio_lock);
+    for (unsigned int i = 0; i < req->num_lines; i++)
+    {
+        mock_line_t *line = &lines[req->chip][req->offsets[i]];
+        line->request = NULL;
+        line->flags = 0;
+        line->debounce_us = 0;
+        line->settling = false;
+    }
+    __real_close(req->event_fd);
+    free(req);
+    pthread_mutex_unlock(&gpio_lock);
+}
+
+int mock_gpio_set_input(unsigned int chip, unsigned int offset, bool level)
+{
+    mock_line_t *line;
+    int ret = 0;
+
+    if (chip >= MOCK_GPIO_CHIPS || offset >= MOCK_GPIO_LINES)
+        return -1;
+
+    pthread_mutex_lock(&gpio_lock);
+
+    line = &lines[chip][offset];
+    if (!(line->flags & GPIO_V2_LINE_FLAG_OUTPUT) && line->level != level)
+    {
+        line->level = level;
+
+        /* Every change restarts the debounce period */
+        if (line->request && line->debounce_us)
+        {
+            line->settling = true;
+            line->settle_ns = monotonic_ns() + (uint64_t)line->debounce_us * 1000;
+            pthread_cond_signal(&debounce_cond);
+        }
+        else
+        {
+            ret = emit_edge(chip, offset);
+        }
+    }
+
+    pthread_mutex_unlock(&gpio_lock);
+    return ret;
+}
+
+int mock_gpio_get_output(unsigned int chip, unsigned int offset)
+{
+    const mock_line_t *line;
+    int level;
+
+    if (chip >= MOCK_GPIO_CHIPS || offset >= MOCK_GPIO_LINES)
+        return -1;
+
+    pthread_mutex_lock(&gpio_lock);
+    line = &lines[chip][offset];
+    level = (line->request && (line->flags & GPIO_V2_LINE_FLAG_OUTPUT)) ? line->level : -1;
+    pthread_mutex_unlock(&gpio_lock);
+    return level;
+}
+
+int mock_gpio_set_line_name(unsigned int chip, unsigned int offset, const char *name)
+{
+    if (chip >= MOCK_GPIO_CHIPS || offset >= MOCK_GPIO_LINES)
+        return -1;
+
+    snprintf(lines[chip][offset].name, sizeof(lines[chip][offset].name), "%s", name ? name : "");
+    return 0;
+}
+
+int mock_gpio_set_chip_label(unsigned int chip, const char *label)
+{
+    if (chip >= MOCK_GPIO_CHIPS)
+        return -1;
+
+    snprintf(labels[chip], sizeof(labels[chip]), "%s", label ? label : "");
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file mock_i2c.c
+ * @brief i2c-dev emulation.
+ *
+ * Every slave is a 256-byte register file: a write sets the register
+ * pointer from its first byte and stores the rest, a read returns bytes
+ * from the pointer on. Transfers to an address without a slave fail with
+ * ENXIO, which is how a missing ACK shows up on a real adapter.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "mock_internal.h"
+
+#define I2C_ADDRS 128
+
+typedef struct mock_slave
+{
+    uint8_t regs[256];
+    uint8_t pointer;
+} mock_slave_t;
+
+static mock_slave_t *slaves[MOCK_I2C_BUSES][I2C_ADDRS];
+
+/* STMPE811 touch controller: CHIP_ID 0x0811, ID_VER 0x03 */
+static void stmpe811_init(uint8_t *regs)
+{
+    regs[0x00] = 0x08;
+    regs[0x01] = 0x11;
+    regs[0x02] = 0x03;
+}
+
+/* Default slaves, or MOCK_I2C_DEVICES="bus:addr,bus:addr" */
+static void attach_defaults(void)
+{
+    static bool done;
+    const char *env;
+
+    if (done)
+        return;
+    done = true;
+
+    env = getenv("MOCK_I2C_DEVICES");
+    if (!env)
+    {
+        uint8_t *regs = mock_i2c_attach(0, 0x41);
+        if (regs)
+            stmpe811_init(regs);
+        return;
+    }
+
+    while (*env)
+    {
+        unsigned int bus, addr;
+        int used;
+
+        if (sscanf(env, "%u:%i%n", &bus, &addr, &used) != 2)
+            break;
+        mock_i2c_attach(bus, (uint16_t)addr);
+        env += used;
+        if (*env == ',')
+            env++;
+    }
+}
+
+uint8_t *mock_i2c_attach(unsigned int bus, uint16_t addr)
+{
+    if (bus >= MOCK_I2C_BUSES || addr >= I2C_ADDRS)
+        return NULL;
+
+    attach_defaults();
+
+    if (!slaves[bus][addr] && (slaves[bus][addr] = calloc(1, sizeof(mock_slave_t))) == NULL)
+        return NULL;
+    return slaves[bus][addr]->regs;
+}
+
+void mock_i2c_detach(unsigned int bus, uint16_t addr)
+{
+    if (bus >= MOCK_I2C_BUSES || addr >= I2C_ADDRS)
+        return;
+
+    attach_defaults();
+
+    free(slaves[bus][addr]);
+    slaves[bus][addr] = NULL;
+}
+
+static int rdwr(unsigned int bus, struct i2c_rdwr_ioctl_data *data)
+{
+    if (data->nmsgs == 0 || data->nmsgs > I2C_RDWR_IOCTL_MAX_MSGS)
+        return errno = EINVAL, -1;
+
+    for (unsigned int m = 0; m < data->nmsgs; m++)
+    {
+        struct i2c_msg *msg = &data->msgs[m];
+        mock_slave_t *slave = msg->addr < I2C_ADDRS ? slaves[bus][msg->addr] : NULL;
+
+        if (!slave)
+            return errno = ENXIO, -1;
+
+        if (msg->flags & I2C_M_RD)
+        {
+            for (unsigned int i = 0; i < msg->len; i++)
+                msg->buf[i] = slave->regs[slave->pointer++];
+        }
+        else if (msg->len > 0)
+        {
+            slave->pointer = msg->buf[0];
+            for (unsigned int i = 1; i < msg->len; i++)
+                slave->regs[slave->pointer++] = msg->buf[i];
+        }
+    }
+    return (int)data->nmsgs;
+}
+
+int mock_i2c_ioctl(unsigned int bus, unsigned long request, void *arg)
+{
+    attach_defaults();
+
+    switch (request)
+    {
+    case I2C_FUNCS:
+        *(unsigned long *)arg = I2C_FUNC_I2C;
+        return 0;
+    case I2C_RDWR:
+        return rdwr(bus, arg);
+    default:
+        errno = ENOTTY;
+        return -1;
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file mock_iio.c
+ * @brief IIO buffered ADC emulation for /dev/iio:device0.
+ *
+ * While buffer/enable in the fake sysfs reads 1, every read() returns as
+ * many whole samples as fit: a 12-bit triangle wave, stored little-endian in
+ * 16 bits as in_voltageN_type says. The stream is not paced to the trigger
+ * rate, so block reads measure the cost of the read path alone. With the
+ * buffer disabled a read returns end of stream.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+
+#include "mock_internal.h"
+
+#define IIO_DEVICES 1
+#define WAVE_PERIOD 512 /* Samples per triangle period */
+
+typedef struct mock_iio
+{
+    unsigned int device;
+    uint32_t phase;
+    char enable_path[PATH_MAX];
+} mock_iio_t;
+
+static bool buffer_enabled(const mock_iio_t *iio)
+{
+    char value = '0';
+    int fd;
+
+    if ((fd = __real_open(iio->enable_path, O_RDONLY | O_CLOEXEC)) < 0)
+        return false;
+    if (__real_read(fd, &value, 1) != 1)
+        value = '0';
+    __real_close(fd);
+
+    return value == '1';
+}
+
+void *mock_iio_open(unsigned int device)
+{
+    mock_iio_t *iio;
+
+    if (device >= IIO_DEVICES)
+    {
+        errno = ENOENT;
+        return NULL;
+    }
+
+    if ((iio = calloc(1, sizeof(*iio))) == NULL)
+        return NULL;
+
+    iio->device = device;
+    if (mock_path("/sys/bus/iio/devices/iio:device0/buffer/enable", iio->enable_path, sizeof(iio->enable_path)) < 0)
+    {
+        free(iio);
+        return NULL;
+    }
+    return iio;
+}
+
+ssize_t mock_iio_read(void *priv, void *buf, size_t count)
+{
+    mock_iio_t *iio = priv;
+    uint8_t *out = buf;
+    size_t samples = count / 2;
+
+    if (!buffer_enabled(iio))
+        return 0;
+
+    if (samples == 0)
+        return errno = EINVAL, -1;
+
+    for (size_t i = 0; i < samples; i++)
+    {
+        uint32_t step = iio->phase++ % WAVE_PERIOD;
+        uint32_t half = WAVE_PERIOD / 2;
+        uint16_t code = (uint16_t)((step < half ? step : WAVE_PERIOD - step) * 4095 / half);
+
+        out[2 * i] = (uint8_t)(code & 0xff);
+        out[2 * i + 1] = (uint8_t)(code >> 8);
+    }
+    return (ssize_t)(samples * 2);
+}
+
+void mock_iio_close(void *priv)
+{
+    free(priv);
+}
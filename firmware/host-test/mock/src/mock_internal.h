@@ -0,0 +1,72 @@
+#ifndef MOCK_INTERNAL_H
+#define MOCK_INTERNAL_H
+
+#include <stddef.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "mock/mock.h"
+
+/** Kinds of file descriptors the mock answers for */
+typedef enum mock_fd_type
+{
+    MOCK_FD_NONE = 0,
+    MOCK_FD_GPIOCHIP,
+    MOCK_FD_GPIOLINE,
+    MOCK_FD_SPI,
+    MOCK_FD_I2C,
+    MOCK_FD_TTY,
+    MOCK_FD_IIO,
+} mock_fd_type_t;
+
+typedef struct mock_fd
+{
+    mock_fd_type_t type;
+    unsigned int index; /**< Chip, bus (bus << 8 | cs for SPI) or device number */
+    void *priv;         /**< Per-descriptor state of the device module */
+} mock_fd_t;
+
+/* Real libc entry points, resolved by the linker's --wrap */
+int __real_open(const char *path, int flags, ...);
+int __real_close(int fd);
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+off_t __real_lseek(int fd, off_t offset, int whence);
+int __real_poll(struct pollfd *fds, nfds_t nfds, int timeout);
+int __real_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout);
+int __real_ioctl(int fd, unsigned long request, ...);
+int __real_stat(const char *path, struct stat *st);
+DIR *__real_opendir(const char *path);
+ssize_t __real_readlink(const char *path, char *buf, size_t len);
+
+/* Descriptor table (mock.c) */
+void mock_init(void);
+mock_fd_t *mock_fd_get(int fd);
+int mock_fd_set(int fd, mock_fd_type_t type, unsigned int index, void *priv);
+int mock_placeholder_fd(void);
+int mock_path(const char *rel, char *buf, size_t len);
+
+/* Board description under the fake root (mock_board.c) */
+int mock_board_create(const char *root);
+
+/* Device modules; ioctl handlers return -1 with errno set like the kernel */
+int mock_gpio_chip_ioctl(unsigned int chip, unsigned long request, void *arg);
+int mock_gpio_line_ioctl(void *priv, unsigned long request, void *arg);
+void mock_gpio_line_close(void *priv);
+
+int mock_spi_exists(unsigned int bus, unsigned int cs);
+int mock_spi_ioctl(unsigned int bus, unsigned int cs, unsigned long request, void *arg);
+
+int mock_i2c_ioctl(unsigned int bus, unsigned long request, void *arg);
+
+int mock_tty_open(unsigned int index, int flags);
+int mock_tty_ioctl(int fd, unsigned int index, unsigned long request, void *arg);
+
+void *mock_iio_open(unsigned int device);
+ssize_t mock_iio_read(void *priv, void *buf, size_t count);
+void mock_iio_close(void *priv);
+
+#endif /* MOCK_INTERNAL_H */
@@ -0,0 +1,193 @@
+/**
+ * @file mock_spi.c
+ * @brief spidev emulation.
+ *
+ * /dev/spidev0.0 behaves like the L3GD20 gyroscope on the board: the first
+ * byte of a message is a command (bit 7 read, bit 6 auto-increment, bits
+ * 5..0 register address) and the following bytes read or write registers.
+ * /dev/spidev1.0 echoes every byte back.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <linux/ioctl.h>
+#include <linux/spi/spidev.h>
+
+#include "mock_internal.h"
+
+#define SPI_REGS 64
+
+typedef struct mock_spi
+{
+    unsigned int bus;
+    unsigned int cs;
+    bool registers;     /**< Register model instead of loopback */
+    uint32_t mode;
+    uint32_t speed_hz;
+    uint8_t bits_per_word;
+    uint8_t regs[SPI_REGS];
+} mock_spi_t;
+
+static mock_spi_t devices[] = {
+    {.bus = 0, .cs = 0, .registers = true, .speed_hz = 500000, .bits_per_word = 8},
+    {.bus = 1, .cs = 0, .registers = false, .speed_hz = 500000, .bits_per_word = 8},
+};
+
+#define DEVICE_COUNT (sizeof(devices) / sizeof(devices[0]))
+
+static mock_spi_t *find_device(unsigned int bus, unsigned int cs)
+{
+    static bool initialized;
+
+    if (!initialized)
+    {
+        /* L3GD20 power-on state with a sample in the output registers */
+        static const int16_t axes[3] = {120, -45, 8};
+        uint8_t *regs = devices[0].regs;
+
+        regs[0x0F] = 0xD4; /* WHO_AM_I */
+        regs[0x20] = 0x07; /* CTRL_REG1 */
+        regs[0x26] = 25;   /* OUT_TEMP */
+        regs[0x27] = 0x0F; /* STATUS_REG: new X, Y, Z data */
+        for (int i = 0; i < 3; i++)
+        {
+            regs[0x28 + 2 * i] = (uint8_t)(axes[i] & 0xff);
+            regs[0x29 + 2 * i] = (uint8_t)((uint16_t)axes[i] >> 8);
+        }
+        initialized = true;
+    }
+
+    for (size_t i = 0; i < DEVICE_COUNT; i++)
+    {
+        if (devices[i].bus == bus && devices[i].cs == cs)
+            return &devices[i];
+    }
+    return NULL;
+}
+
+int mock_spi_exists(unsigned int bus, unsigned int cs)
+{
+    return find_device(bus, cs) != NULL;
+}
+
+uint8_t *mock_spi_registers(unsigned int bus, unsigned int cs)
+{
+    mock_spi_t *dev = find_device(bus, cs);
+    return (dev && dev->registers) ? dev->regs : NULL;
+}
+
+static int transfer(mock_spi_t *dev, struct spi_ioc_transfer *xfers, unsigned int count)
+{
+    bool have_command = false;
+    bool read = false, increment = false;
+    unsigned int addr = 0;
+    int total = 0;
+
+    for (unsigned int t = 0; t < count; t++)
+    {
+        const uint8_t *tx = (const uint8_t *)(uintptr_t)xfers[t].tx_buf;
+        uint8_t *rx = (uint8_t *)(uintptr_t)xfers[t].rx_buf;
+
+        for (uint32_t i = 0; i < xfers[t].len; i++)
+        {
+            uint8_t out = tx ? tx[i] : 0;
+            uint8_t in;
+
+            if (!dev->registers)
+            {
+                in = out;
+            }
+            else if (!have_command)
+            {
+                read = out & 0x80;
+                increment = out & 0x40;
+                addr = out & 0x3F;
+                have_command = true;
+                in = 0xFF;
+            }
+            else
+            {
+                if (read)
+                    in = dev->regs[addr];
+                else
+                {
+                    in = 0xFF;
+                    if (addr != 0x0F)
+                        dev->regs[addr] = out;
+                }
+                if (increment)
+                    addr = (addr + 1) % SPI_REGS;
+            }
+
+            if (rx)
+                rx[i] = in;
+        }
+
+        total += xfers[t].len;
+
+        /* Chip select released: the next byte is a new command */
+        if (xfers[t].cs_change)
+            have_command = false;
+    }
+    return total;
+}
+
+int mock_spi_ioctl(unsigned int bus, unsigned int cs, unsigned long request, void *arg)
+{
+    mock_spi_t *dev = find_device(bus, cs);
+
+    if (!dev)
+        return errno = ENODEV, -1;
+
+    /* SPI_IOC_MESSAGE(n) encodes n in the size field */
+    if (_IOC_TYPE(request) == SPI_IOC_MAGIC && _IOC_NR(request) == 0 && _IOC_DIR(request) == _IOC_WRITE)
+    {
+        unsigned int size = _IOC_SIZE(request);
+
+        if (size == 0 || size % sizeof(struct spi_ioc_transfer) != 0)
+            return errno = EINVAL, -1;
+        return transfer(dev, arg, size / sizeof(struct spi_ioc_transfer));
+    }
+
+    switch (request)
+    {
+    case SPI_IOC_RD_MODE:
+        *(uint8_t *)arg = (uint8_t)dev->mode;
+        return 0;
+    case SPI_IOC_WR_MODE:
+        dev->mode = (dev->mode & ~0xffu) | *(uint8_t *)arg;
+        return 0;
+    case SPI_IOC_RD_MODE32:
+        *(uint32_t *)arg = dev->mode;
+        return 0;
+    case SPI_IOC_WR_MODE32:
+        dev->mode = *(uint32_t *)arg;
+        return 0;
+    case SPI_IOC_RD_LSB_FIRST:
+        *(uint8_t *)arg = (dev->mode & SPI_LSB_FIRST) ? 1 : 0;
+        return 0;
+    case SPI_IOC_WR_LSB_FIRST:
+        dev->mode = *(uint8_t *)arg ? (dev->mode | SPI_LSB_FIRST) : (dev->mode & ~SPI_LSB_FIRST);
+        return 0;
+    case SPI_IOC_RD_BITS_PER_WORD:
+        *(uint8_t *)arg = dev->bits_per_word;
+        return 0;
+    case SPI_IOC_WR_BITS_PER_WORD:
+        if (*(uint8_t *)arg != 0 && *(uint8_t *)arg != 8 && *(uint8_t *)arg != 16)
+            return errno = EINVAL, -1;
+        dev->bits_per_word = *(uint8_t *)arg ? *(uint8_t *)arg : 8;
+        return 0;
+    case SPI_IOC_RD_MAX_SPEED_HZ:
+        *(uint32_t *)arg = dev->speed_hz;
+        return 0;
+    case SPI_IOC_WR_MAX_SPEED_HZ:
+        dev->speed_hz = *(uint32_t *)arg;
+        return 0;
+    default:
+        errno = ENOTTY;
+        return -1;
+    }
+}
@@ -0,0 +1,141 @@
+/**
+ * @file mock_tty.c
+ * @brief ttySTM emulation on pseudo terminals.
+ *
+ * Each /dev/ttySTMn is the slave side of a pty created on first use. The
+ * master stays open for the life of the process and is what a test reads
+ * and writes as the device on the other end of the cable. termios calls go
+ * to the pty unchanged; the RS485 ioctls, which a pty does not know, are
+ * remembered per port.
+ *
+ * Port MOCK_TTY_LOOPBACK has its TX wired to RX instead: a thread copies
+ * whatever the master reads back into it, so a program reads its own
+ * writes, like a board with a jumper across the UART pins.
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+#include "mock_internal.h"
+
+typedef struct mock_tty
+{
+    int master;                 /**< pty master + 1, 0 before first use */
+    bool looped;                /**< Loopback thread started */
+    struct serial_rs485 rs485;
+} mock_tty_t;
+
+static mock_tty_t ttys[MOCK_TTYS];
+
+static void *loopback(void *arg)
+{
+    int master = (int)(intptr_t)arg;
+    char buf[256];
+    ssize_t len;
+
+    for (;;)
+    {
+        /* EIO while no slave descriptor is open: wait for the next open */
+        if ((len = __real_read(master, buf, sizeof(buf))) < 0)
+        {
+            if (errno != EINTR)
+                usleep(1000);
+            continue;
+        }
+        if (__real_write(master, buf, (size_t)len) < 0)
+            usleep(1000);
+    }
+    return NULL;
+}
+
+static int master_fd(unsigned int index)
+{
+    mock_tty_t *tty = &ttys[index];
+    int fd;
+
+    if (tty->master)
+        return tty->master - 1;
+
+    if ((fd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC)) < 0)
+        return -1;
+
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0)
+    {
+        __real_close(fd);
+        return -1;
+    }
+
+    tty->master = fd + 1;
+    return fd;
+}
+
+int mock_tty_open(unsigned int index, int flags)
+{
+    int master = master_fd(index);
+    char name[64];
+    pthread_t thread;
+    int fd;
+
+    if (master < 0 || ptsname_r(master, name, sizeof(name)) != 0)
+        return -1;
+
+    if ((fd = __real_open(name, flags | O_NOCTTY)) < 0)
+        return -1;
+
+    if (index == MOCK_TTY_LOOPBACK && !ttys[index].looped)
+    {
+        if (pthread_create(&thread, NULL, loopback, (void *)(intptr_t)master) != 0)
+        {
+            __real_close(fd);
+            return errno = EAGAIN, -1;
+        }
+        pthread_detach(thread);
+        ttys[index].looped = true;
+    }
+
+    return fd;
+}
+
+int mock_tty_ioctl(int fd, unsigned int index, unsigned long request, void *arg)
+{
+    switch (request)
+    {
+    case TIOCSRS485:
+        memcpy(&ttys[index].rs485, arg, sizeof(struct serial_rs485));
+        return 0;
+    case TIOCGRS485:
+        memcpy(arg, &ttys[index].rs485, sizeof(struct serial_rs485));
+        return 0;
+    default:
+        return __real_ioctl(fd, request, arg);
+    }
+}
+
+int mock_serial_peer(const char *path)
+{
+    unsigned int index;
+    char tail;
+
+    if (sscanf(path, "/dev/ttySTM%u%c", &index, &tail) != 1 || index >= MOCK_TTYS)
+    {
+        errno = ENOENT;
+        return -1;
+    }
+    if (index == MOCK_TTY_LOOPBACK)
+    {
+        errno = EBUSY;
+        return -1;
+    }
+    return master_fd(index);
+}
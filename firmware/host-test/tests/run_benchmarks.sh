@@ -0,0 +1,41 @@
+#!/bin/sh
+# Host benchmarks: the benchmark modes the packages already have, plus the
+# ADC streaming path through the mock. Host numbers only show relative
+# changes between commits; target numbers come from the same modes on the
+# board. Called by "make bench" with the build directory.
+#
+# Usage: run_benchmarks.sh <build-dir>
+
+OUT=${1:?usage: run_benchmarks.sh <build-dir>}
+failed=0
+
+# bench <title> <directory> <program> [arguments...]
+bench() {
+    title=$1
+    dir=$2
+    shift 2
+    echo "==> $title"
+    if ! (cd "$dir" && "$@"); then
+        echo "FAILED: $*"
+        failed=$((failed + 1))
+    fi
+    echo
+}
+
+bench "configuration store (hellomk)" "$OUT/hellomk" ./hellomk --bench-config 10000
+bench "configuration image (hellomk)" "$OUT/hellomk" ./hellomk --bench-cache 10000
+bench "timestamp formatting (hellomk)" "$OUT/hellomk" ./hellomk --bench-time
+bench "libmath batch operations (hellomk)" "$OUT/hellomk" ./hellomk --bench-math
+bench "libmath fixed point (hellomk)" "$OUT/hellomk" ./hellomk --bench-fixed
+bench "libdsp block kernels (ioexample4)" "$OUT/ioexample4" ./ioexample4 --bench
+bench "libevloop timer wheel (sleepexample)" "$OUT/sleepexample" ./sleepexample -E 10000
+bench "IIO block reads through the mock (ioexample9)" "$OUT/ioexample9" ./ioexample9 -n 1
+
+# libperiphery hot paths; the JSON files are what bench_compare.py reads.
+# The GPIO cases run against both character device ABIs.
+bench "libperiphery, GPIO v2 ABI (periphery-bench)" "$OUT/periphery-bench" \
+    ./periphery-bench -t 0.2 -S /dev/ttySTM7 -o "$OUT/periphery-bench.json"
+bench "libperiphery, GPIO v1 ABI (periphery-bench)" "$OUT/periphery-bench-v1" \
+    ./periphery-bench -t 0.2 -f gpio_ -o "$OUT/periphery-bench-v1.json"
+
+[ $failed -eq 0 ]
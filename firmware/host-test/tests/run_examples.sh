@@ -0,0 +1,73 @@
+#!/bin/sh
+# Smoke runs of the example programs against the host mock. Each program
+# gets scripted input on stdin and must exit with status 0 and print the
+# expected text. Called by "make test" with the build directory; MOCK_ROOT
+# is set there so all runs share one board.
+#
+# Usage: run_examples.sh <build-dir>
+
+OUT=${1:?usage: run_examples.sh <build-dir>}
+IMAGES=$(cd "$(dirname "$0")/../../board/stm32f429disco/rootfs-overlay/usr/share/images" && pwd)
+LOG=$OUT/examples.log
+: > "$LOG"
+failed=0
+total=0
+
+# check <name> <expected text> <stdin script> <program> [arguments...]
+check() {
+    name=$1
+    expect=$2
+    input=$3
+    shift 3
+    total=$((total + 1))
+
+    out=$(sh -c "$input" | timeout 30 "$@" 2>&1)
+    status=$?
+    printf '==> %s: %s\n%s\n\n' "$name" "$*" "$out" >> "$LOG"
+
+    if [ $status -ne 0 ]; then
+        printf '%-24s FAILED (exit status %d)\n' "$name" $status
+        failed=$((failed + 1))
+    elif ! printf '%s\n' "$out" | grep -qF -- "$expect"; then
+        printf '%-24s FAILED (no "%s")\n' "$name" "$expect"
+        failed=$((failed + 1))
+    else
+        printf '%-24s ok\n' "$name"
+    fi
+}
+
+# Keystrokes spaced out so an event loop sees each one separately
+keys() {
+    echo "for i in \$(seq $1); do echo; sleep 0.1; done"
+}
+
+check ioexample1 "LED turned OFF." "printf '1\n0\nq\n'" "$OUT/ioexample1/ioexample1"
+check ioexample2 "Cleanup done" "sleep 0.3" "$OUT/ioexample2/ioexample2"
+check ioexample3 "Device found at address 0x41" "true" "$OUT/ioexample3/ioexample3"
+check ioexample4 "WHO_AM_I: 0xD4" "sleep 0.5" "$OUT/ioexample4/ioexample4" 50
+check ioexample5 "Detected CPU frequency: 180000000 Hz" "true" "$OUT/ioexample5/ioexample5"
+check ioexample6 "Test complete." "$(keys 6)" "$OUT/ioexample6/ioexample6" 0 1
+check ioexample7 "Sent 5 bytes." "printf 'hello\n\n'" "$OUT/ioexample7/ioexample7" /dev/ttySTM1
+check ioexample8 "RS485 mode configured successfully" "printf 'hello\n\n'" "$OUT/ioexample8/ioexample8" /dev/ttySTM2
+check ioexample9 "Sustained rate:" "true" "$OUT/ioexample9/ioexample9" -n 1
+check sleepexample "busy,1000,2" "true" "$OUT/sleepexample/sleepexample" -b -n 2 -l 100 -u 1000
+check periphery-tools "Detected CPU frequency: 180000000 Hz" "true" "$OUT/periphery-tools/periphery-tools" ioexample5
+
+# One short repetition of every benchmark; none may be skipped on the mock
+check periphery-bench "20 run, 0 skipped, 0 failed" "true" \
+    "$OUT/periphery-bench/periphery-bench" -t 0.01 -r 1 -S /dev/ttySTM7
+check periphery-bench-v1 "6 run, 0 skipped, 0 failed" "true" \
+    "$OUT/periphery-bench-v1/periphery-bench" -t 0.01 -r 1 -f gpio_
+
+# The configuration examples look for their .ini next to the working directory
+check hellomk "Database Host: localhost" "true" sh -c "cd '$OUT/hellomk' && ./hellomk"
+check hellomkcpp "Program finished successfully." "true" sh -c "cd '$OUT/hellomkcpp' && ./hellomkcpp"
+
+# The slideshow needs a framebuffer; only its asset converter runs here
+if [ -x "$OUT/slideshow/png2rgb565" ]; then
+    check png2rgb565 "(240x320, raw)" "true" "$OUT/slideshow/png2rgb565" \
+        "$IMAGES/tiger.png" "$OUT/slideshow/tiger.rgb565"
+fi
+
+echo "$((total - failed)) of $total example runs passed (output in $LOG)"
+[ $failed -eq 0 ]
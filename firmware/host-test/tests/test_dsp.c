@@ -0,0 +1,244 @@
+/**
+ * @file test_dsp.c
+ * @brief Known-answer tests of the libdsp block filters.
+ *
+ * The host build only runs the portable scalar kernels, so these vectors pin
+ * their results; the ARMv7E-M kernels are checked against the same scalar
+ * code by the self-check at the start of dsp_bench(). The vectors are small
+ * enough to verify by hand. Run with "make host-test".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libdsp/dsp.h"
+
+static int failures;
+
+#define CHECK(cond)                                                                        \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(cond))                                                                       \
+        {                                                                                  \
+            fprintf(stderr, "  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+            failures++;                                                                    \
+        }                                                                                  \
+    } while (0)
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+/* Compares a block against the expected samples, reporting the first mismatch */
+static void check_block(const char *name, const int16_t *got, const int16_t *want, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (got[i] != want[i])
+        {
+            fprintf(stderr, "  %s: sample %zu is %d, expected %d\n", name, i, got[i], want[i]);
+            failures++;
+            return;
+        }
+    }
+}
+
+static void test_movavg(void)
+{
+    /* Power-of-two window: the sum is shifted, so negatives round down */
+    static const int16_t in4[] = {4, 8, 12, 16, 20, -4, -4, -4, -4, -5};
+    static const int16_t out4[] = {1, 3, 6, 10, 14, 11, 7, 2, -4, -5};
+    /* Other windows divide, rounding toward zero */
+    static const int16_t in3[] = {3, 6, 9, -9, -10};
+    static const int16_t out3[] = {1, 3, 6, 2, -3};
+    dsp_movavg_t f;
+    int16_t out[16];
+
+    CHECK(dsp_movavg_init(&f, 0) < 0);
+    CHECK(dsp_movavg_init(&f, DSP_MOVAVG_MAX_WINDOW + 1) < 0);
+
+    CHECK(dsp_movavg_init(&f, 4) == 0);
+    dsp_movavg_process(&f, in4, out, 3);
+    dsp_movavg_process(&f, in4 + 3, out + 3, COUNT(in4) - 3);
+    check_block("movavg/4", out, out4, COUNT(out4));
+
+    CHECK(dsp_movavg_init(&f, 3) == 0);
+    dsp_movavg_process(&f, in3, out, COUNT(in3));
+    check_block("movavg/3", out, out3, COUNT(out3));
+
+    /* Reset forgets the history; in place is allowed */
+    dsp_movavg_reset(&f);
+    memcpy(out, in3, sizeof(in3));
+    dsp_movavg_process(&f, out, out, COUNT(in3));
+    check_block("movavg/3 reset", out, out3, COUNT(out3));
+}
+
+static void test_biquad(void)
+{
+    /* Q14: 16384 is 1.0 */
+    static const dsp_biquad_coeffs_t identity = {.b0 = 16384};
+    static const dsp_biquad_coeffs_t delay = {.b1 = 16384};
+    static const dsp_biquad_coeffs_t half_pole[2] = {
+        {.b0 = 16384, .a1 = 8192},
+        {.b0 = 16384, .a1 = 8192},
+    };
+    static const dsp_biquad_coeffs_t second_pole = {.b0 = 16384, .a2 = 8192};
+    static const dsp_biquad_coeffs_t gain2 = {.b0 = 32767};
+    static const int16_t ramp[] = {1, 2, 3, -4, 32767, -32768};
+    static const int16_t ramp_delayed[] = {0, 1, 2, 3, -4, 32767};
+    static const int16_t impulse[] = {16384, 0, 0, 0, 0};
+    /* y[n] = 0.5 y[n-1], then the same again: (n + 1) * 0.5^n */
+    static const int16_t one_stage[] = {16384, 8192, 4096, 2048, 1024};
+    static const int16_t two_stages[] = {16384, 16384, 12288, 8192, 5120};
+    static const int16_t small_impulse[] = {1000, 0, 0, 0, 0};
+    static const int16_t every_other[] = {1000, 0, 500, 0, 250};
+    static const int16_t loud[] = {20000, -20000, 100};
+    static const int16_t loud_out[] = {32767, -32768, 199};
+    dsp_biquad_t f;
+    int16_t out[8];
+
+    CHECK(dsp_biquad_init(&f, &identity, 0) < 0);
+    CHECK(dsp_biquad_init(&f, &identity, DSP_BIQUAD_MAX_STAGES + 1) < 0);
+
+    CHECK(dsp_biquad_init(&f, &identity, 1) == 0);
+    dsp_biquad_process(&f, ramp, out, COUNT(ramp));
+    check_block("biquad identity", out, ramp, COUNT(ramp));
+
+    CHECK(dsp_biquad_init(&f, &delay, 1) == 0);
+    dsp_biquad_process(&f, ramp, out, 2);
+    dsp_biquad_process(&f, ramp + 2, out + 2, COUNT(ramp) - 2);
+    check_block("biquad delay", out, ramp_delayed, COUNT(ramp_delayed));
+
+    CHECK(dsp_biquad_init(&f, half_pole, 1) == 0);
+    dsp_biquad_process(&f, impulse, out, COUNT(impulse));
+    check_block("biquad a1", out, one_stage, COUNT(one_stage));
+
+    CHECK(dsp_biquad_init(&f, half_pole, 2) == 0);
+    dsp_biquad_process(&f, impulse, out, COUNT(impulse));
+    check_block("biquad cascade", out, two_stages, COUNT(two_stages));
+
+    CHECK(dsp_biquad_init(&f, &second_pole, 1) == 0);
+    dsp_biquad_process(&f, small_impulse, out, COUNT(small_impulse));
+    check_block("biquad a2", out, every_other, COUNT(every_other));
+
+    /* 2.0 gain saturates instead of wrapping */
+    CHECK(dsp_biquad_init(&f, &gain2, 1) == 0);
+    dsp_biquad_process(&f, loud, out, COUNT(loud));
+    check_block("biquad saturation", out, loud_out, COUNT(loud_out));
+}
+
+static void test_fir_decim(void)
+{
+    /* Q15: 16384 is 0.5 */
+    static const int16_t pair[] = {16384, 16384};
+    static const int16_t tri[] = {8192, 16384, 8192};
+    static const int16_t half[] = {16384};
+    static const int16_t max_pair[] = {32767, 32767};
+    static const int16_t in[] = {100, 200, 300, -100};
+    static const int16_t pair_out[] = {50, 150, 250, 100};
+    static const int16_t pair_decim[] = {150, 100};
+    static const int16_t impulse[] = {4000, 0, 0, 0};
+    static const int16_t tri_out[] = {1000, 2000, 1000, 0};
+    static const int16_t odd[] = {-3, 3};
+    static const int16_t half_out[] = {-2, 1};
+    static const int16_t loud[] = {30000, 30000, -30000, -30000};
+    static const int16_t loud_out[] = {29999, 32767, 0, -32768};
+    dsp_fir_decim_t f;
+    int16_t out[8];
+
+    CHECK(dsp_fir_decim_init(&f, pair, 0, 1) < 0);
+    CHECK(dsp_fir_decim_init(&f, pair, DSP_FIR_MAX_TAPS + 1, 1) < 0);
+    CHECK(dsp_fir_decim_init(&f, pair, 2, 0) < 0);
+
+    CHECK(dsp_fir_decim_init(&f, pair, 2, 1) == 0);
+    CHECK(dsp_fir_decim_process(&f, in, out, COUNT(in)) == COUNT(pair_out));
+    check_block("fir pair", out, pair_out, COUNT(pair_out));
+
+    /* Decimation keeps every second output, across calls */
+    CHECK(dsp_fir_decim_init(&f, pair, 2, 2) == 0);
+    CHECK(dsp_fir_decim_process(&f, in, out, 3) == 1);
+    CHECK(dsp_fir_decim_process(&f, in + 3, out + 1, 1) == 1);
+    check_block("fir decimate", out, pair_decim, COUNT(pair_decim));
+
+    /* Odd tap counts are padded internally */
+    CHECK(dsp_fir_decim_init(&f, tri, 3, 1) == 0);
+    CHECK(dsp_fir_decim_process(&f, impulse, out, COUNT(impulse)) == COUNT(tri_out));
+    check_block("fir odd taps", out, tri_out, COUNT(tri_out));
+
+    /* The product is shifted, so negatives round down */
+    CHECK(dsp_fir_decim_init(&f, half, 1, 1) == 0);
+    CHECK(dsp_fir_decim_process(&f, odd, out, COUNT(odd)) == COUNT(half_out));
+    check_block("fir rounding", out, half_out, COUNT(half_out));
+
+    CHECK(dsp_fir_decim_init(&f, max_pair, 2, 1) == 0);
+    CHECK(dsp_fir_decim_process(&f, loud, out, COUNT(loud)) == COUNT(loud_out));
+    check_block("fir saturation", out, loud_out, COUNT(loud_out));
+}
+
+static void test_stats(void)
+{
+    static const int16_t in[] = {-3, 7, 1, 4, -9};
+    static const int16_t flat[] = {100, 100, 100};
+    static const int16_t extremes[] = {32767, -32768};
+    dsp_stats_t s;
+
+    dsp_stats_reset(&s);
+    CHECK(dsp_stats_mean(&s) == 0 && dsp_stats_rms(&s) == 0);
+
+    /* Split unevenly so both the paired loop and the tail see samples */
+    dsp_stats_update(&s, in, 3);
+    dsp_stats_update(&s, in + 3, 2);
+    CHECK(s.min == -9 && s.max == 7);
+    CHECK(s.sum == 0 && s.sum_squares == 156 && s.count == 5);
+    CHECK(dsp_stats_mean(&s) == 0);
+    CHECK(dsp_stats_rms(&s) == 5);          /* sqrt(156 / 5) = 5.59 */
+
+    dsp_stats_reset(&s);
+    dsp_stats_update(&s, flat, COUNT(flat));
+    CHECK(s.min == 100 && s.max == 100);
+    CHECK(dsp_stats_mean(&s) == 100 && dsp_stats_rms(&s) == 100);
+
+    dsp_stats_reset(&s);
+    dsp_stats_update(&s, extremes, COUNT(extremes));
+    CHECK(s.min == -32768 && s.max == 32767);
+    CHECK(dsp_stats_mean(&s) == 0);
+    CHECK(dsp_stats_rms(&s) == 32767);
+}
+
+static void test_self_check(void)
+{
+    /* With no time per kernel this is just the reference comparison */
+    CHECK(dsp_bench(0.0) == 0);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} tests[] = {
+    {"movavg", test_movavg},
+    {"biquad", test_biquad},
+    {"fir", test_fir_decim},
+    {"stats", test_stats},
+    {"selfchk", test_self_check},
+};
+
+int main(void)
+{
+    int failed_tests = 0;
+
+    printf("libdsp kernels: %s\n", dsp_implementation());
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        int before = failures;
+
+        tests[i].run();
+        printf("%-8s %s\n", tests[i].name, failures == before ? "ok" : "FAILED");
+        if (failures != before)
+            failed_tests++;
+    }
+
+    printf("%d of %zu tests failed\n", failed_tests, sizeof(tests) / sizeof(tests[0]));
+    return failed_tests ? EXIT_FAILURE : EXIT_SUCCESS;
+}
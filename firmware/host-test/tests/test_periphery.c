@@ -0,0 +1,606 @@
+/**
+ * @file test_periphery.c
+ * @brief Functional tests of libperiphery against the host mock.
+ *
+ * Each test drives one module through the emulated kernel interface and
+ * checks what arrives on the other side (line levels, register files, the
+ * pty peer, sysfs attribute files). Run with "make host-test".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "mock/mock.h"
+#include "periphery/adc.h"
+#include "periphery/gpio.h"
+#include "periphery/i2c.h"
+#include "periphery/led.h"
+#include "periphery/mmio.h"
+#include "periphery/pwm.h"
+#include "periphery/serial.h"
+#include "periphery/spi.h"
+#include "periphery/stats.h"
+
+static int failures;
+
+#define CHECK(cond)                                                                        \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(cond))                                                                       \
+        {                                                                                  \
+            fprintf(stderr, "  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+            failures++;                                                                    \
+        }                                                                                  \
+    } while (0)
+
+/* Reads a fake sysfs attribute, newline stripped */
+static void read_attr(const char *rel, char *buf, size_t len)
+{
+    char path[512];
+    FILE *file;
+
+    buf[0] = '\0';
+    snprintf(path, sizeof(path), "%s%s", mock_root(), rel);
+    if ((file = fopen(path, "r")) == NULL)
+        return;
+    if (fgets(buf, (int)len, file) == NULL)
+        buf[0] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+    fclose(file);
+}
+
+static void test_gpio(void)
+{
+    gpio_t *led = gpio_new();
+    gpio_t *button = gpio_new();
+    gpio_config_t config = {
+        .direction = GPIO_DIR_IN,
+        .edge = GPIO_EDGE_BOTH,
+        .bias = GPIO_BIAS_DEFAULT,
+        .drive = GPIO_DRIVE_DEFAULT,
+        .inverted = false,
+        .label = "test",
+    };
+    gpio_edge_t edge;
+    uint64_t timestamp;
+    char name[32];
+    bool value;
+
+    /* PG13, the green LED */
+    CHECK(gpio_open(led, "/dev/gpiochip6", 13, GPIO_DIR_OUT) == 0);
+    CHECK(mock_gpio_get_output(6, 13) == 0);
+    CHECK(gpio_write(led, true) == 0);
+    CHECK(mock_gpio_get_output(6, 13) == 1);
+    CHECK(gpio_name(led, name, sizeof(name)) == 0 && strcmp(name, "PG13") == 0);
+
+    /* A second request of a busy line fails like on the kernel */
+    gpio_t *again = gpio_new();
+    CHECK(gpio_open(again, "/dev/gpiochip6", 13, GPIO_DIR_IN) < 0);
+    gpio_free(again);
+
+    /* PA0, the user button, with edge events */
+    CHECK(gpio_open_advanced(button, "/dev/gpiochip0", 0, &config) == 0);
+    CHECK(gpio_read(button, &value) == 0 && value == false);
+    CHECK(gpio_poll(button, 0) == 0);
+
+    mock_gpio_set_input(0, 0, true);
+    CHECK(gpio_read(button, &value) == 0 && value == true);
+    CHECK(gpio_poll(button, 100) == 1);
+    CHECK(gpio_read_event(button, &edge, &timestamp) == 0 && edge == GPIO_EDGE_RISING && timestamp != 0);
+
+    mock_gpio_set_input(0, 0, false);
+    CHECK(gpio_read_event(button, &edge, NULL) == 0 && edge == GPIO_EDGE_FALLING);
+    CHECK(gpio_poll(button, 0) == 0);
+
+    /* Lookup by line name */
+    gpio_close(led);
+    CHECK(gpio_open_name(led, "/dev/gpiochip6", "PG14", GPIO_DIR_OUT_HIGH) == 0);
+    CHECK(mock_gpio_get_output(6, 14) == 1);
+
+    gpio_close(led);
+    gpio_close(button);
+    CHECK(mock_gpio_get_output(6, 14) == -1);
+    CHECK(gpio_open(led, "/dev/gpiochip11", 0, GPIO_DIR_IN) < 0);
+
+    gpio_free(led);
+    gpio_free(button);
+}
+
+static void test_gpio_names(void)
+{
+    gpio_t *gpio = gpio_new();
+    unsigned long before, by_number;
+    char path[512], chip[32];
+    FILE *file;
+
+    gpio_name_cache_clear();
+
+    /* Without a path every chip is searched */
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == 0);
+    CHECK(gpio_chip_name(gpio, chip, sizeof(chip)) == 0 && strcmp(chip, "gpiochip10") == 0);
+    CHECK(gpio_line(gpio) == 15);
+    gpio_close(gpio);
+
+    /* Once indexed, a name costs a chip info and a line info query, not one
+     * per line */
+    before = mock_syscalls();
+    CHECK(gpio_open(gpio, "/dev/gpiochip10", 15, GPIO_DIR_IN) == 0);
+    by_number = mock_syscalls() - before;
+    gpio_close(gpio);
+
+    before = mock_syscalls();
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == 0);
+    CHECK(mock_syscalls() - before == by_number + 4);
+    gpio_close(gpio);
+
+    /* The index survives a restart through a file */
+    snprintf(path, sizeof(path), "%s/gpio-names", mock_root());
+    CHECK(gpio_name_cache_save(path) == 0);
+    gpio_name_cache_clear();
+    CHECK(gpio_name_cache_load(path) == 0);
+
+    before = mock_syscalls();
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == 0);
+    CHECK(mock_syscalls() - before == by_number + 4);
+    gpio_close(gpio);
+
+    /* A line renamed on an unchanged chip is not resolved from the index */
+    mock_gpio_set_line_name(10, 15, "SENSOR_IRQ");
+    mock_gpio_set_line_name(10, 14, "PK15");
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 14);
+    gpio_close(gpio);
+    CHECK(gpio_open_name(gpio, "/dev/gpiochip10", "SENSOR_IRQ", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 15);
+    gpio_close(gpio);
+    mock_gpio_set_line_name(10, 14, NULL);
+    CHECK(gpio_open_name(gpio, "/dev/gpiochip10", "PK15", GPIO_DIR_IN) == GPIO_ERROR_NOT_FOUND);
+    mock_gpio_set_line_name(10, 15, NULL);
+
+    /* So is a name newly given to a line of an unchanged chip, with or
+     * without a path */
+    mock_gpio_set_line_name(10, 3, "DRDY");
+    CHECK(gpio_open_name(gpio, "/dev/gpiochip10", "DRDY", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 3);
+    gpio_close(gpio);
+    mock_gpio_set_line_name(2, 7, "ALERT");
+    CHECK(gpio_open_name(gpio, NULL, "ALERT", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 7);
+    CHECK(gpio_chip_name(gpio, chip, sizeof(chip)) == 0 && strcmp(chip, "gpiochip2") == 0);
+    gpio_close(gpio);
+    mock_gpio_set_line_name(10, 3, NULL);
+    mock_gpio_set_line_name(2, 7, NULL);
+    CHECK(gpio_open_name(gpio, NULL, "ALERT", GPIO_DIR_IN) == GPIO_ERROR_NOT_FOUND);
+
+    /* A chip that reports a new label is indexed again */
+    mock_gpio_set_line_name(10, 15, "SENSOR_IRQ");
+    mock_gpio_set_chip_label(10, "gpio-sim.0-node0");
+    CHECK(gpio_open_name(gpio, NULL, "SENSOR_IRQ", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 15);
+    gpio_close(gpio);
+    CHECK(gpio_open_name(gpio, "/dev/gpiochip10", "PK15", GPIO_DIR_IN) == GPIO_ERROR_NOT_FOUND);
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == GPIO_ERROR_NOT_FOUND);
+
+    mock_gpio_set_line_name(10, 15, NULL);
+    mock_gpio_set_chip_label(10, NULL);
+
+    /* An empty label is a field of its own */
+    if ((file = fopen(path, "w")) != NULL)
+    {
+        fputs("chip\t/dev/gpiochip10\t\t16\n15\tPK15\n", file);
+        fclose(file);
+    }
+    CHECK(gpio_name_cache_load(path) == 0);
+    CHECK(gpio_open_name(gpio, NULL, "PK15", GPIO_DIR_IN) == 0 && gpio_line(gpio) == 15);
+    gpio_close(gpio);
+
+    /* A malformed file is refused */
+    if ((file = fopen(path, "w")) != NULL)
+    {
+        fputs("not a cache\n", file);
+        fclose(file);
+    }
+    CHECK(gpio_name_cache_load(path) == GPIO_ERROR_ARG);
+
+    gpio_name_cache_clear();
+    gpio_free(gpio);
+}
+
+static uint64_t clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Pulse train on PA1: <count> toggles back to back, far quicker than any
+ * debounce period below */
+static void pulse_train(unsigned int count)
+{
+    static bool level;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        level = !level;
+        mock_gpio_set_input(0, 1, level);
+    }
+}
+
+static void test_gpio_debounce(void)
+{
+    gpio_t *button = gpio_new();
+    gpio_config_t config = {
+        .direction = GPIO_DIR_IN,
+        .edge = GPIO_EDGE_BOTH,
+        .event_clock = GPIO_EVENT_CLOCK_MONOTONIC,
+        .debounce_us = 20000,
+    };
+    gpio_event_clock_t event_clock;
+    uint32_t debounce_us;
+    uint64_t timestamp, before;
+    gpio_edge_t edge;
+    unsigned int events;
+    bool value;
+
+    CHECK(gpio_open_advanced(button, "/dev/gpiochip0", 1, &config) == 0);
+    CHECK(gpio_get_event_clock(button, &event_clock) == 0 && event_clock == GPIO_EVENT_CLOCK_MONOTONIC);
+    CHECK(gpio_get_debounce_us(button, &debounce_us) == 0 && debounce_us == 20000);
+
+    /* A bouncing press that settles high is one rising edge, seen only
+     * after the period, with a monotonic timestamp */
+    before = clock_ns(CLOCK_MONOTONIC);
+    pulse_train(7);
+    CHECK(gpio_read(button, &value) == 0 && value == false);
+    CHECK(gpio_poll(button, 1000) == 1);
+    CHECK(gpio_read_event(button, &edge, &timestamp) == 0 && edge == GPIO_EDGE_RISING);
+    CHECK(timestamp >= before + 20000000ULL && timestamp <= clock_ns(CLOCK_MONOTONIC));
+    CHECK(gpio_read(button, &value) == 0 && value == true);
+    CHECK(gpio_poll(button, 50) == 0);
+
+    /* A glitch shorter than the period is filtered out entirely */
+    pulse_train(2);
+    CHECK(gpio_poll(button, 50) == 0);
+
+    /* Without debounce every bounce costs an event */
+    CHECK(gpio_set_debounce_us(button, 0) == 0);
+    pulse_train(8);
+    for (events = 0; gpio_poll(button, 0) == 1 && gpio_read_event(button, NULL, NULL) == 0; events++)
+        ;
+    CHECK(events == 8);
+
+    /* Realtime stamps, the default, follow the wall clock */
+    CHECK(gpio_set_event_clock(button, GPIO_EVENT_CLOCK_REALTIME) == 0);
+    before = clock_ns(CLOCK_REALTIME);
+    pulse_train(1);
+    CHECK(gpio_read_event(button, &edge, &timestamp) == 0 && edge == GPIO_EDGE_FALLING);
+    CHECK(timestamp >= before && timestamp <= clock_ns(CLOCK_REALTIME));
+    gpio_close(button);
+
+    /* No timestamp engine here; debounce is for inputs only */
+    config.event_clock = GPIO_EVENT_CLOCK_HTE;
+    CHECK(gpio_open_advanced(button, "/dev/gpiochip0", 1, &config) == GPIO_ERROR_OPEN);
+    config.event_clock = GPIO_EVENT_CLOCK_MONOTONIC;
+    config.direction = GPIO_DIR_OUT;
+    config.edge = GPIO_EDGE_NONE;
+    CHECK(gpio_open_advanced(button, "/dev/gpiochip0", 1, &config) == GPIO_ERROR_ARG);
+
+    CHECK(gpio_open(button, "/dev/gpiochip0", 1, GPIO_DIR_OUT) == 0);
+    CHECK(gpio_set_debounce_us(button, 1000) == GPIO_ERROR_INVALID_OPERATION);
+    gpio_close(button);
+
+    gpio_free(button);
+}
+
+static void test_led(void)
+{
+    led_t *led = led_new();
+    unsigned int max_brightness;
+    char attr[32];
+    bool value;
+
+    CHECK(led_open(led, "led-green") == 0);
+    CHECK(led_get_max_brightness(led, &max_brightness) == 0 && max_brightness == 1);
+    CHECK(led_write(led, true) == 0);
+    read_attr("/sys/class/leds/led-green/brightness", attr, sizeof(attr));
+    CHECK(strcmp(attr, "1") == 0);
+    CHECK(led_read(led, &value) == 0 && value == true);
+    CHECK(led_write(led, false) == 0);
+    CHECK(led_read(led, &value) == 0 && value == false);
+    led_close(led);
+
+    CHECK(led_open(led, "led-blue") < 0);
+    led_free(led);
+}
+
+static void test_pwm(void)
+{
+    pwm_t *pwm = pwm_new();
+    double frequency, duty_cycle;
+    char attr[32];
+    bool enabled;
+
+    CHECK(pwm_open(pwm, 0, 1) == 0);
+    CHECK(pwm_set_frequency(pwm, 1000.0) == 0);
+    CHECK(pwm_set_duty_cycle(pwm, 0.25) == 0);
+    CHECK(pwm_enable(pwm) == 0);
+
+    read_attr("/sys/class/pwm/pwmchip0/pwm1/period", attr, sizeof(attr));
+    CHECK(strcmp(attr, "1000000") == 0);
+    read_attr("/sys/class/pwm/pwmchip0/pwm1/duty_cycle", attr, sizeof(attr));
+    CHECK(strcmp(attr, "250000") == 0);
+    CHECK(pwm_get_frequency(pwm, &frequency) == 0 && frequency > 999.0 && frequency < 1001.0);
+    CHECK(pwm_get_duty_cycle(pwm, &duty_cycle) == 0 && duty_cycle > 0.24 && duty_cycle < 0.26);
+    CHECK(pwm_get_enabled(pwm, &enabled) == 0 && enabled);
+
+    CHECK(pwm_disable(pwm) == 0);
+    pwm_close(pwm);
+    pwm_free(pwm);
+}
+
+static void test_i2c(void)
+{
+    i2c_t *i2c = i2c_new();
+    uint8_t reg = 0x00, id[2] = {0};
+    uint8_t write[3] = {0x40, 0xAB, 0xCD}, readback[2] = {0};
+    struct i2c_msg msgs[2] = {
+        {.addr = 0x41, .flags = 0, .len = 1, .buf = &reg},
+        {.addr = 0x41, .flags = I2C_M_RD, .len = 2, .buf = id},
+    };
+
+    CHECK(i2c_open(i2c, "/dev/i2c-0") == 0);
+
+    /* STMPE811 CHIP_ID */
+    CHECK(i2c_transfer(i2c, msgs, 2) == 0);
+    CHECK(id[0] == 0x08 && id[1] == 0x11);
+
+    /* Register write, then read back */
+    msgs[0].len = 3;
+    msgs[0].buf = write;
+    CHECK(i2c_transfer(i2c, msgs, 1) == 0);
+    reg = 0x40;
+    msgs[0].len = 1;
+    msgs[0].buf = &reg;
+    msgs[1].buf = readback;
+    CHECK(i2c_transfer(i2c, msgs, 2) == 0);
+    CHECK(readback[0] == 0xAB && readback[1] == 0xCD);
+
+    /* No slave, no ACK */
+    msgs[0].addr = 0x50;
+    CHECK(i2c_transfer(i2c, msgs, 1) < 0);
+    CHECK(mock_i2c_attach(0, 0x50) != NULL);
+    CHECK(i2c_transfer(i2c, msgs, 1) == 0);
+    mock_i2c_detach(0, 0x50);
+
+    i2c_close(i2c);
+    i2c_free(i2c);
+}
+
+static void test_spi(void)
+{
+    spi_t *spi = spi_new();
+    uint8_t tx[7] = {0x8F, 0x00}, rx[7] = {0};
+    unsigned int mode;
+    uint32_t speed;
+
+    /* L3GD20 WHO_AM_I */
+    CHECK(spi_open(spi, "/dev/spidev0.0", 3, 1000000) == 0);
+    CHECK(spi_get_mode(spi, &mode) == 0 && mode == 3);
+    CHECK(spi_get_max_speed(spi, &speed) == 0 && speed == 1000000);
+    CHECK(spi_transfer(spi, tx, rx, 2) == 0);
+    CHECK(rx[1] == 0xD4);
+
+    /* Write CTRL_REG1, read it back, then a burst of the three axes */
+    tx[0] = 0x20;
+    tx[1] = 0x0F;
+    CHECK(spi_transfer(spi, tx, rx, 2) == 0);
+    CHECK(mock_spi_registers(0, 0)[0x20] == 0x0F);
+    tx[0] = 0xE8;
+    memset(tx + 1, 0, 6);
+    CHECK(spi_transfer(spi, tx, rx, 7) == 0);
+    CHECK(memcmp(rx + 1, mock_spi_registers(0, 0) + 0x28, 6) == 0);
+    spi_close(spi);
+
+    /* Loopback device */
+    CHECK(spi_open(spi, "/dev/spidev1.0", 0, 500000) == 0);
+    memcpy(tx, "\x01\x02\x03\x04", 4);
+    CHECK(spi_transfer(spi, tx, rx, 4) == 0);
+    CHECK(memcmp(tx, rx, 4) == 0);
+    spi_close(spi);
+
+    CHECK(spi_open(spi, "/dev/spidev2.0", 0, 500000) < 0);
+    spi_free(spi);
+}
+
+static void test_serial(void)
+{
+    serial_t *serial = serial_new();
+    uint8_t buf[16] = {0};
+    int peer;
+
+    CHECK(serial_open(serial, "/dev/ttySTM1", 115200) == 0);
+    peer = mock_serial_peer("/dev/ttySTM1");
+    CHECK(peer >= 0);
+
+    CHECK(serial_write(serial, (const uint8_t *)"hello", 5) == 5);
+    CHECK(read(peer, buf, sizeof(buf)) == 5 && memcmp(buf, "hello", 5) == 0);
+
+    CHECK(write(peer, "pong", 4) == 4);
+    memset(buf, 0, sizeof(buf));
+    CHECK(serial_read(serial, buf, 4, 1000) == 4 && memcmp(buf, "pong", 4) == 0);
+    CHECK(serial_read(serial, buf, 1, 10) == 0);
+
+    serial_close(serial);
+    serial_free(serial);
+}
+
+static void test_mmio(void)
+{
+    mmio_t *mmio = mmio_new();
+    uint32_t value;
+
+    /* RCC: PLLCFGR of the 180 MHz setup, then a scratch write */
+    CHECK(mmio_open(mmio, 0x40023800, 0x400) == 0);
+    CHECK(mmio_read32(mmio, 0x04, &value) == 0 && value == 0x00405A08);
+    CHECK(mmio_write32(mmio, 0x70, 0xA5A5F00D) == 0);
+    CHECK(mmio_read32(mmio, 0x70, &value) == 0 && value == 0xA5A5F00D);
+    CHECK(mmio_read32(mmio, 0x400, &value) < 0);
+
+    mmio_close(mmio);
+    mmio_free(mmio);
+}
+
+static void test_adc(void)
+{
+    adc_t *adc = adc_new();
+    uint16_t samples[256];
+    uint16_t max = 0;
+    char attr[32], path[512], saved[520];
+    FILE *file;
+    int n;
+
+    CHECK(adc_open(adc, 0, 8) == 0);
+    read_attr("/sys/bus/iio/devices/iio:device0/scan_elements/in_voltage8_en", attr, sizeof(attr));
+    CHECK(strcmp(attr, "1") == 0);
+
+    /* Nothing flows before the buffer is enabled */
+    CHECK(adc_read(adc, samples, 16, 0) == 0);
+
+    CHECK(adc_start(adc) == 0);
+    n = adc_read(adc, samples, 256, 100);
+    CHECK(n == 256);
+    for (int i = 0; i < n; i++)
+        max = samples[i] > max ? samples[i] : max;
+    CHECK(max > 0 && max <= 4095);
+
+    CHECK(adc_stop(adc) == 0);
+    CHECK(adc_close(adc) == 0);
+
+    /* A buffer that cannot be disabled is reported, but the fd is closed */
+    snprintf(path, sizeof(path), "%s/sys/bus/iio/devices/iio:device0/buffer/enable", mock_root());
+    snprintf(saved, sizeof(saved), "%s.saved", path);
+    CHECK(adc_open(adc, 0, 8) == 0 && adc_start(adc) == 0);
+    CHECK(rename(path, saved) == 0);
+    CHECK(adc_close(adc) == ADC_ERROR_CONFIGURE);
+    CHECK(adc_fd(adc) < 0 && adc_close(adc) == 0);
+    CHECK(rename(saved, path) == 0);
+    if ((file = fopen(path, "w")) != NULL)
+    {
+        fputs("0\n", file);
+        fclose(file);
+    }
+
+    adc_free(adc);
+}
+
+/* Needs the library built with PERIPHERY_STATS, as the Makefile does for
+ * the unit tests */
+static void test_stats(void)
+{
+    gpio_t *gpio = gpio_new();
+    spi_t *spi = spi_new();
+    serial_t *serial = serial_new();
+    mmio_t *mmio = mmio_new();
+    periphery_stats_t stats;
+    uint8_t buf[4] = {0x01, 0x02, 0x03, 0x04};
+    char dump[4096] = "";
+    uint32_t value;
+    bool level;
+    FILE *stream;
+    int listed;
+
+    CHECK(periphery_stats_enabled());
+
+    /* Failed operations count as operations and errors, without bytes */
+    CHECK(gpio_open(gpio, "/dev/gpiochip0", 0, GPIO_DIR_IN) == 0);
+    CHECK(gpio_read(gpio, &level) == 0);
+    CHECK(gpio_write(gpio, true) < 0);
+    CHECK(gpio_poll(gpio, 0) == 0);
+    CHECK(gpio_stats(gpio, &stats) == 0 && stats.ops == 2 && stats.errors == 1 && stats.bytes == 0);
+    CHECK(stats.max_ns > 0 && stats.total_ns >= stats.max_ns);
+
+    CHECK(spi_open(spi, "/dev/spidev1.0", 0, 500000) == 0);
+    CHECK(spi_stats(spi, &stats) == 0 && stats.ops == 0);
+    for (int i = 0; i < 3; i++)
+        CHECK(spi_transfer(spi, buf, buf, sizeof(buf)) == 0);
+    CHECK(spi_stats(spi, &stats) == 0 && stats.ops == 3 && stats.errors == 0 && stats.bytes == 12);
+
+    /* Serial counts what was actually moved, a timed out read adds nothing */
+    CHECK(serial_open(serial, "/dev/ttySTM1", 115200) == 0);
+    CHECK(serial_write(serial, buf, 3) == 3);
+    CHECK(serial_read(serial, buf, 1, 0) == 0);
+    CHECK(serial_stats(serial, &stats) == 0 && stats.ops == 2 && stats.bytes == 3);
+
+    CHECK(mmio_open(mmio, 0x40023800, 0x400) == 0);
+    CHECK(mmio_read32(mmio, 0x04, &value) == 0);
+    CHECK(mmio_read32(mmio, 0x400, &value) < 0);
+    CHECK(mmio_stats(mmio, &stats) == 0 && stats.ops == 2 && stats.errors == 1 && stats.bytes == 4);
+
+    /* The registry lists the handles that did I/O until they are closed */
+    if ((stream = fmemopen(dump, sizeof(dump) - 1, "w")) != NULL)
+    {
+        listed = periphery_stats_dump(stream);
+        fclose(stream);
+        CHECK(listed >= 4);
+        CHECK(strstr(dump, "SPI (fd=") != NULL && strstr(dump, "MMIO 0x40023800") != NULL);
+
+        spi_close(spi);
+        stream = fmemopen(dump, sizeof(dump) - 1, "w");
+        CHECK(stream != NULL && periphery_stats_dump(stream) == listed - 1);
+        if (stream)
+            fclose(stream);
+    }
+    else
+    {
+        CHECK(stream != NULL);
+    }
+
+    /* Counters survive close, reset clears the open handles only */
+    periphery_stats_reset();
+    CHECK(spi_stats(spi, &stats) == 0 && stats.ops == 3);
+    CHECK(gpio_stats(gpio, &stats) == 0 && stats.ops == 0 && stats.max_ns == 0);
+
+    gpio_close(gpio);
+    serial_close(serial);
+    mmio_close(mmio);
+    gpio_free(gpio);
+    spi_free(spi);
+    serial_free(serial);
+    mmio_free(mmio);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} tests[] = {
+    {"gpio", test_gpio},
+    {"gpioname", test_gpio_names},
+    {"debounce", test_gpio_debounce},
+    {"led", test_led},
+    {"pwm", test_pwm},
+    {"i2c", test_i2c},
+    {"spi", test_spi},
+    {"serial", test_serial},
+    {"mmio", test_mmio},
+    {"adc", test_adc},
+    {"stats", test_stats},
+};
+
+int main(void)
+{
+    int failed_tests = 0;
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        int before = failures;
+
+        tests[i].run();
+        printf("%-8s %s\n", tests[i].name, failures == before ? "ok" : "FAILED");
+        if (failures != before)
+            failed_tests++;
+    }
+
+    printf("%d of %zu tests failed\n", failed_tests, sizeof(tests) / sizeof(tests[0]));
+    return failed_tests ? EXIT_FAILURE : EXIT_SUCCESS;
+}
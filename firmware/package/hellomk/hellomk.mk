@@ -9,6 +9,10 @@ HELLOMK_VERSION = 1.0
 HELLOMK_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/hellomk/project
 HELLOMK_SITE_METHOD = local
 
+# The C configuration, time and math code comes from the libhellocore
+# package; its host build provides the INI compiler for the binary image
+HELLOMK_DEPENDENCIES = host-libhellocore libhellocore libtrace
+
 # Build commands (use the correct target compiler and environment)
 define HELLOMK_BUILD_CMDS
 	$(MAKE) CC="$(TARGET_CC)" CFLAGS="$(TARGET_CFLAGS)" LDFLAGS="$(TARGET_LDFLAGS)" -C $(@D)
@@ -18,6 +22,7 @@ endef
 define HELLOMK_INSTALL_TARGET_CMDS
 	$(INSTALL) -D -m 0755 $(@D)/bin/hellomk $(TARGET_DIR)/usr/bin/hellomk
 	$(INSTALL) -D -m 0644 $(@D)/bin/hellomk.ini $(TARGET_DIR)/etc/hellomk.ini
+	$(HOST_DIR)/bin/ini2cache $(TARGET_DIR)/etc/hellomk.ini
 endef
 
 # Evaluate the generic package infrastructure
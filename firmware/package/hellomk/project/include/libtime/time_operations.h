@@ -3,7 +3,7 @@
 #ifndef TIME_OPERATIONS_H
 #define TIME_OPERATIONS_H
 
-const char* currentTime(); // Function to get current time as a string
+const char* currentTime(); // Function to get current time as a string (static buffer, see time_format.h)
 void sleepForSeconds(int seconds); // Function to sleep for a specified number of seconds
 
 #endif // TIME_OPERATIONS_H
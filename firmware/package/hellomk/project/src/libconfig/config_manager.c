@@ -1,6 +1,7 @@
 // src/libconfig/config_manager.c
 
 #include "libconfig/config_manager.h"
+#include "libtrace/startup_trace.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,6 +28,7 @@ const char* findConfigFile(void) {
         if (possiblePaths[i] == NULL) continue; // Skip NULL entries
 
         FILE* configFile = fopen(possiblePaths[i], "r");
+        TRACE_POINT("config_probe");
         if (configFile) {
             fclose(configFile);
             return possiblePaths[i]; // Return the first found path
@@ -0,0 +1,154 @@
+// src/libmath/fixed_point_bench.c
+//
+// Fixed-point benchmark: operations per second of the fixed_point.h functions
+// against the same operation in double, plus the largest error against the
+// double result. On the soft-float target each double operation is a libgcc
+// or libm call. Run with "hellomk --bench-fixed".
+
+#include "libmath/fixed_point.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define FIXED_BENCH_SECONDS 0.3
+#define FIXED_BENCH_VALUES 1024
+#define FIXED_PI 3.14159265358979323846
+
+typedef enum { OP_MUL, OP_DIV, OP_SQRT, OP_SIN, OP_ATAN2, OP_COUNT } benchOp_t;
+
+static const char* const opNames[OP_COUNT] = {"mul (Q16.16)", "div (Q16.16)", "sqrt (Q16.16)", "sin (Q15)", "atan2"};
+static const char* const errorUnits[OP_COUNT] = {"", "", "", "", " deg"};
+
+static q16_16_t fixedA[FIXED_BENCH_VALUES], fixedB[FIXED_BENCH_VALUES];
+static double doubleA[FIXED_BENCH_VALUES], doubleB[FIXED_BENCH_VALUES];
+static fx_angle_t angles[FIXED_BENCH_VALUES];
+static double radians[FIXED_BENCH_VALUES];
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint32_t nextRandom(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// atan2 pairs A with A reversed so (x, y) covers every quadrant.
+// One pass over the inputs; returns a checksum so the work is not dropped
+static double runOnce(benchOp_t op, int fixed) {
+    int64_t fixedSum = 0;
+    double doubleSum = 0;
+
+    for (int i = 0; i < FIXED_BENCH_VALUES; i++) {
+        switch (op) {
+        case OP_MUL:
+            if (fixed) fixedSum += q16_16_mul(fixedA[i], fixedB[i]);
+            else doubleSum += doubleA[i] * doubleB[i];
+            break;
+        case OP_DIV:
+            if (fixed) fixedSum += q16_16_div(fixedA[i], fixedB[i]);
+            else doubleSum += doubleA[i] / doubleB[i];
+            break;
+        case OP_SQRT:
+            if (fixed) fixedSum += q16_16_sqrt(fixedB[i]);
+            else doubleSum += sqrt(doubleB[i]);
+            break;
+        case OP_SIN:
+            if (fixed) fixedSum += q15_sin(angles[i]);
+            else doubleSum += sin(radians[i]);
+            break;
+        case OP_ATAN2:
+            if (fixed) fixedSum += fx_atan2(fixedA[i], fixedA[FIXED_BENCH_VALUES - 1 - i]);
+            else doubleSum += atan2(doubleA[i], doubleA[FIXED_BENCH_VALUES - 1 - i]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return fixed ? (double)fixedSum : doubleSum;
+}
+
+// Operations per second of <op>
+static double measure(benchOp_t op, int fixed) {
+    unsigned long passes = 0;
+    volatile double sink = 0;
+    double start = nowSeconds(), elapsed;
+
+    do {
+        sink += runOnce(op, fixed);
+        passes++;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < FIXED_BENCH_SECONDS);
+
+    (void)sink;
+    return (double)passes * FIXED_BENCH_VALUES / elapsed;
+}
+
+// Largest difference from the double result, in the output's units
+static double maxError(benchOp_t op) {
+    double worst = 0;
+
+    for (int i = 0; i < FIXED_BENCH_VALUES; i++) {
+        double error = 0;
+        switch (op) {
+        case OP_MUL:
+            error = q16_16_mul(fixedA[i], fixedB[i]) / 65536.0 - doubleA[i] * doubleB[i];
+            break;
+        case OP_DIV:
+            error = q16_16_div(fixedA[i], fixedB[i]) / 65536.0 - doubleA[i] / doubleB[i];
+            break;
+        case OP_SQRT:
+            error = q16_16_sqrt(fixedB[i]) / 65536.0 - sqrt(doubleB[i]);
+            break;
+        case OP_SIN:
+            error = q15_sin(angles[i]) / 32768.0 - sin(radians[i]);
+            break;
+        case OP_ATAN2: {
+            int j = FIXED_BENCH_VALUES - 1 - i;
+            double expected = atan2(doubleA[i], doubleA[j]) * 180.0 / FIXED_PI;
+            error = fx_atan2(fixedA[i], fixedA[j]) * 360.0 / 65536.0 - (expected < 0 ? expected + 360.0 : expected);
+            if (error > 180.0) error -= 360.0;
+            if (error < -180.0) error += 360.0;
+            break;
+        }
+        default:
+            break;
+        }
+        if (fabs(error) > worst) worst = fabs(error);
+    }
+
+    return worst;
+}
+
+int fixed_point_bench(void) {
+    uint32_t seed = 0x9e3779b9u;
+
+    // Operands in [-100, 100) and (0, 100) so products and quotients stay in
+    // range; both formats start from the same quantized values
+    for (int i = 0; i < FIXED_BENCH_VALUES; i++) {
+        fixedA[i] = (q16_16_t)(nextRandom(&seed) % (200u * Q16_16_ONE)) - 100 * Q16_16_ONE;
+        fixedB[i] = (q16_16_t)(nextRandom(&seed) % (100u * Q16_16_ONE)) + 1;
+        doubleA[i] = fixedA[i] / 65536.0;
+        doubleB[i] = fixedB[i] / 65536.0;
+        angles[i] = (fx_angle_t)nextRandom(&seed);
+        radians[i] = angles[i] * 2.0 * FIXED_PI / 65536.0;
+    }
+
+    printf("Fixed-point benchmark, %d operands\n", FIXED_BENCH_VALUES);
+    printf("  %-14s %14s %14s %8s %14s\n", "operation", "double Mop/s", "fixed Mop/s", "speedup", "max error");
+
+    for (int op = 0; op < OP_COUNT; op++) {
+        double floating = measure((benchOp_t)op, 0);
+        double fixed = measure((benchOp_t)op, 1);
+        printf("  %-14s %14.1f %14.1f %7.1fx %14.3g%s\n", opNames[op], floating / 1e6, fixed / 1e6, fixed / floating,
+               maxError((benchOp_t)op), errorUnits[op]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+// src/libmath/math_batch_bench.c
+//
+// Batch benchmark: elements per second of a loop over the scalar
+// math_operations.h functions against the matching math_batch.h call, with
+// the results of both compared. Run with "hellomk --bench-math [n]".
+
+#include "libmath/math_batch.h"
+#include "libmath/math_operations.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MATH_BENCH_SECONDS 0.3
+
+typedef enum { OP_ADD, OP_MUL, OP_FMA, OP_DIV, OP_ADD_SAT_I16, OP_ADD_SAT_I32, OP_COUNT } benchOp_t;
+
+static const char* const opNames[OP_COUNT] = {
+    "add (int)", "mul (float)", "fma (float)", "div (float)", "add_sat (int16)", "add_sat (int32)",
+};
+
+typedef struct {
+    size_t n;
+    int *ia, *ib, *iout;
+    float *fa, *fb, *fc, *fout;
+    int16_t *sa, *sb, *sout;
+    uint8_t* mask;
+} benchData_t;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint32_t nextRandom(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static int16_t clampI16(int value) {
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value);
+}
+
+static int32_t clampI32(long long value) {
+    return (int32_t)(value > INT32_MAX ? INT32_MAX : value < INT32_MIN ? INT32_MIN : value);
+}
+
+// One pass over the arrays, through the scalar API or the batch API
+static void runOnce(benchData_t* d, benchOp_t op, int batch) {
+    size_t n = d->n;
+    int error;
+
+    switch (op) {
+    case OP_ADD:
+        if (batch) math_add_n(d->ia, d->ib, d->iout, n);
+        else for (size_t i = 0; i < n; i++) d->iout[i] = add(d->ia[i], d->ib[i]);
+        break;
+    case OP_MUL:
+        if (batch) math_mul_n(d->fa, d->fb, d->fout, n);
+        else for (size_t i = 0; i < n; i++) d->fout[i] = (float)multiply(d->fa[i], d->fb[i]);
+        break;
+    case OP_FMA:
+        if (batch) math_fma_n(d->fa, d->fb, d->fc, d->fout, n);
+        else for (size_t i = 0; i < n; i++) d->fout[i] = (float)(multiply(d->fa[i], d->fb[i]) + d->fc[i]);
+        break;
+    case OP_DIV:
+        if (batch) math_div_n(d->fa, d->fb, d->fout, d->mask, n);
+        else for (size_t i = 0; i < n; i++) d->fout[i] = (float)divide(d->fa[i], d->fb[i], &error);
+        break;
+    case OP_ADD_SAT_I16:
+        if (batch) math_add_sat_i16_n(d->sa, d->sb, d->sout, n);
+        else for (size_t i = 0; i < n; i++) d->sout[i] = clampI16(add(d->sa[i], d->sb[i]));
+        break;
+    case OP_ADD_SAT_I32:
+        if (batch) math_add_sat_i32_n(d->ia, d->ib, d->iout, n);
+        else for (size_t i = 0; i < n; i++) d->iout[i] = clampI32((long long)d->ia[i] + d->ib[i]);
+        break;
+    default:
+        break;
+    }
+}
+
+// Elements per second of <op>
+static double measure(benchData_t* d, benchOp_t op, int batch) {
+    unsigned long passes = 0;
+    double start = nowSeconds(), elapsed;
+
+    do {
+        runOnce(d, op, batch);
+        passes++;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < MATH_BENCH_SECONDS);
+
+    return (double)passes * (double)d->n / elapsed;
+}
+
+// Elements where the batch result differs from the scalar one. Float results
+// are compared exactly: both paths round the same product or quotient once,
+// except fma, which may skip the intermediate rounding.
+static size_t compare(benchData_t* d, benchOp_t op, void* expected) {
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < d->n; i++) {
+        switch (op) {
+        case OP_ADD:
+        case OP_ADD_SAT_I32:
+            mismatches += ((int*)expected)[i] != d->iout[i];
+            break;
+        case OP_ADD_SAT_I16:
+            mismatches += ((int16_t*)expected)[i] != d->sout[i];
+            break;
+        case OP_FMA: {
+            float diff = ((float*)expected)[i] - d->fout[i];
+            mismatches += diff > 1e-3f || diff < -1e-3f;
+            break;
+        }
+        default:
+            mismatches += ((float*)expected)[i] != d->fout[i];
+            break;
+        }
+    }
+
+    return mismatches;
+}
+
+int math_batch_bench(size_t n) {
+    benchData_t d = {.n = n};
+    uint32_t seed = 0x2545f491u;
+    size_t zeros = 0, failures = 0;
+
+    if (n == 0) return 1;
+
+    d.ia = malloc(n * sizeof(int));
+    d.ib = malloc(n * sizeof(int));
+    d.iout = malloc(n * sizeof(int));
+    d.fa = malloc(n * sizeof(float));
+    d.fb = malloc(n * sizeof(float));
+    d.fc = malloc(n * sizeof(float));
+    d.fout = malloc(n * sizeof(float));
+    d.sa = malloc(n * sizeof(int16_t));
+    d.sb = malloc(n * sizeof(int16_t));
+    d.sout = malloc(n * sizeof(int16_t));
+    d.mask = malloc(MATH_MASK_BYTES(n));
+    void* expected = malloc(n * (sizeof(float) > sizeof(int) ? sizeof(float) : sizeof(int)));
+    if (!d.ia || !d.ib || !d.iout || !d.fa || !d.fb || !d.fc || !d.fout || !d.sa || !d.sb || !d.sout ||
+        !d.mask || !expected) {
+        fprintf(stderr, "Out of memory\n");
+        failures = 1;
+        goto cleanup;
+    }
+
+    // Wide int ranges so the saturating paths clamp; one divisor in 64 is zero
+    for (size_t i = 0; i < n; i++) {
+        d.ia[i] = (int)nextRandom(&seed);
+        d.ib[i] = (int)nextRandom(&seed);
+        d.sa[i] = (int16_t)nextRandom(&seed);
+        d.sb[i] = (int16_t)nextRandom(&seed);
+        d.fa[i] = (float)(nextRandom(&seed) % 20001) / 100.0f - 100.0f;
+        d.fb[i] = nextRandom(&seed) % 64 == 0 ? 0.0f : (float)(nextRandom(&seed) % 2000 + 1) / 100.0f;
+        d.fc[i] = (float)(nextRandom(&seed) % 1001) / 10.0f;
+        zeros += d.fb[i] == 0.0f;
+    }
+    // Scalar add() wraps like the batch version; keep the operands in range
+    // so neither relies on signed overflow
+    for (size_t i = 0; i < n; i++) {
+        d.ia[i] /= 2;
+        d.ib[i] /= 2;
+    }
+
+    printf("Batch math benchmark, %zu elements (%zu zero divisors)\n", n, zeros);
+    printf("  %-16s %14s %14s %8s %10s\n", "operation", "scalar Mel/s", "batch Mel/s", "speedup", "mismatch");
+
+    for (int op = 0; op < OP_COUNT; op++) {
+        double scalar = measure(&d, (benchOp_t)op, 0);
+        runOnce(&d, (benchOp_t)op, 0);
+        if (op == OP_ADD_SAT_I16) memcpy(expected, d.sout, n * sizeof(int16_t));
+        else if (op == OP_ADD || op == OP_ADD_SAT_I32) memcpy(expected, d.iout, n * sizeof(int));
+        else memcpy(expected, d.fout, n * sizeof(float));
+
+        double batch = measure(&d, (benchOp_t)op, 1);
+        size_t mismatches = compare(&d, (benchOp_t)op, expected);
+        failures += mismatches;
+
+        printf("  %-16s %14.1f %14.1f %7.1fx %10zu\n", opNames[op], scalar / 1e6, batch / 1e6, batch / scalar,
+               mismatches);
+    }
+
+    // The mask must flag exactly the zero divisors
+    size_t flagged = 0;
+    for (size_t i = 0; i < n; i++) {
+        int bit = (d.mask[i / 8] >> (i % 8)) & 1;
+        flagged += (size_t)bit;
+        failures += (size_t)(bit != (d.fb[i] == 0.0f));
+    }
+    printf("  divide-by-zero mask flagged %zu/%zu\n", flagged, zeros);
+
+cleanup:
+    free(d.ia);
+    free(d.ib);
+    free(d.iout);
+    free(d.fa);
+    free(d.fb);
+    free(d.fc);
+    free(d.fout);
+    free(d.sa);
+    free(d.sb);
+    free(d.sout);
+    free(d.mask);
+    free(expected);
+    return failures ? 1 : 0;
+}
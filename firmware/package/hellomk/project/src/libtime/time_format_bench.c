@@ -0,0 +1,123 @@
+// src/libtime/time_format_bench.c
+//
+// Timestamp benchmark: formats per second of currentTime(), a naive
+// localtime_r() + snprintf() ISO-8601 formatter and time_format_*(), both
+// within one second (the logging case) and with a new second on every call.
+// Run with "hellomk --bench-time".
+
+#include "libtime/time_format.h"
+#include "libtime/time_operations.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TIME_BENCH_SECONDS 0.5
+#define TIME_BENCH_BATCH 1000
+#define TIME_BENCH_CHECKS 100000
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// What a caller without the cache would write
+static size_t naiveIso8601(const struct timespec* ts, char* buf, size_t size) {
+    struct tm tm;
+    localtime_r(&ts->tv_sec, &tm);
+    size_t length = strftime(buf, size, "%Y-%m-%dT%H:%M:%S", &tm);
+    return length + (size_t)snprintf(buf + length, size - length, ".%06ld", ts->tv_nsec / 1000);
+}
+
+typedef enum { CASE_CURRENT_TIME, CASE_NAIVE, CASE_CACHED_NOW, CASE_CACHED_NEW_SECOND } benchCase_t;
+
+static const char* const caseNames[] = {
+    "currentTime() (localtime+strftime)",
+    "localtime_r+strftime+snprintf",
+    "time_format_now() (6 digits)",
+    "time_format_iso8601(), new second",
+};
+
+// Run <which> for TIME_BENCH_SECONDS and return formats per second
+static double runCase(benchCase_t which) {
+    time_format_cache_t cache;
+    char buf[TIME_FORMAT_MAX_LENGTH];
+    struct timespec ts;
+    unsigned long calls = 0;
+    volatile char sink = 0;
+
+    time_format_init(&cache);
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    double start = nowSeconds(), elapsed;
+    do {
+        for (int i = 0; i < TIME_BENCH_BATCH; i++) {
+            switch (which) {
+            case CASE_CURRENT_TIME:
+                sink ^= currentTime()[18];
+                break;
+            case CASE_NAIVE:
+                clock_gettime(CLOCK_REALTIME, &ts);
+                naiveIso8601(&ts, buf, sizeof(buf));
+                sink ^= buf[20];
+                break;
+            case CASE_CACHED_NOW:
+                time_format_now(&cache, 6, buf, sizeof(buf));
+                sink ^= buf[20];
+                break;
+            case CASE_CACHED_NEW_SECOND:
+                ts.tv_sec++;
+                time_format_iso8601(&cache, &ts, 6, buf, sizeof(buf));
+                sink ^= buf[20];
+                break;
+            }
+        }
+        calls += TIME_BENCH_BATCH;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < TIME_BENCH_SECONDS);
+
+    (void)sink;
+    return (double)calls / elapsed;
+}
+
+// The cached formatter must agree with strftime() over a day of seconds
+static unsigned long checkAgainstStrftime(void) {
+    time_format_cache_t cache;
+    char expected[TIME_FORMAT_MAX_LENGTH], actual[TIME_FORMAT_MAX_LENGTH];
+    unsigned long mismatches = 0;
+    struct timespec ts;
+
+    time_format_init(&cache);
+    clock_gettime(CLOCK_REALTIME, &ts);
+    for (unsigned int i = 0; i < TIME_BENCH_CHECKS; i++) {
+        ts.tv_sec += i % 3 == 0;
+        ts.tv_nsec = (long)(i * 7919UL % 1000000000UL);
+        naiveIso8601(&ts, expected, sizeof(expected));
+        time_format_iso8601(&cache, &ts, 6, actual, sizeof(actual));
+        if (strncmp(expected, actual, strlen(expected)) != 0) mismatches++;
+    }
+
+    return mismatches;
+}
+
+int time_format_bench(void) {
+    time_format_cache_t cache;
+    char sample[TIME_FORMAT_MAX_LENGTH];
+
+    time_format_init(&cache);
+    time_format_now(&cache, 6, sample, sizeof(sample));
+    printf("Timestamp benchmark, sample \"%s\"\n", sample);
+
+    unsigned long mismatches = checkAgainstStrftime();
+    printf("  %-36s %lu/%u\n", "mismatches against strftime", mismatches, TIME_BENCH_CHECKS);
+
+    double baseline = 0;
+    for (int which = CASE_CURRENT_TIME; which <= CASE_CACHED_NEW_SECOND; which++) {
+        double rate = runCase((benchCase_t)which);
+        if (which == CASE_CURRENT_TIME) baseline = rate;
+        printf("  %-36s %10.0f formats/s  %5.1fx\n", caseNames[which], rate, rate / baseline);
+    }
+
+    return mismatches ? 1 : 0;
+}
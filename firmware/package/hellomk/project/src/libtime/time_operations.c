@@ -10,10 +10,11 @@
 const char* currentTime() {
     static char buffer[20]; // Buffer to hold the time string in format "YYYY-MM-DD HH:MM:SS"
     time_t now = time(NULL);
-    struct tm *localTime = localtime(&now);
+    struct tm localTime;
 
-    // Format the time as a string
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", localTime);
+    // Format the time as a string; localtime_r() keeps libc's static struct tm out of it
+    localtime_r(&now, &localTime);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &localTime);
     return buffer;
 }
 
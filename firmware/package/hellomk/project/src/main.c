@@ -1,13 +1,116 @@
 // src/main.c
 
 #include "libmath/math_operations.h"
+#include "libmath/math_batch.h"
+#include "libmath/fixed_point.h"
 #include "libtime/time_operations.h"
+#include "libtime/time_format.h"
 #include "libconfig/config_manager.h"
+#include "libconfig/config.h"
+#include "libconfig/config_image.h"
+#include "libconfig/config_watch.h"
+#include "libtrace/startup_trace.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
 
+#define BENCH_DEFAULT_KEYS 10000
+#define STRESS_DEFAULT_THREADS 4
+#define STRESS_DEFAULT_SECONDS 5
+#define RELOAD_DEFAULT_READERS 2
+#define RELOAD_DEFAULT_COUNT 100
+#define MATH_BENCH_DEFAULT_ELEMENTS 4096
+
+// Print one configuration value or a not-found message
+static void printValue(const config_t* cfg, const char* label, const char* section, const char* key) {
+    size_t length;
+    const char* value = config_get(cfg, section, key, &length);
+    if (value) {
+        printf("%s: %.*s\n", label, (int)length, value);
+    } else {
+        printf("Key not found in section '%s'\n", section);
+    }
+}
+
+// Print the configuration, then again every time the file changes
+static int watchConfig(const char* configFile) {
+    config_watch_t* watch = config_watch_open(configFile);
+    if (watch == NULL) {
+        perror(configFile);
+        return 1;
+    }
+
+    struct pollfd pfd = {config_watch_fd(watch), POLLIN, 0};
+    for (;;) {
+        config_snapshot_t snap = config_watch_acquire(watch);
+        printf("Configuration generation %u:\n", config_watch_generation(watch));
+        printValue(snap.cfg, "  Database Host", "database", "host");
+        printValue(snap.cfg, "  Server Port", "server", "port");
+        config_watch_release(watch, snap);
+        fflush(stdout);
+
+        // Block until the file changes and a new snapshot is published
+        int published = 0;
+        while (!published) {
+            if (poll(&pfd, 1, -1) < 0) {
+                perror("poll");
+                config_watch_close(watch);
+                return 1;
+            }
+            published = config_watch_dispatch(watch);
+            if (published < 0) {
+                perror("Reload failed, keeping previous configuration");
+                published = 0;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Host benchmark of the configuration store
+    if (argc >= 2 && strcmp(argv[1], "--bench-config") == 0) {
+        unsigned int keys = argc >= 3 ? (unsigned int)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_KEYS;
+        return config_bench(keys, getConfigValue);
+    }
+
+    // Cold start through the binary image against parsing the INI
+    if (argc >= 2 && strcmp(argv[1], "--bench-cache") == 0) {
+        unsigned int keys = argc >= 3 ? (unsigned int)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_KEYS;
+        return config_image_bench(keys);
+    }
+
+    // Multithreaded stress test of the configuration store
+    if (argc >= 2 && strcmp(argv[1], "--stress-config") == 0) {
+        unsigned int threads = argc >= 3 ? (unsigned int)strtoul(argv[2], NULL, 10) : STRESS_DEFAULT_THREADS;
+        unsigned int seconds = argc >= 4 ? (unsigned int)strtoul(argv[3], NULL, 10) : STRESS_DEFAULT_SECONDS;
+        return config_stress(threads, seconds);
+    }
+
+    // Reader overhead and reload latency of the hot-reloading store
+    if (argc >= 2 && strcmp(argv[1], "--bench-reload") == 0) {
+        unsigned int readers = argc >= 3 ? (unsigned int)strtoul(argv[2], NULL, 10) : RELOAD_DEFAULT_READERS;
+        unsigned int reloads = argc >= 4 ? (unsigned int)strtoul(argv[3], NULL, 10) : RELOAD_DEFAULT_COUNT;
+        return config_watch_bench(readers, reloads);
+    }
+
+    // Host benchmark of the timestamp formatters
+    if (argc >= 2 && strcmp(argv[1], "--bench-time") == 0) {
+        return time_format_bench();
+    }
+
+    // Scalar against batch throughput of libmath
+    if (argc >= 2 && strcmp(argv[1], "--bench-math") == 0) {
+        size_t elements = argc >= 3 ? (size_t)strtoul(argv[2], NULL, 10) : MATH_BENCH_DEFAULT_ELEMENTS;
+        return math_batch_bench(elements);
+    }
+
+    // Fixed-point against double throughput and accuracy
+    if (argc >= 2 && strcmp(argv[1], "--bench-fixed") == 0) {
+        return fixed_point_bench();
+    }
 
-int main() {
     // Math operations example
     int a = 10, b = 5;
     printf("Addition: %d\n", add(a, b)); // Assuming add is a function in libmath
@@ -15,42 +118,56 @@ int main() {
     // Time operations example
     printf("Current Time: %s\n", currentTime()); // Assuming currentTime returns a string
 
+    time_format_cache_t timeCache;
+    char timestamp[TIME_FORMAT_MAX_LENGTH];
+    time_format_init(&timeCache);
+    time_format_now(&timeCache, 3, timestamp, sizeof(timestamp));
+    printf("Timestamp: %s\n", timestamp);
+
     // Configuration example (load from a hypothetical config file)
     const char* configFile = findConfigFile();
+    TRACE_POINT("config_find");
     if (configFile == NULL) {
         fprintf(stderr, "Configuration file not found.\n");
         return 1; // Error
     }
     printf("Configuration file: %s\n", configFile);
 
-    // Load configuration from the found path
-    const char* dbHost = getConfigValue(configFile, "database", "host");
-    if (dbHost) {
-        printf("Database Host: %s\n", dbHost);
-    } else {
-        printf("Key not found in section 'database'\n");
+    // Keep running and follow edits to the file
+    if (argc >= 2 && strcmp(argv[1], "--watch") == 0) {
+        return watchConfig(configFile);
     }
 
-    const char* serverPort = getConfigValue(configFile, "server", "port");
-    if (serverPort) {
-        printf("Server Port: %s\n", serverPort);
-    } else {
-        printf("Key not found in section 'server'\n");
+    // Map the binary image if it is current, otherwise parse the file once;
+    // every lookup below is served from memory
+    int fromImage;
+    config_t* cfg = config_open(configFile, &fromImage);
+    if (cfg == NULL) {
+        perror(configFile);
+        return 1;
     }
+    TRACE_POINT("config_load");
+    printf("Configuration source: %s\n", fromImage ? "binary image" : "INI");
+
+    printValue(cfg, "Database Host", "database", "host");
+    TRACE_FIRST_IO("config_get");
+    printValue(cfg, "Database User", "database", "user");
 
-    const char* dbUser = getConfigValue(configFile, "database", "user");
-    if (dbUser) {
-        printf("Database User: %s\n", dbUser);
+    // Typed values are parsed once and cached in the store
+    int64_t serverPort;
+    if (config_get_int(cfg, "server", "port", &serverPort) == 0) {
+        printf("Server Port: %lld\n", (long long)serverPort);
     } else {
-        printf("Key not found in section 'database'\n");
+        printf("Invalid or missing key 'port' in section 'server'\n");
     }
 
-    const char* enableLogging = getConfigValue(configFile, "server", "enable_logging");
-    if (enableLogging) {
-        printf("Enable Logging: %s\n", enableLogging);
+    int enableLogging;
+    if (config_get_bool(cfg, "server", "enable_logging", &enableLogging) == 0) {
+        printf("Enable Logging: %s\n", enableLogging ? "true" : "false");
     } else {
-        printf("Key not found in section 'server'\n");
+        printf("Invalid or missing key 'enable_logging' in section 'server'\n");
     }
 
+    config_free(cfg);
     return 0;
 }
@@ -9,6 +9,11 @@ HELLOMKCPP_VERSION = 1.0
 HELLOMKCPP_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/hellomkcpp/project
 HELLOMKCPP_SITE_METHOD = local
 
+# The C configuration, time and math code comes from the libhellocore
+# package; its host build provides the INI compiler for the binary image.
+# The startup recorder comes from libtrace
+HELLOMKCPP_DEPENDENCIES = host-libhellocore libhellocore libtrace
+
 # Build dependencies (ensure g++ is available for the build)
 # Run make menuconfig in your buildroot system. Under the toolchain heading select the g++ option.
 # Then flag is set in configiguration file BR2_TOOLCHAIN_BUILDROOT_CXX=y
@@ -22,6 +27,7 @@ endef
 define HELLOMKCPP_INSTALL_TARGET_CMDS
 	$(INSTALL) -D -m 0755 $(@D)/bin/hellomkcpp $(TARGET_DIR)/usr/bin/hellomkcpp
 	$(INSTALL) -D -m 0644 $(@D)/bin/hellomkcpp.ini $(TARGET_DIR)/etc/hellomkcpp.ini
+	$(HOST_DIR)/bin/ini2cache $(TARGET_DIR)/etc/hellomkcpp.ini
 endef
 
 # Evaluate the generic package infrastructure
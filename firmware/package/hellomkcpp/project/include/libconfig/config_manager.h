@@ -16,6 +16,8 @@ extern "C" {
 
 // Function declarations for configuration management
 const char* findConfigFile(void);
+// Legacy lookup: rescans the file and returns a static buffer that the next
+// call overwrites, so it is not reentrant. Prefer config_load()/config_get().
 const char* getConfigValue(const char* filename, const char* section, const char* key);
 
 #ifdef __cplusplus
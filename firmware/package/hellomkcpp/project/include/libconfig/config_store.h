@@ -0,0 +1,108 @@
+// include/libconfig/config_store.h
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "libconfig/config.h"
+
+// C++ front-end for the parse-once store. A Config owns one config_t (a
+// single allocation, or a mapped image) and hands out std::string_view and
+// typed values that point into it; no accessor allocates.
+class Config {
+public:
+    enum class Type { String, Int, Bool, Double, Duration };
+
+    // One expected key; a schema is a constexpr std::array of these
+    struct Key {
+        const char* section;
+        const char* name;
+        Type type;
+        bool required;
+    };
+
+    // Called once per schema problem found by validate()
+    using Report = void (*)(const Key& key, const char* problem);
+
+    Config() noexcept = default;
+    explicit Config(config_t* store) noexcept : store_(store) {}
+    Config(Config&& other) noexcept;
+    Config& operator=(Config&& other) noexcept;
+    Config(const Config&) = delete;
+    Config& operator=(const Config&) = delete;
+    ~Config();
+
+    // Open <path> through its binary image, or parse it
+    static Config open(const char* path) noexcept;
+
+    // Open <path> and check it against <schema>; returns an empty Config if
+    // the file cannot be loaded or any key is missing or malformed
+    template <std::size_t N>
+    static Config load(const char* path, const std::array<Key, N>& schema, Report report = nullptr) noexcept {
+        Config cfg = open(path);
+        if (cfg && cfg.validate(schema.data(), N, report) != 0) cfg = Config();
+        return cfg;
+    }
+
+    explicit operator bool() const noexcept { return store_ != nullptr; }
+    const config_t* store() const noexcept { return store_; }
+    std::size_t size() const noexcept { return config_count(store_); }
+
+    // Raw value, empty if the key does not exist
+    std::string_view view(const char* section, const char* name) const noexcept;
+
+    // Typed value, std::nullopt if missing or malformed. Supported types are
+    // std::string_view, int, std::int64_t, bool, double and
+    // std::chrono::microseconds.
+    template <typename T>
+    std::optional<T> get(const char* section, const char* name) const noexcept;
+
+    template <typename T>
+    std::optional<T> get(const Key& key) const noexcept { return get<T>(key.section, key.name); }
+
+    // Number of problems with <keys>, each passed to <report>
+    std::size_t validate(const Key* keys, std::size_t count, Report report = nullptr) const noexcept;
+
+    // True if no section/name pair appears twice, usable in static_assert()
+    template <std::size_t N>
+    static constexpr bool unique(const std::array<Key, N>& schema) {
+        for (std::size_t i = 0; i < N; i++) {
+            for (std::size_t j = i + 1; j < N; j++) {
+                if (equal(schema[i].section, schema[j].section) && equal(schema[i].name, schema[j].name)) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr bool equal(const char* a, const char* b) {
+        while (*a && *a == *b) {
+            a++;
+            b++;
+        }
+        return *a == *b;
+    }
+
+    config_t* store_ = nullptr;
+};
+
+template <typename T>
+std::optional<T> Config::get(const char*, const char*) const noexcept {
+    static_assert(sizeof(T) == 0, "Config::get<T>: unsupported type");
+    return std::nullopt;
+}
+
+template <> std::optional<std::string_view> Config::get(const char* section, const char* name) const noexcept;
+template <> std::optional<std::int64_t> Config::get(const char* section, const char* name) const noexcept;
+template <> std::optional<int> Config::get(const char* section, const char* name) const noexcept;
+template <> std::optional<bool> Config::get(const char* section, const char* name) const noexcept;
+template <> std::optional<double> Config::get(const char* section, const char* name) const noexcept;
+template <> std::optional<std::chrono::microseconds> Config::get(const char* section, const char* name) const noexcept;
+
+#endif // CONFIG_STORE_H
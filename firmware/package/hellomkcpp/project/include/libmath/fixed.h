@@ -0,0 +1,148 @@
+// include/libmath/fixed.h
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "libmath/fixed_point.h"
+
+// Fixed-point number with <Frac> fraction bits stored in <Rep>. The format
+// is part of the type, so mixing formats in an expression does not compile;
+// convert with fixedCast<>() or multiply<>(). Arithmetic saturates and rounds
+// to nearest like fixed_point.h, and is constexpr.
+template <typename Rep, int Frac>
+class Fixed {
+    static_assert(std::is_integral_v<Rep> && std::is_signed_v<Rep>, "Fixed needs a signed integer representation");
+    static_assert(sizeof(Rep) <= sizeof(std::int32_t), "Fixed supports representations up to 32 bits");
+    static_assert(Frac >= 0 && Frac <= std::numeric_limits<Rep>::digits, "too many fraction bits for the representation");
+
+public:
+    using rep = Rep;
+    // Holds the product of two values before it is scaled back
+    using wide = std::conditional_t<sizeof(Rep) <= sizeof(std::int16_t), std::int32_t, std::int64_t>;
+    static constexpr int fractionBits = Frac;
+
+    constexpr Fixed() noexcept = default;
+
+    static constexpr Fixed fromRaw(Rep raw) noexcept {
+        Fixed value;
+        value.raw_ = raw;
+        return value;
+    }
+
+    // Meant for constants: a value outside the format's range fails to
+    // compile in a constant expression and throws std::out_of_range otherwise
+    static constexpr Fixed fromDouble(double value) {
+        double scaled = value * scale();
+        if (!(scaled >= kMin - 0.5 && scaled < kMax + 0.5)) throw std::out_of_range("value outside the fixed-point range");
+        return fromRaw(static_cast<Rep>(scaled >= 0 ? scaled + 0.5 : scaled - 0.5));
+    }
+
+    static constexpr Fixed fromInt(int value) {
+        wide scaled = static_cast<wide>(value) * (wide(1) << Frac);
+        if (scaled < kMin || scaled > kMax) throw std::out_of_range("value outside the fixed-point range");
+        return fromRaw(static_cast<Rep>(scaled));
+    }
+
+    static constexpr Fixed max() noexcept { return fromRaw(kMax); }
+    static constexpr Fixed min() noexcept { return fromRaw(kMin); }
+
+    constexpr Rep raw() const noexcept { return raw_; }
+    constexpr double toDouble() const noexcept { return raw_ / scale(); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept { return saturate(wide(a.raw_) + b.raw_); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept { return saturate(wide(a.raw_) - b.raw_); }
+    friend constexpr Fixed operator-(Fixed a) noexcept { return saturate(-wide(a.raw_)); }
+
+    friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept {
+        return saturate((wide(a.raw_) * b.raw_ + kHalf) >> Frac);
+    }
+
+    // A zero divisor saturates towards the sign of <a>
+    friend constexpr Fixed operator/(Fixed a, Fixed b) noexcept {
+        if (b.raw_ == 0) return a.raw_ < 0 ? min() : a.raw_ > 0 ? max() : Fixed();
+        std::int64_t numerator = static_cast<std::int64_t>(a.raw_) * (std::int64_t(1) << Frac);
+        std::int64_t half = (b.raw_ < 0 ? -std::int64_t(b.raw_) : std::int64_t(b.raw_)) / 2;
+        numerator += numerator < 0 ? -half : half;
+        return saturate(static_cast<wide>(numerator / b.raw_));
+    }
+
+    constexpr Fixed& operator+=(Fixed other) noexcept { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) noexcept { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) noexcept { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) noexcept { return *this = *this / other; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) noexcept { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) noexcept { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed a, Fixed b) noexcept { return a.raw_ < b.raw_; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) noexcept { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>(Fixed a, Fixed b) noexcept { return a.raw_ > b.raw_; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) noexcept { return a.raw_ >= b.raw_; }
+
+    // Clamp a value already in this format to the representation
+    template <typename Wide>
+    static constexpr Fixed saturate(Wide value) noexcept {
+        return fromRaw(static_cast<Rep>(value > kMax ? kMax : value < kMin ? kMin : value));
+    }
+
+private:
+    static constexpr Rep kMax = std::numeric_limits<Rep>::max();
+    static constexpr Rep kMin = std::numeric_limits<Rep>::min();
+    static constexpr wide kHalf = (wide(1) << Frac) >> 1;
+
+    static constexpr double scale() noexcept { return static_cast<double>(std::int64_t(1) << Frac); }
+
+    Rep raw_ = 0;
+};
+
+using Q15 = Fixed<std::int16_t, 15>;
+using Q31 = Fixed<std::int32_t, 31>;
+using Q16_16 = Fixed<std::int32_t, 16>;
+
+static_assert(sizeof(Q15) == sizeof(q15_t) && sizeof(Q31) == sizeof(q31_t) && sizeof(Q16_16) == sizeof(q16_16_t),
+              "Fixed must stay layout-compatible with fixed_point.h");
+
+namespace fixed_detail {
+// Move <raw> from <From> to <To> fraction bits, rounding to nearest
+template <int From, int To>
+constexpr std::int64_t rescale(std::int64_t raw) noexcept {
+    if constexpr (To >= From) {
+        return raw * (std::int64_t(1) << (To - From));
+    } else {
+        return (raw + (std::int64_t(1) << (From - To - 1))) >> (From - To);
+    }
+}
+} // namespace fixed_detail
+
+// Convert between formats with rounding and saturation
+template <typename To, typename FromRep, int FromFrac>
+constexpr To fixedCast(Fixed<FromRep, FromFrac> value) noexcept {
+    return To::saturate(fixed_detail::rescale<FromFrac, To::fractionBits>(value.raw()));
+}
+
+// Product of two different formats, computed exactly and then converted to
+// <Result>; e.g. multiply<Q16_16>(Q15 gain, Q16_16 sample)
+template <typename Result, typename RepA, int FracA, typename RepB, int FracB>
+constexpr Result multiply(Fixed<RepA, FracA> a, Fixed<RepB, FracB> b) noexcept {
+    static_assert(sizeof(RepA) + sizeof(RepB) <= sizeof(std::int64_t), "product does not fit 64 bits");
+    static_assert(FracA + FracB <= 62, "product has too many fraction bits");
+    std::int64_t product = static_cast<std::int64_t>(a.raw()) * b.raw();
+    return Result::saturate(fixed_detail::rescale<FracA + FracB, Result::fractionBits>(product));
+}
+
+// Table-based functions from fixed_point.h
+inline Q15 fixedSin(fx_angle_t angle) noexcept { return Q15::fromRaw(q15_sin(angle)); }
+inline Q15 fixedCos(fx_angle_t angle) noexcept { return Q15::fromRaw(q15_cos(angle)); }
+inline Q16_16 fixedSqrt(Q16_16 value) noexcept { return Q16_16::fromRaw(q16_16_sqrt(value.raw())); }
+
+// Angle of (x, y); both must share a format
+template <typename Rep, int Frac>
+fx_angle_t fixedAtan2(Fixed<Rep, Frac> y, Fixed<Rep, Frac> x) noexcept {
+    return fx_atan2(y.raw(), x.raw());
+}
+
+#endif // FIXED_H
@@ -3,12 +3,51 @@
 #ifndef MATH_OPERATIONS_H
 #define MATH_OPERATIONS_H
 
+#include <cstddef>
+#include <cstdint>
+
+#include "libmath/math_batch.h"
+
 class MathOperations {
 public:
     static int add(int a, int b);
     static int subtract(int a, int b);
     static double multiply(double a, double b);
     static double divide(double a, double b);
+
+    // Array forms over <n> elements (see libmath/math_batch.h); out may alias
+    // an input. The batch divide() does not throw: quotients with a zero
+    // divisor are 0, flagged in <zeroMask> (MATH_MASK_BYTES(n) bytes, may be
+    // nullptr) and counted in the return value.
+    static void add(const int* a, const int* b, int* out, std::size_t n) noexcept { math_add_n(a, b, out, n); }
+    static void subtract(const int* a, const int* b, int* out, std::size_t n) noexcept {
+        math_sub_n(a, b, out, n);
+    }
+    static void multiply(const float* a, const float* b, float* out, std::size_t n) noexcept {
+        math_mul_n(a, b, out, n);
+    }
+    static void multiplyAdd(const float* a, const float* b, const float* c, float* out, std::size_t n) noexcept {
+        math_fma_n(a, b, c, out, n);
+    }
+    static std::size_t divide(const float* a, const float* b, float* out, std::uint8_t* zeroMask,
+                              std::size_t n) noexcept {
+        return math_div_n(a, b, out, zeroMask, n);
+    }
+
+    static void addSaturated(const std::int16_t* a, const std::int16_t* b, std::int16_t* out, std::size_t n) noexcept {
+        math_add_sat_i16_n(a, b, out, n);
+    }
+    static void subtractSaturated(const std::int16_t* a, const std::int16_t* b, std::int16_t* out,
+                                  std::size_t n) noexcept {
+        math_sub_sat_i16_n(a, b, out, n);
+    }
+    static void addSaturated(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n) noexcept {
+        math_add_sat_i32_n(a, b, out, n);
+    }
+    static void subtractSaturated(const std::int32_t* a, const std::int32_t* b, std::int32_t* out,
+                                  std::size_t n) noexcept {
+        math_sub_sat_i32_n(a, b, out, n);
+    }
 };
 
 #endif // MATH_OPERATIONS_H
@@ -4,12 +4,43 @@
 #define TIME_OPERATIONS_H
 
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <cstddef>
+
+#include "libtime/time_format.h"
 
 class TimeOperations {
 public:
     static std::string currentTime();
     static void sleepForSeconds(int seconds);
+
+    // Allocation-free ISO-8601 timestamps with sub-second precision. Keeps
+    // the broken-down date of the last second it formatted, so give each
+    // thread or logger its own instance.
+    class Formatter {
+    public:
+        explicit Formatter(int digits = 6) noexcept : digits_(digits) { time_format_init(&cache_); }
+
+        // Format into the caller's buffer; returns the length, 0 if too small
+        std::size_t now(char* buf, std::size_t size) noexcept {
+            return time_format_now(&cache_, digits_, buf, size);
+        }
+        std::size_t format(const timespec& ts, char* buf, std::size_t size) noexcept {
+            return time_format_iso8601(&cache_, &ts, digits_, buf, size);
+        }
+
+        // Format into the internal buffer; valid until the next call
+        std::string_view now() noexcept { return {buffer_, now(buffer_, sizeof(buffer_))}; }
+        std::string_view format(const timespec& ts) noexcept {
+            return {buffer_, format(ts, buffer_, sizeof(buffer_))};
+        }
+
+    private:
+        time_format_cache_t cache_;
+        int digits_;
+        char buffer_[TIME_FORMAT_MAX_LENGTH];
+    };
 };
 
 #endif // TIME_OPERATIONS_H
@@ -1,4 +1,5 @@
 #include "libconfig/config_manager.h"
+#include "libtrace/startup_trace.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,6 +33,7 @@ const char* findConfigFile(void) {
         #endif
 
         FILE* configFile = fopen(possiblePaths[i], "r");
+        TRACE_POINT("config_probe");
         if (configFile) {
             fclose(configFile);
 
@@ -0,0 +1,103 @@
+// src/libconfig/config_store.cpp
+
+#include "libconfig/config_store.h"
+#include "libconfig/config_image.h"
+
+#include <climits>
+#include <utility>
+
+Config::Config(Config&& other) noexcept : store_(std::exchange(other.store_, nullptr)) {}
+
+Config& Config::operator=(Config&& other) noexcept {
+    if (this != &other) {
+        config_free(store_);
+        store_ = std::exchange(other.store_, nullptr);
+    }
+    return *this;
+}
+
+Config::~Config() {
+    config_free(store_);
+}
+
+Config Config::open(const char* path) noexcept {
+    return Config(config_open(path, nullptr));
+}
+
+std::string_view Config::view(const char* section, const char* name) const noexcept {
+    std::optional<std::string_view> value = get<std::string_view>(section, name);
+    return value ? *value : std::string_view();
+}
+
+template <>
+std::optional<std::string_view> Config::get(const char* section, const char* name) const noexcept {
+    size_t length;
+    const char* value = config_get(store_, section, name, &length);
+    if (value == nullptr) return std::nullopt;
+    return std::string_view(value, length);
+}
+
+template <>
+std::optional<std::int64_t> Config::get(const char* section, const char* name) const noexcept {
+    int64_t value;
+    if (config_get_int(store_, section, name, &value) != 0) return std::nullopt;
+    return value;
+}
+
+template <>
+std::optional<int> Config::get(const char* section, const char* name) const noexcept {
+    std::optional<std::int64_t> value = get<std::int64_t>(section, name);
+    if (!value || *value < INT_MIN || *value > INT_MAX) return std::nullopt;
+    return static_cast<int>(*value);
+}
+
+template <>
+std::optional<bool> Config::get(const char* section, const char* name) const noexcept {
+    int value;
+    if (config_get_bool(store_, section, name, &value) != 0) return std::nullopt;
+    return value != 0;
+}
+
+template <>
+std::optional<double> Config::get(const char* section, const char* name) const noexcept {
+    double value;
+    if (config_get_double(store_, section, name, &value) != 0) return std::nullopt;
+    return value;
+}
+
+template <>
+std::optional<std::chrono::microseconds> Config::get(const char* section, const char* name) const noexcept {
+    uint64_t value;
+    if (config_get_duration_us(store_, section, name, &value) != 0 || value > INT64_MAX) return std::nullopt;
+    return std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(value));
+}
+
+std::size_t Config::validate(const Key* keys, std::size_t count, Report report) const noexcept {
+    std::size_t problems = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        const Key& key = keys[i];
+        const char* problem = nullptr;
+
+        if (config_get(store_, key.section, key.name, nullptr) == nullptr) {
+            if (key.required) problem = "missing";
+        } else {
+            bool valid = true;
+            switch (key.type) {
+            case Type::String: break;
+            case Type::Int: valid = get<std::int64_t>(key).has_value(); break;
+            case Type::Bool: valid = get<bool>(key).has_value(); break;
+            case Type::Double: valid = get<double>(key).has_value(); break;
+            case Type::Duration: valid = get<std::chrono::microseconds>(key).has_value(); break;
+            }
+            if (!valid) problem = "malformed";
+        }
+
+        if (problem != nullptr) {
+            problems++;
+            if (report != nullptr) report(key, problem);
+        }
+    }
+
+    return problems;
+}
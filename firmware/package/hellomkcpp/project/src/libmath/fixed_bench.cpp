@@ -0,0 +1,169 @@
+// src/libmath/fixed_bench.cpp
+//
+// Fixed-point benchmark: operations per second of the Fixed<> types against
+// the same operation in double, plus the largest error against the double
+// result. On the soft-float target each double operation is a libgcc or libm
+// call. Run with "hellomkcpp --bench-fixed".
+
+#include "libmath/fixed.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+
+constexpr double kBenchSeconds = 0.3;
+constexpr int kValues = 1024;
+constexpr double kPi = 3.14159265358979323846;
+
+// The format is checked while compiling
+static_assert(Q15::fromDouble(0.5).raw() == 16384);
+static_assert((Q16_16::fromInt(3) * Q16_16::fromDouble(0.5)).raw() == 3 * 32768);
+static_assert(Q15::fromDouble(-1.0) * Q15::fromDouble(-1.0) == Q15::max(), "-1 * -1 saturates");
+static_assert(fixedCast<Q16_16>(Q15::fromDouble(-0.25)) == Q16_16::fromDouble(-0.25));
+static_assert(multiply<Q16_16>(Q15::fromDouble(0.5), Q16_16::fromInt(100)) == Q16_16::fromInt(50));
+
+enum class Op { Multiply, Divide, Sqrt, Sin, Atan2, Count };
+
+constexpr const char* kOpNames[] = {"mul (Q16.16)", "div (Q16.16)", "sqrt (Q16.16)", "sin (Q15)", "atan2"};
+constexpr const char* kErrorUnits[] = {"", "", "", "", " deg"};
+
+struct Operands {
+    std::array<Q16_16, kValues> fixedA, fixedB;
+    std::array<double, kValues> doubleA, doubleB;
+    std::array<fx_angle_t, kValues> angles;
+    std::array<double, kValues> radians;
+};
+
+double nowSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// atan2 pairs A with A reversed so (x, y) covers every quadrant.
+// One pass over the operands; returns a checksum so the work is not dropped
+double runOnce(const Operands& in, Op op, bool fixed) {
+    std::int64_t fixedSum = 0;
+    double doubleSum = 0;
+
+    for (int i = 0; i < kValues; i++) {
+        switch (op) {
+        case Op::Multiply:
+            if (fixed) fixedSum += (in.fixedA[i] * in.fixedB[i]).raw();
+            else doubleSum += in.doubleA[i] * in.doubleB[i];
+            break;
+        case Op::Divide:
+            if (fixed) fixedSum += (in.fixedA[i] / in.fixedB[i]).raw();
+            else doubleSum += in.doubleA[i] / in.doubleB[i];
+            break;
+        case Op::Sqrt:
+            if (fixed) fixedSum += fixedSqrt(in.fixedB[i]).raw();
+            else doubleSum += std::sqrt(in.doubleB[i]);
+            break;
+        case Op::Sin:
+            if (fixed) fixedSum += fixedSin(in.angles[i]).raw();
+            else doubleSum += std::sin(in.radians[i]);
+            break;
+        case Op::Atan2:
+            if (fixed) fixedSum += fixedAtan2(in.fixedA[i], in.fixedA[kValues - 1 - i]);
+            else doubleSum += std::atan2(in.doubleA[i], in.doubleA[kValues - 1 - i]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return fixed ? static_cast<double>(fixedSum) : doubleSum;
+}
+
+// Operations per second of <op>
+double measure(const Operands& in, Op op, bool fixed) {
+    unsigned long passes = 0;
+    volatile double sink = 0;
+    double start = nowSeconds(), elapsed;
+
+    do {
+        sink = sink + runOnce(in, op, fixed);
+        passes++;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < kBenchSeconds);
+
+    return static_cast<double>(passes) * kValues / elapsed;
+}
+
+// Largest difference from the double result, in the output's units
+double maxError(const Operands& in, Op op) {
+    double worst = 0;
+
+    for (int i = 0; i < kValues; i++) {
+        double error = 0;
+        switch (op) {
+        case Op::Multiply:
+            error = (in.fixedA[i] * in.fixedB[i]).toDouble() - in.doubleA[i] * in.doubleB[i];
+            break;
+        case Op::Divide:
+            error = (in.fixedA[i] / in.fixedB[i]).toDouble() - in.doubleA[i] / in.doubleB[i];
+            break;
+        case Op::Sqrt:
+            error = fixedSqrt(in.fixedB[i]).toDouble() - std::sqrt(in.doubleB[i]);
+            break;
+        case Op::Sin:
+            error = fixedSin(in.angles[i]).toDouble() - std::sin(in.radians[i]);
+            break;
+        case Op::Atan2: {
+            int j = kValues - 1 - i;
+            double expected = std::atan2(in.doubleA[i], in.doubleA[j]) * 180.0 / kPi;
+            error = fixedAtan2(in.fixedA[i], in.fixedA[j]) * 360.0 / 65536.0 - (expected < 0 ? expected + 360.0 : expected);
+            if (error > 180.0) error -= 360.0;
+            if (error < -180.0) error += 360.0;
+            break;
+        }
+        default:
+            break;
+        }
+        worst = std::fmax(worst, std::fabs(error));
+    }
+
+    return worst;
+}
+
+} // namespace
+
+int fixed_point_bench(void) {
+    static Operands in;
+    std::uint32_t seed = 0x9e3779b9u;
+
+    // Operands in [-100, 100) and (0, 100) so products and quotients stay in
+    // range; both types start from the same quantized values
+    for (int i = 0; i < kValues; i++) {
+        in.fixedA[i] = Q16_16::fromRaw(static_cast<std::int32_t>(nextRandom(seed) % (200u * Q16_16_ONE)) - 100 * Q16_16_ONE);
+        in.fixedB[i] = Q16_16::fromRaw(static_cast<std::int32_t>(nextRandom(seed) % (100u * Q16_16_ONE)) + 1);
+        in.doubleA[i] = in.fixedA[i].toDouble();
+        in.doubleB[i] = in.fixedB[i].toDouble();
+        in.angles[i] = static_cast<fx_angle_t>(nextRandom(seed));
+        in.radians[i] = in.angles[i] * 2.0 * kPi / 65536.0;
+    }
+
+    std::printf("Fixed-point benchmark, %d operands\n", kValues);
+    std::printf("  %-14s %14s %14s %8s %14s\n", "operation", "double Mop/s", "fixed Mop/s", "speedup", "max error");
+
+    for (int i = 0; i < static_cast<int>(Op::Count); i++) {
+        Op op = static_cast<Op>(i);
+        double floating = measure(in, op, false);
+        double fixed = measure(in, op, true);
+        std::printf("  %-14s %14.1f %14.1f %7.1fx %14.3g%s\n", kOpNames[i], floating / 1e6, fixed / 1e6, fixed / floating,
+                    maxError(in, op), kErrorUnits[i]);
+    }
+
+    return 0;
+}
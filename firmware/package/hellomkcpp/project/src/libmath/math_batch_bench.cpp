@@ -0,0 +1,194 @@
+// src/libmath/math_batch_bench.cpp
+//
+// Batch benchmark: elements per second of a loop over the scalar
+// MathOperations functions against the matching array overload, with the
+// results of both compared. The scalar divide() throws on a zero divisor,
+// which the loop catches per element. Run with "hellomkcpp --bench-math [n]".
+
+#include "libmath/math_batch.h"
+#include "libmath/math_operations.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <ctime>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr double kBenchSeconds = 0.3;
+
+enum class Op { Add, Multiply, MultiplyAdd, Divide, AddSaturated16, AddSaturated32, Count };
+
+constexpr const char* kOpNames[] = {
+    "add (int)", "mul (float)", "fma (float)", "div (float)", "add_sat (int16)", "add_sat (int32)",
+};
+
+struct BenchData {
+    explicit BenchData(std::size_t n)
+        : ia(n), ib(n), iout(n), iexpected(n), fa(n), fb(n), fc(n), fout(n), fexpected(n), sa(n), sb(n), sout(n),
+          sexpected(n), mask(MATH_MASK_BYTES(n)) {}
+
+    std::vector<int> ia, ib, iout, iexpected;
+    std::vector<float> fa, fb, fc, fout, fexpected;
+    std::vector<std::int16_t> sa, sb, sout, sexpected;
+    std::vector<std::uint8_t> mask;
+};
+
+double nowSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template <typename T, typename Wide>
+T clampTo(Wide value) {
+    return static_cast<T>(std::clamp<Wide>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+}
+
+// One pass over the arrays, through the scalar API or the batch API
+void runOnce(BenchData& d, Op op, bool batch) {
+    std::size_t n = d.ia.size();
+
+    switch (op) {
+    case Op::Add:
+        if (batch) MathOperations::add(d.ia.data(), d.ib.data(), d.iout.data(), n);
+        else for (std::size_t i = 0; i < n; i++) d.iout[i] = MathOperations::add(d.ia[i], d.ib[i]);
+        break;
+    case Op::Multiply:
+        if (batch) MathOperations::multiply(d.fa.data(), d.fb.data(), d.fout.data(), n);
+        else for (std::size_t i = 0; i < n; i++) d.fout[i] = static_cast<float>(MathOperations::multiply(d.fa[i], d.fb[i]));
+        break;
+    case Op::MultiplyAdd:
+        if (batch) MathOperations::multiplyAdd(d.fa.data(), d.fb.data(), d.fc.data(), d.fout.data(), n);
+        else for (std::size_t i = 0; i < n; i++)
+            d.fout[i] = static_cast<float>(MathOperations::multiply(d.fa[i], d.fb[i]) + d.fc[i]);
+        break;
+    case Op::Divide:
+        if (batch) {
+            MathOperations::divide(d.fa.data(), d.fb.data(), d.fout.data(), d.mask.data(), n);
+        } else {
+            for (std::size_t i = 0; i < n; i++) {
+                try {
+                    d.fout[i] = static_cast<float>(MathOperations::divide(d.fa[i], d.fb[i]));
+                } catch (const std::invalid_argument&) {
+                    d.fout[i] = 0.0f;
+                }
+            }
+        }
+        break;
+    case Op::AddSaturated16:
+        if (batch) MathOperations::addSaturated(d.sa.data(), d.sb.data(), d.sout.data(), n);
+        else for (std::size_t i = 0; i < n; i++) d.sout[i] = clampTo<std::int16_t>(MathOperations::add(d.sa[i], d.sb[i]));
+        break;
+    case Op::AddSaturated32:
+        if (batch) MathOperations::addSaturated(d.ia.data(), d.ib.data(), d.iout.data(), n);
+        else for (std::size_t i = 0; i < n; i++)
+            d.iout[i] = clampTo<std::int32_t>(static_cast<long long>(d.ia[i]) + d.ib[i]);
+        break;
+    default:
+        break;
+    }
+}
+
+// Elements per second of <op>
+double measure(BenchData& d, Op op, bool batch) {
+    unsigned long passes = 0;
+    double start = nowSeconds(), elapsed;
+
+    do {
+        runOnce(d, op, batch);
+        passes++;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < kBenchSeconds);
+
+    return static_cast<double>(passes) * static_cast<double>(d.ia.size()) / elapsed;
+}
+
+// Elements where the batch result differs from the scalar one. Float results
+// are compared exactly except fma, which may skip the intermediate rounding.
+std::size_t compare(const BenchData& d, Op op) {
+    std::size_t mismatches = 0;
+
+    for (std::size_t i = 0; i < d.ia.size(); i++) {
+        switch (op) {
+        case Op::Add:
+        case Op::AddSaturated32:
+            mismatches += d.iexpected[i] != d.iout[i];
+            break;
+        case Op::AddSaturated16:
+            mismatches += d.sexpected[i] != d.sout[i];
+            break;
+        case Op::MultiplyAdd:
+            mismatches += std::abs(d.fexpected[i] - d.fout[i]) > 1e-3f;
+            break;
+        default:
+            mismatches += d.fexpected[i] != d.fout[i];
+            break;
+        }
+    }
+
+    return mismatches;
+}
+
+} // namespace
+
+int math_batch_bench(std::size_t n) {
+    if (n == 0) return 1;
+
+    BenchData d(n);
+    std::uint32_t seed = 0x2545f491u;
+    std::size_t zeros = 0, failures = 0;
+
+    // Wide int ranges so the saturating paths clamp; one divisor in 64 is
+    // zero. The plain int operands are halved so scalar add() cannot overflow.
+    for (std::size_t i = 0; i < n; i++) {
+        d.ia[i] = static_cast<int>(nextRandom(seed)) / 2;
+        d.ib[i] = static_cast<int>(nextRandom(seed)) / 2;
+        d.sa[i] = static_cast<std::int16_t>(nextRandom(seed));
+        d.sb[i] = static_cast<std::int16_t>(nextRandom(seed));
+        d.fa[i] = static_cast<float>(nextRandom(seed) % 20001) / 100.0f - 100.0f;
+        d.fb[i] = nextRandom(seed) % 64 == 0 ? 0.0f : static_cast<float>(nextRandom(seed) % 2000 + 1) / 100.0f;
+        d.fc[i] = static_cast<float>(nextRandom(seed) % 1001) / 10.0f;
+        zeros += d.fb[i] == 0.0f;
+    }
+
+    std::printf("Batch math benchmark, %zu elements (%zu zero divisors)\n", n, zeros);
+    std::printf("  %-16s %14s %14s %8s %10s\n", "operation", "scalar Mel/s", "batch Mel/s", "speedup", "mismatch");
+
+    for (int i = 0; i < static_cast<int>(Op::Count); i++) {
+        Op op = static_cast<Op>(i);
+        double scalar = measure(d, op, false);
+        runOnce(d, op, false);
+        d.iexpected = d.iout;
+        d.fexpected = d.fout;
+        d.sexpected = d.sout;
+
+        double batch = measure(d, op, true);
+        std::size_t mismatches = compare(d, op);
+        failures += mismatches;
+
+        std::printf("  %-16s %14.1f %14.1f %7.1fx %10zu\n", kOpNames[i], scalar / 1e6, batch / 1e6, batch / scalar,
+                    mismatches);
+    }
+
+    // The mask must flag exactly the zero divisors
+    std::size_t flagged = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        bool bit = (d.mask[i / 8] >> (i % 8)) & 1;
+        flagged += bit;
+        failures += bit != (d.fb[i] == 0.0f);
+    }
+    std::printf("  divide-by-zero mask flagged %zu/%zu\n", flagged, zeros);
+
+    return failures ? 1 : 0;
+}
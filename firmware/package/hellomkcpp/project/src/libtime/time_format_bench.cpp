@@ -0,0 +1,121 @@
+// src/libtime/time_format_bench.cpp
+//
+// Timestamp benchmark: formats per second of TimeOperations::currentTime()
+// (stringstream + put_time), a naive localtime_r() + snprintf() ISO-8601
+// formatter and TimeOperations::Formatter, both within one second (the
+// logging case) and with a new second on every call. Run with
+// "hellomkcpp --bench-time".
+
+#include "libtime/time_format.h"
+#include "libtime/time_operations.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+constexpr double kBenchSeconds = 0.5;
+constexpr int kBatch = 1000;
+constexpr unsigned int kChecks = 100000;
+
+double nowSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+// What a caller without the cache would write
+std::size_t naiveIso8601(const timespec& ts, char* buf, std::size_t size) {
+    std::tm tm;
+    localtime_r(&ts.tv_sec, &tm);
+    std::size_t length = std::strftime(buf, size, "%Y-%m-%dT%H:%M:%S", &tm);
+    return length + static_cast<std::size_t>(std::snprintf(buf + length, size - length, ".%06ld", ts.tv_nsec / 1000));
+}
+
+enum class Case { CurrentTime, Naive, FormatterNow, FormatterNewSecond };
+
+constexpr const char* kCaseNames[] = {
+    "currentTime() (stringstream)",
+    "localtime_r+strftime+snprintf",
+    "Formatter::now() (6 digits)",
+    "Formatter::format(), new second",
+};
+
+// Run <which> for kBenchSeconds and return formats per second
+double runCase(Case which) {
+    TimeOperations::Formatter formatter(6);
+    char buf[TIME_FORMAT_MAX_LENGTH];
+    timespec ts;
+    unsigned long calls = 0;
+    volatile char sink = 0;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    double start = nowSeconds(), elapsed;
+    do {
+        for (int i = 0; i < kBatch; i++) {
+            switch (which) {
+            case Case::CurrentTime:
+                sink = sink ^ TimeOperations::currentTime()[18];
+                break;
+            case Case::Naive:
+                clock_gettime(CLOCK_REALTIME, &ts);
+                naiveIso8601(ts, buf, sizeof(buf));
+                sink = sink ^ buf[20];
+                break;
+            case Case::FormatterNow:
+                formatter.now(buf, sizeof(buf));
+                sink = sink ^ buf[20];
+                break;
+            case Case::FormatterNewSecond:
+                ts.tv_sec++;
+                formatter.format(ts, buf, sizeof(buf));
+                sink = sink ^ buf[20];
+                break;
+            }
+        }
+        calls += kBatch;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < kBenchSeconds);
+
+    return static_cast<double>(calls) / elapsed;
+}
+
+// The cached formatter must agree with strftime() over a day of seconds
+unsigned long checkAgainstStrftime() {
+    TimeOperations::Formatter formatter(6);
+    char expected[TIME_FORMAT_MAX_LENGTH];
+    unsigned long mismatches = 0;
+    timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    for (unsigned int i = 0; i < kChecks; i++) {
+        ts.tv_sec += i % 3 == 0;
+        ts.tv_nsec = static_cast<long>(i * 7919UL % 1000000000UL);
+        std::size_t length = naiveIso8601(ts, expected, sizeof(expected));
+        if (formatter.format(ts).substr(0, length) != std::string_view(expected, length)) mismatches++;
+    }
+
+    return mismatches;
+}
+
+} // namespace
+
+int time_format_bench(void) {
+    TimeOperations::Formatter formatter(6);
+    std::string_view sample = formatter.now();
+    std::printf("Timestamp benchmark, sample \"%.*s\"\n", static_cast<int>(sample.size()), sample.data());
+
+    unsigned long mismatches = checkAgainstStrftime();
+    std::printf("  %-36s %lu/%u\n", "mismatches against strftime", mismatches, kChecks);
+
+    double baseline = 0;
+    for (int which = 0; which <= static_cast<int>(Case::FormatterNewSecond); which++) {
+        double rate = runCase(static_cast<Case>(which));
+        if (which == 0) baseline = rate;
+        std::printf("  %-36s %10.0f formats/s  %5.1fx\n", kCaseNames[which], rate, rate / baseline);
+    }
+
+    return mismatches ? 1 : 0;
+}
@@ -10,8 +10,10 @@
 std::string TimeOperations::currentTime() {
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    std::tm local{};
+    localtime_r(&now_c, &local); // std::localtime() shares one static std::tm
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
     return ss.str();
 }
 
@@ -2,58 +2,195 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <poll.h>
 
 #include "libmath/math_operations.h"
+#include "libmath/fixed_point.h"
 #include "libtime/time_operations.h"
 #include "libconfig/config_manager.h"
+#include "libconfig/config.h"
+#include "libconfig/config_image.h"
+#include "libconfig/config_watch.h"
+#include "libconfig/config_store.h"
+#include "libtrace/startup_trace.h"
+
+#define BENCH_DEFAULT_KEYS 10000
+#define STRESS_DEFAULT_THREADS 4
+#define STRESS_DEFAULT_SECONDS 5
+#define RELOAD_DEFAULT_READERS 2
+#define RELOAD_DEFAULT_COUNT 100
+#define MATH_BENCH_DEFAULT_ELEMENTS 4096
+
+// Keys this program expects, checked once when the file is loaded
+static constexpr std::array<Config::Key, 4> kSchema{{
+    {"database", "host", Config::Type::String, true},
+    {"database", "user", Config::Type::String, true},
+    {"server", "port", Config::Type::Int, true},
+    {"server", "enable_logging", Config::Type::Bool, false},
+}};
+static_assert(Config::unique(kSchema), "duplicate key in the configuration schema");
+
+static constexpr std::array<const char*, kSchema.size()> kLabels{{
+    "Database Host", "Database User", "Server Port", "Enable Logging",
+}};
+
+static void reportSchemaError(const Config::Key& key, const char* problem) {
+    std::cerr << "Error: key '" << key.name << "' in section '" << key.section << "' is " << problem << std::endl;
+}
+
+// Print one value of the schema according to its type
+static void printKey(const Config& cfg, const char* label, const Config::Key& key) {
+    std::cout << label << ": ";
+    switch (key.type) {
+    case Config::Type::Int:
+        std::cout << cfg.get<std::int64_t>(key).value_or(0);
+        break;
+    case Config::Type::Bool:
+        std::cout << (cfg.get<bool>(key).value_or(false) ? "true" : "false");
+        break;
+    case Config::Type::Double:
+        std::cout << cfg.get<double>(key).value_or(0.0);
+        break;
+    case Config::Type::Duration:
+        std::cout << cfg.get<std::chrono::microseconds>(key).value_or(std::chrono::microseconds(0)).count() << " us";
+        break;
+    default:
+        std::cout << cfg.view(key.section, key.name);
+        break;
+    }
+    std::cout << std::endl;
+}
+
+// Print one configuration value or a not-found message
+static void printValue(const config_t* cfg, const char* label, const char* section, const char* key) {
+    size_t length;
+    const char* value = config_get(cfg, section, key, &length);
+    if (value != nullptr) {
+        std::cout << label << ": ";
+        std::cout.write(value, static_cast<std::streamsize>(length)) << std::endl;
+    } else {
+        std::cout << "Key '" << key << "' not found in section '" << section << "'" << std::endl;
+    }
+}
+
+// Print the configuration, then again every time the file changes
+static int watchConfig(const char* configFile) {
+    config_watch_t* watch = config_watch_open(configFile);
+    if (watch == nullptr) {
+        std::perror(configFile);
+        return 1;
+    }
+
+    struct pollfd pfd = {config_watch_fd(watch), POLLIN, 0};
+    for (;;) {
+        config_snapshot_t snap = config_watch_acquire(watch);
+        std::cout << "Configuration generation " << config_watch_generation(watch) << ":" << std::endl;
+        printValue(snap.cfg, "  Database Host", "database", "host");
+        printValue(snap.cfg, "  Server Port", "server", "port");
+        config_watch_release(watch, snap);
+
+        // Block until the file changes and a new snapshot is published
+        int published = 0;
+        while (published == 0) {
+            if (poll(&pfd, 1, -1) < 0) {
+                std::perror("poll");
+                config_watch_close(watch);
+                return 1;
+            }
+            published = config_watch_dispatch(watch);
+            if (published < 0) {
+                std::perror("Reload failed, keeping previous configuration");
+                published = 0;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Host benchmark of the configuration store
+    if (argc >= 2 && std::string(argv[1]) == "--bench-config") {
+        unsigned int keys = argc >= 3 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : BENCH_DEFAULT_KEYS;
+        return config_bench(keys, getConfigValue);
+    }
+
+    // Cold start through the binary image against parsing the INI
+    if (argc >= 2 && std::string(argv[1]) == "--bench-cache") {
+        unsigned int keys = argc >= 3 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : BENCH_DEFAULT_KEYS;
+        return config_image_bench(keys);
+    }
+
+    // Multithreaded stress test of the configuration store
+    if (argc >= 2 && std::string(argv[1]) == "--stress-config") {
+        unsigned int threads = argc >= 3 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : STRESS_DEFAULT_THREADS;
+        unsigned int seconds = argc >= 4 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : STRESS_DEFAULT_SECONDS;
+        return config_stress(threads, seconds);
+    }
+
+    // Reader overhead and reload latency of the hot-reloading store
+    if (argc >= 2 && std::string(argv[1]) == "--bench-reload") {
+        unsigned int readers = argc >= 3 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : RELOAD_DEFAULT_READERS;
+        unsigned int reloads = argc >= 4 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : RELOAD_DEFAULT_COUNT;
+        return config_watch_bench(readers, reloads);
+    }
+
+    // Host benchmark of the timestamp formatters
+    if (argc >= 2 && std::string(argv[1]) == "--bench-time") {
+        return time_format_bench();
+    }
+
+    // Scalar against batch throughput of libmath
+    if (argc >= 2 && std::string(argv[1]) == "--bench-math") {
+        std::size_t elements = argc >= 3 ? static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10)) : MATH_BENCH_DEFAULT_ELEMENTS;
+        return math_batch_bench(elements);
+    }
+
+    // Fixed-point against double throughput and accuracy
+    if (argc >= 2 && std::string(argv[1]) == "--bench-fixed") {
+        return fixed_point_bench();
+    }
 
-int main() {
     // Math operations example
     int a = 10, b = 5;
     std::cout << "Addition: " << MathOperations::add(a, b) << std::endl;
 
     // Time operations example
     std::cout << "Current Time: " << TimeOperations::currentTime() << std::endl;
+    TimeOperations::Formatter timestamp(3);
+    std::cout << "Timestamp: " << timestamp.now() << std::endl;
 
     // Configuration example (load from a hypothetical config file)
     const char* configFile = findConfigFile();
+    TRACE_POINT("config_find");
     if (configFile == nullptr) {
         std::cerr << "Error: Configuration file not found." << std::endl;
         exit(1);  // Terminate the program with an error status
     }
     std::cout << "Configuration file: " << configFile << std::endl;
 
-    // Retrieve and print config values using C++ string and iostream
-    std::string dbHost = getConfigValue(configFile, "database", "host");
-    if (!dbHost.empty()) {
-        std::cout << "Database Host: " << dbHost << std::endl;
-    } else {
-        std::cout << "Key 'host' not found in section 'database'" << std::endl;
+    // Keep running and follow edits to the file
+    if (argc >= 2 && std::string(argv[1]) == "--watch") {
+        return watchConfig(configFile);
     }
 
-    std::string serverPort = getConfigValue(configFile, "server", "port");
-    if (!serverPort.empty()) {
-        std::cout << "Server Port: " << serverPort << std::endl;
-    } else {
-        std::cout << "Key 'port' not found in section 'server'" << std::endl;
+    // Map the binary image if it is current, otherwise parse the file once,
+    // and check every expected key up front
+    Config cfg = Config::load(configFile, kSchema, reportSchemaError);
+    if (!cfg) {
+        std::cerr << "Error: Failed to load " << configFile << std::endl;
+        exit(1);
     }
+    TRACE_POINT("config_load");
 
-    std::string dbUser = getConfigValue(configFile, "database", "user");
-    if (!dbUser.empty()) {
-        std::cout << "Database User: " << dbUser << std::endl;
-    } else {
-        std::cout << "Key 'user' not found in section 'database'" << std::endl;
-    }
-
-    std::string enableLogging = getConfigValue(configFile, "server", "enable_logging");
-    if (!enableLogging.empty()) {
-        std::cout << "Enable Logging: " << enableLogging << std::endl;
-    } else {
-        std::cout << "Key 'enable_logging' not found in section 'server'" << std::endl;
+    // Values are views into the store or typed values cached by it
+    for (std::size_t i = 0; i < kSchema.size(); i++) {
+        printKey(cfg, kLabels[i], kSchema[i]);
+        TRACE_FIRST_IO("config_get");
     }
 
     // Normal execution
     std::cout << "Program finished successfully." << std::endl;
-    //return 0; // Normal termination
-    exit(0);
+    return 0; // Normal termination, releases the configuration
 }
@@ -0,0 +1,133 @@
+// tests/config_alloc_test.cpp
+//
+// Host test: after Config::load() no accessor may allocate. Counts every
+// operator new and, through -Wl,--wrap, every malloc/calloc/realloc made by
+// the configuration code. Run with "make test".
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <unistd.h>
+
+#include "libconfig/config_store.h"
+#include "libconfig/config_image.h"
+
+static unsigned long allocations = 0;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = __real_malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocations++;
+    return __real_malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static constexpr std::array<Config::Key, 6> kSchema{{
+    {"database", "host", Config::Type::String, true},
+    {"server", "port", Config::Type::Int, true},
+    {"server", "enable_logging", Config::Type::Bool, true},
+    {"server", "load_factor", Config::Type::Double, true},
+    {"server", "timeout", Config::Type::Duration, true},
+    {"server", "missing", Config::Type::String, false},
+}};
+static_assert(Config::unique(kSchema), "duplicate key in the test schema");
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+int main() {
+    char path[64];
+    std::snprintf(path, sizeof(path), "/tmp/config_alloc_test-%d.ini", static_cast<int>(getpid()));
+
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        std::perror(path);
+        return 1;
+    }
+    std::fputs("[database]\nhost = localhost\n\n"
+               "[server]\nport = 8080\nenable_logging = yes\nload_factor = 0.75\ntimeout = 250ms\n", file);
+    std::fclose(file);
+
+    unsigned long beforeLoad = allocations;
+    Config cfg = Config::load(path, kSchema);
+    unsigned long afterLoad = allocations;
+    check(static_cast<bool>(cfg), "load with a valid schema");
+
+    // Every accessor, many times, including misses and malformed reads
+    unsigned long checksum = 0;
+    for (int round = 0; round < 10000; round++) {
+        checksum += cfg.view("database", "host").size();
+        checksum += static_cast<unsigned long>(cfg.get<int>("server", "port").value_or(0));
+        checksum += cfg.get<std::int64_t>(kSchema[1]).has_value();
+        checksum += cfg.get<bool>(kSchema[2]).value_or(false);
+        checksum += static_cast<unsigned long>(cfg.get<double>(kSchema[3]).value_or(0.0) * 4);
+        checksum += static_cast<unsigned long>(cfg.get<std::chrono::microseconds>(kSchema[4])->count());
+        checksum += cfg.get<std::string_view>("server", "missing").has_value();
+        checksum += cfg.get<int>("database", "host").has_value();
+        checksum += cfg.validate(kSchema.data(), kSchema.size());
+    }
+    unsigned long afterLookups = allocations;
+
+    check(checksum == 10000ul * (9 + 8080 + 1 + 1 + 3 + 250000), "values read back");
+    check(afterLookups == afterLoad, "no allocations after load");
+
+    // A malformed key must fail the load
+    static constexpr std::array<Config::Key, 1> kBad{{{"database", "host", Config::Type::Int, true}}};
+    check(!Config::load(path, kBad), "malformed key rejected at load");
+
+    std::printf("Config::load: %lu allocations\n", afterLoad - beforeLoad);
+    std::printf("10000 rounds of lookups: %lu allocations\n", afterLookups - afterLoad);
+
+    char imagePath[80];
+    std::snprintf(imagePath, sizeof(imagePath), "%s" CONFIG_IMAGE_SUFFIX, path);
+    unlink(imagePath);
+    unlink(path);
+
+    std::printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
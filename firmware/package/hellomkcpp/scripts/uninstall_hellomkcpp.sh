@@ -1,4 +1,5 @@
 #!/bin/bash
 echo "Removing hellomkcpp from target..."
 rm -f $(TARGET_DIR)/usr/bin/hellomkcpp
-rm -f $(TARGET_DIR)/etc/hellomkcpp.ini
\ No newline at end of file
+rm -f $(TARGET_DIR)/etc/hellomkcpp.ini
+rm -f $(TARGET_DIR)/etc/hellomkcpp.ini.cache
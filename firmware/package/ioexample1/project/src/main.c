@@ -7,6 +7,7 @@
 #include <errno.h>
 
 #include "periphery/led.h"
+#include "libtrace/startup_trace.h"
 
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
@@ -78,6 +79,7 @@ int main(void)
     unsigned int max_brightness;
 
     clear_led_trigger(LED_NAME);
+    TRACE_POINT("led_trigger");
 
     printf("Creating LED object...\n");
     led = led_new();
@@ -94,6 +96,7 @@ int main(void)
         led_free(led);
         exit(1);
     }
+    TRACE_POINT("led_open");
     printf("LED '%s' opened successfully.\n", LED_NAME);
 
     if (led_get_max_brightness(led, &max_brightness) < 0)
@@ -103,6 +106,7 @@ int main(void)
         led_free(led);
         exit(1);
     }
+    TRACE_FIRST_IO("led_get_max_brightness");
 
     char input[16];
     while (true)
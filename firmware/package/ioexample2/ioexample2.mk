@@ -9,21 +9,18 @@ IOEXAMPLE2_VERSION = 1.0
 IOEXAMPLE2_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/ioexample2/project
 IOEXAMPLE2_SITE_METHOD = local
 
-# Use cross-compiler for detection
-IOEXAMPLE2_NULL := $(if $(filter Windows_NT,$(OS)),NUL,/dev/null)
-IOEXAMPLE2_GPIO_CDEV_V1_SUPPORT := $(shell ! env printf "\x23include <linux/gpio.h>\n\x23ifndef GPIO_GET_LINEEVENT_IOCTL\n\x23error\n\x23endif" | $(TARGET_CC) -E - >$(IOEXAMPLE2_NULL) 2>&1; echo $$?)
-IOEXAMPLE2_GPIO_CDEV_V2_SUPPORT := $(shell ! env printf "\x23include <linux/gpio.h>\nint main(void) { GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME; return 0; }" | $(TARGET_CC) -x c - >$(IOEXAMPLE2_NULL) 2>&1; echo $$?)
-IOEXAMPLE2_GPIO_CDEV_SUPPORT = $(if $(filter 1,$(IOEXAMPLE2_GPIO_CDEV_V2_SUPPORT)),2,$(if $(filter 1,$(IOEXAMPLE2_GPIO_CDEV_V1_SUPPORT)),1,0))
-
-IOEXAMPLE2_DEFINES += -DPERIPHERY_GPIO_CDEV_SUPPORT=$(IOEXAMPLE2_GPIO_CDEV_SUPPORT)
-
+# c-periphery and the event loop come from the libperiphery and libevloop
+# packages; main() reports which GPIO character device ABI the library was
+# built for
+IOEXAMPLE2_DEPENDENCIES = libevloop libperiphery libtrace
+IOEXAMPLE2_DEFINES += -DPERIPHERY_GPIO_CDEV_SUPPORT=$(LIBPERIPHERY_GPIO_CDEV_SUPPORT)
 
 # Build commands
 define IOEXAMPLE2_BUILD_CMDS
 	$(MAKE) \
 		CC="$(TARGET_CC)" \
 		CFLAGS="$(TARGET_CFLAGS) $(IOEXAMPLE2_DEFINES)" \
-		LDFLAGS="$(TARGET_LDFLAGS)" \
+		LDFLAGS="$(TARGET_LDFLAGS) $(LIBPERIPHERY_LDFLAGS)" \
 		-C $(@D)
 endef
 
@@ -3,14 +3,19 @@
 #include <stdbool.h>
 #include <unistd.h>
 #include <termios.h>
-#include <fcntl.h>
+#include <sys/epoll.h>
 
 #include "periphery/gpio.h"
+#include "libevloop/evloop.h"
+#include "libtrace/startup_trace.h"
 
 #define GREEN_LED_GPIO "G13"
 #define RED_LED_GPIO "G14"
 #define BUTTON_GPIO "A0"
 
+#define POLL_INTERVAL_US 100000 // Button sampling period without edge events
+#define DEBOUNCE_US 10000       // Contact bounce the kernel filters out
+
 void GPIO_CHIP(const char *gpio_str, char *buf, size_t bufsize)
 {
     if (gpio_str == NULL || buf == NULL || bufsize == 0)
@@ -37,38 +42,88 @@ int GPIO_LINE(const char *gpio_str)
     return atoi(&gpio_str[1]);
 }
 
-// Non-blocking terminal key check
-int kbhit(void)
+typedef struct
+{
+    gpio_t *button;
+    gpio_t *led;
+    evloop_timer_t poll_timer;
+    evloop_io_t button_events;
+    evloop_io_t keyboard;
+    int status;
+} app_t;
+
+// Switch the terminal to unbuffered input without echo
+static int terminal_raw(struct termios *saved)
 {
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
+    struct termios raw;
 
-    // Save terminal settings
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
+    if (tcgetattr(STDIN_FILENO, saved) < 0)
+        return -1;
 
-    // Disable canonical mode and echo
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+    raw = *saved;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    return tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+}
 
-    // Set non-blocking input
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
+// Timer: mirror the button on the LED, periodically when sampling
+static void poll_button(evloop_t *loop, evloop_timer_t *timer, void *arg)
+{
+    app_t *app = arg;
+    bool button_value;
 
-    ch = getchar();
+    (void)timer;
 
-    // Restore terminal settings
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
+    if (gpio_read(app->button, &button_value) < 0)
+    {
+        fprintf(stderr, "gpio_read(): %s\n", gpio_errmsg(app->button));
+        app->status = 1;
+        evloop_stop(loop);
+        return;
+    }
 
-    if (ch != EOF)
+    if (gpio_write(app->led, button_value) < 0)
     {
-        ungetc(ch, stdin);
-        return 1;
+        fprintf(stderr, "gpio_write(): %s\n", gpio_errmsg(app->led));
+        app->status = 1;
+        evloop_stop(loop);
+        return;
     }
 
-    return 0;
+    /* The button is mirrored on the LED for the first time */
+    TRACE_FIRST_IO("gpio_write");
+}
+
+// Edge event of the debounced button: consume it and mirror the new state
+static void button_changed(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg)
+{
+    app_t *app = arg;
+
+    (void)io;
+    (void)events;
+
+    if (gpio_read_event(app->button, NULL, NULL) < 0)
+    {
+        fprintf(stderr, "gpio_read_event(): %s\n", gpio_errmsg(app->button));
+        app->status = 1;
+        evloop_stop(loop);
+        return;
+    }
+
+    poll_button(loop, &app->poll_timer, app);
+}
+
+// Any key on stdin ends the loop
+static void key_pressed(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg)
+{
+    char ch;
+
+    (void)events;
+    (void)arg;
+    if (read(io->fd, &ch, 1) != 0)
+        printf("Key pressed. Exiting loop...\n");
+    evloop_stop(loop);
 }
 
 // Helper macros for stringifying macro values
@@ -112,14 +167,42 @@ int main(void)
         exit(1);
     }
 
-    printf("Opening button GPIO: chip='%s', line=%d, direction=IN\n", button_chip, button_line);
-    if (gpio_open(button_gpio, button_chip, button_line, GPIO_DIR_IN) < 0)
+    // The kernel debounces the button and wakes us once per press and
+    // release. Where that fails (v1 GPIO ABI, no debounce support, ...)
+    // the button still wakes us on edges, and without edge events it is
+    // sampled
+    gpio_config_t button_config = {
+        .direction = GPIO_DIR_IN,
+        .edge = GPIO_EDGE_BOTH,
+        .event_clock = GPIO_EVENT_CLOCK_MONOTONIC,
+        .debounce_us = DEBOUNCE_US,
+    };
+    bool button_events = true;
+    int ret;
+
+    printf("Opening button GPIO: chip='%s', line=%d, direction=IN, debounce=%u us\n", button_chip, button_line, DEBOUNCE_US);
+    ret = gpio_open_advanced(button_gpio, button_chip, button_line, &button_config);
+    if (ret < 0)
+    {
+        printf("No kernel debounce (%s), using plain edge events\n", gpio_errmsg(button_gpio));
+        button_config.event_clock = GPIO_EVENT_CLOCK_REALTIME;
+        button_config.debounce_us = 0;
+        ret = gpio_open_advanced(button_gpio, button_chip, button_line, &button_config);
+    }
+    if (ret < 0)
+    {
+        printf("No edge events (%s), sampling the button instead\n", gpio_errmsg(button_gpio));
+        button_events = false;
+        ret = gpio_open(button_gpio, button_chip, button_line, GPIO_DIR_IN);
+    }
+    if (ret < 0)
     {
         fprintf(stderr, "gpio_open(button): %s\n", gpio_errmsg(button_gpio));
         gpio_free(button_gpio);
         gpio_free(led_gpio);
         exit(1);
     }
+    TRACE_POINT("gpio_open");
 
     printf("Opening LED GPIO: chip='%s', line=%d, direction=OUT\n", led_chip, led_line);
     if (gpio_open(led_gpio, led_chip, led_line, GPIO_DIR_OUT) < 0)
@@ -130,33 +213,54 @@ int main(void)
         gpio_free(led_gpio);
         exit(1);
     }
+    TRACE_POINT("gpio_open");
 
-    printf("Reading button state, showing on LED...\n");
-    printf("Press any key in the terminal to exit.\n");
+    static evloop_t loop;
+    app_t app = {.button = button_gpio, .led = led_gpio, .status = 0};
+    struct termios saved_termios;
+    bool raw = false;
 
-    bool button_value;
-    while (1)
+    if (evloop_init(&loop, 0) < 0)
     {
-        if (gpio_read(button_gpio, &button_value) < 0)
-        {
-            fprintf(stderr, "gpio_read(): %s\n", gpio_errmsg(button_gpio));
-            break;
-        }
+        perror("evloop_init");
+        exit(1);
+    }
 
-        if (gpio_write(led_gpio, button_value) < 0)
-        {
-            fprintf(stderr, "gpio_write(): %s\n", gpio_errmsg(led_gpio));
-            break;
-        }
+    // With edge events the timer only sets the LED once at startup
+    evloop_timer_init(&app.poll_timer, poll_button, &app);
+    evloop_timer_start(&loop, &app.poll_timer, 0, button_events ? 0 : POLL_INTERVAL_US);
 
-        if (kbhit())
+    if (button_events)
+    {
+        evloop_io_init(&app.button_events, gpio_fd(button_gpio), button_changed, &app);
+        if (evloop_io_add(&loop, &app.button_events, EPOLLIN) < 0)
         {
-            printf("Key pressed. Exiting loop...\n");
-            break;
+            perror("evloop_io_add(button)");
+            exit(1);
         }
+    }
 
-        usleep(100000);
+    evloop_io_init(&app.keyboard, STDIN_FILENO, key_pressed, &app);
+    printf("Reading button state, showing on LED...\n");
+    if (evloop_io_add(&loop, &app.keyboard, EPOLLIN) == 0)
+    {
+        raw = terminal_raw(&saved_termios) == 0;
+        printf("Press any key in the terminal to exit.\n");
     }
+    else
+    {
+        printf("stdin cannot be polled, press Ctrl+C to exit.\n");
+    }
+
+    if (evloop_run(&loop) < 0)
+    {
+        perror("evloop_run");
+        app.status = 1;
+    }
+
+    if (raw)
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+    evloop_close(&loop);
 
     gpio_close(button_gpio);
     gpio_close(led_gpio);
@@ -164,5 +268,5 @@ int main(void)
     gpio_free(led_gpio);
 
     printf("Cleanup done, exiting.\n");
-    return 0;
+    return app.status;
 }
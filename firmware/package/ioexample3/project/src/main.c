@@ -4,6 +4,7 @@
 #include <unistd.h>
 
 #include "periphery/i2c.h"
+#include "libtrace/startup_trace.h"
 
 int main()
 {
@@ -17,6 +18,7 @@ int main()
         fprintf(stderr, "Failed to open I2C bus: %s\n", i2c_errmsg(i2c));
         return 1;
     }
+    TRACE_POINT("i2c_open");
 
     printf("Scanning I2C bus %s...\n", i2c_path);
 
@@ -30,6 +32,7 @@ int main()
         msg.buf = NULL;
 
         ret = i2c_transfer(i2c, &msg, 1);
+        TRACE_FIRST_IO("i2c_transfer");
         if (ret == 0)
         {
             printf("Device found at address 0x%02X\n", addr);
@@ -2,12 +2,16 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <stdbool.h>
 #include <termios.h>
-#include <fcntl.h>
-#include <sys/select.h>
 #include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
 
 #include "periphery/spi.h"
+#include "libdsp/dsp.h"
+#include "libevloop/evloop.h"
+#include "libtrace/startup_trace.h"
 
 /* -------------------- Configuration -------------------- */
 #define SPI_DEVICE "/dev/spidev0.0"
@@ -19,6 +23,10 @@
 #define REG_TEMP 0x26
 #define REG_OUT_X_L 0x28
 
+#define SETTLE_US 100000    /* Power-up time before the first readout */
+#define SMOOTH_WINDOW 8     /* Readouts averaged per axis */
+#define BENCH_SECONDS 1.0
+
 /* -------------------- Utility Functions -------------------- */
 
 /**
@@ -83,98 +91,91 @@ static int spi_read_multi(spi_t *spi, uint8_t start_reg, uint8_t *buf, size_t le
 }
 
 /**
- * @brief Check if a key has been pressed (non-blocking).
+ * @brief Switch the terminal to unbuffered input without echo.
  *
- * @return 1 if a key was pressed, 0 otherwise.
+ * @param saved Receives the previous settings.
+ * @return 0 on success, -1 if stdin is not a terminal.
  */
-static int kbhit(void)
+static int terminal_raw(struct termios *saved)
 {
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
+    struct termios raw;
 
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
+    if (tcgetattr(STDIN_FILENO, saved) < 0)
+        return -1;
 
-    ch = getchar();
+    raw = *saved;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    return tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+}
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
+/* -------------------- Event Handlers -------------------- */
 
-    if (ch != EOF)
-    {
-        ungetc(ch, stdin);
-        return 1;
-    }
-    return 0;
-}
+typedef struct app {
+    spi_t *spi;
+    uint8_t whoami;
+    dsp_movavg_t smooth[3];
+    evloop_timer_t sample_timer;
+    evloop_io_t keyboard;
+    int status;
+} app_t;
 
 /**
- * @brief Delay execution for a specified number of microseconds.
- *
- * @param us Delay duration in microseconds.
+ * @brief Sample timer: read temperature and XYZ, print raw and smoothed.
  */
-void delay_us(unsigned int us)
+static void sample_sensor(evloop_t *loop, evloop_timer_t *timer, void *arg)
 {
-    struct timeval tv;
-    tv.tv_sec = us / 1000000;
-    tv.tv_usec = us % 1000000;
+    app_t *app = arg;
+    uint8_t temp_raw;
+    uint8_t buf[6];
+
+    (void)timer;
 
-    while (select(0, NULL, NULL, NULL, &tv) == -1)
+    if (spi_read_register(app->spi, REG_TEMP, &temp_raw) < 0)
     {
-        if (errno == EINTR)
-        {
-            printf("Sleep interrupted, retrying...\n");
-            continue;
-        }
-        else
-        {
-            perror("select");
-            exit(EXIT_FAILURE);
-        }
+        fprintf(stderr, "\nError: Failed to read temperature register\n");
+        goto fail;
     }
-}
 
-/**
- * @brief Wait for a delay or stop if a key is pressed.
- *
- * @param us Delay duration in microseconds.
- * @return 1 if a key was pressed, 0 if timeout elapsed.
- */
-int delay_or_keypress(unsigned int us)
-{
-    struct timeval tv;
-    fd_set readfds;
-    int retval;
+    if (spi_read_multi(app->spi, REG_OUT_X_L, buf, sizeof(buf)) < 0)
+    {
+        fprintf(stderr, "\nError: Failed to read gyro XYZ registers\n");
+        goto fail;
+    }
 
-    tv.tv_sec = us / 1000000;
-    tv.tv_usec = us % 1000000;
+    int16_t xyz[3] = {
+        (int16_t)(buf[1] << 8 | buf[0]),
+        (int16_t)(buf[3] << 8 | buf[2]),
+        (int16_t)(buf[5] << 8 | buf[4]),
+    };
+    int16_t avg[3];
 
-    FD_ZERO(&readfds);
-    FD_SET(STDIN_FILENO, &readfds);
+    for (int i = 0; i < 3; i++)
+        dsp_movavg_process(&app->smooth[i], &xyz[i], &avg[i], 1);
 
-    struct termios oldt, newt;
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    fcntl(STDIN_FILENO, F_SETFL, O_NONBLOCK);
+    printf("\r0x%02X | Temp: %3d°C | X: %6d (%6d) | Y: %6d (%6d) | Z: %6d (%6d)   ",
+           app->whoami, 25 + (int8_t)temp_raw, xyz[0], avg[0], xyz[1], avg[1], xyz[2], avg[2]);
+    fflush(stdout);
+    return;
 
-    retval = select(STDIN_FILENO + 1, &readfds, NULL, NULL, &tv);
+fail:
+    app->status = EXIT_FAILURE;
+    evloop_stop(loop);
+}
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, 0);
+/**
+ * @brief Keyboard watcher: any key stops the loop.
+ */
+static void key_pressed(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg)
+{
+    char ch;
 
-    if (retval > 0 && FD_ISSET(STDIN_FILENO, &readfds))
-    {
-        getchar(); // Consume the key
-        return 1;
-    }
-    return 0;
+    (void)events;
+    (void)arg;
+    if (read(io->fd, &ch, 1) != 0)
+        printf("\nKey pressed. Stopping...\n");
+    evloop_stop(loop);
 }
 
 /* -------------------- Initialization & Cleanup -------------------- */
@@ -199,16 +200,23 @@ static void cleanup(spi_t *spi)
  * @brief Entry point of the SPI sensor reader program.
  *
  * @param argc Argument count.
- * @param argv Argument vector (optional delay in ms).
+ * @param argv Argument vector (optional delay in ms, or --bench).
  * @return EXIT_SUCCESS on success, EXIT_FAILURE on error.
  */
 int main(int argc, char *argv[])
 {
     unsigned int delay_ms = 1000; // Default 1 second
-    spi_t *spi = NULL;
+    static evloop_t loop;
+    app_t app = {.spi = NULL, .status = EXIT_SUCCESS};
+    struct termios saved_termios;
+    bool raw = false;
 
     /* Parse command-line argument */
-    if (argc == 2)
+    if (argc == 2 && strcmp(argv[1], "--bench") == 0)
+    {
+        return dsp_bench(BENCH_SECONDS) < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    else if (argc == 2)
     {
         char *endptr;
         errno = 0;
@@ -222,77 +230,77 @@ int main(int argc, char *argv[])
     }
     else
     {
-        fprintf(stderr, "Usage: %s [delay_ms]\nDefaulting to %u ms\n", argv[0], delay_ms);
+        fprintf(stderr, "Usage: %s [delay_ms | --bench]\nDefaulting to %u ms\n", argv[0], delay_ms);
     }
 
     printf("Starting SPI sensor readout...\n");
 
     /* Initialize SPI */
-    spi = spi_new();
-    if (spi_open(spi, SPI_DEVICE, SPI_MODE, SPI_SPEED_HZ) < 0)
+    app.spi = spi_new();
+    if (spi_open(app.spi, SPI_DEVICE, SPI_MODE, SPI_SPEED_HZ) < 0)
     {
-        fprintf(stderr, "spi_open(): %s\n", spi_errmsg(spi));
-        cleanup(spi);
+        fprintf(stderr, "spi_open(): %s\n", spi_errmsg(app.spi));
+        cleanup(app.spi);
         return EXIT_FAILURE;
     }
+    TRACE_POINT("spi_open");
 
     /* WHO_AM_I check */
-    uint8_t whoami = 0;
-    if (spi_read_register(spi, REG_WHOAMI, &whoami) < 0)
+    if (spi_read_register(app.spi, REG_WHOAMI, &app.whoami) < 0)
     {
         fprintf(stderr, "Failed to read WHO_AM_I\n");
-        cleanup(spi);
+        cleanup(app.spi);
         return EXIT_FAILURE;
     }
-    printf("WHO_AM_I: 0x%02X\n", whoami);
+    TRACE_FIRST_IO("spi_transfer");
+    printf("WHO_AM_I: 0x%02X\n", app.whoami);
 
     /* Enable device */
-    if (spi_write_register(spi, REG_CTRL1, 0x0F) < 0)
+    if (spi_write_register(app.spi, REG_CTRL1, 0x0F) < 0)
     {
         fprintf(stderr, "Failed to write CTRL_REG1\n");
-        cleanup(spi);
+        cleanup(app.spi);
         return EXIT_FAILURE;
     }
 
-    delay_us(100000);
-
-    printf("Press any key to stop...\n");
+    for (int i = 0; i < 3; i++)
+        dsp_movavg_init(&app.smooth[i], SMOOTH_WINDOW);
 
-    /* Main loop */
-    while (!kbhit())
+    if (evloop_init(&loop, 0) < 0)
     {
-        uint8_t temp_raw;
-        uint8_t buf[6];
-
-        if (spi_read_register(spi, REG_TEMP, &temp_raw) < 0)
-        {
-            fprintf(stderr, "\nError: Failed to read temperature register\n");
-            break;
-        }
-
-        if (spi_read_multi(spi, REG_OUT_X_L, buf, sizeof(buf)) < 0)
-        {
-            fprintf(stderr, "\nError: Failed to read gyro XYZ registers\n");
-            break;
-        }
+        perror("evloop_init");
+        cleanup(app.spi);
+        return EXIT_FAILURE;
+    }
 
-        int16_t x = (int16_t)(buf[1] << 8 | buf[0]);
-        int16_t y = (int16_t)(buf[3] << 8 | buf[2]);
-        int16_t z = (int16_t)(buf[5] << 8 | buf[4]);
+    /* First sample after the power-up settle time, then every delay_ms */
+    evloop_timer_init(&app.sample_timer, sample_sensor, &app);
+    evloop_timer_start(&loop, &app.sample_timer, SETTLE_US, (uint64_t)delay_ms * 1000);
 
-        printf("\r0x%02X | Temp: %3d°C | X: %6d | Y: %6d | Z: %6d   ",
-               whoami, 25 + (int8_t)temp_raw, x, y, z);
-        fflush(stdout);
+    evloop_io_init(&app.keyboard, STDIN_FILENO, key_pressed, &app);
+    if (evloop_io_add(&loop, &app.keyboard, EPOLLIN) == 0)
+    {
+        raw = terminal_raw(&saved_termios) == 0;
+        printf("Press any key to stop...\n");
+    }
+    else
+    {
+        printf("stdin cannot be polled, press Ctrl+C to stop...\n");
+    }
 
-        if (delay_or_keypress(delay_ms * 1000))
-        {
-            printf("\nKey pressed. Stopping...\n");
-            break;
-        }
+    /* Main loop */
+    if (evloop_run(&loop) < 0)
+    {
+        perror("evloop_run");
+        app.status = EXIT_FAILURE;
     }
 
+    if (raw)
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+    evloop_close(&loop);
+
     printf("\nStopping...\n");
-    cleanup(spi);
+    cleanup(app.spi);
 
-    return EXIT_SUCCESS;
+    return app.status;
 }
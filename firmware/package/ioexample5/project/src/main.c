@@ -5,6 +5,7 @@
 #include <fcntl.h>
 
 #include "periphery/mmio.h"
+#include "libtrace/startup_trace.h"
 
 /**
  * @file rcc_freq_reader.c
@@ -127,10 +128,12 @@ int main(int argc, char *argv[])
 {
     mmio_t *mmio_rcc = mmio_new();
     mmio_open(mmio_rcc, RCC_BASE, sizeof(RCC_TypeDef));
+    TRACE_POINT("mmio_open");
 
     rcc_regs = (volatile RCC_TypeDef *)mmio_ptr(mmio_rcc);
 
     unsigned long cpu_freq = get_sysclk_freq_hz();
+    TRACE_FIRST_IO("mmio_read");
     printf("Detected CPU frequency: %lu Hz\n", cpu_freq);
 
     mmio_close(mmio_rcc);
@@ -3,19 +3,134 @@
 #include <stdint.h>
 #include <unistd.h>
 #include <errno.h>
-#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
 
 #include "periphery/pwm.h"
+#include "libevloop/evloop.h"
+#include "libtrace/startup_trace.h"
+
+/** Duty cycle steps shown one after the other */
+typedef struct pwm_step {
+    double duty;
+    const char *label;
+} pwm_step_t;
+
+static const pwm_step_t steps[] = {
+    {0.25, "25%"},
+    {0.50, "50%"},
+    {0.75, "75%"},
+    {1.00, "100% (always ON)"},
+};
+
+#define STEP_COUNT (sizeof(steps) / sizeof(steps[0]))
+
+typedef struct app {
+    pwm_t *pwm;
+    int chip;
+    int channel;
+    unsigned int step;
+    unsigned int step_seconds;  /* Auto-advance period, 0 waits for ENTER only */
+    evloop_timer_t step_timer;
+    evloop_io_t keyboard;
+    int status;
+} app_t;
 
 /**
- * @brief Waits for the user to press ENTER before continuing.
+ * @brief Apply the current step and prompt the user.
  *
- * @param message Message displayed before waiting.
+ * @return 0 on success, -1 on PWM error.
  */
-static void wait_for_user(const char *message)
+static int apply_step(evloop_t *loop, app_t *app)
 {
-    printf("\n%s\nPress ENTER to continue...", message);
-    getchar();
+    const pwm_step_t *step = &steps[app->step];
+
+    if (pwm_set_duty_cycle(app->pwm, step->duty) < 0)
+    {
+        fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(app->pwm));
+        return -1;
+    }
+    printf("Duty cycle set to %s on chip%d, channel%d.\n", step->label, app->chip, app->channel);
+
+    printf("\nObserve LED brightness at %.0f%% duty\n", step->duty * 100.0);
+    if (app->step_seconds)
+    {
+        printf("Press ENTER or wait %u s to continue...", app->step_seconds);
+        evloop_timer_start(loop, &app->step_timer, (uint64_t)app->step_seconds * 1000000, 0);
+    }
+    else
+    {
+        printf("Press ENTER to continue...");
+    }
+    fflush(stdout);
+    return 0;
+}
+
+/**
+ * @brief Move to the next step, stopping the loop after the last one.
+ */
+static void next_step(evloop_t *loop, app_t *app)
+{
+    evloop_timer_cancel(loop, &app->step_timer);
+
+    if (++app->step == STEP_COUNT)
+    {
+        evloop_stop(loop);
+        return;
+    }
+
+    if (apply_step(loop, app) < 0)
+    {
+        app->status = EXIT_FAILURE;
+        evloop_stop(loop);
+    }
+}
+
+static void step_timeout(evloop_t *loop, evloop_timer_t *timer, void *arg)
+{
+    (void)timer;
+    printf("\n");
+    next_step(loop, arg);
+}
+
+/**
+ * @brief stdin watcher: ENTER advances, end of input stops.
+ */
+static void key_pressed(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg)
+{
+    char buf[64];
+    ssize_t n = read(io->fd, buf, sizeof(buf));
+
+    (void)events;
+    if (n <= 0)
+    {
+        evloop_io_remove(loop, io);
+        evloop_stop(loop);
+        return;
+    }
+
+    if (memchr(buf, '\n', (size_t)n))
+        next_step(loop, arg);
+}
+
+/**
+ * @brief Parse a non-negative integer argument.
+ *
+ * @return 0 on success, -1 on invalid input.
+ */
+static int parse_arg(const char *str, const char *name, int *value)
+{
+    char *endptr;
+
+    errno = 0;
+    long val = strtol(str, &endptr, 10);
+    if (errno || *endptr != '\0' || val < 0 || val > INT32_MAX)
+    {
+        fprintf(stderr, "Invalid %s value: '%s'\n", name, str);
+        return -1;
+    }
+    *value = (int)val;
+    return 0;
 }
 
 /**
@@ -28,111 +143,89 @@ static void wait_for_user(const char *message)
  */
 int main(int argc, char *argv[])
 {
-    int chip = 0;    // Default chip
-    int channel = 0; // Default channel
-    pwm_t *pwm = NULL;
+    static evloop_t loop;
+    app_t app = {.chip = 0, .channel = 0, .status = EXIT_SUCCESS};
+    int step_seconds = 0;
 
     /* Parse command-line arguments */
-    if (argc == 3)
+    if (argc == 3 || argc == 4)
     {
-        char *endptr;
-
-        errno = 0;
-        long val_chip = strtol(argv[1], &endptr, 10);
-        if (errno || *endptr != '\0' || val_chip < 0)
-        {
-            fprintf(stderr, "Invalid chip value: '%s'\n", argv[1]);
+        if (parse_arg(argv[1], "chip", &app.chip) < 0 ||
+            parse_arg(argv[2], "channel", &app.channel) < 0 ||
+            (argc == 4 && parse_arg(argv[3], "step seconds", &step_seconds) < 0))
             return EXIT_FAILURE;
-        }
-        chip = (int)val_chip;
-
-        errno = 0;
-        long val_channel = strtol(argv[2], &endptr, 10);
-        if (errno || *endptr != '\0' || val_channel < 0)
-        {
-            fprintf(stderr, "Invalid channel value: '%s'\n", argv[2]);
-            return EXIT_FAILURE;
-        }
-        channel = (int)val_channel;
+        app.step_seconds = (unsigned int)step_seconds;
     }
     else
     {
-        fprintf(stderr, "Usage: %s [chip] [channel]\nDefaulting to chip=%d, channel=%d\n",
-                argv[0], chip, channel);
+        fprintf(stderr, "Usage: %s [chip] [channel] [step_seconds]\nDefaulting to chip=%d, channel=%d\n",
+                argv[0], app.chip, app.channel);
     }
 
-    pwm = pwm_new();
-    if (!pwm)
+    app.pwm = pwm_new();
+    if (!app.pwm)
     {
         fprintf(stderr, "Failed to allocate PWM instance\n");
         return EXIT_FAILURE;
     }
 
     /* Open PWM */
-    if (pwm_open(pwm, chip, channel) < 0)
+    if (pwm_open(app.pwm, app.chip, app.channel) < 0)
     {
-        fprintf(stderr, "pwm_open(): %s\n", pwm_errmsg(pwm));
-        pwm_free(pwm);
+        fprintf(stderr, "pwm_open(): %s\n", pwm_errmsg(app.pwm));
+        pwm_free(app.pwm);
         return EXIT_FAILURE;
     }
+    TRACE_POINT("pwm_open");
 
-    /* Set base frequency */
-    if (pwm_set_frequency(pwm, 1000.0) < 0)
+    if (evloop_init(&loop, 0) < 0)
     {
-        fprintf(stderr, "pwm_set_frequency(): %s\n", pwm_errmsg(pwm));
+        perror("evloop_init");
+        app.status = EXIT_FAILURE;
         goto cleanup;
     }
-    printf("PWM frequency set to 1 kHz on chip%d, channel%d.\n", chip, channel);
 
-    /* Enable PWM */
-    if (pwm_enable(pwm) < 0)
-    {
-        fprintf(stderr, "pwm_enable(): %s\n", pwm_errmsg(pwm));
-        goto cleanup;
-    }
-    printf("PWM enabled on chip%d, channel%d.\n", chip, channel);
-
-    /* Step 1: 25% duty */
-    if (pwm_set_duty_cycle(pwm, 0.25) < 0)
+    /* Set base frequency */
+    if (pwm_set_frequency(app.pwm, 1000.0) < 0)
     {
-        fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(pwm));
+        fprintf(stderr, "pwm_set_frequency(): %s\n", pwm_errmsg(app.pwm));
+        app.status = EXIT_FAILURE;
         goto cleanup;
     }
-    printf("Duty cycle set to 25%% on chip%d, channel%d.\n", chip, channel);
-    wait_for_user("Observe LED brightness at 25% duty");
+    TRACE_FIRST_IO("pwm_set_frequency");
+    printf("PWM frequency set to 1 kHz on chip%d, channel%d.\n", app.chip, app.channel);
 
-    /* Step 2: 50% duty */
-    if (pwm_set_duty_cycle(pwm, 0.50) < 0)
+    /* Enable PWM */
+    if (pwm_enable(app.pwm) < 0)
     {
-        fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(pwm));
+        fprintf(stderr, "pwm_enable(): %s\n", pwm_errmsg(app.pwm));
+        app.status = EXIT_FAILURE;
         goto cleanup;
     }
-    printf("Duty cycle set to 50%% on chip%d, channel%d.\n", chip, channel);
-    wait_for_user("Observe LED brightness at 50% duty");
+    printf("PWM enabled on chip%d, channel%d.\n", app.chip, app.channel);
 
-    /* Step 3: 75% duty */
-    if (pwm_set_duty_cycle(pwm, 0.75) < 0)
+    evloop_timer_init(&app.step_timer, step_timeout, &app);
+    evloop_io_init(&app.keyboard, STDIN_FILENO, key_pressed, &app);
+    if (evloop_io_add(&loop, &app.keyboard, EPOLLIN) < 0 && app.step_seconds == 0)
     {
-        fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(pwm));
-        goto cleanup;
+        /* Without a pollable stdin nothing could ever advance the steps */
+        app.step_seconds = 5;
     }
-    printf("Duty cycle set to 75%% on chip%d, channel%d.\n", chip, channel);
-    wait_for_user("Observe LED brightness at 75% duty");
 
-    /* Step 4: 100% duty */
-    if (pwm_set_duty_cycle(pwm, 1.0) < 0)
+    /* Step through the duty cycles, driven by ENTER and/or the step timer */
+    if (apply_step(&loop, &app) < 0 || evloop_run(&loop) < 0)
     {
-        fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(pwm));
+        app.status = EXIT_FAILURE;
         goto cleanup;
     }
-    printf("Duty cycle set to 100%% (always ON) on chip%d, channel%d.\n", chip, channel);
-    wait_for_user("Observe LED brightness at 100% duty");
 
-    printf("\nTest complete. Disabling PWM on chip%d, channel%d...\n", chip, channel);
+    if (app.step == STEP_COUNT)
+        printf("\nTest complete. Disabling PWM on chip%d, channel%d...\n", app.chip, app.channel);
 
 cleanup:
-    pwm_disable(pwm);
-    pwm_close(pwm);
-    pwm_free(pwm);
-    return 0;
+    evloop_close(&loop);
+    pwm_disable(app.pwm);
+    pwm_close(app.pwm);
+    pwm_free(app.pwm);
+    return app.status;
 }
@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "periphery/serial.h"
+#include "libtrace/startup_trace.h"
 
 #define MAX_MSG_LEN 255
 
@@ -61,6 +62,7 @@ int main(int argc, char *argv[])
         fprintf(stderr, "serial_open(): %s\n", serial_errmsg(serial));
         cleanup(EXIT_FAILURE);
     }
+    TRACE_POINT("serial_open");
 
     printf("Serial configured on %s. Type your message and press Enter.\n", tty_path);
     printf("Empty input will terminate the program.\n");
@@ -90,6 +92,7 @@ int main(int argc, char *argv[])
             fprintf(stderr, "serial_write(): %s\n", serial_errmsg(serial));
             cleanup(EXIT_FAILURE);
         }
+        TRACE_FIRST_IO("serial_write");
 
         printf("Sent %d bytes.\n", len);
     }
@@ -8,6 +8,8 @@
 #include <sys/ioctl.h>
 #include <linux/serial.h>
 
+#include "libtrace/startup_trace.h"
+
 #define MAX_MSG_LEN 255
 // #define READ_BUF_SIZE 256
 
@@ -125,9 +127,11 @@ int main(int argc, char *argv[])
 
     if (configure_serial(tty_path) < 0)
         cleanup(EXIT_FAILURE);
+    TRACE_POINT("tty_open");
 
     if (configure_rs485() < 0)
         cleanup(EXIT_FAILURE);
+    TRACE_POINT("rs485_config");
 
     printf("RS485 serial configured on %s. Type your message and press Enter.\n", tty_path);
     printf("Empty input will terminate the program.\n");
@@ -158,6 +162,7 @@ int main(int argc, char *argv[])
             perror("write");
             cleanup(EXIT_FAILURE);
         }
+        TRACE_FIRST_IO("tty_write");
 
         printf("Sent %d bytes.\n", len);
 #if defined(READ_BUF_SIZE)
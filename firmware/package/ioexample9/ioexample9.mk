@@ -0,0 +1,31 @@
+###############################################################################
+#
+# IOEXAMPLE9 package
+#
+###############################################################################
+
+# Package version and source location
+IOEXAMPLE9_VERSION = 1.0
+IOEXAMPLE9_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/ioexample9/project
+IOEXAMPLE9_SITE_METHOD = local
+
+# c-periphery and the DSP kernels come from the libperiphery and libdsp
+# packages
+IOEXAMPLE9_DEPENDENCIES = libdsp libperiphery libtrace
+
+# Build commands
+define IOEXAMPLE9_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		CFLAGS="$(TARGET_CFLAGS)" \
+		LDFLAGS="$(TARGET_LDFLAGS) $(LIBPERIPHERY_LDFLAGS)" \
+		-C $(@D)
+endef
+
+# Install the compiled binary to the target filesystem
+define IOEXAMPLE9_INSTALL_TARGET_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/ioexample9 $(TARGET_DIR)/usr/bin/ioexample9
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,4 @@
+#!/bin/bash
+echo "Removing ioexample9 from target..."
+rm -f $(TARGET_DIR)/usr/bin/ioexample9
+rm -f $(TARGET_DIR)/etc/ioexample9.ini
\ No newline at end of file
@@ -0,0 +1,33 @@
+###############################################################################
+#
+# LIBBENCH package
+#
+###############################################################################
+
+# Package version and source location
+LIBBENCH_VERSION = 1.0
+LIBBENCH_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libbench/project
+LIBBENCH_SITE_METHOD = local
+
+# Header and archive go to staging, where sleepexample and periphery-bench
+# link against them
+LIBBENCH_INSTALL_STAGING = YES
+LIBBENCH_INSTALL_TARGET = NO
+
+# Build commands
+define LIBBENCH_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(TARGET_AR)" \
+		CFLAGS="$(TARGET_CFLAGS) -ffunction-sections -fdata-sections" \
+		-C $(@D)
+endef
+
+# Install the header and archive for other packages to build against
+define LIBBENCH_INSTALL_STAGING_CMDS
+	$(INSTALL) -D -m 0644 $(@D)/include/libbench/stats.h $(STAGING_DIR)/usr/include/libbench/stats.h
+	$(INSTALL) -D -m 0644 $(@D)/bin/libbench.a $(STAGING_DIR)/usr/lib/libbench.a
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,22 @@
+// include/libbench/stats.h
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Order statistics over a set of nanosecond samples */
+typedef struct stats_summary {
+    int64_t min;
+    int64_t median;
+    int64_t p99;
+    int64_t max;
+    double mean;
+} stats_summary_t;
+
+/* Sorts <samples> in place */
+void stats_summarize(int64_t *samples, size_t count, stats_summary_t *summary);
+int64_t stats_percentile(const int64_t *sorted, size_t count, double percentile);
+
+#endif // STATS_H
@@ -0,0 +1,56 @@
+// src/libbench/stats.c
+
+#include <stdlib.h>
+
+#include "libbench/stats.h"
+
+static int compare_int64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nearest-rank percentile of a sorted sample set.
+ *
+ * @param sorted Samples in ascending order.
+ * @param count Number of samples, must be > 0.
+ * @param percentile 0..100.
+ */
+int64_t stats_percentile(const int64_t *sorted, size_t count, double percentile)
+{
+    size_t rank = (size_t)(percentile / 100.0 * (double)count + 0.999999);
+
+    if (rank < 1)
+        rank = 1;
+    if (rank > count)
+        rank = count;
+    return sorted[rank - 1];
+}
+
+/**
+ * @brief Sort samples and compute min/median/p99/max/mean.
+ */
+void stats_summarize(int64_t *samples, size_t count, stats_summary_t *summary)
+{
+    double sum = 0.0;
+
+    if (count == 0)
+    {
+        summary->min = summary->median = summary->p99 = summary->max = 0;
+        summary->mean = 0.0;
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_int64);
+
+    for (size_t i = 0; i < count; i++)
+        sum += (double)samples[i];
+
+    summary->min = samples[0];
+    summary->median = stats_percentile(samples, count, 50.0);
+    summary->p99 = stats_percentile(samples, count, 99.0);
+    summary->max = samples[count - 1];
+    summary->mean = sum / (double)count;
+}
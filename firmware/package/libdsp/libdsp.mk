@@ -0,0 +1,32 @@
+###############################################################################
+#
+# LIBDSP package
+#
+###############################################################################
+
+# Package version and source location
+LIBDSP_VERSION = 1.0
+LIBDSP_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libdsp/project
+LIBDSP_SITE_METHOD = local
+
+# Header and archive go to staging, where the examples link against them
+LIBDSP_INSTALL_STAGING = YES
+LIBDSP_INSTALL_TARGET = NO
+
+# Build commands
+define LIBDSP_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(TARGET_AR)" \
+		CFLAGS="$(TARGET_CFLAGS) -ffunction-sections -fdata-sections" \
+		-C $(@D)
+endef
+
+# Install the header and archive for other packages to build against
+define LIBDSP_INSTALL_STAGING_CMDS
+	$(INSTALL) -D -m 0644 $(@D)/include/libdsp/dsp.h $(STAGING_DIR)/usr/include/libdsp/dsp.h
+	$(INSTALL) -D -m 0644 $(@D)/bin/libdsp.a $(STAGING_DIR)/usr/lib/libdsp.a
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,113 @@
+// include/libdsp/dsp.h
+
+#ifndef DSP_H
+#define DSP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Block-based fixed-point filters for contiguous int16 (Q15) sample arrays.
+ *
+ * On cores with the ARMv7E-M DSP extension (Cortex-M4/M7, __ARM_FEATURE_SIMD32)
+ * the multiply-accumulate kernels process two samples per instruction with
+ * SMLAD/SMLALD and SSUB16/SEL. Everywhere else, or when built with
+ * -DDSP_FORCE_SCALAR, portable scalar C is used. Both paths produce
+ * bit-identical results; dsp_bench() checks every kernel against a scalar
+ * reference before timing it.
+ *
+ * All state lives in the filter structures; nothing is allocated.
+ */
+
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32 && !defined(DSP_FORCE_SCALAR)
+#define DSP_HAVE_SIMD 1
+#else
+#define DSP_HAVE_SIMD 0
+#endif
+
+#define DSP_MOVAVG_MAX_WINDOW 256
+#define DSP_BIQUAD_MAX_STAGES 4
+#define DSP_FIR_MAX_TAPS 64
+
+/* Moving average over the last <window> samples */
+typedef struct dsp_movavg {
+    int16_t history[DSP_MOVAVG_MAX_WINDOW];
+    unsigned int window;
+    unsigned int pos;
+    int32_t sum;
+    int shift;                  /* log2(window) when a power of two, -1 otherwise */
+} dsp_movavg_t;
+
+/* Biquad section coefficients in Q14, a1/a2 with the sign used by
+ * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2] */
+typedef struct dsp_biquad_coeffs {
+    int16_t b0, b1, b2;
+    int16_t a1, a2;
+} dsp_biquad_coeffs_t;
+
+/* Cascade of Direct Form I biquad sections */
+typedef struct dsp_biquad {
+    unsigned int stages;
+    int16_t b0[DSP_BIQUAD_MAX_STAGES];
+    uint32_t b12[DSP_BIQUAD_MAX_STAGES];    /* b1 | b2 << 16 */
+    uint32_t a12[DSP_BIQUAD_MAX_STAGES];    /* a1 | a2 << 16 */
+    uint32_t x12[DSP_BIQUAD_MAX_STAGES];    /* x[n-1] | x[n-2] << 16 */
+    uint32_t y12[DSP_BIQUAD_MAX_STAGES];    /* y[n-1] | y[n-2] << 16 */
+} dsp_biquad_t;
+
+/* Decimating FIR, Q15 coefficients */
+typedef struct dsp_fir_decim {
+    int16_t coeffs[DSP_FIR_MAX_TAPS];       /* Time-reversed, zero-padded to an even count */
+    int16_t delay[2 * DSP_FIR_MAX_TAPS];    /* Mirrored delay line, window is always contiguous */
+    unsigned int taps;                      /* Padded tap count */
+    unsigned int pos;
+    unsigned int factor;
+    unsigned int phase;
+} dsp_fir_decim_t;
+
+/* Running min/max/mean/RMS over one or more blocks */
+typedef struct dsp_stats {
+    int16_t min;
+    int16_t max;
+    int64_t sum;
+    int64_t sum_squares;
+    uint64_t count;
+} dsp_stats_t;
+
+/* Moving average */
+int dsp_movavg_init(dsp_movavg_t *f, unsigned int window);
+void dsp_movavg_reset(dsp_movavg_t *f);
+void dsp_movavg_process(dsp_movavg_t *f, const int16_t *in, int16_t *out, size_t count);
+
+/* Biquad IIR cascade */
+int dsp_biquad_init(dsp_biquad_t *f, const dsp_biquad_coeffs_t *coeffs, unsigned int stages);
+void dsp_biquad_reset(dsp_biquad_t *f);
+void dsp_biquad_process(dsp_biquad_t *f, const int16_t *in, int16_t *out, size_t count);
+
+/* Decimating FIR, returns the number of output samples written */
+int dsp_fir_decim_init(dsp_fir_decim_t *f, const int16_t *coeffs, unsigned int taps, unsigned int factor);
+void dsp_fir_decim_reset(dsp_fir_decim_t *f);
+size_t dsp_fir_decim_process(dsp_fir_decim_t *f, const int16_t *in, int16_t *out, size_t count);
+
+/* Window statistics */
+void dsp_stats_reset(dsp_stats_t *s);
+void dsp_stats_update(dsp_stats_t *s, const int16_t *in, size_t count);
+int16_t dsp_stats_mean(const dsp_stats_t *s);
+int16_t dsp_stats_rms(const dsp_stats_t *s);
+
+/* Miscellaneous */
+const char *dsp_implementation(void);
+
+/* Check every kernel against the scalar reference, then benchmark each for
+ * roughly <seconds> and print samples/sec. Returns -1 on a mismatch. */
+int dsp_bench(double seconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_H
@@ -0,0 +1,452 @@
+// src/libdsp/dsp.c
+
+#include <string.h>
+
+#include "libdsp/dsp.h"
+
+#if DSP_HAVE_SIMD
+#include <arm_acle.h>
+#endif
+
+/* -------------------- Helpers -------------------- */
+
+/**
+ * @brief Saturate a wide accumulator to the int16 range.
+ */
+static inline int16_t dsp_sat16(int64_t v)
+{
+    if (v > INT16_MAX)
+        return INT16_MAX;
+    if (v < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)v;
+}
+
+/**
+ * @brief Load two consecutive int16 samples as one packed word.
+ *
+ * memcpy keeps this legal for unaligned pointers; GCC lowers it to a single
+ * LDR on Cortex-M4, which tolerates unaligned word loads.
+ */
+static inline uint32_t dsp_read_q15x2(const int16_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline int16_t dsp_lo16(uint32_t v)
+{
+    return (int16_t)(v & 0xFFFF);
+}
+
+static inline int16_t dsp_hi16(uint32_t v)
+{
+    return (int16_t)(v >> 16);
+}
+
+static inline uint32_t dsp_pack16(int16_t lo, int16_t hi)
+{
+    return (uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+}
+
+#if DSP_HAVE_SIMD
+/*
+ * SSUB16 sets the per-halfword GE flags consumed by SEL. Both live in one asm
+ * statement so nothing can be scheduled in between and clobber the flags.
+ */
+static inline uint32_t dsp_max16x2(uint32_t a, uint32_t b)
+{
+    uint32_t r;
+    __asm__("ssub16 %0, %1, %2\n\t"
+            "sel %0, %1, %2"
+            : "=&r"(r)
+            : "r"(a), "r"(b)
+            : "cc");
+    return r;
+}
+
+static inline uint32_t dsp_min16x2(uint32_t a, uint32_t b)
+{
+    uint32_t r;
+    __asm__("ssub16 %0, %1, %2\n\t"
+            "sel %0, %2, %1"
+            : "=&r"(r)
+            : "r"(a), "r"(b)
+            : "cc");
+    return r;
+}
+#endif
+
+/* -------------------- Moving Average -------------------- */
+
+/**
+ * @brief Initialize a moving average filter.
+ *
+ * @param f Filter state.
+ * @param window Window length in samples (1..DSP_MOVAVG_MAX_WINDOW).
+ * @return 0 on success, -1 on invalid window.
+ */
+int dsp_movavg_init(dsp_movavg_t *f, unsigned int window)
+{
+    if (window == 0 || window > DSP_MOVAVG_MAX_WINDOW)
+        return -1;
+
+    f->window = window;
+    f->shift = -1;
+    if ((window & (window - 1)) == 0)
+    {
+        f->shift = 0;
+        while ((1u << f->shift) < window)
+            f->shift++;
+    }
+
+    dsp_movavg_reset(f);
+    return 0;
+}
+
+/**
+ * @brief Clear the filter history.
+ */
+void dsp_movavg_reset(dsp_movavg_t *f)
+{
+    memset(f->history, 0, sizeof(f->history));
+    f->pos = 0;
+    f->sum = 0;
+}
+
+/**
+ * @brief Filter a block of samples.
+ *
+ * The running sum makes this O(1) per sample regardless of the window, so
+ * there is no multiply-accumulate to vectorize; the same code serves both
+ * builds. Power-of-two windows replace the divide with a shift.
+ *
+ * @param f Filter state.
+ * @param in Input samples.
+ * @param out Output samples, may alias @p in.
+ * @param count Number of samples.
+ */
+void dsp_movavg_process(dsp_movavg_t *f, const int16_t *in, int16_t *out, size_t count)
+{
+    int16_t *history = f->history;
+    unsigned int window = f->window;
+    unsigned int pos = f->pos;
+    int32_t sum = f->sum;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int16_t x = in[i];
+
+        sum += x - history[pos];
+        history[pos] = x;
+        if (++pos == window)
+            pos = 0;
+
+        out[i] = (int16_t)(f->shift >= 0 ? sum >> f->shift : sum / (int32_t)window);
+    }
+
+    f->pos = pos;
+    f->sum = sum;
+}
+
+/* -------------------- Biquad IIR -------------------- */
+
+/**
+ * @brief Initialize a Direct Form I biquad cascade.
+ *
+ * @param f Filter state.
+ * @param coeffs Array of @p stages coefficient sets in Q14.
+ * @param stages Number of sections (1..DSP_BIQUAD_MAX_STAGES).
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int dsp_biquad_init(dsp_biquad_t *f, const dsp_biquad_coeffs_t *coeffs, unsigned int stages)
+{
+    if (!coeffs || stages == 0 || stages > DSP_BIQUAD_MAX_STAGES)
+        return -1;
+
+    f->stages = stages;
+    for (unsigned int s = 0; s < stages; s++)
+    {
+        f->b0[s] = coeffs[s].b0;
+        f->b12[s] = dsp_pack16(coeffs[s].b1, coeffs[s].b2);
+        f->a12[s] = dsp_pack16(coeffs[s].a1, coeffs[s].a2);
+    }
+
+    dsp_biquad_reset(f);
+    return 0;
+}
+
+/**
+ * @brief Clear the filter delay lines.
+ */
+void dsp_biquad_reset(dsp_biquad_t *f)
+{
+    memset(f->x12, 0, sizeof(f->x12));
+    memset(f->y12, 0, sizeof(f->y12));
+}
+
+/**
+ * @brief Filter a block of samples through every section.
+ *
+ * Each section runs over the whole block before the next one so its
+ * coefficients and state stay in registers. The delay pairs are kept packed,
+ * letting one SMLALD apply b1/b2 and another a1/a2.
+ *
+ * @param f Filter state.
+ * @param in Input samples.
+ * @param out Output samples, may alias @p in.
+ * @param count Number of samples.
+ */
+void dsp_biquad_process(dsp_biquad_t *f, const int16_t *in, int16_t *out, size_t count)
+{
+    const int16_t *src = in;
+
+    for (unsigned int s = 0; s < f->stages; s++)
+    {
+        int32_t b0 = f->b0[s];
+        uint32_t b12 = f->b12[s];
+        uint32_t a12 = f->a12[s];
+        uint32_t x12 = f->x12[s];
+        uint32_t y12 = f->y12[s];
+
+        for (size_t i = 0; i < count; i++)
+        {
+            int16_t x = src[i];
+            int64_t acc = (int64_t)b0 * x;
+
+#if DSP_HAVE_SIMD
+            acc = __smlald((int32_t)b12, (int32_t)x12, acc);
+            acc = __smlald((int32_t)a12, (int32_t)y12, acc);
+#else
+            acc += (int64_t)dsp_lo16(b12) * dsp_lo16(x12) + (int64_t)dsp_hi16(b12) * dsp_hi16(x12);
+            acc += (int64_t)dsp_lo16(a12) * dsp_lo16(y12) + (int64_t)dsp_hi16(a12) * dsp_hi16(y12);
+#endif
+
+            int16_t y = dsp_sat16(acc >> 14);
+
+            x12 = (uint16_t)x | (x12 << 16);
+            y12 = (uint16_t)y | (y12 << 16);
+            out[i] = y;
+        }
+
+        f->x12[s] = x12;
+        f->y12[s] = y12;
+        src = out;
+    }
+}
+
+/* -------------------- Decimating FIR -------------------- */
+
+/**
+ * @brief Initialize a decimating FIR filter.
+ *
+ * @param f Filter state.
+ * @param coeffs Q15 coefficients h[0..taps-1].
+ * @param taps Number of coefficients (1..DSP_FIR_MAX_TAPS).
+ * @param factor Decimation factor, 1 for a plain FIR.
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int dsp_fir_decim_init(dsp_fir_decim_t *f, const int16_t *coeffs, unsigned int taps, unsigned int factor)
+{
+    if (!coeffs || taps == 0 || taps > DSP_FIR_MAX_TAPS || factor == 0)
+        return -1;
+
+    /* Pad to an even count so the MAC loop always consumes pairs */
+    unsigned int padded = (taps + 1) & ~1u;
+
+    memset(f->coeffs, 0, sizeof(f->coeffs));
+    for (unsigned int i = 0; i < taps; i++)
+        f->coeffs[padded - 1 - i] = coeffs[i];
+
+    f->taps = padded;
+    f->factor = factor;
+
+    dsp_fir_decim_reset(f);
+    return 0;
+}
+
+/**
+ * @brief Clear the delay line and decimation phase.
+ */
+void dsp_fir_decim_reset(dsp_fir_decim_t *f)
+{
+    memset(f->delay, 0, sizeof(f->delay));
+    f->pos = 0;
+    f->phase = 0;
+}
+
+/**
+ * @brief Dot product of the time-reversed coefficients with the newest window.
+ */
+static int16_t dsp_fir_output(const dsp_fir_decim_t *f)
+{
+    const int16_t *h = f->coeffs;
+    const int16_t *w = &f->delay[f->pos];
+    int64_t acc = 0;
+
+#if DSP_HAVE_SIMD
+    for (unsigned int i = 0; i < f->taps; i += 2)
+        acc = __smlald((int32_t)dsp_read_q15x2(&h[i]), (int32_t)dsp_read_q15x2(&w[i]), acc);
+#else
+    for (unsigned int i = 0; i < f->taps; i += 2)
+        acc += (int64_t)h[i] * w[i] + (int64_t)h[i + 1] * w[i + 1];
+#endif
+
+    return dsp_sat16(acc >> 15);
+}
+
+/**
+ * @brief Filter and decimate a block of samples.
+ *
+ * Every input is written twice into a delay line of 2 * taps so the current
+ * window is always contiguous; only every factor-th input pays for a MAC pass.
+ *
+ * @param f Filter state.
+ * @param in Input samples.
+ * @param out Output samples, room for count / factor + 1.
+ * @param count Number of input samples.
+ * @return Number of output samples written.
+ */
+size_t dsp_fir_decim_process(dsp_fir_decim_t *f, const int16_t *in, int16_t *out, size_t count)
+{
+    size_t produced = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        f->delay[f->pos] = in[i];
+        f->delay[f->pos + f->taps] = in[i];
+        if (++f->pos == f->taps)
+            f->pos = 0;
+
+        if (++f->phase == f->factor)
+        {
+            f->phase = 0;
+            out[produced++] = dsp_fir_output(f);
+        }
+    }
+
+    return produced;
+}
+
+/* -------------------- Window Statistics -------------------- */
+
+/**
+ * @brief Start a new statistics window.
+ */
+void dsp_stats_reset(dsp_stats_t *s)
+{
+    s->min = INT16_MAX;
+    s->max = INT16_MIN;
+    s->sum = 0;
+    s->sum_squares = 0;
+    s->count = 0;
+}
+
+/**
+ * @brief Fold a block of samples into the window.
+ *
+ * @param s Statistics state.
+ * @param in Input samples.
+ * @param count Number of samples.
+ */
+void dsp_stats_update(dsp_stats_t *s, const int16_t *in, size_t count)
+{
+    int16_t min = s->min;
+    int16_t max = s->max;
+    int64_t sum = s->sum;
+    int64_t sum_squares = s->sum_squares;
+    size_t i = 0;
+
+#if DSP_HAVE_SIMD
+    uint32_t vmin = dsp_pack16(min, min);
+    uint32_t vmax = dsp_pack16(max, max);
+
+    for (; i + 1 < count; i += 2)
+    {
+        uint32_t v = dsp_read_q15x2(&in[i]);
+
+        vmin = dsp_min16x2(v, vmin);
+        vmax = dsp_max16x2(v, vmax);
+        sum = __smlald((int32_t)v, 0x00010001, sum);
+        sum_squares = __smlald((int32_t)v, (int32_t)v, sum_squares);
+    }
+
+    min = dsp_lo16(vmin) < dsp_hi16(vmin) ? dsp_lo16(vmin) : dsp_hi16(vmin);
+    max = dsp_lo16(vmax) > dsp_hi16(vmax) ? dsp_lo16(vmax) : dsp_hi16(vmax);
+#endif
+
+    for (; i < count; i++)
+    {
+        int16_t x = in[i];
+
+        if (x < min)
+            min = x;
+        if (x > max)
+            max = x;
+        sum += x;
+        sum_squares += (int32_t)x * x;
+    }
+
+    s->min = min;
+    s->max = max;
+    s->sum = sum;
+    s->sum_squares = sum_squares;
+    s->count += count;
+}
+
+/**
+ * @brief Mean of the samples seen since the last reset.
+ */
+int16_t dsp_stats_mean(const dsp_stats_t *s)
+{
+    if (s->count == 0)
+        return 0;
+    return (int16_t)(s->sum / (int64_t)s->count);
+}
+
+/**
+ * @brief Root mean square of the samples seen since the last reset.
+ */
+int16_t dsp_stats_rms(const dsp_stats_t *s)
+{
+    if (s->count == 0)
+        return 0;
+
+    /* Integer square root, avoids pulling soft-float sqrt() into the build */
+    uint64_t mean_square = (uint64_t)s->sum_squares / s->count;
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 30;
+
+    while (bit > mean_square)
+        bit >>= 2;
+    while (bit)
+    {
+        if (mean_square >= root + bit)
+        {
+            mean_square -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root > INT16_MAX ? INT16_MAX : (int16_t)root;
+}
+
+/* -------------------- Miscellaneous -------------------- */
+
+/**
+ * @brief Name of the kernel set selected at compile time.
+ */
+const char *dsp_implementation(void)
+{
+#if DSP_HAVE_SIMD
+    return "ARMv7E-M DSP (SMLALD/SSUB16/SEL)";
+#else
+    return "portable scalar";
+#endif
+}
@@ -0,0 +1,346 @@
+// src/libdsp/dsp_bench.c
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "libdsp/dsp.h"
+
+#define BENCH_BLOCK 1024
+#define CHECK_BLOCK 777         /* Odd, so the paired kernels hit their tails */
+
+/* Second-order Butterworth low-pass at fs/10, Q14 */
+static const dsp_biquad_coeffs_t bench_biquad[2] = {
+    {.b0 = 1106, .b1 = 2210, .b2 = 1106, .a1 = 18727, .a2 = -6763},
+    {.b0 = 1106, .b1 = 2210, .b2 = 1106, .a1 = 18727, .a2 = -6763},
+};
+
+/* Sink that the optimizer cannot see through */
+static volatile int32_t bench_sink;
+
+/**
+ * @brief Read CLOCK_MONOTONIC in seconds.
+ */
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Fill a block with a deterministic noisy ramp.
+ */
+static void bench_fill(int16_t *buf, size_t count)
+{
+    uint32_t lcg = 12345;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        lcg = lcg * 1664525u + 1013904223u;
+        buf[i] = (int16_t)(((int32_t)(i * 64) & 0x3FFF) - 0x2000 + (int16_t)(lcg >> 20));
+    }
+}
+
+/**
+ * @brief Report throughput for one kernel.
+ */
+static void bench_report(const char *name, double samples, double elapsed)
+{
+    printf("  %-28s %12.0f samples/s\n", name, elapsed > 0 ? samples / elapsed : 0.0);
+}
+
+/* -------------------- Self-check -------------------- */
+
+/* Full-scale noise, drives the filters into saturation */
+static void check_fill_noise(int16_t *buf, size_t count, uint32_t seed)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        buf[i] = (int16_t)(seed >> 16);
+    }
+}
+
+static int16_t ref_sat16(int64_t v)
+{
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+/* Textbook scalar forms of the kernels, sample by sample with plain arrays */
+static void ref_movavg(const int16_t *in, int16_t *out, size_t count, unsigned int window)
+{
+    for (size_t n = 0; n < count; n++)
+    {
+        int32_t sum = 0;
+
+        for (unsigned int k = 0; k < window && k <= n; k++)
+            sum += in[n - k];
+        /* Power-of-two windows shift, which rounds down rather than to zero */
+        if ((window & (window - 1)) == 0)
+            out[n] = (int16_t)(sum >= 0 ? sum / (int32_t)window : -((-sum + (int32_t)window - 1) / (int32_t)window));
+        else
+            out[n] = (int16_t)(sum / (int32_t)window);
+    }
+}
+
+static void ref_biquad(const dsp_biquad_coeffs_t *c, unsigned int stages, const int16_t *in, int16_t *out,
+                       size_t count)
+{
+    memmove(out, in, count * sizeof(*out));
+
+    for (unsigned int s = 0; s < stages; s++)
+    {
+        int16_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for (size_t n = 0; n < count; n++)
+        {
+            int16_t x = out[n];
+            int64_t acc = (int64_t)c[s].b0 * x + (int64_t)c[s].b1 * x1 + (int64_t)c[s].b2 * x2 +
+                          (int64_t)c[s].a1 * y1 + (int64_t)c[s].a2 * y2;
+            int16_t y = ref_sat16(acc >> 14);
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            out[n] = y;
+        }
+    }
+}
+
+static size_t ref_fir_decim(const int16_t *h, unsigned int taps, unsigned int factor, const int16_t *in,
+                            int16_t *out, size_t count)
+{
+    size_t produced = 0;
+
+    for (size_t n = factor - 1; n < count; n += factor)
+    {
+        int64_t acc = 0;
+
+        for (unsigned int k = 0; k < taps && k <= n; k++)
+            acc += (int64_t)h[k] * in[n - k];
+        out[produced++] = ref_sat16(acc >> 15);
+    }
+
+    return produced;
+}
+
+/**
+ * @brief Compare two output blocks and report the first mismatch.
+ */
+static int check_equal(const char *name, const int16_t *got, const int16_t *want, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (got[i] != want[i])
+        {
+            fprintf(stderr, "DSP self-check failed: %s, sample %zu: %d, expected %d\n", name, i, got[i], want[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Check every kernel against the scalar reference.
+ *
+ * The input is fed in two uneven blocks, from an odd address, so the state
+ * carried between calls, the unpaired tail samples and unaligned loads are
+ * all exercised. This is what keeps the SIMD kernels honest: the host build
+ * only ever runs the portable ones.
+ *
+ * @return 0 if every output matches, -1 otherwise.
+ */
+static int dsp_self_check(const int16_t *fir_coeffs)
+{
+    static int16_t input[CHECK_BLOCK + 1];
+    static int16_t got[CHECK_BLOCK];
+    static int16_t want[CHECK_BLOCK];
+    static dsp_movavg_t movavg;
+    static dsp_biquad_t biquad;
+    static dsp_fir_decim_t fir;
+    const int16_t *in = &input[1];
+    const size_t split = CHECK_BLOCK / 3;
+
+    /* A resonant section whose output saturates on full-scale noise */
+    static const dsp_biquad_coeffs_t loud[2] = {
+        {.b0 = 16384, .b1 = 16384, .b2 = 8192, .a1 = 29000, .a2 = -14000},
+        {.b0 = 8192, .b1 = -4096, .b2 = 2048, .a1 = -12000, .a2 = -9000},
+    };
+    /* Gain well above 1, so the FIR output saturates too */
+    static const int16_t loud_fir[5] = {32767, 32767, -32768, 32767, 20000};
+    const struct {
+        const int16_t *coeffs;
+        unsigned int taps;
+        unsigned int factor;
+    } firs[] = {{fir_coeffs, 32, 4}, {fir_coeffs, 31, 3}, {fir_coeffs, 1, 1}, {loud_fir, 5, 2}};
+    static const unsigned int windows[] = {16, 10, 1};
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 0)
+            bench_fill(&input[1], CHECK_BLOCK);
+        else
+            check_fill_noise(&input[1], CHECK_BLOCK, 0xC0FFEE);
+
+        for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+        {
+            if (dsp_movavg_init(&movavg, windows[w]) < 0)
+                return -1;
+            dsp_movavg_process(&movavg, in, got, split);
+            dsp_movavg_process(&movavg, in + split, got + split, CHECK_BLOCK - split);
+            ref_movavg(in, want, CHECK_BLOCK, windows[w]);
+            if (check_equal("moving average", got, want, CHECK_BLOCK) < 0)
+                return -1;
+        }
+
+        for (unsigned int stages = 1; stages <= 2; stages++)
+        {
+            const dsp_biquad_coeffs_t *coeffs = pass == 0 ? bench_biquad : loud;
+
+            if (dsp_biquad_init(&biquad, coeffs, stages) < 0)
+                return -1;
+            dsp_biquad_process(&biquad, in, got, split);
+            dsp_biquad_process(&biquad, in + split, got + split, CHECK_BLOCK - split);
+            ref_biquad(coeffs, stages, in, want, CHECK_BLOCK);
+            if (check_equal("biquad", got, want, CHECK_BLOCK) < 0)
+                return -1;
+        }
+
+        for (size_t k = 0; k < sizeof(firs) / sizeof(firs[0]); k++)
+        {
+            size_t n, m;
+
+            if (dsp_fir_decim_init(&fir, firs[k].coeffs, firs[k].taps, firs[k].factor) < 0)
+                return -1;
+            n = dsp_fir_decim_process(&fir, in, got, split);
+            n += dsp_fir_decim_process(&fir, in + split, got + n, CHECK_BLOCK - split);
+            m = ref_fir_decim(firs[k].coeffs, firs[k].taps, firs[k].factor, in, want, CHECK_BLOCK);
+            if (n != m)
+            {
+                fprintf(stderr, "DSP self-check failed: FIR decimate, %zu outputs, expected %zu\n", n, m);
+                return -1;
+            }
+            if (check_equal("FIR decimate", got, want, n) < 0)
+                return -1;
+        }
+
+        for (size_t count = CHECK_BLOCK - 2; count <= CHECK_BLOCK; count++)
+        {
+            dsp_stats_t stats;
+            int16_t min = INT16_MAX, max = INT16_MIN;
+            int64_t sum = 0, sum_squares = 0;
+
+            dsp_stats_reset(&stats);
+            dsp_stats_update(&stats, in, split);
+            dsp_stats_update(&stats, in + split, count - split);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                min = in[i] < min ? in[i] : min;
+                max = in[i] > max ? in[i] : max;
+                sum += in[i];
+                sum_squares += (int32_t)in[i] * in[i];
+            }
+
+            if (stats.min != min || stats.max != max || stats.sum != sum || stats.sum_squares != sum_squares ||
+                stats.count != count)
+            {
+                fprintf(stderr, "DSP self-check failed: window statistics over %zu samples\n", count);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Benchmark every kernel on a fixed input block.
+ *
+ * The kernels are first checked against the scalar reference, then each
+ * runs back-to-back over the same block until @p seconds have elapsed; the
+ * clock is only read between blocks.
+ *
+ * @param seconds Approximate run time per kernel.
+ * @return 0 on success, -1 if a filter could not be initialized or a kernel
+ *         disagrees with the reference.
+ */
+int dsp_bench(double seconds)
+{
+    static int16_t in[BENCH_BLOCK];
+    static int16_t out[BENCH_BLOCK];
+    static dsp_movavg_t movavg;
+    static dsp_biquad_t biquad;
+    static dsp_fir_decim_t fir;
+    int16_t fir_coeffs[32];
+    double start, now;
+    double samples;
+
+    /* Triangular low-pass, taps sum to 1.0 in Q15 */
+    for (int i = 0; i < 32; i++)
+        fir_coeffs[i] = (int16_t)(((i < 16 ? i + 1 : 32 - i) * 32767) / 272);
+
+    if (dsp_movavg_init(&movavg, 16) < 0 ||
+        dsp_biquad_init(&biquad, bench_biquad, 2) < 0 ||
+        dsp_fir_decim_init(&fir, fir_coeffs, 32, 4) < 0)
+        return -1;
+
+    if (dsp_self_check(fir_coeffs) < 0)
+        return -1;
+
+    bench_fill(in, BENCH_BLOCK);
+
+    printf("DSP kernels: %s, bit-exact with the scalar reference\n", dsp_implementation());
+    printf("Throughput: %u-sample blocks, %.1f s each\n", BENCH_BLOCK, seconds);
+
+    samples = 0;
+    start = now = bench_now();
+    while (now - start < seconds)
+    {
+        dsp_movavg_process(&movavg, in, out, BENCH_BLOCK);
+        bench_sink += out[BENCH_BLOCK - 1];
+        samples += BENCH_BLOCK;
+        now = bench_now();
+    }
+    bench_report("moving average (16)", samples, now - start);
+
+    samples = 0;
+    start = now = bench_now();
+    while (now - start < seconds)
+    {
+        dsp_biquad_process(&biquad, in, out, BENCH_BLOCK);
+        bench_sink += out[BENCH_BLOCK - 1];
+        samples += BENCH_BLOCK;
+        now = bench_now();
+    }
+    bench_report("biquad (2 stages)", samples, now - start);
+
+    samples = 0;
+    start = now = bench_now();
+    while (now - start < seconds)
+    {
+        size_t n = dsp_fir_decim_process(&fir, in, out, BENCH_BLOCK);
+        bench_sink += out[n - 1];
+        samples += BENCH_BLOCK;
+        now = bench_now();
+    }
+    bench_report("FIR decimate (32 taps, /4)", samples, now - start);
+
+    samples = 0;
+    start = now = bench_now();
+    while (now - start < seconds)
+    {
+        dsp_stats_t stats;
+
+        dsp_stats_reset(&stats);
+        dsp_stats_update(&stats, in, BENCH_BLOCK);
+        bench_sink += dsp_stats_rms(&stats) + stats.min + stats.max;
+        samples += BENCH_BLOCK;
+        now = bench_now();
+    }
+    bench_report("min/max/RMS window", samples, now - start);
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+###############################################################################
+#
+# LIBEVLOOP package
+#
+###############################################################################
+
+# Package version and source location
+LIBEVLOOP_VERSION = 1.0
+LIBEVLOOP_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libevloop/project
+LIBEVLOOP_SITE_METHOD = local
+
+# Header and archive go to staging, where the examples link against them
+LIBEVLOOP_INSTALL_STAGING = YES
+LIBEVLOOP_INSTALL_TARGET = NO
+
+# Build commands
+define LIBEVLOOP_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(TARGET_AR)" \
+		CFLAGS="$(TARGET_CFLAGS) -ffunction-sections -fdata-sections" \
+		-C $(@D)
+endef
+
+# Install the header and archive for other packages to build against
+define LIBEVLOOP_INSTALL_STAGING_CMDS
+	$(INSTALL) -D -m 0644 $(@D)/include/libevloop/evloop.h $(STAGING_DIR)/usr/include/libevloop/evloop.h
+	$(INSTALL) -D -m 0644 $(@D)/bin/libevloop.a $(STAGING_DIR)/usr/lib/libevloop.a
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,87 @@
+// include/libevloop/evloop.h
+//
+// Single-threaded event loop: one epoll set, one timerfd and a hierarchical
+// timer wheel. Timers and fd watchers are embedded in the caller's structs,
+// so starting, stopping and cancelling never allocate.
+
+#ifndef EVLOOP_H
+#define EVLOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Wheel geometry: 5 levels of 64 slots covers 2^30 ticks (~30 h at 100 us) */
+#define EVLOOP_WHEEL_BITS 6
+#define EVLOOP_WHEEL_SLOTS (1u << EVLOOP_WHEEL_BITS)
+#define EVLOOP_WHEEL_LEVELS 5
+
+#define EVLOOP_DEFAULT_TICK_US 100
+#define EVLOOP_MAX_EVENTS 8
+
+typedef struct evloop evloop_t;
+typedef struct evloop_timer evloop_timer_t;
+typedef struct evloop_io evloop_io_t;
+
+typedef void (*evloop_timer_cb)(evloop_t *loop, evloop_timer_t *timer, void *arg);
+typedef void (*evloop_io_cb)(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg);
+
+/* Intrusive list node; slot heads are sentinels */
+typedef struct evloop_link {
+    struct evloop_link *next;
+    struct evloop_link *prev;
+} evloop_link_t;
+
+struct evloop_timer {
+    evloop_link_t link;         /* Must stay first */
+    uint64_t expires;           /* Absolute tick */
+    uint64_t interval;          /* Ticks between periodic expiries, 0 for one-shot */
+    uint16_t slot;              /* level * EVLOOP_WHEEL_SLOTS + index while active */
+    bool active;
+    evloop_timer_cb cb;
+    void *arg;
+};
+
+struct evloop_io {
+    int fd;
+    evloop_io_cb cb;
+    void *arg;
+};
+
+struct evloop {
+    int epfd;
+    int tfd;
+    evloop_io_t timer_io;
+    uint64_t origin_ns;         /* CLOCK_MONOTONIC of tick 0 */
+    uint64_t tick_ns;
+    uint64_t now;               /* Next tick to process, all earlier ones are done */
+    uint64_t armed;             /* Tick the timerfd is armed for, UINT64_MAX if none */
+    unsigned int timers;        /* Active timers */
+    bool running;
+    uint64_t occupied[EVLOOP_WHEEL_LEVELS];
+    evloop_link_t wheel[EVLOOP_WHEEL_LEVELS][EVLOOP_WHEEL_SLOTS];
+};
+
+/* Loop */
+int evloop_init(evloop_t *loop, unsigned int tick_us);
+void evloop_close(evloop_t *loop);
+int evloop_run(evloop_t *loop);
+int evloop_run_once(evloop_t *loop, bool block);
+void evloop_stop(evloop_t *loop);
+uint64_t evloop_now_us(const evloop_t *loop);
+
+/* Timers: delays are rounded up to whole ticks, so timers never fire early */
+void evloop_timer_init(evloop_timer_t *timer, evloop_timer_cb cb, void *arg);
+int evloop_timer_start(evloop_t *loop, evloop_timer_t *timer, uint64_t delay_us, uint64_t interval_us);
+void evloop_timer_cancel(evloop_t *loop, evloop_timer_t *timer);
+static inline bool evloop_timer_active(const evloop_timer_t *timer) { return timer->active; }
+
+/* File descriptors: <events> is an EPOLLIN/EPOLLOUT/... mask */
+void evloop_io_init(evloop_io_t *io, int fd, evloop_io_cb cb, void *arg);
+int evloop_io_add(evloop_t *loop, evloop_io_t *io, uint32_t events);
+int evloop_io_modify(evloop_t *loop, evloop_io_t *io, uint32_t events);
+int evloop_io_remove(evloop_t *loop, evloop_io_t *io);
+
+/* Benchmark */
+int evloop_bench(unsigned int timers);
+
+#endif // EVLOOP_H
@@ -0,0 +1,466 @@
+// src/libevloop/evloop.c
+//
+// Timer wheel after Varghese & Lauck: level L slot i holds timers that are
+// 64^L..64^(L+1) ticks away and whose expiry tick has bits [6L, 6L+6) == i.
+// When the wheel reaches the start of a level L slot its timers cascade one
+// or more levels down; level 0 slots hold timers for exactly one tick.
+// A per-level occupancy bitmap finds the next tick with work in O(levels),
+// which is what the single timerfd is armed for.
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "libevloop/evloop.h"
+
+#define NSEC_PER_SEC 1000000000ull
+#define NO_TICK UINT64_MAX
+#define SLOT_MASK (EVLOOP_WHEEL_SLOTS - 1)
+#define LEVEL_SHIFT(level) ((level) * EVLOOP_WHEEL_BITS)
+#define WHEEL_SPAN (1ull << LEVEL_SHIFT(EVLOOP_WHEEL_LEVELS))
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t current_tick(const evloop_t *loop)
+{
+    return (monotonic_ns() - loop->origin_ns) / loop->tick_ns;
+}
+
+/* -------------------- Lists -------------------- */
+
+static inline void link_init(evloop_link_t *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static inline void link_append(evloop_link_t *head, evloop_link_t *node)
+{
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+static inline void link_remove(evloop_link_t *node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = node->prev = node;
+}
+
+/* -------------------- Wheel -------------------- */
+
+/**
+ * @brief Hash a timer into its slot relative to loop->now. O(1).
+ */
+static void wheel_insert(evloop_t *loop, evloop_timer_t *timer)
+{
+    uint64_t expires = timer->expires < loop->now ? loop->now : timer->expires;
+    uint64_t delta = expires - loop->now;
+    unsigned int level = 0;
+
+    /* Beyond the wheel: park in the top level, re-hashed when it cascades */
+    if (delta >= WHEEL_SPAN)
+    {
+        delta = WHEEL_SPAN - 1;
+        expires = loop->now + delta;
+    }
+
+    while (level < EVLOOP_WHEEL_LEVELS - 1 && delta >= (1ull << LEVEL_SHIFT(level + 1)))
+        level++;
+
+    unsigned int index = (unsigned int)(expires >> LEVEL_SHIFT(level)) & SLOT_MASK;
+
+    timer->slot = (uint16_t)(level * EVLOOP_WHEEL_SLOTS + index);
+    link_append(&loop->wheel[level][index], &timer->link);
+    loop->occupied[level] |= 1ull << index;
+}
+
+/**
+ * @brief Unlink a timer from its slot. O(1).
+ */
+static void wheel_remove(evloop_t *loop, evloop_timer_t *timer)
+{
+    unsigned int level = timer->slot / EVLOOP_WHEEL_SLOTS;
+    unsigned int index = timer->slot % EVLOOP_WHEEL_SLOTS;
+    evloop_link_t *head = &loop->wheel[level][index];
+
+    link_remove(&timer->link);
+    if (head->next == head)
+        loop->occupied[level] &= ~(1ull << index);
+}
+
+/**
+ * @brief Offset of the first set bit at or after <start>, cyclically.
+ */
+static inline unsigned int next_bit(uint64_t bitmap, unsigned int start)
+{
+    uint64_t rotated = start ? (bitmap >> start) | (bitmap << (EVLOOP_WHEEL_SLOTS - start)) : bitmap;
+    return (unsigned int)__builtin_ctzll(rotated);
+}
+
+/**
+ * @brief Earliest tick at which the wheel has work: a level 0 slot to
+ * expire or a higher level slot to cascade.
+ *
+ * @return Tick, or NO_TICK when no timers are pending.
+ */
+static uint64_t wheel_next_tick(const evloop_t *loop)
+{
+    uint64_t next = NO_TICK;
+
+    for (unsigned int level = 0; level < EVLOOP_WHEEL_LEVELS; level++)
+    {
+        if (!loop->occupied[level])
+            continue;
+
+        /* First slot boundary of this level at or after now */
+        unsigned int shift = LEVEL_SHIFT(level);
+        uint64_t base = (loop->now + (1ull << shift) - 1) >> shift;
+        unsigned int offset = next_bit(loop->occupied[level], (unsigned int)base & SLOT_MASK);
+        uint64_t tick = (base + offset) << shift;
+
+        if (tick < next)
+            next = tick;
+    }
+
+    return next;
+}
+
+/**
+ * @brief Move the timers of a level >= 1 slot to lower levels.
+ */
+static void wheel_cascade(evloop_t *loop, unsigned int level, unsigned int index)
+{
+    evloop_link_t pending;
+    evloop_link_t *head = &loop->wheel[level][index];
+
+    if (head->next == head)
+        return;
+
+    /* Detach the slot first: re-hashing may land in the same slot */
+    pending.next = head->next;
+    pending.prev = head->prev;
+    pending.next->prev = &pending;
+    pending.prev->next = &pending;
+    link_init(head);
+    loop->occupied[level] &= ~(1ull << index);
+
+    while (pending.next != &pending)
+    {
+        evloop_timer_t *timer = (evloop_timer_t *)pending.next;
+        link_remove(&timer->link);
+        wheel_insert(loop, timer);
+    }
+}
+
+/**
+ * @brief Process one tick: cascade, then run the timers due now.
+ *
+ * Periodic timers are re-inserted before their callback so the callback
+ * may cancel or restart them.
+ */
+static void wheel_process(evloop_t *loop)
+{
+    uint64_t tick = loop->now;
+
+    for (unsigned int level = 1; level < EVLOOP_WHEEL_LEVELS; level++)
+    {
+        if (tick & ((1ull << LEVEL_SHIFT(level)) - 1))
+            break;
+        wheel_cascade(loop, level, (unsigned int)(tick >> LEVEL_SHIFT(level)) & SLOT_MASK);
+    }
+
+    evloop_link_t *head = &loop->wheel[0][tick & SLOT_MASK];
+    while (head->next != head)
+    {
+        evloop_timer_t *timer = (evloop_timer_t *)head->next;
+
+        wheel_remove(loop, timer);
+        if (timer->interval)
+        {
+            /* Keep the phase, but skip periods missed while the loop was busy */
+            timer->expires += timer->interval;
+            if (timer->expires <= tick)
+                timer->expires = tick + timer->interval;
+            wheel_insert(loop, timer);
+        }
+        else
+        {
+            timer->active = false;
+            loop->timers--;
+        }
+
+        timer->cb(loop, timer, timer->arg);
+    }
+
+    loop->now = tick + 1;
+}
+
+/**
+ * @brief Run every tick up to and including <target>, skipping idle ones.
+ */
+static void wheel_advance(evloop_t *loop, uint64_t target)
+{
+    while (loop->now <= target)
+    {
+        uint64_t next = wheel_next_tick(loop);
+
+        if (next > target)
+        {
+            loop->now = target + 1;
+            break;
+        }
+
+        loop->now = next;
+        wheel_process(loop);
+    }
+}
+
+/**
+ * @brief Arm the timerfd for the next tick with work, if it changed.
+ */
+static int rearm(evloop_t *loop)
+{
+    uint64_t next = wheel_next_tick(loop);
+    struct itimerspec its;
+
+    if (next == loop->armed)
+        return 0;
+
+    memset(&its, 0, sizeof(its));
+    if (next != NO_TICK)
+    {
+        uint64_t at = loop->origin_ns + next * loop->tick_ns;
+        its.it_value.tv_sec = (time_t)(at / NSEC_PER_SEC);
+        its.it_value.tv_nsec = (long)(at % NSEC_PER_SEC);
+    }
+
+    if (timerfd_settime(loop->tfd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+        return -1;
+
+    loop->armed = next;
+    return 0;
+}
+
+/* -------------------- Loop -------------------- */
+
+static void timerfd_ready(evloop_t *loop, evloop_io_t *io, uint32_t events, void *arg)
+{
+    uint64_t expirations;
+
+    (void)events;
+    (void)arg;
+    if (read(io->fd, &expirations, sizeof(expirations)) < 0)
+        return;
+    loop->armed = NO_TICK;
+}
+
+/**
+ * @brief Create the epoll set and timerfd.
+ *
+ * @param loop Loop to initialize.
+ * @param tick_us Wheel resolution, 0 for EVLOOP_DEFAULT_TICK_US.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int evloop_init(evloop_t *loop, unsigned int tick_us)
+{
+    memset(loop, 0, sizeof(*loop));
+    loop->tick_ns = (uint64_t)(tick_us ? tick_us : EVLOOP_DEFAULT_TICK_US) * 1000;
+    loop->origin_ns = monotonic_ns();
+    loop->armed = NO_TICK;
+    loop->epfd = -1;
+    loop->tfd = -1;
+
+    for (unsigned int level = 0; level < EVLOOP_WHEEL_LEVELS; level++)
+        for (unsigned int i = 0; i < EVLOOP_WHEEL_SLOTS; i++)
+            link_init(&loop->wheel[level][i]);
+
+    loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epfd < 0)
+        return -1;
+
+    loop->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (loop->tfd < 0)
+        goto fail;
+
+    evloop_io_init(&loop->timer_io, loop->tfd, timerfd_ready, NULL);
+    if (evloop_io_add(loop, &loop->timer_io, EPOLLIN) < 0)
+        goto fail;
+
+    return 0;
+
+fail:
+    {
+        int saved_errno = errno;
+        evloop_close(loop);
+        errno = saved_errno;
+    }
+    return -1;
+}
+
+/**
+ * @brief Close the loop's descriptors. Timers are simply forgotten.
+ */
+void evloop_close(evloop_t *loop)
+{
+    if (loop->tfd >= 0)
+        close(loop->tfd);
+    if (loop->epfd >= 0)
+        close(loop->epfd);
+    loop->tfd = -1;
+    loop->epfd = -1;
+}
+
+/**
+ * @brief Wait for events once and dispatch them.
+ *
+ * @param loop Loop.
+ * @param block Wait for the next event instead of polling.
+ * @return Number of fd events handled, -1 on error with errno set.
+ */
+int evloop_run_once(evloop_t *loop, bool block)
+{
+    struct epoll_event events[EVLOOP_MAX_EVENTS];
+
+    if (rearm(loop) < 0)
+        return -1;
+
+    int n = epoll_wait(loop->epfd, events, EVLOOP_MAX_EVENTS, block ? -1 : 0);
+    if (n < 0)
+        return errno == EINTR ? 0 : -1;
+
+    for (int i = 0; i < n; i++)
+    {
+        evloop_io_t *io = events[i].data.ptr;
+        io->cb(loop, io, events[i].events, io->arg);
+    }
+
+    wheel_advance(loop, current_tick(loop));
+    return n;
+}
+
+/**
+ * @brief Dispatch events until evloop_stop() is called.
+ *
+ * @return 0 when stopped, -1 on error with errno set.
+ */
+int evloop_run(evloop_t *loop)
+{
+    loop->running = true;
+    while (loop->running)
+        if (evloop_run_once(loop, true) < 0)
+            return -1;
+    return 0;
+}
+
+void evloop_stop(evloop_t *loop)
+{
+    loop->running = false;
+}
+
+/**
+ * @brief Microseconds since evloop_init().
+ */
+uint64_t evloop_now_us(const evloop_t *loop)
+{
+    return (monotonic_ns() - loop->origin_ns) / 1000;
+}
+
+/* -------------------- Timers -------------------- */
+
+void evloop_timer_init(evloop_timer_t *timer, evloop_timer_cb cb, void *arg)
+{
+    memset(timer, 0, sizeof(*timer));
+    link_init(&timer->link);
+    timer->cb = cb;
+    timer->arg = arg;
+}
+
+/**
+ * @brief Start (or restart) a timer. O(1), no system call.
+ *
+ * @param loop Loop.
+ * @param timer Initialized timer.
+ * @param delay_us Time to the first expiry.
+ * @param interval_us Period of later expiries, 0 for a one-shot timer.
+ * @return 0 on success, -1 if the loop is not usable (errno EBADF).
+ */
+int evloop_timer_start(evloop_t *loop, evloop_timer_t *timer, uint64_t delay_us, uint64_t interval_us)
+{
+    uint64_t tick_us = loop->tick_ns / 1000;
+
+    if (loop->epfd < 0)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    evloop_timer_cancel(loop, timer);
+
+    /* First tick boundary at or after now + delay */
+    uint64_t due_ns = monotonic_ns() - loop->origin_ns + delay_us * 1000;
+    timer->expires = (due_ns + loop->tick_ns - 1) / loop->tick_ns;
+    timer->interval = interval_us ? (interval_us + tick_us - 1) / tick_us : 0;
+    timer->active = true;
+    loop->timers++;
+
+    wheel_insert(loop, timer);
+    return 0;
+}
+
+/**
+ * @brief Stop a timer if it is active. O(1), no system call.
+ */
+void evloop_timer_cancel(evloop_t *loop, evloop_timer_t *timer)
+{
+    if (!timer->active)
+        return;
+
+    wheel_remove(loop, timer);
+    timer->active = false;
+    loop->timers--;
+}
+
+/* -------------------- File Descriptors -------------------- */
+
+void evloop_io_init(evloop_io_t *io, int fd, evloop_io_cb cb, void *arg)
+{
+    io->fd = fd;
+    io->cb = cb;
+    io->arg = arg;
+}
+
+static int io_ctl(evloop_t *loop, int op, evloop_io_t *io, uint32_t events)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = io;
+    return epoll_ctl(loop->epfd, op, io->fd, &ev);
+}
+
+int evloop_io_add(evloop_t *loop, evloop_io_t *io, uint32_t events)
+{
+    return io_ctl(loop, EPOLL_CTL_ADD, io, events);
+}
+
+int evloop_io_modify(evloop_t *loop, evloop_io_t *io, uint32_t events)
+{
+    return io_ctl(loop, EPOLL_CTL_MOD, io, events);
+}
+
+int evloop_io_remove(evloop_t *loop, evloop_io_t *io)
+{
+    return io_ctl(loop, EPOLL_CTL_DEL, io, 0);
+}
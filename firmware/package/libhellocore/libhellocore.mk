@@ -0,0 +1,54 @@
+###############################################################################
+#
+# LIBHELLOCORE package
+#
+###############################################################################
+
+# Package version and source location
+LIBHELLOCORE_VERSION = 1.0
+LIBHELLOCORE_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libhellocore/project
+LIBHELLOCORE_SITE_METHOD = local
+
+# Headers and archive go to staging, where hellomk and hellomkcpp link
+# against them
+LIBHELLOCORE_INSTALL_STAGING = YES
+LIBHELLOCORE_INSTALL_TARGET = NO
+
+LIBHELLOCORE_HEADERS = libconfig/config.h libconfig/config_image.h libconfig/config_watch.h \
+	libtime/time_format.h libmath/math_batch.h libmath/fixed_point.h
+
+# Build commands
+define LIBHELLOCORE_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(TARGET_AR)" \
+		CFLAGS="$(TARGET_CFLAGS) -ffunction-sections -fdata-sections" \
+		-C $(@D)
+endef
+
+# Install the headers and archive for other packages to build against
+define LIBHELLOCORE_INSTALL_STAGING_CMDS
+	for header in $(LIBHELLOCORE_HEADERS); do \
+		$(INSTALL) -D -m 0644 $(@D)/include/$$header $(STAGING_DIR)/usr/include/$$header || exit 1; \
+	done
+	$(INSTALL) -D -m 0644 $(@D)/bin/libhellocore.a $(STAGING_DIR)/usr/lib/libhellocore.a
+endef
+
+# Host build provides the INI compiler that pre-builds the binary images
+# /etc/hellomk.ini.cache and /etc/hellomkcpp.ini.cache, so the first boot
+# does not parse the INI
+define HOST_LIBHELLOCORE_BUILD_CMDS
+	$(MAKE) \
+		CC="$(HOSTCC)" \
+		CFLAGS="$(HOST_CFLAGS)" \
+		LDFLAGS="$(HOST_LDFLAGS)" \
+		-C $(@D) tools
+endef
+
+define HOST_LIBHELLOCORE_INSTALL_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/ini2cache $(HOST_DIR)/bin/ini2cache
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
+$(eval $(host-generic-package))
@@ -0,0 +1,90 @@
+// include/libconfig/config.h
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One "section.key = value" pair; offsets point into the string arena
+typedef struct {
+    uint32_t hash;          // FNV-1a of "section.key"
+    uint32_t key;           // Offset of "section.key\0"
+    uint32_t sectionLength; // Length of the section part of the key
+    uint32_t value;         // Offset of "value\0"
+    uint32_t valueLength;
+} config_entry_t;
+
+// Typed value cache, private to config.c
+struct config_cache;
+
+// Parsed INI file: entries, hash index and strings share one allocation.
+// The store is immutable after config_load(), so any number of threads may
+// read it concurrently; the typed value cache is filled lock-free.
+typedef struct {
+    struct config_cache* cache;
+    config_entry_t* entries;
+    uint32_t* index;        // Open addressing, entry number + 1, 0 = empty
+    char* strings;
+    size_t count;
+    size_t indexMask;       // Index size - 1 (power of two)
+    size_t stringsSize;     // Bytes of strings in use
+    size_t size;            // Bytes allocated or mapped
+
+    // Entries, index and strings living outside the allocation (cache image)
+    void* storage;
+    size_t storageSize;
+    int storageMapped;      // munmap() rather than free() the storage
+} config_t;
+
+// Parse <filename> once; returns NULL with errno set on failure
+config_t* config_load(const char* filename);
+
+// Parse INI text already in memory
+config_t* config_parse(const char* text, size_t length);
+
+// Build a store around entries, index and strings laid out by <layout> in
+// <storage> (a cache image) without copying them. The storage is released
+// with the store. Returns NULL with errno set on failure.
+config_t* config_adopt(const config_t* layout, void* storage, size_t storageSize, int mapped);
+void config_free(config_t* cfg);
+
+// O(1) lookup without I/O, returning a view into the store that stays valid
+// until config_free(). Stores the value length in <length> if not NULL.
+// Returns NULL with errno = ENOENT if the key does not exist.
+const char* config_get(const config_t* cfg, const char* section, const char* key, size_t* length);
+
+// config_get() without the length
+const char* config_lookup(const config_t* cfg, const char* section, const char* key);
+
+// Typed getters. Each value is parsed on first use and cached. Return 0 on
+// success, -1 with errno = ENOENT (missing key) or EINVAL (malformed value).
+int config_get_int(const config_t* cfg, const char* section, const char* key, int64_t* value);
+int config_get_bool(const config_t* cfg, const char* section, const char* key, int* value);
+int config_get_double(const config_t* cfg, const char* section, const char* key, double* value);
+
+// Duration in microseconds: a number with an optional us, ms, s, m or h
+// suffix; a bare number means seconds ("250ms", "1.5s", "2m", "30")
+int config_get_duration_us(const config_t* cfg, const char* section, const char* key, uint64_t* value);
+
+size_t config_count(const config_t* cfg);
+size_t config_memory(const config_t* cfg);
+
+// Per-lookup reader of the calling program, e.g. getConfigValue()
+typedef const char* (*config_legacy_get_fn)(const char* filename, const char* section, const char* key);
+
+// Compare config_load/config_lookup with <legacyGet> on a generated file
+int config_bench(unsigned int keys, config_legacy_get_fn legacyGet);
+
+// Hammer one store from <threads> threads for <seconds>, verifying every read
+int config_stress(unsigned int threads, unsigned int seconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONFIG_H
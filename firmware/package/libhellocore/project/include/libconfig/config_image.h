@@ -0,0 +1,61 @@
+// include/libconfig/config_image.h
+
+#ifndef CONFIG_IMAGE_H
+#define CONFIG_IMAGE_H
+
+#include <stdint.h>
+
+#include "libconfig/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONFIG_IMAGE_MAGIC "HCFG"
+#define CONFIG_IMAGE_VERSION 1
+#define CONFIG_IMAGE_BYTE_ORDER 0x01020304u
+#define CONFIG_IMAGE_SUFFIX ".cache"
+
+// Binary image of a parsed store: this header followed by the entries, the
+// hash index and the strings exactly as config_parse() lays them out, so the
+// file can be mapped and queried in place. All fields are 32-bit and in the
+// producer's byte order; a reader with a different order rejects the file.
+typedef struct {
+    char magic[4];          // CONFIG_IMAGE_MAGIC
+    uint32_t byteOrder;     // CONFIG_IMAGE_BYTE_ORDER
+    uint32_t version;       // CONFIG_IMAGE_VERSION
+    uint32_t count;         // Entries
+    uint32_t indexSize;     // Index slots, a power of two
+    uint32_t stringsSize;   // Bytes of strings
+
+    // The INI the image was built from, to detect a stale image
+    uint32_t sourceSize;
+    uint32_t sourceMtime;   // Seconds, low 32 bits
+    uint32_t sourceHash;    // FNV-1a of the whole file
+    uint32_t reserved;
+} config_image_header_t;
+
+// Parse <iniPath> and write its image to <imagePath> (replaced atomically).
+// Returns 0 on success, -1 with errno set on failure.
+int config_image_compile(const char* iniPath, const char* imagePath);
+
+// Map <imagePath> and use it in place. When <iniPath> is given the image
+// must match it: same size and mtime, or failing that (e.g. a filesystem
+// that does not keep mtimes) the same content hash. A missing INI is not an
+// error. Returns NULL with errno = ESTALE for an outdated image, EINVAL for a
+// malformed one, or the errno of a failed open.
+config_t* config_image_open(const char* imagePath, const char* iniPath);
+
+// Open <iniPath> through its image at <iniPath>.cache: use the image when it
+// is current, otherwise parse the INI and try to rewrite the image for the
+// next start. <fromImage>, if not NULL, reports which path was taken.
+config_t* config_open(const char* iniPath, int* fromImage);
+
+// Compare cold-start time of the INI and image paths on a generated file
+int config_image_bench(unsigned int keys);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONFIG_IMAGE_H
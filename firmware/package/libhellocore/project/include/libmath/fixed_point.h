@@ -0,0 +1,132 @@
+// include/libmath/fixed_point.h
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fixed-point arithmetic for the soft-float target, where every double
+// operation is a libgcc call. Formats:
+//
+//   q15_t       Q0.15 in int16_t, [-1, 1)
+//   q31_t       Q0.31 in int32_t, [-1, 1)
+//   q16_16_t    Q16.16 in int32_t, [-32768, 32768)
+//   fx_angle_t  binary angle, 65536 is one full turn
+//
+// Arithmetic saturates to the format's range instead of wrapping, and
+// products and quotients round to nearest.
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int32_t q16_16_t;
+typedef uint16_t fx_angle_t;
+
+#define Q15_MAX INT16_MAX
+#define Q15_MIN INT16_MIN
+#define Q31_MAX INT32_MAX
+#define Q31_MIN INT32_MIN
+#define Q16_16_MAX INT32_MAX
+#define Q16_16_MIN INT32_MIN
+#define Q16_16_ONE 65536
+
+#define FX_ANGLE_QUARTER 16384 // 90 degrees
+
+// Constants from a literal, e.g. Q15(0.5) or Q16_16(-2.25), saturated and
+// rounded. Only for constant expressions: with a variable this is soft-float.
+#define FX_ROUND_(x) ((x) >= 0 ? (x) + 0.5 : (x) - 0.5)
+#define Q15(x) ((q15_t)((x) >= 1.0 ? Q15_MAX : (x) <= -1.0 ? Q15_MIN : FX_ROUND_((x) * 32768.0)))
+#define Q31(x) ((q31_t)((x) >= 1.0 ? Q31_MAX : (x) <= -1.0 ? Q31_MIN : FX_ROUND_((x) * 2147483648.0)))
+#define Q16_16(x)                                                                                   \
+    ((q16_16_t)((x) >= 32768.0 ? Q16_16_MAX : (x) <= -32768.0 ? Q16_16_MIN : FX_ROUND_((x) * 65536.0)))
+
+static inline q15_t q15_saturate(int32_t value) {
+    return (q15_t)(value > Q15_MAX ? Q15_MAX : value < Q15_MIN ? Q15_MIN : value);
+}
+
+static inline int32_t q31_saturate(int64_t value) {
+    return (int32_t)(value > INT32_MAX ? INT32_MAX : value < INT32_MIN ? INT32_MIN : value);
+}
+
+static inline q15_t q15_add(q15_t a, q15_t b) {
+    return q15_saturate((int32_t)a + b);
+}
+
+static inline q15_t q15_sub(q15_t a, q15_t b) {
+    return q15_saturate((int32_t)a - b);
+}
+
+// Only -1 * -1 saturates
+static inline q15_t q15_mul(q15_t a, q15_t b) {
+    return q15_saturate(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+static inline q31_t q31_add(q31_t a, q31_t b) {
+    return q31_saturate((int64_t)a + b);
+}
+
+static inline q31_t q31_sub(q31_t a, q31_t b) {
+    return q31_saturate((int64_t)a - b);
+}
+
+// One SMULL on the Cortex-M4
+static inline q31_t q31_mul(q31_t a, q31_t b) {
+    return q31_saturate(((int64_t)a * b + (1LL << 30)) >> 31);
+}
+
+static inline q16_16_t q16_16_add(q16_16_t a, q16_16_t b) {
+    return q31_saturate((int64_t)a + b);
+}
+
+static inline q16_16_t q16_16_sub(q16_16_t a, q16_16_t b) {
+    return q31_saturate((int64_t)a - b);
+}
+
+static inline q16_16_t q16_16_mul(q16_16_t a, q16_16_t b) {
+    return q31_saturate(((int64_t)a * b + (1 << 15)) >> 16);
+}
+
+static inline q16_16_t q16_16_from_int(int32_t value) {
+    return q31_saturate((int64_t)value * Q16_16_ONE);
+}
+
+// Rounds to nearest
+static inline int32_t q16_16_to_int(q16_16_t value) {
+    return (int32_t)(((int64_t)value + (1 << 15)) >> 16);
+}
+
+static inline q16_16_t q15_to_q16_16(q15_t value) {
+    return (q16_16_t)value * 2;
+}
+
+static inline q15_t q16_16_to_q15(q16_16_t value) {
+    return q15_saturate((int32_t)(((int64_t)value + 1) >> 1));
+}
+
+// a / b; a zero divisor saturates towards the sign of <a>
+q16_16_t q16_16_div(q16_16_t a, q16_16_t b);
+
+// Square root, 0 for negative input; exact to the last bit
+q16_16_t q16_16_sqrt(q16_16_t value);
+
+// Sine and cosine from a 129-entry quarter-wave table with linear
+// interpolation, within 2 LSB
+q15_t q15_sin(fx_angle_t angle);
+q15_t q15_cos(fx_angle_t angle);
+
+// Angle of the vector (x, y). Only the ratio matters, so any common format
+// works. Table-based, within 0.01 degrees; 0 for (0, 0).
+fx_angle_t fx_atan2(int32_t y, int32_t x);
+
+// Fixed-point against double throughput and accuracy; implemented by each
+// program (src/libmath/fixed_point_bench.c, fixed_bench.cpp)
+int fixed_point_bench(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,51 @@
+// include/libmath/math_batch.h
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Array forms of the math_operations.h functions for sensor post-processing.
+// out[i] = a[i] op b[i] for i < n; out may alias a or b but the inputs must
+// not otherwise overlap it. The loops are written to auto-vectorize on the
+// host; on Cortex-M4 the saturating forms use the DSP extension. Floating
+// point work is done in float: single precision is much cheaper than double
+// with the soft-float toolchain and maps to the M4 FPU when it is enabled.
+
+// Bytes of a mask with one bit per element, bit i%8 of byte i/8
+#define MATH_MASK_BYTES(n) (((n) + 7) / 8)
+
+// Wrapping integer arithmetic, like add()/subtract()
+void math_add_n(const int* a, const int* b, int* out, size_t n);
+void math_sub_n(const int* a, const int* b, int* out, size_t n);
+
+void math_mul_n(const float* a, const float* b, float* out, size_t n);
+
+// out[i] = a[i] * b[i] + c[i]
+void math_fma_n(const float* a, const float* b, const float* c, float* out, size_t n);
+
+// out[i] = a[i] / b[i], or 0 where b[i] is zero. Those elements are flagged
+// in <zeroMask> (MATH_MASK_BYTES(n) bytes, may be NULL). Returns how many
+// divisors were zero.
+size_t math_div_n(const float* a, const float* b, float* out, uint8_t* zeroMask, size_t n);
+
+// Saturating arithmetic: results are clamped to the type's range
+void math_add_sat_i16_n(const int16_t* a, const int16_t* b, int16_t* out, size_t n);
+void math_sub_sat_i16_n(const int16_t* a, const int16_t* b, int16_t* out, size_t n);
+void math_add_sat_i32_n(const int32_t* a, const int32_t* b, int32_t* out, size_t n);
+void math_sub_sat_i32_n(const int32_t* a, const int32_t* b, int32_t* out, size_t n);
+
+// Scalar against batch throughput over arrays of <n> elements; implemented
+// by each program against its own scalar functions
+int math_batch_bench(size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATH_BATCH_H
@@ -0,0 +1,45 @@
+// include/libtime/time_format.h
+
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Longest result: "YYYY-MM-DDTHH:MM:SS.nnnnnnnnn+hh:mm" plus the terminator
+#define TIME_FORMAT_MAX_LENGTH 36
+
+// Per-caller cache of the formatted date and time of one second. Each thread
+// (or logger) keeps its own, so formatting needs no locks or static buffers.
+typedef struct {
+    time_t second;          // Second described by prefix/offset, -1 if none
+    char prefix[19];        // "YYYY-MM-DDTHH:MM:SS", not terminated
+    char offset[7];         // "+hh:mm" or "Z"
+    size_t offsetLength;
+} time_format_cache_t;
+
+void time_format_init(time_format_cache_t* cache);
+
+// Write <ts> as ISO-8601 local time with <digits> (0-9) fractional digits,
+// e.g. "2024-05-01T12:34:56.123456+02:00". localtime_r() only runs when the
+// second differs from the previous call. Returns the length written, or 0
+// if <size> is too small.
+size_t time_format_iso8601(time_format_cache_t* cache, const struct timespec* ts, int digits,
+                           char* buf, size_t size);
+
+// Same for CLOCK_REALTIME now
+size_t time_format_now(time_format_cache_t* cache, int digits, char* buf, size_t size);
+
+// Formats per second of the old and new paths; implemented by each program
+// against its own currentTime()
+int time_format_bench(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIME_FORMAT_H
@@ -0,0 +1,460 @@
+// src/libconfig/config.c
+//
+// Parse-once configuration store. The file is read with a single read(),
+// parsed in two passes (count, then fill) and laid out in one allocation:
+//
+//   [ typed cache | entries | hash index | "section.key\0value\0" strings ]
+//
+// Lookups hash the section and key in place and probe the index, so they
+// never touch the file or copy anything. Nothing but the typed cache is
+// written after config_load(), which makes concurrent reads safe without
+// locks; cache slots are claimed with a compare-and-swap.
+
+#include "libconfig/config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+// Cache slot states: empty, being filled, or filled with one type
+#define CACHE_EMPTY 0u
+#define CACHE_BUSY 1u
+#define CACHE_READY 2u
+#define CACHE_VALID 4u
+#define CACHE_TYPE_SHIFT 4
+
+typedef enum {
+    CONFIG_TYPE_INT = 1,
+    CONFIG_TYPE_BOOL,
+    CONFIG_TYPE_DOUBLE,
+    CONFIG_TYPE_DURATION
+} configType_t;
+
+typedef union {
+    int64_t i;
+    double d;
+    uint64_t us;
+} configValue_t;
+
+// One slot per entry. The first typed getter to reach an entry owns the slot;
+// other types are parsed on every call, which only happens if a key is read
+// as two different types.
+struct config_cache {
+    _Atomic uint32_t state;
+    uint32_t reserved;
+    configValue_t value;
+};
+
+static uint32_t fnv1a(uint32_t hash, const char* str, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Hash of "section.key" without building the string
+static uint32_t keyHash(const char* section, size_t sectionLength, const char* key, size_t keyLength) {
+    uint32_t hash = fnv1a(FNV_OFFSET, section, sectionLength);
+    hash = fnv1a(hash, ".", 1);
+    return fnv1a(hash, key, keyLength);
+}
+
+static int isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Trim blanks from both ends of [*start, *end)
+static void trim(const char** start, const char** end) {
+    while (*start < *end && isBlank(**start)) (*start)++;
+    while (*end > *start && isBlank(*(*end - 1))) (*end)--;
+}
+
+// Read a whole file into a NUL-terminated heap buffer
+static char* readFile(const char* filename, size_t* length) {
+    struct stat st;
+    char* data = NULL;
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &st) == 0 && (data = malloc((size_t)st.st_size + 1)) != NULL) {
+        size_t done = 0;
+        while (done < (size_t)st.st_size) {
+            ssize_t n = read(fd, data + done, (size_t)st.st_size - done);
+            if (n <= 0) break;
+            done += (size_t)n;
+        }
+        data[done] = '\0';
+        *length = done;
+    }
+
+    int savedErrno = errno;
+    close(fd);
+    errno = savedErrno;
+    return data;
+}
+
+// Parsing callback: one key/value pair with trimmed [start, end) ranges
+typedef void (*pairFn)(void* ctx, const char* section, size_t sectionLength,
+                       const char* key, size_t keyLength, const char* value, size_t valueLength);
+
+// Walk the INI text with the same rules as getConfigValue(): '#' comments,
+// [section] headers, key = value pairs, pairs before any section ignored
+static void parse(const char* text, size_t length, pairFn fn, void* ctx) {
+    const char* section = NULL;
+    size_t sectionLength = 0;
+    const char* end = text + length;
+
+    for (const char* line = text; line < end;) {
+        const char* eol = memchr(line, '\n', (size_t)(end - line));
+        if (!eol) eol = end;
+
+        const char* start = line;
+        const char* stop = eol;
+        trim(&start, &stop);
+
+        if (start < stop && *start != '#' && *start != ';') {
+            if (*start == '[') {
+                const char* close = memchr(start, ']', (size_t)(stop - start));
+                if (close) {
+                    section = start + 1;
+                    sectionLength = (size_t)(close - section);
+                }
+            } else if (section && sectionLength > 0) {
+                const char* equals = memchr(start, '=', (size_t)(stop - start));
+                if (equals) {
+                    const char* keyEnd = equals;
+                    const char* value = equals + 1;
+                    trim(&start, &keyEnd);
+                    trim(&value, &stop);
+                    fn(ctx, section, sectionLength, start, (size_t)(keyEnd - start),
+                       value, (size_t)(stop - value));
+                }
+            }
+        }
+
+        line = eol + 1;
+    }
+}
+
+// First pass: number of pairs and bytes of string storage
+typedef struct {
+    size_t count;
+    size_t strings;
+} sizing_t;
+
+static void countPair(void* ctx, const char* section, size_t sectionLength,
+                      const char* key, size_t keyLength, const char* value, size_t valueLength) {
+    sizing_t* sizing = ctx;
+    (void)section; (void)key; (void)value;
+    sizing->count++;
+    sizing->strings += sectionLength + 1 + keyLength + 1 + valueLength + 1;
+}
+
+// Index slot holding "section.key", or the empty slot where it would go
+static uint32_t* findSlot(const config_t* cfg, uint32_t hash, const char* section, size_t sectionLength,
+                          const char* key, size_t keyLength) {
+    for (size_t i = hash & cfg->indexMask;; i = (i + 1) & cfg->indexMask) {
+        uint32_t* slot = &cfg->index[i];
+        if (*slot == 0) return slot;
+
+        const config_entry_t* e = &cfg->entries[*slot - 1];
+        const char* stored = cfg->strings + e->key;
+        if (e->hash == hash && e->sectionLength == sectionLength &&
+            memcmp(stored, section, sectionLength) == 0 &&
+            memcmp(stored + sectionLength + 1, key, keyLength) == 0 &&
+            stored[sectionLength + 1 + keyLength] == '\0') {
+            return slot;
+        }
+    }
+}
+
+// Second pass: copy strings into the arena and index them
+typedef struct {
+    config_t* cfg;
+    size_t used;
+} filling_t;
+
+static void storePair(void* ctx, const char* section, size_t sectionLength,
+                      const char* key, size_t keyLength, const char* value, size_t valueLength) {
+    filling_t* fill = ctx;
+    config_t* cfg = fill->cfg;
+    uint32_t hash = keyHash(section, sectionLength, key, keyLength);
+
+    uint32_t* slot = findSlot(cfg, hash, section, sectionLength, key, keyLength);
+    if (*slot != 0) return; // Duplicate: the first occurrence wins, as in getConfigValue()
+
+    config_entry_t* e = &cfg->entries[cfg->count];
+    char* out = cfg->strings + fill->used;
+
+    e->hash = hash;
+    e->key = (uint32_t)fill->used;
+    e->sectionLength = (uint32_t)sectionLength;
+    memcpy(out, section, sectionLength);
+    out[sectionLength] = '.';
+    memcpy(out + sectionLength + 1, key, keyLength);
+    out[sectionLength + 1 + keyLength] = '\0';
+    fill->used += sectionLength + 1 + keyLength + 1;
+
+    e->value = (uint32_t)fill->used;
+    e->valueLength = (uint32_t)valueLength;
+    memcpy(cfg->strings + fill->used, value, valueLength);
+    cfg->strings[fill->used + valueLength] = '\0';
+    fill->used += valueLength + 1;
+
+    *slot = (uint32_t)++cfg->count;
+}
+
+config_t* config_parse(const char* text, size_t length) {
+    sizing_t sizing = {0, 0};
+    parse(text, length, countPair, &sizing);
+
+    // Keep the index at most two thirds full; it is also the bulk of a cache image
+    size_t indexSize = 8;
+    while (indexSize < sizing.count + sizing.count / 2) indexSize <<= 1;
+
+    size_t header = (sizeof(config_t) + 7) & ~(size_t)7;
+    size_t cacheBytes = sizing.count * sizeof(struct config_cache);
+    size_t entryBytes = sizing.count * sizeof(config_entry_t);
+    size_t indexBytes = indexSize * sizeof(uint32_t);
+    size_t total = header + cacheBytes + entryBytes + indexBytes + sizing.strings;
+
+    config_t* cfg = calloc(1, total);
+    if (!cfg) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    // calloc() leaves every cache slot CACHE_EMPTY
+    cfg->cache = (struct config_cache*)((char*)cfg + header);
+    cfg->entries = (config_entry_t*)((char*)cfg->cache + cacheBytes);
+    cfg->index = (uint32_t*)((char*)cfg->entries + entryBytes);
+    cfg->strings = (char*)cfg->index + indexBytes;
+    cfg->indexMask = indexSize - 1;
+    cfg->size = total;
+
+    filling_t fill = {cfg, 0};
+    parse(text, length, storePair, &fill);
+    cfg->stringsSize = fill.used;
+
+    return cfg;
+}
+
+config_t* config_load(const char* filename) {
+    size_t length = 0;
+    char* text = readFile(filename, &length);
+    if (!text) return NULL;
+
+    config_t* cfg = config_parse(text, length);
+    free(text);
+    return cfg;
+}
+
+config_t* config_adopt(const config_t* layout, void* storage, size_t storageSize, int mapped) {
+    size_t header = (sizeof(config_t) + 7) & ~(size_t)7;
+    size_t total = header + layout->count * sizeof(struct config_cache);
+
+    config_t* cfg = calloc(1, total);
+    if (!cfg) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    *cfg = *layout;
+    cfg->cache = (struct config_cache*)((char*)cfg + header);
+    cfg->size = total + storageSize;
+    cfg->storage = storage;
+    cfg->storageSize = storageSize;
+    cfg->storageMapped = mapped;
+    return cfg;
+}
+
+void config_free(config_t* cfg) {
+    if (cfg && cfg->storage) {
+        if (cfg->storageMapped) {
+            munmap(cfg->storage, cfg->storageSize);
+        } else {
+            free(cfg->storage);
+        }
+    }
+    free(cfg);
+}
+
+// Entry for "section.key", or NULL with errno = ENOENT
+static const config_entry_t* findEntry(const config_t* cfg, const char* section, const char* key) {
+    if (!cfg || !section || !key) {
+        errno = ENOENT;
+        return NULL;
+    }
+
+    size_t sectionLength = strlen(section);
+    size_t keyLength = strlen(key);
+    uint32_t hash = keyHash(section, sectionLength, key, keyLength);
+    uint32_t* slot = findSlot(cfg, hash, section, sectionLength, key, keyLength);
+
+    if (*slot == 0) {
+        errno = ENOENT;
+        return NULL;
+    }
+    return &cfg->entries[*slot - 1];
+}
+
+const char* config_get(const config_t* cfg, const char* section, const char* key, size_t* length) {
+    const config_entry_t* e = findEntry(cfg, section, key);
+    if (!e) return NULL;
+
+    if (length) *length = e->valueLength;
+    return cfg->strings + e->value;
+}
+
+const char* config_lookup(const config_t* cfg, const char* section, const char* key) {
+    return config_get(cfg, section, key, NULL);
+}
+
+/* ---- Typed values ---- */
+
+static int parseInt(const char* str, configValue_t* out) {
+    char* end;
+    errno = 0;
+    long long value = strtoll(str, &end, 0);
+    if (errno || end == str || *end != '\0') return -1;
+    out->i = value;
+    return 0;
+}
+
+static int parseBool(const char* str, configValue_t* out) {
+    static const char* const truthy[] = {"1", "true", "yes", "on"};
+    static const char* const falsy[] = {"0", "false", "no", "off"};
+
+    for (size_t i = 0; i < sizeof(truthy) / sizeof(truthy[0]); i++) {
+        if (strcasecmp(str, truthy[i]) == 0) {
+            out->i = 1;
+            return 0;
+        }
+        if (strcasecmp(str, falsy[i]) == 0) {
+            out->i = 0;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int parseDouble(const char* str, configValue_t* out) {
+    char* end;
+    errno = 0;
+    double value = strtod(str, &end);
+    if (errno || end == str || *end != '\0') return -1;
+    out->d = value;
+    return 0;
+}
+
+static int parseDuration(const char* str, configValue_t* out) {
+    static const struct {
+        const char* suffix;
+        double scale;
+    } units[] = {
+        {"", 1e6}, {"us", 1.0}, {"ms", 1e3}, {"s", 1e6}, {"m", 60e6}, {"h", 3600e6},
+    };
+    char* end;
+
+    errno = 0;
+    double value = strtod(str, &end);
+    if (errno || end == str || value < 0) return -1;
+    while (*end == ' ') end++;
+
+    for (size_t i = 0; i < sizeof(units) / sizeof(units[0]); i++) {
+        if (strcmp(end, units[i].suffix) == 0) {
+            double us = value * units[i].scale + 0.5;
+            if (us >= 18446744073709551615.0) return -1;
+            out->us = (uint64_t)us;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Parse an entry as <type>, going through the entry's cache slot
+static int getTyped(const config_t* cfg, const char* section, const char* key, configType_t type,
+                    int (*parseFn)(const char*, configValue_t*), configValue_t* out) {
+    const config_entry_t* e = findEntry(cfg, section, key);
+    if (!e) return -1;
+
+    struct config_cache* slot = &cfg->cache[e - cfg->entries];
+    uint32_t tag = CACHE_READY | (uint32_t)type << CACHE_TYPE_SHIFT;
+    uint32_t state = atomic_load_explicit(&slot->state, memory_order_acquire);
+
+    // Fast path: already parsed as this type
+    if ((state & ~CACHE_VALID) == tag) {
+        if (!(state & CACHE_VALID)) {
+            errno = EINVAL;
+            return -1;
+        }
+        *out = slot->value;
+        return 0;
+    }
+
+    configValue_t value = {0};
+    int valid = parseFn(cfg->strings + e->value, &value) == 0;
+
+    // Publish the result if the slot is still free; losing the race is harmless
+    uint32_t expected = CACHE_EMPTY;
+    if (state == CACHE_EMPTY &&
+        atomic_compare_exchange_strong_explicit(&slot->state, &expected, CACHE_BUSY,
+                                                memory_order_acquire, memory_order_relaxed)) {
+        slot->value = value;
+        atomic_store_explicit(&slot->state, tag | (valid ? CACHE_VALID : 0), memory_order_release);
+    }
+
+    if (!valid) {
+        errno = EINVAL;
+        return -1;
+    }
+    *out = value;
+    return 0;
+}
+
+int config_get_int(const config_t* cfg, const char* section, const char* key, int64_t* value) {
+    configValue_t v;
+    if (getTyped(cfg, section, key, CONFIG_TYPE_INT, parseInt, &v) < 0) return -1;
+    *value = v.i;
+    return 0;
+}
+
+int config_get_bool(const config_t* cfg, const char* section, const char* key, int* value) {
+    configValue_t v;
+    if (getTyped(cfg, section, key, CONFIG_TYPE_BOOL, parseBool, &v) < 0) return -1;
+    *value = (int)v.i;
+    return 0;
+}
+
+int config_get_double(const config_t* cfg, const char* section, const char* key, double* value) {
+    configValue_t v;
+    if (getTyped(cfg, section, key, CONFIG_TYPE_DOUBLE, parseDouble, &v) < 0) return -1;
+    *value = v.d;
+    return 0;
+}
+
+int config_get_duration_us(const config_t* cfg, const char* section, const char* key, uint64_t* value) {
+    configValue_t v;
+    if (getTyped(cfg, section, key, CONFIG_TYPE_DURATION, parseDuration, &v) < 0) return -1;
+    *value = v.us;
+    return 0;
+}
+
+size_t config_count(const config_t* cfg) {
+    return cfg ? cfg->count : 0;
+}
+
+size_t config_memory(const config_t* cfg) {
+    return cfg ? cfg->size : 0;
+}
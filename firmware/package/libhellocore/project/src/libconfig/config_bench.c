@@ -0,0 +1,268 @@
+// src/libconfig/config_bench.c
+//
+// Host benchmarks for the parse-once store against a program's legacy
+// per-lookup reader (getConfigValue() in hellomk and hellomkcpp) and for the
+// binary image against parsing. Run with "hellomk --bench-config [keys]" and
+// "hellomk --bench-cache [keys]", or the same options of hellomkcpp.
+
+#include "libconfig/config.h"
+#include "libconfig/config_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <utime.h>
+#include <sys/stat.h>
+
+#define BENCH_KEYS_PER_SECTION 100
+#define BENCH_LEGACY_LOOKUPS 200 // the legacy reader rescans the file, keep this small
+#define BENCH_LOOKUP_ROUNDS 10
+#define BENCH_COLD_RUNS 7
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void benchName(unsigned int i, char* section, size_t sectionSize, char* key, size_t keySize) {
+    snprintf(section, sectionSize, "section%u", i / BENCH_KEYS_PER_SECTION);
+    snprintf(key, keySize, "key%u", i % BENCH_KEYS_PER_SECTION);
+}
+
+// Write an INI file with <keys> pairs, BENCH_KEYS_PER_SECTION per section
+static long writeBenchFile(const char* path, unsigned int keys) {
+    FILE* file = fopen(path, "w");
+    if (!file) return -1;
+
+    fprintf(file, "# Generated by config_bench()\n");
+    for (unsigned int i = 0; i < keys; i++) {
+        if (i % BENCH_KEYS_PER_SECTION == 0) {
+            fprintf(file, "\n[section%u]\n", i / BENCH_KEYS_PER_SECTION);
+        }
+        fprintf(file, "key%u = value-%u-%08x\n", i % BENCH_KEYS_PER_SECTION, i, i * 2654435761u);
+    }
+
+    long size = ftell(file);
+    if (fclose(file) != 0) return -1;
+    return size;
+}
+
+int config_bench(unsigned int keys, config_legacy_get_fn legacyGet) {
+    char path[64];
+    char section[32], key[32];
+    int status = 0;
+
+    if (keys == 0) keys = 1;
+    snprintf(path, sizeof(path), "/tmp/config-bench-%d.ini", (int)getpid());
+
+    long fileSize = writeBenchFile(path, keys);
+    if (fileSize < 0) {
+        perror(path);
+        return 1;
+    }
+
+    // Parse once
+    double start = nowNs();
+    config_t* cfg = config_load(path);
+    double parseNs = nowNs() - start;
+    if (!cfg) {
+        perror("config_load");
+        unlink(path);
+        return 1;
+    }
+
+    // Names are formatted up front so only the lookups are timed
+    char (*names)[2][24] = malloc((size_t)keys * sizeof(*names));
+    if (!names) {
+        config_free(cfg);
+        unlink(path);
+        return 1;
+    }
+    for (unsigned int i = 0; i < keys; i++) {
+        benchName(i, names[i][0], sizeof(names[i][0]), names[i][1], sizeof(names[i][1]));
+    }
+
+    // Every key, several rounds, in a different order each round
+    unsigned int misses = 0;
+    size_t lookups = (size_t)keys * BENCH_LOOKUP_ROUNDS;
+    start = nowNs();
+    for (unsigned int round = 0; round < BENCH_LOOKUP_ROUNDS; round++) {
+        for (unsigned int i = 0; i < keys; i++) {
+            unsigned int n = (unsigned int)(((unsigned long)i * 7919u + round) % keys);
+            if (!config_lookup(cfg, names[n][0], names[n][1])) misses++;
+        }
+    }
+    double lookupNs = (nowNs() - start) / (double)lookups;
+
+    // Legacy path: one fopen and linear scan per lookup
+    unsigned int legacyCount = keys < BENCH_LEGACY_LOOKUPS ? keys : BENCH_LEGACY_LOOKUPS;
+    start = nowNs();
+    for (unsigned int i = 0; i < legacyCount; i++) {
+        benchName((unsigned int)(((unsigned long)i * keys) / legacyCount), section, sizeof(section), key, sizeof(key));
+        const char* legacy = legacyGet(path, section, key);
+        const char* value = config_lookup(cfg, section, key);
+        if (!legacy || !value || strcmp(legacy, value) != 0) {
+            fprintf(stderr, "Mismatch for [%s] %s\n", section, key);
+            status = 1;
+        }
+    }
+    double legacyNs = (nowNs() - start) / legacyCount;
+
+    printf("Config benchmark: %u keys, %ld bytes INI\n", keys, fileSize);
+    printf("  config_load:     %.3f ms (%zu entries)\n", parseNs / 1e6, config_count(cfg));
+    printf("  config_lookup:   %.1f ns/lookup (%zu lookups, %u misses)\n", lookupNs, lookups, misses);
+    printf("  legacy lookup:   %.1f ns/lookup (%u lookups)\n", legacyNs, legacyCount);
+    printf("  memory:          %zu bytes in one allocation (%.2f x file size)\n",
+           config_memory(cfg), (double)config_memory(cfg) / (double)fileSize);
+
+    if (misses) status = 1;
+    free(names);
+    config_free(cfg);
+    unlink(path);
+    return status;
+}
+
+/* ---- Image cold start ---- */
+
+// Drop a file from the page cache so the next open reads the device
+static void dropCache(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static int compareDouble(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+typedef config_t* (*openFn)(const char* ini, const char* image);
+
+static config_t* openIni(const char* ini, const char* image) {
+    (void)image;
+    return config_load(ini);
+}
+
+static config_t* openImage(const char* ini, const char* image) {
+    return config_image_open(image, ini);
+}
+
+// Median time of opening through <fn> with cold caches, plus the memory used
+static double coldOpen(openFn fn, const char* ini, const char* image, size_t* memory) {
+    double samples[BENCH_COLD_RUNS];
+
+    for (int i = 0; i < BENCH_COLD_RUNS; i++) {
+        dropCache(ini);
+        dropCache(image);
+
+        double start = nowNs();
+        config_t* cfg = fn(ini, image);
+        samples[i] = nowNs() - start;
+        if (!cfg) return -1.0;
+
+        *memory = config_memory(cfg);
+        config_free(cfg);
+    }
+
+    qsort(samples, BENCH_COLD_RUNS, sizeof(samples[0]), compareDouble);
+    return samples[BENCH_COLD_RUNS / 2];
+}
+
+// Both stores must give the same answer for every key
+static int compareStores(const config_t* a, const config_t* b, unsigned int keys) {
+    char section[32], key[32];
+
+    if (config_count(a) != config_count(b)) return -1;
+    for (unsigned int i = 0; i < keys; i++) {
+        benchName(i, section, sizeof(section), key, sizeof(key));
+        const char* x = config_lookup(a, section, key);
+        const char* y = config_lookup(b, section, key);
+        if (!x || !y || strcmp(x, y) != 0) return -1;
+    }
+    return 0;
+}
+
+int config_image_bench(unsigned int keys) {
+    char ini[64], image[80];
+    size_t iniMemory = 0, imageMemory = 0, touchedMemory = 0;
+    struct stat st;
+    int status = 0;
+
+    if (keys == 0) keys = 1;
+    snprintf(ini, sizeof(ini), "/tmp/config-cache-%d.ini", (int)getpid());
+    snprintf(image, sizeof(image), "%s" CONFIG_IMAGE_SUFFIX, ini);
+
+    long fileSize = writeBenchFile(ini, keys);
+    if (fileSize < 0) {
+        perror(ini);
+        return 1;
+    }
+
+    double start = nowNs();
+    if (config_image_compile(ini, image) < 0) {
+        perror("config_image_compile");
+        unlink(ini);
+        return 1;
+    }
+    double compileNs = nowNs() - start;
+
+    double iniNs = coldOpen(openIni, ini, image, &iniMemory);
+    double imageNs = coldOpen(openImage, ini, image, &imageMemory);
+
+    // A copy that lost the mtime falls back to hashing the INI once, after
+    // which the image carries the new mtime
+    struct utimbuf old = {1, 1};
+    utime(ini, &old);
+    dropCache(ini);
+    dropCache(image);
+    start = nowNs();
+    config_t* touched = config_image_open(image, ini);
+    double touchedNs = nowNs() - start;
+    if (touched) touchedMemory = config_memory(touched);
+    else touchedNs = -1.0;
+    config_free(touched);
+    double refreshedNs = coldOpen(openImage, ini, image, &imageMemory);
+
+    config_t* parsed = config_load(ini);
+    config_t* mapped = config_image_open(image, ini);
+    if (!parsed || !mapped || compareStores(parsed, mapped, keys) != 0) {
+        fprintf(stderr, "Image does not match the INI\n");
+        status = 1;
+    }
+    config_free(parsed);
+    config_free(mapped);
+
+    // Any edit must make the image stale
+    FILE* file = fopen(ini, "a");
+    if (file) {
+        fputs("[extra]\nkey = 1\n", file);
+        fclose(file);
+    }
+    mapped = config_image_open(image, ini);
+    if (mapped || errno != ESTALE) {
+        fprintf(stderr, "Edited INI was not detected as stale\n");
+        status = 1;
+    }
+    config_free(mapped);
+
+    long imageSize = stat(image, &st) == 0 ? (long)st.st_size : -1;
+
+    printf("Config cache benchmark: %u keys, %ld bytes INI, %ld bytes image\n", keys, fileSize, imageSize);
+    printf("  compile:            %.3f ms\n", compileNs / 1e6);
+    printf("  cold open, INI:     %.3f ms (%zu bytes)\n", iniNs / 1e6, iniMemory);
+    printf("  cold open, image:   %.3f ms (%zu bytes, mtime match)\n", imageNs / 1e6, imageMemory);
+    printf("  cold open, image:   %.3f ms (%zu bytes, hash match)\n", touchedNs / 1e6, touchedMemory);
+    printf("  cold open, image:   %.3f ms (after mtime refresh)\n", refreshedNs / 1e6);
+
+    if (iniNs < 0 || imageNs < 0 || touchedNs < 0 || refreshedNs < 0) status = 1;
+    unlink(image);
+    unlink(ini);
+    return status;
+}
@@ -0,0 +1,321 @@
+// src/libconfig/config_image.c
+//
+// Binary cache of a parsed configuration. config_parse() already keeps
+// everything as 32-bit offsets, so the image is that layout written out
+// behind a header; opening it is a single mmap() (or read() where the file
+// cannot be mapped) and a bounds check, with no text parsing at all.
+
+#include "libconfig/config_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+// What an image records about the INI it was built from
+typedef struct {
+    uint32_t size;
+    uint32_t mtime;
+    uint32_t hash;
+} sourceInfo_t;
+
+static uint32_t hashBytes(const char* data, size_t length) {
+    uint32_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Read a whole file into a heap buffer, with the stat of the same descriptor
+static char* readSource(const char* path, struct stat* st, size_t* length) {
+    char* data = NULL;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, st) == 0 && (data = malloc((size_t)st->st_size + 1)) != NULL) {
+        size_t done = 0;
+        while (done < (size_t)st->st_size) {
+            ssize_t n = read(fd, data + done, (size_t)st->st_size - done);
+            if (n <= 0) break;
+            done += (size_t)n;
+        }
+        data[done] = '\0';
+        *length = done;
+    }
+
+    int savedErrno = errno;
+    close(fd);
+    errno = savedErrno;
+    return data;
+}
+
+// Parse an INI and describe it for the image header
+static config_t* loadSource(const char* iniPath, sourceInfo_t* info) {
+    struct stat st;
+    size_t length = 0;
+    char* text = readSource(iniPath, &st, &length);
+    if (!text) return NULL;
+
+    info->size = (uint32_t)length;
+    info->mtime = (uint32_t)st.st_mtime;
+    info->hash = hashBytes(text, length);
+
+    config_t* cfg = config_parse(text, length);
+    free(text);
+    return cfg;
+}
+
+static int writeAll(int fd, const void* data, size_t length) {
+    const char* p = data;
+    while (length > 0) {
+        ssize_t n = write(fd, p, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+// Write <cfg> as an image; a temporary file is renamed over <imagePath> so
+// readers never see a partial image
+static int writeImage(const config_t* cfg, const sourceInfo_t* info, const char* imagePath) {
+    char tmp[PATH_MAX];
+    config_image_header_t header;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", imagePath) >= (int)sizeof(tmp)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CONFIG_IMAGE_MAGIC, sizeof(header.magic));
+    header.byteOrder = CONFIG_IMAGE_BYTE_ORDER;
+    header.version = CONFIG_IMAGE_VERSION;
+    header.count = (uint32_t)cfg->count;
+    header.indexSize = (uint32_t)(cfg->indexMask + 1);
+    header.stringsSize = (uint32_t)cfg->stringsSize;
+    header.sourceSize = info->size;
+    header.sourceMtime = info->mtime;
+    header.sourceHash = info->hash;
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    if (writeAll(fd, &header, sizeof(header)) < 0 ||
+        writeAll(fd, cfg->entries, cfg->count * sizeof(config_entry_t)) < 0 ||
+        writeAll(fd, cfg->index, header.indexSize * sizeof(uint32_t)) < 0 ||
+        writeAll(fd, cfg->strings, cfg->stringsSize) < 0 ||
+        close(fd) < 0) {
+        int savedErrno = errno;
+        close(fd);
+        unlink(tmp);
+        errno = savedErrno;
+        return -1;
+    }
+
+    if (rename(tmp, imagePath) < 0) {
+        int savedErrno = errno;
+        unlink(tmp);
+        errno = savedErrno;
+        return -1;
+    }
+    return 0;
+}
+
+int config_image_compile(const char* iniPath, const char* imagePath) {
+    sourceInfo_t info;
+    config_t* cfg = loadSource(iniPath, &info);
+    if (!cfg) return -1;
+
+    int ret = writeImage(cfg, &info, imagePath);
+    config_free(cfg);
+    return ret;
+}
+
+/* ---- Opening an image ---- */
+
+// Record a new INI mtime in the image header so the next open skips the hash
+static void refreshMtime(const char* imagePath, uint32_t mtime) {
+    int fd = open(imagePath, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return; // Read-only filesystem: keep hashing on every start
+
+    pwrite(fd, &mtime, sizeof(mtime), offsetof(config_image_header_t, sourceMtime));
+    close(fd);
+}
+
+// Does the image still describe <iniPath>?
+static int isFresh(const config_image_header_t* header, const char* imagePath, const char* iniPath) {
+    struct stat st;
+
+    if (!iniPath) return 1;
+    if (stat(iniPath, &st) < 0) return errno == ENOENT; // Image-only deployment
+    if ((uint64_t)st.st_size != header->sourceSize) return 0;
+    if ((uint32_t)st.st_mtime == header->sourceMtime) return 1;
+
+    // Same size, different mtime: copied or touched, compare the content
+    size_t length = 0;
+    char* text = readSource(iniPath, &st, &length);
+    if (!text) return 0;
+
+    int fresh = length == header->sourceSize && hashBytes(text, length) == header->sourceHash;
+    free(text);
+
+    if (fresh) refreshMtime(imagePath, (uint32_t)st.st_mtime);
+    return fresh;
+}
+
+// Check that every offset in the image stays inside it
+static int isWellFormed(const config_image_header_t* header, size_t size) {
+    if (memcmp(header->magic, CONFIG_IMAGE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->byteOrder != CONFIG_IMAGE_BYTE_ORDER || header->version != CONFIG_IMAGE_VERSION) {
+        return 0;
+    }
+
+    uint64_t expected = sizeof(*header) + (uint64_t)header->count * sizeof(config_entry_t) +
+                        (uint64_t)header->indexSize * sizeof(uint32_t) + header->stringsSize;
+    if (expected != size || header->indexSize <= header->count ||
+        (header->indexSize & (header->indexSize - 1)) != 0) {
+        return 0;
+    }
+
+    const config_entry_t* entries = (const config_entry_t*)(header + 1);
+    const uint32_t* index = (const uint32_t*)(entries + header->count);
+    const char* strings = (const char*)(index + header->indexSize);
+    uint32_t stringsSize = header->stringsSize;
+
+    if (stringsSize > 0 && strings[stringsSize - 1] != '\0') return 0;
+    for (uint32_t i = 0; i < header->indexSize; i++) {
+        if (index[i] > header->count) return 0;
+    }
+    for (uint32_t i = 0; i < header->count; i++) {
+        const config_entry_t* e = &entries[i];
+        if (e->key >= stringsSize || e->sectionLength >= stringsSize - e->key ||
+            e->value >= stringsSize || e->valueLength >= stringsSize - e->value ||
+            strings[e->value + e->valueLength] != '\0') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Read exactly <size> bytes into a new buffer
+static void* readExactly(int fd, size_t size) {
+    char* data = malloc(size);
+    size_t done = 0;
+
+    if (!data) return NULL;
+    while (done < size) {
+        ssize_t n = read(fd, data + done, size - done);
+        if (n <= 0) break;
+        done += (size_t)n;
+    }
+    if (done != size) {
+        free(data);
+        errno = EIO;
+        return NULL;
+    }
+    return data;
+}
+
+// Map a file read-only, or read it into memory where it cannot be mapped
+static void* mapFile(const char* path, size_t* size, int* mapped) {
+    struct stat st;
+    void* data = NULL;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &st) == 0) {
+        *size = (size_t)st.st_size;
+        if (*size < sizeof(config_image_header_t)) {
+            errno = EINVAL;
+        } else {
+            data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+            *mapped = data != MAP_FAILED;
+            if (!*mapped) data = readExactly(fd, *size);
+        }
+    }
+
+    int savedErrno = errno;
+    close(fd);
+    errno = savedErrno;
+    return data;
+}
+
+static void unmapFile(void* data, size_t size, int mapped) {
+    if (mapped) {
+        munmap(data, size);
+    } else {
+        free(data);
+    }
+}
+
+config_t* config_image_open(const char* imagePath, const char* iniPath) {
+    size_t size = 0;
+    int mapped = 0;
+    void* data = mapFile(imagePath, &size, &mapped);
+    if (!data) return NULL;
+
+    const config_image_header_t* header = data;
+    if (!isWellFormed(header, size)) {
+        unmapFile(data, size, mapped);
+        errno = EINVAL;
+        return NULL;
+    }
+    if (!isFresh(header, imagePath, iniPath)) {
+        unmapFile(data, size, mapped);
+        errno = ESTALE;
+        return NULL;
+    }
+
+    config_t layout;
+    memset(&layout, 0, sizeof(layout));
+    layout.entries = (config_entry_t*)(header + 1);
+    layout.index = (uint32_t*)(layout.entries + header->count);
+    layout.strings = (char*)(layout.index + header->indexSize);
+    layout.count = header->count;
+    layout.indexMask = header->indexSize - 1;
+    layout.stringsSize = header->stringsSize;
+
+    config_t* cfg = config_adopt(&layout, data, size, mapped);
+    if (!cfg) unmapFile(data, size, mapped);
+    return cfg;
+}
+
+config_t* config_open(const char* iniPath, int* fromImage) {
+    char imagePath[PATH_MAX];
+    sourceInfo_t info;
+
+    if (fromImage) *fromImage = 0;
+    if (snprintf(imagePath, sizeof(imagePath), "%s" CONFIG_IMAGE_SUFFIX, iniPath) >= (int)sizeof(imagePath)) {
+        return config_load(iniPath);
+    }
+
+    config_t* cfg = config_image_open(imagePath, iniPath);
+    if (cfg) {
+        if (fromImage) *fromImage = 1;
+        return cfg;
+    }
+
+    cfg = loadSource(iniPath, &info);
+    if (cfg) {
+        // Best effort: a read-only filesystem just keeps using the INI
+        int savedErrno = errno;
+        writeImage(cfg, &info, imagePath);
+        errno = savedErrno;
+    }
+    return cfg;
+}
@@ -0,0 +1,187 @@
+// src/libconfig/config_stress.c
+//
+// Multithreaded stress test for the configuration store. Every thread reads
+// random keys through config_get() and the typed getters, including reads of
+// the same key as a different type, and checks each result against the
+// value the key was generated with. Run with
+// "hellomk --stress-config [threads] [seconds]" (or hellomkcpp).
+
+#include "libconfig/config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define STRESS_KEYS 4096
+#define STRESS_KEYS_PER_SECTION 64
+#define STRESS_STACK_SIZE (32 * 1024)
+#define STRESS_MAX_THREADS 64
+
+typedef struct {
+    const config_t* cfg;
+    pthread_mutex_t* start;
+    atomic_int* stop;
+    unsigned int seed;
+    unsigned long reads;
+    unsigned long errors;
+} stressWorker_t;
+
+static void stressName(unsigned int i, char* section, size_t sectionSize, char* key, size_t keySize) {
+    snprintf(section, sectionSize, "s%u", i / STRESS_KEYS_PER_SECTION);
+    snprintf(key, keySize, "k%u", i % STRESS_KEYS_PER_SECTION);
+}
+
+// Text of key <i>; the key number picks the type: int, bool, double, duration
+static void stressValue(unsigned int i, char* buf, size_t size) {
+    static const char* const bools[] = {"true", "off", "Yes", "0"};
+
+    switch (i % 4) {
+    case 0: snprintf(buf, size, "%d", (int)(i * 37u) - 50000); break;
+    case 1: snprintf(buf, size, "%s", bools[(i / 4) % 4]); break;
+    case 2: snprintf(buf, size, "%u.25", i); break;
+    default: snprintf(buf, size, "%ums", i % 1000); break;
+    }
+}
+
+// Check one typed read of key <i>; returns 1 on a wrong result
+static int stressCheckTyped(const config_t* cfg, unsigned int i, const char* section, const char* key) {
+    int64_t n;
+    int b;
+    double d;
+    uint64_t us;
+
+    switch (i % 4) {
+    case 0:
+        return config_get_int(cfg, section, key, &n) != 0 || n != (int)(i * 37u) - 50000;
+    case 1:
+        return config_get_bool(cfg, section, key, &b) != 0 || b != ((i / 4) % 2 == 0);
+    case 2:
+        // Not an integer, so reading it as one must fail with EINVAL
+        if (config_get_int(cfg, section, key, &n) == 0 || errno != EINVAL) return 1;
+        return config_get_double(cfg, section, key, &d) != 0 || d != i + 0.25;
+    default:
+        return config_get_duration_us(cfg, section, key, &us) != 0 || us != (i % 1000) * 1000ull;
+    }
+}
+
+static void* stressThread(void* arg) {
+    stressWorker_t* w = arg;
+    char section[16], key[16], expected[32];
+    unsigned int x = w->seed;
+
+    // Held by the main thread until every worker exists
+    pthread_mutex_lock(w->start);
+    pthread_mutex_unlock(w->start);
+
+    while (!atomic_load_explicit(w->stop, memory_order_relaxed)) {
+        // xorshift32, private to the thread
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+
+        unsigned int i = x % (STRESS_KEYS + 16); // A few keys past the end must be missing
+        size_t length = 0;
+        stressName(i, section, sizeof(section), key, sizeof(key));
+        const char* value = config_get(w->cfg, section, key, &length);
+
+        if (i >= STRESS_KEYS) {
+            if (value || errno != ENOENT) w->errors++;
+        } else {
+            stressValue(i, expected, sizeof(expected));
+            if (!value || length != strlen(expected) || memcmp(value, expected, length) != 0 ||
+                stressCheckTyped(w->cfg, i, section, key)) {
+                w->errors++;
+            }
+        }
+        w->reads++;
+    }
+
+    return NULL;
+}
+
+// Write the stress INI; returns 0 on success
+static int writeStressFile(const char* path) {
+    char value[32];
+    FILE* file = fopen(path, "w");
+    if (!file) return -1;
+
+    for (unsigned int i = 0; i < STRESS_KEYS; i++) {
+        if (i % STRESS_KEYS_PER_SECTION == 0) {
+            fprintf(file, "[s%u]\n", i / STRESS_KEYS_PER_SECTION);
+        }
+        stressValue(i, value, sizeof(value));
+        fprintf(file, "k%u = %s\n", i % STRESS_KEYS_PER_SECTION, value);
+    }
+
+    return fclose(file);
+}
+
+int config_stress(unsigned int threads, unsigned int seconds) {
+    stressWorker_t workers[STRESS_MAX_THREADS];
+    pthread_t ids[STRESS_MAX_THREADS];
+    pthread_mutex_t start = PTHREAD_MUTEX_INITIALIZER;
+    pthread_attr_t attr;
+    atomic_int stop = 0;
+    char path[64];
+    unsigned int started = 0;
+
+    if (threads == 0) threads = 1;
+    if (threads > STRESS_MAX_THREADS) threads = STRESS_MAX_THREADS;
+
+    snprintf(path, sizeof(path), "/tmp/config-stress-%d.ini", (int)getpid());
+    if (writeStressFile(path) != 0) {
+        perror(path);
+        return 1;
+    }
+
+    config_t* cfg = config_load(path);
+    unlink(path);
+    if (!cfg) {
+        perror("config_load");
+        return 1;
+    }
+
+    // Small stacks: the target has no MMU and allocates them up front
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, STRESS_STACK_SIZE);
+    pthread_mutex_lock(&start);
+
+    for (; started < threads; started++) {
+        workers[started] = (stressWorker_t){cfg, &start, &stop, 2463534242u + started * 7919u, 0, 0};
+        int ret = pthread_create(&ids[started], &attr, stressThread, &workers[started]);
+        if (ret != 0) {
+            fprintf(stderr, "pthread_create(): %s\n", strerror(ret));
+            break;
+        }
+    }
+
+    if (started < threads) atomic_store(&stop, 1);
+    pthread_mutex_unlock(&start);
+    if (started == threads) sleep(seconds);
+    atomic_store(&stop, 1);
+
+    unsigned long reads = 0, errors = 0;
+    for (unsigned int t = 0; t < started; t++) {
+        pthread_join(ids[t], NULL);
+        reads += workers[t].reads;
+        errors += workers[t].errors;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (started < threads) {
+        fprintf(stderr, "Only %u of %u threads started\n", started, threads);
+        config_free(cfg);
+        return 1;
+    }
+
+    printf("Config stress: %u threads, %u s, %u keys\n", threads, seconds, STRESS_KEYS);
+    printf("  reads:  %lu (%.0f/s per thread)\n", reads, (double)reads / (seconds ? seconds : 1) / threads);
+    printf("  errors: %lu\n", errors);
+
+    config_free(cfg);
+    return errors ? 1 : 0;
+}
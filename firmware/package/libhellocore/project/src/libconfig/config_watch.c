@@ -0,0 +1,193 @@
+// src/libconfig/config_watch.c
+//
+// inotify-driven reload with RCU-style publication. Readers register in one
+// of two counters chosen by the low bit of <epoch>; a reload swaps the
+// snapshot pointer, flips the epoch and frees the old snapshot only after
+// the counter of the previous epoch drains. Every reader that could have
+// loaded the old pointer is counted there, because it checked the epoch
+// after its increment and loaded the pointer after that check.
+//
+// The directory is watched rather than the file so that editors which
+// replace the file by renaming a temporary over it are seen as well.
+
+#include "libconfig/config_watch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+#define WATCH_DRAIN_SLEEP_NS 100000 // Poll period while an old snapshot drains
+
+struct config_watch {
+    config_t* _Atomic current;
+    _Atomic uint32_t readers[2];
+    _Atomic uint32_t epoch;
+    _Atomic uint32_t generation;
+
+    // Writer side, only touched by the thread calling config_watch_dispatch()
+    config_t* retired;          // Previous snapshot waiting for its readers
+    unsigned int retiredSlot;
+    int fd;
+    int wd;
+    char path[PATH_MAX];
+    const char* name;           // File name inside <path>, matched against events
+};
+
+/* ---- Reclamation ---- */
+
+// Free the retired snapshot once its readers are gone. With <wait> set this
+// sleeps until they are; otherwise it returns immediately if any remain.
+static void reclaim(config_watch_t* watch, int wait) {
+    const struct timespec pause = {0, WATCH_DRAIN_SLEEP_NS};
+
+    if (!watch->retired) return;
+
+    while (atomic_load(&watch->readers[watch->retiredSlot]) != 0) {
+        if (!wait) return;
+        // Sleep rather than yield: a SCHED_FIFO writer would starve lower priority readers
+        nanosleep(&pause, NULL);
+    }
+
+    config_free(watch->retired);
+    watch->retired = NULL;
+}
+
+static void publish(config_watch_t* watch, config_t* cfg) {
+    // The previous grace period must end before the epoch flips back to its slot
+    reclaim(watch, 1);
+
+    config_t* old = atomic_exchange(&watch->current, cfg);
+    uint32_t epoch = atomic_fetch_add(&watch->epoch, 1);
+    atomic_fetch_add(&watch->generation, 1);
+
+    watch->retired = old;
+    watch->retiredSlot = epoch & 1;
+    reclaim(watch, 0);
+}
+
+/* ---- Open & Close ---- */
+
+config_watch_t* config_watch_open(const char* path) {
+    char dir[PATH_MAX];
+
+    if (strlen(path) >= PATH_MAX) {
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+
+    config_watch_t* watch = calloc(1, sizeof(*watch));
+    if (!watch) return NULL;
+
+    strcpy(watch->path, path);
+    const char* slash = strrchr(watch->path, '/');
+    if (slash) {
+        watch->name = slash + 1;
+        snprintf(dir, sizeof(dir), "%.*s", (int)(slash - watch->path), watch->path);
+        if (dir[0] == '\0') strcpy(dir, "/");
+    } else {
+        watch->name = watch->path;
+        strcpy(dir, ".");
+    }
+
+    config_t* cfg = config_load(path);
+    if (!cfg) {
+        free(watch);
+        return NULL;
+    }
+    atomic_init(&watch->current, cfg);
+
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd < 0 || (watch->wd = inotify_add_watch(watch->fd, dir, WATCH_EVENTS)) < 0) {
+        int savedErrno = errno;
+        if (watch->fd >= 0) close(watch->fd);
+        config_free(cfg);
+        free(watch);
+        errno = savedErrno;
+        return NULL;
+    }
+
+    return watch;
+}
+
+void config_watch_close(config_watch_t* watch) {
+    if (!watch) return;
+
+    // Readers must be done by now; wait for any that are still leaving
+    reclaim(watch, 1);
+    close(watch->fd);
+    config_free(atomic_load(&watch->current));
+    free(watch);
+}
+
+/* ---- Writer ---- */
+
+int config_watch_fd(const config_watch_t* watch) {
+    return watch->fd;
+}
+
+int config_watch_dispatch(config_watch_t* watch) {
+    char buf[sizeof(struct inotify_event) + NAME_MAX + 1] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+
+    for (;;) {
+        ssize_t n = read(watch->fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) break;
+            return -1;
+        }
+
+        for (char* p = buf; p < buf + n;) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            if ((event->mask & IN_Q_OVERFLOW) ||
+                (event->len && strcmp(event->name, watch->name) == 0)) {
+                changed = 1;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    reclaim(watch, 0);
+    if (!changed) return 0;
+
+    // Parse outside of any reader's path; readers keep the old snapshot meanwhile
+    config_t* cfg = config_load(watch->path);
+    if (!cfg) return -1;
+
+    publish(watch, cfg);
+    return 1;
+}
+
+/* ---- Readers ---- */
+
+config_snapshot_t config_watch_acquire(config_watch_t* watch) {
+    config_snapshot_t snapshot;
+
+    for (;;) {
+        unsigned int slot = atomic_load(&watch->epoch) & 1;
+        atomic_fetch_add(&watch->readers[slot], 1);
+
+        // The epoch flipped in between: this counter may already be drained
+        if ((atomic_load(&watch->epoch) & 1) == slot) {
+            snapshot.cfg = atomic_load(&watch->current);
+            snapshot.slot = slot;
+            return snapshot;
+        }
+        atomic_fetch_sub(&watch->readers[slot], 1);
+    }
+}
+
+void config_watch_release(config_watch_t* watch, config_snapshot_t snapshot) {
+    atomic_fetch_sub(&watch->readers[snapshot.slot], 1);
+}
+
+uint32_t config_watch_generation(const config_watch_t* watch) {
+    return atomic_load(&((config_watch_t*)watch)->generation);
+}
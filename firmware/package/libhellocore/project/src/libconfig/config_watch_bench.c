@@ -0,0 +1,232 @@
+// src/libconfig/config_watch_bench.c
+//
+// Reload benchmark: reader threads check that every snapshot they acquire is
+// internally consistent while the file is rewritten and renamed into place;
+// the main thread measures the delay until each new version is published and
+// the cost a reader pays for acquire/release. Run with
+// "hellomk --bench-reload [readers] [reloads]" (or hellomkcpp).
+
+#include "libconfig/config_watch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define WATCH_BENCH_KEYS 1000
+#define WATCH_BENCH_ROUNDS 200000
+#define WATCH_BENCH_STACK_SIZE (32 * 1024)
+#define WATCH_BENCH_MAX_READERS 16
+#define WATCH_BENCH_TIMEOUT_NS 2000000000LL
+
+typedef struct {
+    config_watch_t* watch;
+    atomic_int* stop;
+    unsigned long reads;
+    unsigned long inconsistent;
+} watchReader_t;
+
+typedef struct {
+    config_watch_t* watch;
+    atomic_int* stop;
+    unsigned long failures;
+} watchWriter_t;
+
+static int64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Write version <version> to <tmp>, ready to be renamed over the watched file
+static int writeVersion(const char* tmp, unsigned int version) {
+    FILE* file = fopen(tmp, "w");
+    if (!file) return -1;
+
+    fprintf(file, "[meta]\nversion = %u\n\n[data]\n", version);
+    for (unsigned int i = 0; i < WATCH_BENCH_KEYS; i++) {
+        fprintf(file, "k%u = v%u-%u\n", i, version, i);
+    }
+
+    return fclose(file);
+}
+
+// Every key of a snapshot must belong to the same version
+static void* readerThread(void* arg) {
+    watchReader_t* r = arg;
+    char key[16], expected[32];
+    unsigned int i = 0;
+
+    while (!atomic_load_explicit(r->stop, memory_order_relaxed)) {
+        config_snapshot_t snap = config_watch_acquire(r->watch);
+        int64_t version;
+
+        if (config_get_int(snap.cfg, "meta", "version", &version) != 0) {
+            r->inconsistent++;
+        } else {
+            for (unsigned int n = 0; n < 8; n++, i = (i + 127) % WATCH_BENCH_KEYS) {
+                snprintf(key, sizeof(key), "k%u", i);
+                snprintf(expected, sizeof(expected), "v%lld-%u", (long long)version, i);
+                const char* value = config_lookup(snap.cfg, "data", key);
+                if (!value || strcmp(value, expected) != 0) r->inconsistent++;
+            }
+        }
+
+        config_watch_release(r->watch, snap);
+        r->reads++;
+    }
+
+    return NULL;
+}
+
+// Stand-in for the application's event loop: dispatch whenever inotify fires
+static void* writerThread(void* arg) {
+    watchWriter_t* w = arg;
+    struct pollfd pfd = {config_watch_fd(w->watch), POLLIN, 0};
+
+    while (!atomic_load_explicit(w->stop, memory_order_relaxed)) {
+        if (poll(&pfd, 1, 100) > 0 && config_watch_dispatch(w->watch) < 0) w->failures++;
+    }
+
+    return NULL;
+}
+
+// Average cost of <rounds> lookups, with or without acquire/release around each
+static double readerCost(config_watch_t* watch, int acquire, unsigned int rounds) {
+    config_snapshot_t snap = config_watch_acquire(watch);
+    const config_t* held = snap.cfg;
+    unsigned int misses = 0;
+
+    int64_t start = nowNs();
+    for (unsigned int i = 0; i < rounds; i++) {
+        if (acquire) {
+            config_snapshot_t s = config_watch_acquire(watch);
+            misses += config_lookup(s.cfg, "meta", "version") == NULL;
+            config_watch_release(watch, s);
+        } else {
+            misses += config_lookup(held, "meta", "version") == NULL;
+        }
+    }
+    int64_t elapsed = nowNs() - start;
+
+    config_watch_release(watch, snap);
+    return misses ? -1.0 : (double)elapsed / rounds;
+}
+
+int config_watch_bench(unsigned int readers, unsigned int reloads) {
+    char dir[64], path[96], tmp[96];
+    watchReader_t workers[WATCH_BENCH_MAX_READERS];
+    pthread_t ids[WATCH_BENCH_MAX_READERS], writer;
+    pthread_attr_t attr;
+    atomic_int stop = 0;
+    int status = 0;
+
+    if (readers > WATCH_BENCH_MAX_READERS) readers = WATCH_BENCH_MAX_READERS;
+    if (reloads == 0) reloads = 1;
+
+    // A private directory keeps unrelated files out of the inotify stream
+    snprintf(dir, sizeof(dir), "/tmp/config-watch-%d", (int)getpid());
+    snprintf(path, sizeof(path), "%s/bench.ini", dir);
+    snprintf(tmp, sizeof(tmp), "%s/bench.ini.tmp", dir);
+    if (mkdir(dir, 0700) < 0 || writeVersion(tmp, 0) < 0 || rename(tmp, path) < 0) {
+        perror(dir);
+        rmdir(dir);
+        return 1;
+    }
+
+    config_watch_t* watch = config_watch_open(path);
+    if (!watch) {
+        perror("config_watch_open");
+        unlink(path);
+        rmdir(dir);
+        return 1;
+    }
+
+    double plainNs = readerCost(watch, 0, WATCH_BENCH_ROUNDS);
+    double guardedNs = readerCost(watch, 1, WATCH_BENCH_ROUNDS);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, WATCH_BENCH_STACK_SIZE);
+
+    watchWriter_t w = {watch, &stop, 0};
+    unsigned int started = 0;
+    if (pthread_create(&writer, &attr, writerThread, &w) != 0) {
+        fprintf(stderr, "Failed to start the dispatch thread\n");
+        status = 1;
+        goto out;
+    }
+    for (; started < readers; started++) {
+        workers[started] = (watchReader_t){watch, &stop, 0, 0};
+        if (pthread_create(&ids[started], &attr, readerThread, &workers[started]) != 0) break;
+    }
+
+    // Replace the file and wait for the matching generation to be published
+    int64_t minNs = INT64_MAX, maxNs = 0, sumNs = 0;
+    unsigned int published = 0;
+    for (unsigned int v = 1; v <= reloads; v++) {
+        uint32_t generation = config_watch_generation(watch);
+        if (writeVersion(tmp, v) < 0) {
+            perror(tmp);
+            status = 1;
+            break;
+        }
+
+        // Timed from just before the rename, the point the new file becomes visible
+        int64_t written = nowNs();
+        if (rename(tmp, path) < 0) {
+            perror(path);
+            status = 1;
+            break;
+        }
+
+        while (config_watch_generation(watch) == generation && nowNs() - written < WATCH_BENCH_TIMEOUT_NS) {
+            usleep(20);
+        }
+        if (config_watch_generation(watch) == generation) {
+            fprintf(stderr, "Version %u was not published\n", v);
+            status = 1;
+            break;
+        }
+
+        int64_t latency = nowNs() - written;
+        if (latency < minNs) minNs = latency;
+        if (latency > maxNs) maxNs = latency;
+        sumNs += latency;
+        published++;
+    }
+
+    atomic_store(&stop, 1);
+    pthread_join(writer, NULL);
+
+    unsigned long reads = 0, inconsistent = 0;
+    for (unsigned int t = 0; t < started; t++) {
+        pthread_join(ids[t], NULL);
+        reads += workers[t].reads;
+        inconsistent += workers[t].inconsistent;
+    }
+
+    printf("Config reload benchmark: %u keys, %u readers, %u reloads\n", WATCH_BENCH_KEYS + 1, started, reloads);
+    printf("  reader lookup:   %.1f ns plain, %.1f ns with acquire/release (+%.1f ns)\n",
+           plainNs, guardedNs, guardedNs - plainNs);
+    if (published) {
+        printf("  reload latency:  min %.1f us, avg %.1f us, max %.1f us (rename to publish)\n",
+               minNs / 1e3, sumNs / 1e3 / published, maxNs / 1e3);
+    }
+    printf("  snapshots read:  %lu, inconsistent %lu, failed reloads %lu\n", reads, inconsistent, w.failures);
+
+    if (inconsistent || w.failures || plainNs < 0 || guardedNs < 0) status = 1;
+
+out:
+    pthread_attr_destroy(&attr);
+    config_watch_close(watch);
+    unlink(tmp);
+    unlink(path);
+    rmdir(dir);
+    return status;
+}
@@ -0,0 +1,119 @@
+// src/libmath/fixed_point.c
+//
+// Out-of-line fixed-point functions. The tables were generated with
+//   round(32768 * sin(i / 128 * pi / 2))    (clamped to 32767)
+//   round(65536 * atan(i / 128) / (2 * pi))
+// for i = 0..128, so every lookup interpolates between two entries.
+
+#include "libmath/fixed_point.h"
+
+// sin() over one quadrant in Q15
+static const q15_t sinTable[129] = {
+    0, 402, 804, 1206, 1608, 2009, 2411, 2811, 3212, 3612, 4011, 4410,
+    4808, 5205, 5602, 5998, 6393, 6787, 7180, 7571, 7962, 8351, 8740, 9127,
+    9512, 9896, 10279, 10660, 11039, 11417, 11793, 12167, 12540, 12910, 13279, 13646,
+    14010, 14373, 14733, 15091, 15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+    18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475, 20788, 21097, 21403, 21706,
+    22006, 22302, 22595, 22884, 23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+    25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020, 27246, 27467, 27684, 27897,
+    28106, 28311, 28511, 28707, 28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+    30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238, 31357, 31471, 31581, 31686,
+    31786, 31881, 31972, 32058, 32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+    32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766, 32767,
+};
+
+// atan() over [0, 1] in binary angle units (8192 is 45 degrees)
+static const uint16_t atanTable[129] = {
+    0, 81, 163, 244, 326, 407, 489, 570, 651, 732, 813, 894,
+    975, 1056, 1136, 1217, 1297, 1377, 1457, 1537, 1617, 1696, 1775, 1854,
+    1933, 2012, 2090, 2168, 2246, 2324, 2401, 2478, 2555, 2632, 2708, 2784,
+    2860, 2935, 3010, 3085, 3159, 3233, 3307, 3380, 3453, 3526, 3599, 3670,
+    3742, 3813, 3884, 3955, 4025, 4095, 4164, 4233, 4302, 4370, 4438, 4505,
+    4572, 4639, 4705, 4771, 4836, 4901, 4966, 5030, 5094, 5157, 5220, 5282,
+    5344, 5406, 5467, 5528, 5589, 5649, 5708, 5768, 5826, 5885, 5943, 6000,
+    6058, 6114, 6171, 6227, 6282, 6337, 6392, 6446, 6500, 6554, 6607, 6660,
+    6712, 6764, 6815, 6867, 6917, 6968, 7018, 7068, 7117, 7166, 7214, 7262,
+    7310, 7358, 7405, 7451, 7498, 7544, 7589, 7635, 7679, 7724, 7768, 7812,
+    7856, 7899, 7942, 7984, 8026, 8068, 8110, 8151, 8192,
+};
+
+q16_16_t q16_16_div(q16_16_t a, q16_16_t b) {
+    if (b == 0) return a < 0 ? Q16_16_MIN : a > 0 ? Q16_16_MAX : 0;
+
+    // Round half away from zero: grow |a| by |b| / 2 before truncating
+    int64_t numerator = (int64_t)a * Q16_16_ONE;
+    int64_t half = (b < 0 ? -(int64_t)b : b) / 2;
+    numerator += numerator < 0 ? -half : half;
+
+    return q31_saturate(numerator / b);
+}
+
+q16_16_t q16_16_sqrt(q16_16_t value) {
+    if (value <= 0) return 0;
+
+    // Digit-by-digit square root of value * 2^16; no divisions or tables
+    uint64_t remainder = (uint64_t)value << 16;
+    uint64_t root = 0;
+    // Start at the highest even power of two not above the operand
+    uint64_t bit = 1ULL << ((63 - __builtin_clzll(remainder)) & ~1);
+
+    while (bit) {
+        // Branch-free: the digit is unpredictable, a mispredict costs more
+        uint64_t trial = root + bit;
+        uint64_t take = 0 - (uint64_t)(remainder >= trial);
+        remainder -= trial & take;
+        root = (root >> 1) + (bit & take);
+        bit >>= 2;
+    }
+
+    return (q16_16_t)(remainder > root ? root + 1 : root);
+}
+
+q15_t q15_sin(fx_angle_t angle) {
+    unsigned int quadrant = angle >> 14;
+    unsigned int position = angle & (FX_ANGLE_QUARTER - 1);
+
+    // The second and fourth quadrants mirror the table
+    if (quadrant & 1) position = FX_ANGLE_QUARTER - position;
+
+    unsigned int index = position >> 7;
+    int32_t fraction = (int32_t)(position & 127);
+    int32_t value = sinTable[index];
+    if (fraction) value += ((sinTable[index + 1] - value) * fraction + 64) >> 7;
+
+    return (q15_t)(quadrant & 2 ? -value : value);
+}
+
+q15_t q15_cos(fx_angle_t angle) {
+    return q15_sin((fx_angle_t)(angle + FX_ANGLE_QUARTER));
+}
+
+fx_angle_t fx_atan2(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) return 0;
+
+    // Reduce to the first octant: ratio = smaller / larger magnitude
+    uint32_t ax = x < 0 ? 0u - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = y < 0 ? 0u - (uint32_t)y : (uint32_t)y;
+    int swapped = ay > ax;
+    uint32_t numerator = swapped ? ax : ay;
+    uint32_t denominator = swapped ? ay : ax;
+
+    // Keep the numerator << 16 within 32 bits for the hardware UDIV
+    while (denominator >> 16) {
+        numerator >>= 1;
+        denominator >>= 1;
+    }
+    uint32_t ratio = (numerator << 16) / denominator;
+
+    unsigned int index = ratio >> 9;
+    uint32_t fraction = ratio & 511;
+    uint32_t angle = atanTable[index];
+    if (fraction) angle += ((atanTable[index + 1] - angle) * fraction + 256) >> 9;
+
+    // Unfold the octant into the full circle
+    if (swapped) angle = FX_ANGLE_QUARTER - angle;
+    if (x < 0) angle = 2 * FX_ANGLE_QUARTER - angle;
+    if (y < 0) angle = 4 * FX_ANGLE_QUARTER - angle;
+
+    return (fx_angle_t)angle;
+}
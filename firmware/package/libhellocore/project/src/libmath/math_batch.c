@@ -0,0 +1,137 @@
+// src/libmath/math_batch.c
+//
+// Batch arithmetic. Every loop body is branch-free so GCC can vectorize it on
+// the host (-O2 with -ftree-vectorize, or -O3). On Cortex-M4 the int16 forms
+// process two elements per QADD16/QSUB16 and the int32 forms use QADD/QSUB.
+
+#include "libmath/math_batch.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_SIMD32) || defined(__ARM_FEATURE_QBIT)
+#include <arm_acle.h>
+#endif
+
+void math_add_n(const int* a, const int* b, int* out, size_t n) {
+    // Unsigned arithmetic wraps without undefined behaviour
+    for (size_t i = 0; i < n; i++) out[i] = (int)((unsigned int)a[i] + (unsigned int)b[i]);
+}
+
+void math_sub_n(const int* a, const int* b, int* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = (int)((unsigned int)a[i] - (unsigned int)b[i]);
+}
+
+void math_mul_n(const float* a, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = a[i] * b[i];
+}
+
+void math_fma_n(const float* a, const float* b, const float* c, float* out, size_t n) {
+    // Contracted to VFMA.F32 on an M4 with the FPU and FMA on hosts that have it
+    for (size_t i = 0; i < n; i++) out[i] = a[i] * b[i] + c[i];
+}
+
+// Float bit patterns: the division loop tests and selects on these because
+// float compares and selects around a division are turned into branches
+// under -ftrapping-math (the default), which stops vectorization
+#define FLOAT_ONE_BITS 0x3f800000u
+
+static inline uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float bitsFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t math_div_n(const float* a, const float* b, float* out, uint8_t* zeroMask, size_t n) {
+    size_t zeros = 0;
+
+    // The mask comes first: out may alias b
+    if (zeroMask) {
+        for (size_t i = 0; i < n; i += 8) {
+            size_t count = n - i < 8 ? n - i : 8;
+            unsigned int bits = 0;
+            for (size_t j = 0; j < count; j++) bits |= (unsigned int)((floatBits(b[i + j]) << 1) == 0) << j;
+            zeroMask[i / 8] = (uint8_t)bits;
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t divisor = floatBits(b[i]);
+        uint32_t zero = 0u - (uint32_t)((divisor << 1) == 0); // All ones for +0 and -0
+
+        // Divide by 1 instead of zero, then clear the result
+        float quotient = a[i] / bitsFloat((divisor & ~zero) | (FLOAT_ONE_BITS & zero));
+        out[i] = bitsFloat(floatBits(quotient) & ~zero);
+        zeros += zero & 1u;
+    }
+
+    return zeros;
+}
+
+static inline int16_t clampI16(int32_t value) {
+    value = value > INT16_MAX ? INT16_MAX : value;
+    return (int16_t)(value < INT16_MIN ? INT16_MIN : value);
+}
+
+// Wrapped sum/difference <result> overflowed: pick the limit on <a>'s side.
+// Stays in 32-bit lanes, unlike widening to int64_t.
+static inline int32_t saturateI32(int32_t a, int32_t result, int32_t overflow) {
+    int32_t limit = (int32_t)((uint32_t)(a >> 31) ^ (uint32_t)INT32_MAX);
+    return overflow < 0 ? limit : result;
+}
+
+#ifdef __ARM_FEATURE_SIMD32
+// Two int16 lanes per word; memcpy() compiles to a single (unaligned) LDR/STR
+static inline int16x2_t loadPair(const int16_t* p) {
+    int16x2_t pair;
+    memcpy(&pair, p, sizeof(pair));
+    return pair;
+}
+
+static inline void storePair(int16_t* p, int16x2_t pair) {
+    memcpy(p, &pair, sizeof(pair));
+}
+#endif
+
+void math_add_sat_i16_n(const int16_t* a, const int16_t* b, int16_t* out, size_t n) {
+    size_t i = 0;
+#ifdef __ARM_FEATURE_SIMD32
+    for (; i + 2 <= n; i += 2) storePair(out + i, __qadd16(loadPair(a + i), loadPair(b + i)));
+#endif
+    for (; i < n; i++) out[i] = clampI16((int32_t)a[i] + b[i]);
+}
+
+void math_sub_sat_i16_n(const int16_t* a, const int16_t* b, int16_t* out, size_t n) {
+    size_t i = 0;
+#ifdef __ARM_FEATURE_SIMD32
+    for (; i + 2 <= n; i += 2) storePair(out + i, __qsub16(loadPair(a + i), loadPair(b + i)));
+#endif
+    for (; i < n; i++) out[i] = clampI16((int32_t)a[i] - b[i]);
+}
+
+void math_add_sat_i32_n(const int32_t* a, const int32_t* b, int32_t* out, size_t n) {
+#ifdef __ARM_FEATURE_QBIT
+    for (size_t i = 0; i < n; i++) out[i] = __qadd(a[i], b[i]);
+#else
+    for (size_t i = 0; i < n; i++) {
+        int32_t sum = (int32_t)((uint32_t)a[i] + (uint32_t)b[i]);
+        out[i] = saturateI32(a[i], sum, (a[i] ^ sum) & (b[i] ^ sum));
+    }
+#endif
+}
+
+void math_sub_sat_i32_n(const int32_t* a, const int32_t* b, int32_t* out, size_t n) {
+#ifdef __ARM_FEATURE_QBIT
+    for (size_t i = 0; i < n; i++) out[i] = __qsub(a[i], b[i]);
+#else
+    for (size_t i = 0; i < n; i++) {
+        int32_t difference = (int32_t)((uint32_t)a[i] - (uint32_t)b[i]);
+        out[i] = saturateI32(a[i], difference, (a[i] ^ b[i]) & (a[i] ^ difference));
+    }
+#endif
+}
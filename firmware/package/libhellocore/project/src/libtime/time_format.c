@@ -0,0 +1,96 @@
+// src/libtime/time_format.c
+//
+// ISO-8601 timestamps for logging. The date, time and UTC offset only change
+// once a second, so they are formatted into the caller's cache then and the
+// per-call work is two memcpy()s and the fractional digits.
+
+#include "libtime/time_format.h"
+
+#include <string.h>
+
+#define PREFIX_LENGTH 19 // "YYYY-MM-DDTHH:MM:SS"
+
+static const long fractionScale[10] = {
+    1000000000L, 100000000L, 10000000L, 1000000L, 100000L, 10000L, 1000L, 100L, 10L, 1L,
+};
+
+// Write <value> as exactly <width> decimal digits
+static void putDigits(char* out, unsigned long value, int width) {
+    while (width-- > 0) {
+        out[width] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Recompute the cached fields for <second>
+static void fillCache(time_format_cache_t* cache, time_t second) {
+    struct tm tm;
+
+    if (!localtime_r(&second, &tm)) {
+        memset(&tm, 0, sizeof(tm));
+        tm.tm_mday = 1;
+    }
+
+    char* p = cache->prefix;
+    putDigits(p, (unsigned long)(tm.tm_year + 1900) % 10000, 4);
+    p[4] = '-';
+    putDigits(p + 5, (unsigned long)tm.tm_mon + 1, 2);
+    p[7] = '-';
+    putDigits(p + 8, (unsigned long)tm.tm_mday, 2);
+    p[10] = 'T';
+    putDigits(p + 11, (unsigned long)tm.tm_hour, 2);
+    p[13] = ':';
+    putDigits(p + 14, (unsigned long)tm.tm_min, 2);
+    p[16] = ':';
+    putDigits(p + 17, (unsigned long)tm.tm_sec, 2);
+
+    long gmtoff = tm.tm_gmtoff;
+    if (gmtoff == 0) {
+        cache->offset[0] = 'Z';
+        cache->offsetLength = 1;
+    } else {
+        unsigned long minutes = (unsigned long)(gmtoff < 0 ? -gmtoff : gmtoff) / 60;
+        cache->offset[0] = gmtoff < 0 ? '-' : '+';
+        putDigits(cache->offset + 1, minutes / 60 % 100, 2);
+        cache->offset[3] = ':';
+        putDigits(cache->offset + 4, minutes % 60, 2);
+        cache->offsetLength = 6;
+    }
+
+    cache->second = second;
+}
+
+void time_format_init(time_format_cache_t* cache) {
+    memset(cache, 0, sizeof(*cache));
+    cache->second = (time_t)-1;
+}
+
+size_t time_format_iso8601(time_format_cache_t* cache, const struct timespec* ts, int digits,
+                           char* buf, size_t size) {
+    if (digits < 0) digits = 0;
+    if (digits > 9) digits = 9;
+
+    size_t length = PREFIX_LENGTH + (digits ? 1 + (size_t)digits : 0);
+    if (cache->second != ts->tv_sec || cache->second == (time_t)-1) fillCache(cache, ts->tv_sec);
+    if (length + cache->offsetLength + 1 > size) return 0;
+
+    char* p = buf;
+    memcpy(p, cache->prefix, PREFIX_LENGTH);
+    p += PREFIX_LENGTH;
+    if (digits) {
+        *p++ = '.';
+        putDigits(p, (unsigned long)(ts->tv_nsec / fractionScale[digits]), digits);
+        p += digits;
+    }
+    memcpy(p, cache->offset, cache->offsetLength);
+    p += cache->offsetLength;
+    *p = '\0';
+
+    return (size_t)(p - buf);
+}
+
+size_t time_format_now(time_format_cache_t* cache, int digits, char* buf, size_t size) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return time_format_iso8601(cache, &ts, digits, buf, size);
+}
@@ -0,0 +1,42 @@
+// tools/ini2cache.c
+//
+// Build-host compiler from an INI file to the binary image read by
+// config_image_open(). Uses the same parser as the target binary.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "libconfig/config_image.h"
+
+int main(int argc, char* argv[]) {
+    char imagePath[4096];
+
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "Usage: %s <input.ini> [output]\n", argv[0]);
+        fprintf(stderr, "Writes <input.ini>" CONFIG_IMAGE_SUFFIX " unless an output is given.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (argc == 3) {
+        snprintf(imagePath, sizeof(imagePath), "%s", argv[2]);
+    } else {
+        snprintf(imagePath, sizeof(imagePath), "%s" CONFIG_IMAGE_SUFFIX, argv[1]);
+    }
+
+    if (config_image_compile(argv[1], imagePath) < 0) {
+        fprintf(stderr, "%s -> %s: %s\n", argv[1], imagePath, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    config_t* cfg = config_image_open(imagePath, argv[1]);
+    if (!cfg) {
+        fprintf(stderr, "%s: %s\n", imagePath, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    printf("%s -> %s (%zu keys, %zu bytes)\n", argv[1], imagePath, config_count(cfg), cfg->storageSize);
+    config_free(cfg);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+###############################################################################
+#
+# LIBPERIPHERY package
+#
+###############################################################################
+
+# Package version and source location
+LIBPERIPHERY_VERSION = 2.4.3
+LIBPERIPHERY_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libperiphery/project
+LIBPERIPHERY_SITE_METHOD = local
+LIBPERIPHERY_LICENSE = MIT
+
+# Headers and the archive go to staging, where the examples link against them
+LIBPERIPHERY_INSTALL_STAGING = YES
+
+# Use cross-compiler for detection
+LIBPERIPHERY_NULL := $(if $(filter Windows_NT,$(OS)),NUL,/dev/null)
+LIBPERIPHERY_GPIO_CDEV_V1_SUPPORT := $(shell ! env printf "\x23include <linux/gpio.h>\n\x23ifndef GPIO_GET_LINEEVENT_IOCTL\n\x23error\n\x23endif" | $(TARGET_CC) -E - >$(LIBPERIPHERY_NULL) 2>&1; echo $$?)
+LIBPERIPHERY_GPIO_CDEV_V2_SUPPORT := $(shell ! env printf "\x23include <linux/gpio.h>\nint main(void) { GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME; return 0; }" | $(TARGET_CC) -x c - >$(LIBPERIPHERY_NULL) 2>&1; echo $$?)
+LIBPERIPHERY_GPIO_CDEV_DETECTED = $(if $(filter 1,$(LIBPERIPHERY_GPIO_CDEV_V2_SUPPORT)),2,$(if $(filter 1,$(LIBPERIPHERY_GPIO_CDEV_V1_SUPPORT)),1,0))
+
+# An explicit ABI choice overrides the detection
+ifeq ($(BR2_PACKAGE_LIBPERIPHERY_GPIO_CDEV_V2),y)
+LIBPERIPHERY_GPIO_CDEV_SUPPORT = 2
+else ifeq ($(BR2_PACKAGE_LIBPERIPHERY_GPIO_CDEV_V1),y)
+LIBPERIPHERY_GPIO_CDEV_SUPPORT = 1
+else ifeq ($(BR2_PACKAGE_LIBPERIPHERY_GPIO_CDEV_NONE),y)
+LIBPERIPHERY_GPIO_CDEV_SUPPORT = 0
+else
+LIBPERIPHERY_GPIO_CDEV_SUPPORT = $(LIBPERIPHERY_GPIO_CDEV_DETECTED)
+endif
+
+LIBPERIPHERY_DEFINES += -DPERIPHERY_GPIO_CDEV_SUPPORT=$(LIBPERIPHERY_GPIO_CDEV_SUPPORT)
+
+# Modules selected in Kconfig; the others are not compiled at all
+LIBPERIPHERY_MODULES = \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_ADC),adc) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_GPIO),gpio) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_I2C),i2c) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_LED),led) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_MMIO),mmio) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_PWM),pwm) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_SERIAL),serial) \
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_SPI),spi)
+
+# One section per function and object so consumers can drop what they do not
+# call; consumers add LIBPERIPHERY_LDFLAGS to their link line
+LIBPERIPHERY_CFLAGS = $(TARGET_CFLAGS) -ffunction-sections -fdata-sections
+LIBPERIPHERY_LDFLAGS = -Wl,--gc-sections
+LIBPERIPHERY_AR = $(TARGET_AR)
+
+# Fat LTO objects still link into consumers built without -flto
+ifeq ($(BR2_ENABLE_LTO),y)
+LIBPERIPHERY_CFLAGS += -flto -ffat-lto-objects
+LIBPERIPHERY_LDFLAGS += -flto
+LIBPERIPHERY_AR = $(TARGET_CROSS)gcc-ar
+endif
+
+# Public headers of the selected modules; gpio_internal.h and
+# stats_internal.h are only used by the library sources
+LIBPERIPHERY_HEADERS = $(addsuffix .h,$(LIBPERIPHERY_MODULES) version stats)
+
+LIBPERIPHERY_MAKE_TARGETS = all
+ifeq ($(BR2_PACKAGE_LIBPERIPHERY_SHARED),y)
+LIBPERIPHERY_MAKE_TARGETS += shared
+endif
+
+# Build commands
+define LIBPERIPHERY_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(LIBPERIPHERY_AR)" \
+		CFLAGS="$(LIBPERIPHERY_CFLAGS) $(LIBPERIPHERY_DEFINES)" \
+		LDFLAGS="$(TARGET_LDFLAGS)" \
+		PERIPHERY_MODULES="$(LIBPERIPHERY_MODULES)" \
+		PERIPHERY_GPIO_SYSFS=$(if $(BR2_PACKAGE_LIBPERIPHERY_GPIO_SYSFS),y,n) \
+		PERIPHERY_STATS=$(if $(BR2_PACKAGE_LIBPERIPHERY_STATS),y,n) \
+		-C $(@D) $(LIBPERIPHERY_MAKE_TARGETS)
+endef
+
+define LIBPERIPHERY_INSTALL_SHARED
+	$(INSTALL) -D -m 0755 $(@D)/bin/libperiphery.so.2 $(1)/usr/lib/libperiphery.so.2
+	ln -sf libperiphery.so.2 $(1)/usr/lib/libperiphery.so
+endef
+
+# Install the headers and libraries for other packages to build against
+define LIBPERIPHERY_INSTALL_STAGING_CMDS
+	for h in $(LIBPERIPHERY_HEADERS); do \
+		$(INSTALL) -D -m 0644 $(@D)/include/periphery/$$h $(STAGING_DIR)/usr/include/periphery/$$h || exit 1; \
+	done
+	$(INSTALL) -D -m 0644 $(@D)/bin/libperiphery.a $(STAGING_DIR)/usr/lib/libperiphery.a
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_SHARED),$(call LIBPERIPHERY_INSTALL_SHARED,$(STAGING_DIR)))
+endef
+
+# Only the shared variant has anything to put on the target
+define LIBPERIPHERY_INSTALL_TARGET_CMDS
+	$(if $(BR2_PACKAGE_LIBPERIPHERY_SHARED),$(call LIBPERIPHERY_INSTALL_SHARED,$(TARGET_DIR)))
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
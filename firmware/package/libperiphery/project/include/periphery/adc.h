@@ -0,0 +1,71 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#ifndef _PERIPHERY_ADC_H
+#define _PERIPHERY_ADC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+enum adc_error_code {
+    ADC_ERROR_ARG           = -1, /* Invalid arguments */
+    ADC_ERROR_OPEN          = -2, /* Opening ADC */
+    ADC_ERROR_QUERY         = -3, /* Querying ADC attributes */
+    ADC_ERROR_CONFIGURE     = -4, /* Configuring ADC attributes */
+    ADC_ERROR_UNSUPPORTED   = -5, /* Unsupported scan element format */
+    ADC_ERROR_IO            = -6, /* Reading ADC samples */
+    ADC_ERROR_CLOSE         = -7, /* Closing ADC */
+};
+
+/* Configuration structure for adc_open_advanced() */
+typedef struct adc_config {
+    unsigned int channel;       /* in_voltage<channel> scan element */
+    unsigned int buffer_length; /* Kernel buffer size in samples (buffer/length) */
+    unsigned int watermark;     /* Samples queued before read()/poll() wake up, 0 for driver default */
+    const char *trigger;        /* Trigger name (e.g. "tim2_trgo", "sysfstrig0"), NULL to keep current */
+    double sample_rate;         /* Trigger sampling_frequency in Hz, 0 to keep current */
+} adc_config_t;
+
+typedef struct adc_handle adc_t;
+
+/* Primary Functions */
+adc_t *adc_new(void);
+int adc_open(adc_t *adc, unsigned int device, unsigned int channel);
+int adc_open_advanced(adc_t *adc, const char *sysfs_path, const char *dev_path, const adc_config_t *config);
+int adc_start(adc_t *adc);
+int adc_stop(adc_t *adc);
+int adc_read(adc_t *adc, uint16_t *samples, size_t count, int timeout_ms);
+int adc_poll(adc_t *adc, int timeout_ms);
+int adc_read_raw(adc_t *adc, int *value);
+int adc_trigger(adc_t *adc);
+int adc_close(adc_t *adc);
+void adc_free(adc_t *adc);
+
+/* Getters */
+int adc_get_scale(adc_t *adc, double *scale);
+int adc_get_sample_rate(adc_t *adc, double *sample_rate);
+int adc_get_resolution(adc_t *adc, unsigned int *bits);
+
+/* Miscellaneous */
+unsigned int adc_channel(adc_t *adc);
+int adc_fd(adc_t *adc);
+int adc_tostring(adc_t *adc, char *str, size_t len);
+
+/* Error Handling */
+int adc_errno(adc_t *adc);
+const char *adc_errmsg(adc_t *adc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -15,6 +15,8 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "stats.h"
+
 enum gpio_error_code {
     GPIO_ERROR_ARG                  = -1,   /* Invalid arguments */
     GPIO_ERROR_OPEN                 = -2,   /* Opening GPIO */
@@ -41,6 +43,12 @@ typedef enum gpio_edge {
     GPIO_EDGE_BOTH      /* Both edges X -> !X */
 } gpio_edge_t;
 
+typedef enum gpio_event_clock {
+    GPIO_EVENT_CLOCK_REALTIME,  /* Realtime, jumps when the time is set */
+    GPIO_EVENT_CLOCK_MONOTONIC, /* Monotonic */
+    GPIO_EVENT_CLOCK_HTE,       /* Hardware timestamp engine */
+} gpio_event_clock_t;
+
 typedef enum gpio_bias {
     GPIO_BIAS_DEFAULT,      /* Default line bias */
     GPIO_BIAS_PULL_UP,      /* Pull-up */
@@ -62,6 +70,9 @@ typedef struct gpio_config {
     gpio_drive_t drive;
     bool inverted;
     const char *label; /* Can be NULL for default consumer label */
+    /* Added last, so positional initializers of the fields above keep working */
+    gpio_event_clock_t event_clock;
+    uint32_t debounce_us; /* Input debounce period, 0 for none */
 } gpio_config_t;
 
 typedef struct gpio_handle gpio_t;
@@ -88,6 +99,8 @@ int gpio_poll_multiple(gpio_t **gpios, size_t count, int timeout_ms, bool *gpios
 /* Getters */
 int gpio_get_direction(gpio_t *gpio, gpio_direction_t *direction);
 int gpio_get_edge(gpio_t *gpio, gpio_edge_t *edge);
+int gpio_get_event_clock(gpio_t *gpio, gpio_event_clock_t *event_clock);
+int gpio_get_debounce_us(gpio_t *gpio, uint32_t *debounce_us);
 int gpio_get_bias(gpio_t *gpio, gpio_bias_t *bias);
 int gpio_get_drive(gpio_t *gpio, gpio_drive_t *drive);
 int gpio_get_inverted(gpio_t *gpio, bool *inverted);
@@ -95,6 +108,8 @@ int gpio_get_inverted(gpio_t *gpio, bool *inverted);
 /* Setters */
 int gpio_set_direction(gpio_t *gpio, gpio_direction_t direction);
 int gpio_set_edge(gpio_t *gpio, gpio_edge_t edge);
+int gpio_set_event_clock(gpio_t *gpio, gpio_event_clock_t event_clock);
+int gpio_set_debounce_us(gpio_t *gpio, uint32_t debounce_us);
 int gpio_set_bias(gpio_t *gpio, gpio_bias_t bias);
 int gpio_set_drive(gpio_t *gpio, gpio_drive_t drive);
 int gpio_set_inverted(gpio_t *gpio, bool inverted);
@@ -109,6 +124,23 @@ int gpio_chip_name(gpio_t *gpio, char *str, size_t len);
 int gpio_chip_label(gpio_t *gpio, char *str, size_t len);
 int gpio_tostring(gpio_t *gpio, char *str, size_t len);
 
+/* Line Name Cache (for character device GPIOs)
+ *
+ * gpio_open_name() indexes the line names of a chip on first use and
+ * afterwards resolves them without scanning; a chip whose label or line
+ * count changed, or whose resolved line no longer has the name, is indexed
+ * again. A name missing from the index is only reported as not found after
+ * the chip is indexed again. A NULL path searches all chips, and a miss
+ * indexes all of them again. The index can be saved to and loaded from a
+ * file to skip the first scan, e.g. across restarts of a daemon; loaded
+ * entries are checked when used. */
+int gpio_name_cache_load(const char *path);
+int gpio_name_cache_save(const char *path);
+void gpio_name_cache_clear(void);
+
+/* Statistics */
+int gpio_stats(gpio_t *gpio, periphery_stats_t *stats);
+
 /* Error Handling */
 int gpio_errno(gpio_t *gpio);
 const char *gpio_errmsg(gpio_t *gpio);
@@ -10,6 +10,7 @@
 #include <stdarg.h>
 
 #include "gpio.h"
+#include "stats_internal.h"
 
 /*********************************************************************************/
 /* Operations table and handle structure */
@@ -23,11 +24,15 @@ struct gpio_ops {
     int (*close)(gpio_t *gpio);
     int (*get_direction)(gpio_t *gpio, gpio_direction_t *direction);
     int (*get_edge)(gpio_t *gpio, gpio_edge_t *edge);
+    int (*get_event_clock)(gpio_t *gpio, gpio_event_clock_t *event_clock);
+    int (*get_debounce_us)(gpio_t *gpio, uint32_t *debounce_us);
     int (*get_bias)(gpio_t *gpio, gpio_bias_t *bias);
     int (*get_drive)(gpio_t *gpio, gpio_drive_t *drive);
     int (*get_inverted)(gpio_t *gpio, bool *inverted);
     int (*set_direction)(gpio_t *gpio, gpio_direction_t direction);
     int (*set_edge)(gpio_t *gpio, gpio_edge_t edge);
+    int (*set_event_clock)(gpio_t *gpio, gpio_event_clock_t event_clock);
+    int (*set_debounce_us)(gpio_t *gpio, uint32_t debounce_us);
     int (*set_bias)(gpio_t *gpio, gpio_bias_t bias);
     int (*set_drive)(gpio_t *gpio, gpio_drive_t drive);
     int (*set_inverted)(gpio_t *gpio, bool inverted);
@@ -51,6 +56,8 @@ struct gpio_handle {
             int chip_fd;
             gpio_direction_t direction;
             gpio_edge_t edge;
+            gpio_event_clock_t event_clock;
+            uint32_t debounce_us;
             gpio_bias_t bias;
             gpio_drive_t drive;
             bool inverted;
@@ -63,6 +70,10 @@ struct gpio_handle {
         } sysfs;
     } u;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     /* error state */
     struct {
         int c_errno;
@@ -93,5 +104,16 @@ inline static int _gpio_error(gpio_t *gpio, int code, int c_errno, const char *f
     return code;
 }
 
+/* Line of <name> on the chip at <path>, or with a NULL path on the lowest
+ * numbered /dev/gpiochipN having it, whose path is then stored in chip_path */
+int _gpio_name_cache_lookup(gpio_t *gpio, const char *path, const char *name, char *chip_path, size_t len, unsigned int *line);
+
+#if PERIPHERY_STATS
+/* Description of the handle in periphery_stats_dump() */
+inline static int _gpio_stats_tostring(void *handle, char *str, size_t len) {
+    return gpio_tostring(handle, str, len);
+}
+#endif
+
 #endif
 
@@ -18,6 +18,8 @@ extern "C" {
 #include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
+#include "stats.h"
+
 enum i2c_error_code {
     I2C_ERROR_ARG               = -1, /* Invalid arguments */
     I2C_ERROR_OPEN              = -2, /* Opening I2C device */
@@ -40,6 +42,9 @@ void i2c_free(i2c_t *i2c);
 int i2c_fd(i2c_t *i2c);
 int i2c_tostring(i2c_t *i2c, char *str, size_t len);
 
+/* Statistics */
+int i2c_stats(i2c_t *i2c, periphery_stats_t *stats);
+
 /* Error Handling */
 int i2c_errno(i2c_t *i2c);
 const char *i2c_errmsg(i2c_t *i2c);
@@ -15,6 +15,8 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "stats.h"
+
 enum led_error_code {
     LED_ERROR_ARG       = -1, /* Invalid arguments */
     LED_ERROR_OPEN      = -2, /* Opening LED */
@@ -44,6 +46,9 @@ int led_set_brightness(led_t *led, unsigned int brightness);
 int led_name(led_t *led, char *str, size_t len);
 int led_tostring(led_t *led, char *str, size_t len);
 
+/* Statistics */
+int led_stats(led_t *led, periphery_stats_t *stats);
+
 /* Error Handling */
 int led_errno(led_t *led);
 const char *led_errmsg(led_t *led);
@@ -15,6 +15,8 @@ extern "C" {
 #include <stdint.h>
 #include <sys/types.h>
 
+#include "stats.h"
+
 enum mmio_error_code {
     MMIO_ERROR_ARG          = -1, /* Invalid arguments */
     MMIO_ERROR_OPEN         = -2, /* Opening MMIO */
@@ -44,6 +46,9 @@ uintptr_t mmio_base(mmio_t *mmio);
 size_t mmio_size(mmio_t *mmio);
 int mmio_tostring(mmio_t *mmio, char *str, size_t len);
 
+/* Statistics */
+int mmio_stats(mmio_t *mmio, periphery_stats_t *stats);
+
 /* Error Handling */
 int mmio_errno(mmio_t *mmio);
 const char *mmio_errmsg(mmio_t *mmio);
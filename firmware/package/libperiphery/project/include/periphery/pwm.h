@@ -15,6 +15,8 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "stats.h"
+
 enum pwm_error_code {
     PWM_ERROR_ARG           = -1, /* Invalid arguments */
     PWM_ERROR_OPEN          = -2, /* Opening PWM */
@@ -61,6 +63,9 @@ unsigned int pwm_chip(pwm_t *pwm);
 unsigned int pwm_channel(pwm_t *pwm);
 int pwm_tostring(pwm_t *pwm, char *str, size_t len);
 
+/* Statistics */
+int pwm_stats(pwm_t *pwm, periphery_stats_t *stats);
+
 /* Error Handling */
 int pwm_errno(pwm_t *pwm);
 const char *pwm_errmsg(pwm_t *pwm);
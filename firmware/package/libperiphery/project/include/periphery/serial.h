@@ -15,6 +15,8 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "stats.h"
+
 enum serial_error_code {
     SERIAL_ERROR_ARG            = -1, /* Invalid arguments */
     SERIAL_ERROR_OPEN           = -2, /* Opening serial port */
@@ -72,6 +74,9 @@ int serial_set_vtime(serial_t *serial, float vtime);
 int serial_fd(serial_t *serial);
 int serial_tostring(serial_t *serial, char *str, size_t len);
 
+/* Statistics */
+int serial_stats(serial_t *serial, periphery_stats_t *stats);
+
 /* Error Handling */
 int serial_errno(serial_t *serial);
 const char *serial_errmsg(serial_t *serial);
@@ -14,6 +14,8 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "stats.h"
+
 enum spi_error_code {
     SPI_ERROR_ARG           = -1, /* Invalid arguments */
     SPI_ERROR_OPEN          = -2, /* Opening SPI device */
@@ -65,6 +67,9 @@ int spi_set_extra_flags32(spi_t *spi, uint32_t extra_flags);
 int spi_fd(spi_t *spi);
 int spi_tostring(spi_t *spi, char *str, size_t len);
 
+/* Statistics */
+int spi_stats(spi_t *spi, periphery_stats_t *stats);
+
 /* Error Handling */
 int spi_errno(spi_t *spi);
 const char *spi_errmsg(spi_t *spi);
@@ -0,0 +1,46 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#ifndef _PERIPHERY_STATS_H
+#define _PERIPHERY_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Counters of a handle's data path operations: gpio read/write/read_event,
+ * spi and i2c transfers, serial read/write, pwm and led sysfs attribute
+ * accesses, mmio reads and writes. They are kept only when the library is
+ * built with PERIPHERY_STATS=1; otherwise the getters report zeros and
+ * periphery_stats_enabled() returns false. */
+typedef struct periphery_stats {
+    uint64_t ops;       /* Operations, including failed ones */
+    uint64_t errors;    /* Operations that returned an error */
+    uint64_t bytes;     /* Payload of successful spi, i2c, serial and mmio operations */
+    uint64_t total_ns;  /* Cumulative latency */
+    uint64_t max_ns;    /* Slowest single operation */
+} periphery_stats_t;
+
+bool periphery_stats_enabled(void);
+
+/* Print a header and one line per open handle that has done I/O (nothing
+ * without PERIPHERY_STATS), and return the number of handles listed, or a
+ * negative value if writing failed */
+int periphery_stats_dump(FILE *stream);
+
+/* Zero the counters of every open handle */
+void periphery_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,116 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#ifndef _PERIPHERY_STATS_INTERNAL_H
+#define _PERIPHERY_STATS_INTERNAL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "stats.h"
+
+/* Per-handle instrumentation, off by default. Disabled, the handles carry
+ * no counters and the macros below reduce to the plain calls. */
+#ifndef PERIPHERY_STATS
+#define PERIPHERY_STATS 0
+#endif
+
+#if PERIPHERY_STATS
+
+#include <time.h>
+
+/* Every stamp is a clock_gettime() call; without a vDSO, as on no-MMU
+ * targets, that is a syscall, so build with a coarser clock if the
+ * resolution is not needed */
+#ifndef PERIPHERY_STATS_CLOCK
+#define PERIPHERY_STATS_CLOCK CLOCK_MONOTONIC
+#endif
+
+/*********************************************************************************/
+/* Counters and registry entry, embedded in each handle */
+/*********************************************************************************/
+
+/* Room for a handle description in periphery_stats_dump() */
+#define PERIPHERY_STATS_DESCRIPTION_SIZE 128
+
+struct periphery_stats_entry {
+    periphery_stats_t counters;
+
+    /* Description for periphery_stats_dump(), taken when the handle is
+     * registered */
+    const char *module;
+    void *handle;
+    int (*tostring)(void *handle, char *str, size_t len);
+    char description[PERIPHERY_STATS_DESCRIPTION_SIZE];
+
+    /* Link in the registry, made on the first recorded operation */
+    bool registered;
+    struct periphery_stats_entry *prev, *next;
+};
+
+void _periphery_stats_init(struct periphery_stats_entry *entry, const char *module, void *handle,
+                           int (*tostring)(void *handle, char *str, size_t len));
+void _periphery_stats_register(struct periphery_stats_entry *entry);
+void _periphery_stats_unregister(struct periphery_stats_entry *entry);
+
+inline static uint64_t _periphery_stats_now(void) {
+    struct timespec ts;
+
+    clock_gettime(PERIPHERY_STATS_CLOCK, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+inline static void _periphery_stats_record(struct periphery_stats_entry *entry, uint64_t start_ns, int ret, uint64_t bytes) {
+    uint64_t elapsed_ns = _periphery_stats_now() - start_ns;
+
+    if (!entry->registered)
+        _periphery_stats_register(entry);
+
+    entry->counters.ops++;
+    entry->counters.bytes += bytes;
+    if (ret < 0)
+        entry->counters.errors++;
+
+    entry->counters.total_ns += elapsed_ns;
+    if (elapsed_ns > entry->counters.max_ns)
+        entry->counters.max_ns = elapsed_ns;
+}
+
+/* The macros below take a handle whose "stats" member is the entry */
+
+/* Time an operation returning an int error code and account it, with
+ * <bytes> of payload (only evaluated if it succeeded); evaluates to the
+ * call's result */
+#define PERIPHERY_STATS_CALL(handle, bytes, call) __extension__ ({                 \
+        uint64_t _stats_start = _periphery_stats_now();                             \
+        int _stats_ret = (call);                                                    \
+        _periphery_stats_record(&(handle)->stats, _stats_start, _stats_ret,         \
+                                _stats_ret < 0 ? 0 : (uint64_t)(bytes));            \
+        _stats_ret;                                                                 \
+    })
+
+/* Same, for operations returning the number of bytes they moved */
+#define PERIPHERY_STATS_CALL_COUNT(handle, call) \
+    PERIPHERY_STATS_CALL(handle, (uint64_t)_stats_ret, call)
+
+#define PERIPHERY_STATS_INIT(handle, module, tostring) \
+    _periphery_stats_init(&(handle)->stats, (module), (handle), (tostring))
+#define PERIPHERY_STATS_CLOSE(handle) _periphery_stats_unregister(&(handle)->stats)
+#define PERIPHERY_STATS_GET(handle, result) (*(result) = (handle)->stats.counters)
+
+#else
+
+#define PERIPHERY_STATS_CALL(handle, bytes, call) (call)
+#define PERIPHERY_STATS_CALL_COUNT(handle, call) (call)
+#define PERIPHERY_STATS_INIT(handle, module, tostring) ((void)(handle))
+#define PERIPHERY_STATS_CLOSE(handle) ((void)(handle))
+#define PERIPHERY_STATS_GET(handle, result) ((void)(handle), *(result) = (periphery_stats_t){0})
+
+#endif
+
+#endif
+
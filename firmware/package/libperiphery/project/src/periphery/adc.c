@@ -0,0 +1,577 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <dirent.h>
+#include <errno.h>
+
+#include "periphery/adc.h"
+
+#define P_PATH_MAX 256
+
+/* Defaults used by adc_open() */
+#define ADC_DEFAULT_BUFFER_LENGTH 4096
+#define ADC_DEFAULT_WATERMARK 1024
+
+struct adc_handle
+{
+    int fd;
+    unsigned int channel;
+    bool enabled;
+    char sysfs_path[P_PATH_MAX];
+    char dev_path[P_PATH_MAX];
+    char trigger_path[P_PATH_MAX];
+
+    /* Scan element format, parsed from in_voltage<N>_type ("le:u12/16>>0") */
+    struct
+    {
+        bool big_endian;
+        bool is_signed;
+        unsigned int bits;
+        unsigned int storage_bits;
+        unsigned int shift;
+    } scan;
+
+    struct
+    {
+        int c_errno;
+        char errmsg[96];
+    } error;
+};
+
+static int _adc_error(adc_t *adc, int code, int c_errno, const char *fmt, ...)
+{
+    va_list ap;
+
+    adc->error.c_errno = c_errno;
+
+    va_start(ap, fmt);
+    vsnprintf(adc->error.errmsg, sizeof(adc->error.errmsg), fmt, ap);
+    va_end(ap);
+
+    /* Tack on strerror() and errno */
+    if (c_errno)
+    {
+        char buf[64] = {0};
+        strerror_r(c_errno, buf, sizeof(buf));
+        snprintf(adc->error.errmsg + strlen(adc->error.errmsg), sizeof(adc->error.errmsg) - strlen(adc->error.errmsg), ": %s [errno %d]", buf, c_errno);
+    }
+
+    return code;
+}
+
+/* Write a string to a sysfs attribute. Returns 0 on success, errno on failure. */
+static int _adc_attr_write(const char *dir, const char *attr, const char *value)
+{
+    char path[P_PATH_MAX];
+    int fd;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    if ((fd = open(path, O_WRONLY)) < 0)
+        return errno;
+
+    if (write(fd, value, strlen(value)) < 0)
+    {
+        int errsv = errno;
+        close(fd);
+        return errsv;
+    }
+
+    if (close(fd) < 0)
+        return errno;
+
+    return 0;
+}
+
+/* Read a sysfs attribute with the trailing newline stripped. Returns 0 on success, errno on failure. */
+static int _adc_attr_read(const char *dir, const char *attr, char *buf, size_t len)
+{
+    char path[P_PATH_MAX];
+    int fd;
+    ssize_t ret;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return errno;
+
+    if ((ret = read(fd, buf, len - 1)) < 0)
+    {
+        int errsv = errno;
+        close(fd);
+        return errsv;
+    }
+
+    if (close(fd) < 0)
+        return errno;
+
+    buf[ret] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+
+    return 0;
+}
+
+/* Locate the IIO trigger directory (e.g. .../trigger0) whose name matches */
+static bool _adc_find_trigger(const char *devices_path, const char *name, char *trigger_path, size_t len)
+{
+    struct dirent *entry;
+    DIR *dir;
+    bool found = false;
+
+    if ((dir = opendir(devices_path)) == NULL)
+        return false;
+
+    while (!found && (entry = readdir(dir)) != NULL)
+    {
+        char path[P_PATH_MAX];
+        char trigger_name[64];
+
+        if (strncmp(entry->d_name, "trigger", strlen("trigger")) != 0)
+            continue;
+
+        if (snprintf(path, sizeof(path), "%s/%s", devices_path, entry->d_name) >= (int)sizeof(path))
+            continue;
+
+        if (_adc_attr_read(path, "name", trigger_name, sizeof(trigger_name)) != 0)
+            continue;
+
+        if (strcmp(trigger_name, name) == 0)
+        {
+            snprintf(trigger_path, len, "%s", path);
+            found = true;
+        }
+    }
+
+    closedir(dir);
+
+    return found;
+}
+
+static int _adc_setup_trigger(adc_t *adc, const char *name, double sample_rate)
+{
+    char devices_path[P_PATH_MAX];
+    char *slash;
+    unsigned int sysfs_id;
+    int errsv;
+
+    /* Triggers are siblings of the device directory in /sys/bus/iio/devices */
+    snprintf(devices_path, sizeof(devices_path), "%s", adc->sysfs_path);
+    if ((slash = strrchr(devices_path, '/')) != NULL)
+        *slash = '\0';
+
+    if (!_adc_find_trigger(devices_path, name, adc->trigger_path, sizeof(adc->trigger_path)))
+    {
+        char id[16];
+
+        /* Software triggers (CONFIG_IIO_SYSFS_TRIGGER) are created on demand */
+        if (sscanf(name, "sysfstrig%u", &sysfs_id) != 1)
+            return _adc_error(adc, ADC_ERROR_CONFIGURE, 0, "Trigger \"%s\" not found", name);
+
+        snprintf(id, sizeof(id), "%u", sysfs_id);
+        if ((errsv = _adc_attr_write(devices_path, "iio_sysfs_trigger/add_trigger", id)) != 0)
+            return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Creating sysfs trigger \"%s\"", name);
+
+        if (!_adc_find_trigger(devices_path, name, adc->trigger_path, sizeof(adc->trigger_path)))
+            return _adc_error(adc, ADC_ERROR_CONFIGURE, 0, "Trigger \"%s\" not found after creation", name);
+    }
+
+    if ((errsv = _adc_attr_write(adc->sysfs_path, "trigger/current_trigger", name)) != 0)
+        return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Selecting trigger \"%s\"", name);
+
+    if (sample_rate > 0)
+    {
+        char buf[32];
+
+        snprintf(buf, sizeof(buf), "%.0f", sample_rate);
+        if ((errsv = _adc_attr_write(adc->trigger_path, "sampling_frequency", buf)) != 0)
+            return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Setting trigger sampling frequency");
+    }
+
+    return 0;
+}
+
+static int _adc_setup_scan(adc_t *adc)
+{
+    char scan_path[P_PATH_MAX + 16];
+    char attr[64];
+    char type[32];
+    char endian, sign;
+    struct dirent *entry;
+    DIR *dir;
+    int errsv;
+
+    snprintf(scan_path, sizeof(scan_path), "%s/scan_elements", adc->sysfs_path);
+
+    /* Start from an empty scan: one enabled channel gives a packed sample stream */
+    if ((dir = opendir(scan_path)) == NULL)
+        return _adc_error(adc, ADC_ERROR_OPEN, errno, "Opening scan elements (buffered mode unsupported?)");
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        size_t len = strlen(entry->d_name);
+
+        if (len > 3 && strcmp(entry->d_name + len - 3, "_en") == 0)
+            _adc_attr_write(scan_path, entry->d_name, "0");
+    }
+
+    closedir(dir);
+
+    snprintf(attr, sizeof(attr), "in_voltage%u_en", adc->channel);
+    if ((errsv = _adc_attr_write(scan_path, attr, "1")) != 0)
+        return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Enabling scan element in_voltage%u", adc->channel);
+
+    snprintf(attr, sizeof(attr), "in_voltage%u_type", adc->channel);
+    if ((errsv = _adc_attr_read(scan_path, attr, type, sizeof(type))) != 0)
+        return _adc_error(adc, ADC_ERROR_QUERY, errsv, "Reading scan element type");
+
+    if (sscanf(type, "%ce:%c%u/%u>>%u", &endian, &sign, &adc->scan.bits, &adc->scan.storage_bits, &adc->scan.shift) != 5)
+        return _adc_error(adc, ADC_ERROR_UNSUPPORTED, 0, "Unrecognized scan element type \"%s\"", type);
+
+    /* Only 16-bit storage is streamed straight into the caller's buffer */
+    if (adc->scan.storage_bits != 16 || adc->scan.bits == 0 || adc->scan.bits + adc->scan.shift > 16)
+        return _adc_error(adc, ADC_ERROR_UNSUPPORTED, 0, "Unsupported scan element type \"%s\"", type);
+
+    adc->scan.big_endian = (endian == 'b');
+    adc->scan.is_signed = (sign == 's');
+
+    return 0;
+}
+
+adc_t *adc_new(void)
+{
+    adc_t *adc = calloc(1, sizeof(adc_t));
+    if (adc == NULL)
+        return NULL;
+
+    adc->fd = -1;
+
+    return adc;
+}
+
+int adc_open(adc_t *adc, unsigned int device, unsigned int channel)
+{
+    char sysfs_path[P_PATH_MAX];
+    char dev_path[P_PATH_MAX];
+    adc_config_t config = {
+        .channel = channel,
+        .buffer_length = ADC_DEFAULT_BUFFER_LENGTH,
+        .watermark = ADC_DEFAULT_WATERMARK,
+        .trigger = NULL,
+        .sample_rate = 0,
+    };
+
+    snprintf(sysfs_path, sizeof(sysfs_path), "/sys/bus/iio/devices/iio:device%u", device);
+    snprintf(dev_path, sizeof(dev_path), "/dev/iio:device%u", device);
+
+    return adc_open_advanced(adc, sysfs_path, dev_path, &config);
+}
+
+int adc_open_advanced(adc_t *adc, const char *sysfs_path, const char *dev_path, const adc_config_t *config)
+{
+    char buf[32];
+    int ret, errsv;
+
+    if (config->buffer_length == 0)
+        return _adc_error(adc, ADC_ERROR_ARG, 0, "Invalid buffer length (must be non-zero)");
+
+    if (config->watermark > config->buffer_length)
+        return _adc_error(adc, ADC_ERROR_ARG, 0, "Invalid watermark (must not exceed buffer length)");
+
+    memset(adc, 0, sizeof(adc_t));
+    adc->fd = -1;
+    adc->channel = config->channel;
+    snprintf(adc->sysfs_path, sizeof(adc->sysfs_path), "%s", sysfs_path);
+    snprintf(adc->dev_path, sizeof(adc->dev_path), "%s", dev_path);
+
+    /* Buffer geometry and scan elements can only change while disabled */
+    if ((errsv = _adc_attr_write(adc->sysfs_path, "buffer/enable", "0")) != 0)
+        return _adc_error(adc, ADC_ERROR_OPEN, errsv, "Disabling IIO buffer");
+
+    if ((ret = _adc_setup_scan(adc)) < 0)
+        return ret;
+
+    if (config->trigger && (ret = _adc_setup_trigger(adc, config->trigger, config->sample_rate)) < 0)
+        return ret;
+
+    snprintf(buf, sizeof(buf), "%u", config->buffer_length);
+    if ((errsv = _adc_attr_write(adc->sysfs_path, "buffer/length", buf)) != 0)
+        return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Setting buffer length");
+
+    if (config->watermark > 0)
+    {
+        snprintf(buf, sizeof(buf), "%u", config->watermark);
+        if ((errsv = _adc_attr_write(adc->sysfs_path, "buffer/watermark", buf)) != 0)
+            return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Setting buffer watermark");
+    }
+
+    if ((adc->fd = open(adc->dev_path, O_RDONLY | O_NONBLOCK)) < 0)
+        return _adc_error(adc, ADC_ERROR_OPEN, errno, "Opening %s", adc->dev_path);
+
+    return 0;
+}
+
+int adc_start(adc_t *adc)
+{
+    int errsv;
+
+    if (adc->enabled)
+        return 0;
+
+    if ((errsv = _adc_attr_write(adc->sysfs_path, "buffer/enable", "1")) != 0)
+        return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Enabling IIO buffer");
+
+    adc->enabled = true;
+
+    return 0;
+}
+
+int adc_stop(adc_t *adc)
+{
+    int errsv;
+
+    if (!adc->enabled)
+        return 0;
+
+    if ((errsv = _adc_attr_write(adc->sysfs_path, "buffer/enable", "0")) != 0)
+        return _adc_error(adc, ADC_ERROR_CONFIGURE, errsv, "Disabling IIO buffer");
+
+    adc->enabled = false;
+
+    return 0;
+}
+
+int adc_poll(adc_t *adc, int timeout_ms)
+{
+    struct pollfd fds[1];
+    int ret;
+
+    fds[0].fd = adc->fd;
+    fds[0].events = POLLIN;
+    if ((ret = poll(fds, 1, timeout_ms)) < 0)
+        return _adc_error(adc, ADC_ERROR_IO, errno, "Polling IIO buffer");
+
+    return ret > 0;
+}
+
+/* Reads up to count samples. Every read() drains as many whole samples as the
+ * kernel buffer holds, so a block costs one syscall per watermark instead of
+ * one sysfs access per sample. timeout_ms bounds each wait for new data (-1
+ * blocks). Returns the number of samples read. */
+int adc_read(adc_t *adc, uint16_t *samples, size_t count, int timeout_ms)
+{
+    uint8_t *buf = (uint8_t *)samples;
+    size_t want = count * sizeof(uint16_t);
+    size_t got = 0;
+
+    if (adc->fd < 0)
+        return _adc_error(adc, ADC_ERROR_ARG, 0, "ADC not open");
+
+    while (got < want)
+    {
+        ssize_t ret = read(adc->fd, buf + got, want - got);
+
+        if (ret > 0)
+        {
+            got += ret;
+            continue;
+        }
+
+        /* End of stream (e.g. device removed or a file-backed fake) */
+        if (ret == 0)
+            break;
+
+        if (errno == EAGAIN)
+        {
+            int ready = adc_poll(adc, timeout_ms);
+            if (ready < 0)
+                return ready;
+            else if (ready == 0)
+                break;
+            continue;
+        }
+
+        if (errno == EINTR)
+            continue;
+
+        return _adc_error(adc, ADC_ERROR_IO, errno, "Reading IIO buffer");
+    }
+
+    count = got / sizeof(uint16_t);
+
+    /* Normalize to right-aligned codes only when the scan format requires it */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    bool swap = !adc->scan.big_endian;
+#else
+    bool swap = adc->scan.big_endian;
+#endif
+
+    if (swap || adc->scan.shift != 0 || adc->scan.bits != 16)
+    {
+        uint16_t mask = (uint16_t)((1u << adc->scan.bits) - 1);
+        uint16_t sign_bit = (uint16_t)(1u << (adc->scan.bits - 1));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            uint16_t value = samples[i];
+
+            if (swap)
+                value = (uint16_t)((value >> 8) | (value << 8));
+
+            value = (value >> adc->scan.shift) & mask;
+
+            if (adc->scan.is_signed && (value & sign_bit))
+                value |= (uint16_t)~mask;
+
+            samples[i] = value;
+        }
+    }
+
+    return (int)count;
+}
+
+int adc_read_raw(adc_t *adc, int *value)
+{
+    char attr[64];
+    char buf[32];
+    int errsv;
+
+    /* The kernel refuses direct reads while the buffer is enabled */
+    if (adc->enabled)
+        return _adc_error(adc, ADC_ERROR_ARG, 0, "Invalid operation: buffered capture running");
+
+    snprintf(attr, sizeof(attr), "in_voltage%u_raw", adc->channel);
+    if ((errsv = _adc_attr_read(adc->sysfs_path, attr, buf, sizeof(buf))) != 0)
+        return _adc_error(adc, ADC_ERROR_IO, errsv, "Reading %s", attr);
+
+    *value = (int)strtol(buf, NULL, 10);
+
+    return 0;
+}
+
+int adc_trigger(adc_t *adc)
+{
+    int errsv;
+
+    if (adc->trigger_path[0] == '\0')
+        return _adc_error(adc, ADC_ERROR_ARG, 0, "No trigger configured");
+
+    if ((errsv = _adc_attr_write(adc->trigger_path, "trigger_now", "1")) != 0)
+        return _adc_error(adc, ADC_ERROR_IO, errsv, "Firing software trigger");
+
+    return 0;
+}
+
+int adc_close(adc_t *adc)
+{
+    int ret;
+
+    if (adc->fd < 0)
+        return 0;
+
+    /* The descriptor is closed even if the buffer cannot be disabled; the
+     * first error is reported */
+    ret = adc_stop(adc);
+
+    if (close(adc->fd) < 0 && ret == 0)
+        ret = _adc_error(adc, ADC_ERROR_CLOSE, errno, "Closing %s", adc->dev_path);
+
+    adc->fd = -1;
+
+    return ret;
+}
+
+void adc_free(adc_t *adc)
+{
+    free(adc);
+}
+
+int adc_get_scale(adc_t *adc, double *scale)
+{
+    char attr[64];
+    char buf[32];
+    int errsv;
+
+    /* Drivers expose either a per-channel or a shared scale attribute */
+    snprintf(attr, sizeof(attr), "in_voltage%u_scale", adc->channel);
+    if ((errsv = _adc_attr_read(adc->sysfs_path, attr, buf, sizeof(buf))) == ENOENT)
+        errsv = _adc_attr_read(adc->sysfs_path, "in_voltage_scale", buf, sizeof(buf));
+
+    if (errsv != 0)
+        return _adc_error(adc, ADC_ERROR_QUERY, errsv, "Reading voltage scale");
+
+    *scale = strtod(buf, NULL);
+
+    return 0;
+}
+
+int adc_get_sample_rate(adc_t *adc, double *sample_rate)
+{
+    char buf[32];
+    int errsv;
+
+    if (adc->trigger_path[0] != '\0')
+        errsv = _adc_attr_read(adc->trigger_path, "sampling_frequency", buf, sizeof(buf));
+    else
+        errsv = _adc_attr_read(adc->sysfs_path, "sampling_frequency", buf, sizeof(buf));
+
+    if (errsv != 0)
+        return _adc_error(adc, ADC_ERROR_QUERY, errsv, "Reading sampling frequency");
+
+    *sample_rate = strtod(buf, NULL);
+
+    return 0;
+}
+
+int adc_get_resolution(adc_t *adc, unsigned int *bits)
+{
+    *bits = adc->scan.bits;
+    return 0;
+}
+
+unsigned int adc_channel(adc_t *adc)
+{
+    return adc->channel;
+}
+
+int adc_fd(adc_t *adc)
+{
+    return adc->fd;
+}
+
+int adc_tostring(adc_t *adc, char *str, size_t len)
+{
+    double scale;
+    char scale_str[32];
+
+    if (adc_get_scale(adc, &scale) < 0)
+        strcpy(scale_str, "<error>");
+    else
+        snprintf(scale_str, sizeof(scale_str), "%g", scale);
+
+    return snprintf(str, len, "ADC %s (channel=%u, fd=%d, format=%ce:%c%u/%u>>%u, scale=%s, trigger=\"%s\", enabled=%s)",
+                    adc->dev_path, adc->channel, adc->fd, adc->scan.big_endian ? 'b' : 'l', adc->scan.is_signed ? 's' : 'u',
+                    adc->scan.bits, adc->scan.storage_bits, adc->scan.shift, scale_str, adc->trigger_path, adc->enabled ? "true" : "false");
+}
+
+int adc_errno(adc_t *adc)
+{
+    return adc->error.c_errno;
+}
+
+const char *adc_errmsg(adc_t *adc)
+{
+    return adc->error.errmsg;
+}
@@ -21,9 +21,24 @@
 #include "periphery/gpio.h"
 #include "periphery/gpio_internal.h"
 
+/* The sysfs backend can be left out of size-optimized builds */
+#ifndef PERIPHERY_GPIO_SYSFS_SUPPORT
+#define PERIPHERY_GPIO_SYSFS_SUPPORT 1
+#endif
+
+#if !PERIPHERY_GPIO_CDEV_SUPPORT && !PERIPHERY_GPIO_SYSFS_SUPPORT
+#error "c-periphery GPIO needs the character device or the sysfs backend"
+#endif
+
 extern const struct gpio_ops gpio_cdev_ops;
 extern const struct gpio_ops gpio_sysfs_ops;
 
+#if PERIPHERY_GPIO_SYSFS_SUPPORT
+#define GPIO_IS_SYSFS(gpio) ((gpio)->ops == &gpio_sysfs_ops)
+#else
+#define GPIO_IS_SYSFS(gpio) false
+#endif
+
 gpio_t *gpio_new(void)
 {
     gpio_t *gpio = calloc(1, sizeof(gpio_t));
@@ -39,17 +54,19 @@ gpio_t *gpio_new(void)
     gpio->u.sysfs.line_fd = -1;
 #endif
 
+    PERIPHERY_STATS_INIT(gpio, "gpio", _gpio_stats_tostring);
+
     return gpio;
 }
 
 int gpio_read(gpio_t *gpio, bool *value)
 {
-    return gpio->ops->read(gpio, value);
+    return PERIPHERY_STATS_CALL(gpio, 0, gpio->ops->read(gpio, value));
 }
 
 int gpio_write(gpio_t *gpio, bool value)
 {
-    return gpio->ops->write(gpio, value);
+    return PERIPHERY_STATS_CALL(gpio, 0, gpio->ops->write(gpio, value));
 }
 
 int gpio_poll(gpio_t *gpio, int timeout_ms)
@@ -59,17 +76,19 @@ int gpio_poll(gpio_t *gpio, int timeout_ms)
 
 int gpio_close(gpio_t *gpio)
 {
+    PERIPHERY_STATS_CLOSE(gpio);
     return gpio->ops->close(gpio);
 }
 
 void gpio_free(gpio_t *gpio)
 {
+    PERIPHERY_STATS_CLOSE(gpio);
     free(gpio);
 }
 
 int gpio_read_event(gpio_t *gpio, gpio_edge_t *edge, uint64_t *timestamp)
 {
-    return gpio->ops->read_event(gpio, edge, timestamp);
+    return PERIPHERY_STATS_CALL(gpio, 0, gpio->ops->read_event(gpio, edge, timestamp));
 }
 
 int gpio_poll_multiple(gpio_t **gpios, size_t count, int timeout_ms, bool *gpios_ready)
@@ -81,7 +100,7 @@ int gpio_poll_multiple(gpio_t **gpios, size_t count, int timeout_ms, bool *gpios
     for (size_t i = 0; i < count; i++)
     {
         fds[i].fd = gpio_fd(gpios[i]);
-        fds[i].events = (gpios[i]->ops == &gpio_sysfs_ops) ? (POLLPRI | POLLERR) : (POLLIN | POLLRDNORM);
+        fds[i].events = GPIO_IS_SYSFS(gpios[i]) ? (POLLPRI | POLLERR) : (POLLIN | POLLRDNORM);
         if (gpios_ready)
             gpios_ready[i] = false;
     }
@@ -100,7 +119,7 @@ int gpio_poll_multiple(gpio_t **gpios, size_t count, int timeout_ms, bool *gpios
                 gpios_ready[i] = fds[i].revents != 0;
 
             /* Rewind GPIO if it is a sysfs GPIO */
-            if (gpios[i]->ops == &gpio_sysfs_ops)
+            if (GPIO_IS_SYSFS(gpios[i]))
             {
                 if (lseek(gpios[i]->u.sysfs.line_fd, 0, SEEK_SET) < 0)
                     return GPIO_ERROR_IO;
@@ -124,6 +143,16 @@ int gpio_get_edge(gpio_t *gpio, gpio_edge_t *edge)
     return gpio->ops->get_edge(gpio, edge);
 }
 
+int gpio_get_event_clock(gpio_t *gpio, gpio_event_clock_t *event_clock)
+{
+    return gpio->ops->get_event_clock(gpio, event_clock);
+}
+
+int gpio_get_debounce_us(gpio_t *gpio, uint32_t *debounce_us)
+{
+    return gpio->ops->get_debounce_us(gpio, debounce_us);
+}
+
 int gpio_get_bias(gpio_t *gpio, gpio_bias_t *bias)
 {
     return gpio->ops->get_bias(gpio, bias);
@@ -149,6 +178,16 @@ int gpio_set_edge(gpio_t *gpio, gpio_edge_t edge)
     return gpio->ops->set_edge(gpio, edge);
 }
 
+int gpio_set_event_clock(gpio_t *gpio, gpio_event_clock_t event_clock)
+{
+    return gpio->ops->set_event_clock(gpio, event_clock);
+}
+
+int gpio_set_debounce_us(gpio_t *gpio, uint32_t debounce_us)
+{
+    return gpio->ops->set_debounce_us(gpio, debounce_us);
+}
+
 int gpio_set_bias(gpio_t *gpio, gpio_bias_t bias)
 {
     return gpio->ops->set_bias(gpio, bias);
@@ -204,6 +243,12 @@ int gpio_tostring(gpio_t *gpio, char *str, size_t len)
     return gpio->ops->tostring(gpio, str, len);
 }
 
+int gpio_stats(gpio_t *gpio, periphery_stats_t *stats)
+{
+    PERIPHERY_STATS_GET(gpio, stats);
+    return 0;
+}
+
 int gpio_errno(gpio_t *gpio)
 {
     return gpio->error.c_errno;
@@ -250,3 +295,14 @@ int gpio_open_name_advanced(gpio_t *gpio, const char *path, const char *name, co
 }
 
 #endif
+
+#if !PERIPHERY_GPIO_SYSFS_SUPPORT
+
+int gpio_open_sysfs(gpio_t *gpio, unsigned int line, gpio_direction_t direction)
+{
+    (void)line;
+    (void)direction;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "c-periphery library built without sysfs GPIO support.");
+}
+
+#endif
@@ -232,6 +232,20 @@ static int gpio_cdev_get_edge(gpio_t *gpio, gpio_edge_t *edge)
     return 0;
 }
 
+/* The v1 ABI has no event clock or debounce settings: events carry the
+ * kernel's fixed clock (monotonic since Linux 5.7) */
+static int gpio_cdev_get_event_clock(gpio_t *gpio, gpio_event_clock_t *event_clock)
+{
+    (void)event_clock;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support event clock attribute");
+}
+
+static int gpio_cdev_get_debounce_us(gpio_t *gpio, uint32_t *debounce_us)
+{
+    (void)debounce_us;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support debounce attribute");
+}
+
 static int gpio_cdev_get_bias(gpio_t *gpio, gpio_bias_t *bias)
 {
     *bias = gpio->u.cdev.bias;
@@ -275,6 +289,18 @@ static int gpio_cdev_set_edge(gpio_t *gpio, gpio_edge_t edge)
     return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, edge, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
 }
 
+static int gpio_cdev_set_event_clock(gpio_t *gpio, gpio_event_clock_t event_clock)
+{
+    (void)event_clock;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support event clock attribute");
+}
+
+static int gpio_cdev_set_debounce_us(gpio_t *gpio, uint32_t debounce_us)
+{
+    (void)debounce_us;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support debounce attribute");
+}
+
 static int gpio_cdev_set_bias(gpio_t *gpio, gpio_bias_t bias)
 {
     if (bias != GPIO_BIAS_DEFAULT && bias != GPIO_BIAS_PULL_UP && bias != GPIO_BIAS_PULL_DOWN && bias != GPIO_BIAS_DISABLE)
@@ -478,11 +504,15 @@ const struct gpio_ops gpio_cdev_ops = {
     .close = gpio_cdev_close,
     .get_direction = gpio_cdev_get_direction,
     .get_edge = gpio_cdev_get_edge,
+    .get_event_clock = gpio_cdev_get_event_clock,
+    .get_debounce_us = gpio_cdev_get_debounce_us,
     .get_bias = gpio_cdev_get_bias,
     .get_drive = gpio_cdev_get_drive,
     .get_inverted = gpio_cdev_get_inverted,
     .set_direction = gpio_cdev_set_direction,
     .set_edge = gpio_cdev_set_edge,
+    .set_event_clock = gpio_cdev_set_event_clock,
+    .set_debounce_us = gpio_cdev_set_debounce_us,
     .set_bias = gpio_cdev_set_bias,
     .set_drive = gpio_cdev_set_drive,
     .set_inverted = gpio_cdev_set_inverted,
@@ -518,11 +548,19 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
     if (config->direction == GPIO_DIR_IN && config->drive != GPIO_DRIVE_DEFAULT)
         return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO line drive for input GPIO");
 
+    if (config->event_clock != GPIO_EVENT_CLOCK_REALTIME)
+        return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support event clock attribute");
+
+    if (config->debounce_us != 0)
+        return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO character device v1 ABI does not support debounce attribute");
+
     /* Open GPIO chip */
     if ((fd = open(path, 0)) < 0)
         return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening GPIO chip");
 
+    PERIPHERY_STATS_CLOSE(gpio);
     memset(gpio, 0, sizeof(gpio_t));
+    PERIPHERY_STATS_INIT(gpio, "gpio", _gpio_stats_tostring);
     gpio->ops = &gpio_cdev_ops;
     gpio->u.cdev.line = line;
     gpio->u.cdev.line_fd = -1;
@@ -544,52 +582,16 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
 
 int gpio_open_name_advanced(gpio_t *gpio, const char *path, const char *name, const gpio_config_t *config)
 {
-    int fd;
-
-    /* Open GPIO chip */
-    if ((fd = open(path, 0)) < 0)
-        return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening GPIO chip");
-
-    /* Get chip info for number of lines */
-    struct gpiochip_info chip_info = {0};
-    if (ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info) < 0)
-    {
-        int errsv = errno;
-        close(fd);
-        return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO chip info");
-    }
-
-    /* Loop through every line */
-    struct gpioline_info line_info = {0};
+    char chip_path[64];
     unsigned int line;
-    for (line = 0; line < chip_info.lines; line++)
-    {
-        line_info.line_offset = line;
-
-        /* Get the line info */
-        if (ioctl(fd, GPIO_GET_LINEINFO_IOCTL, &line_info) < 0)
-        {
-            int errsv = errno;
-            close(fd);
-            return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO line info for line %u", line);
-        }
-
-        /* Compare the name */
-        if (strcmp(line_info.name, name) == 0)
-            break;
-    }
-
-    /* If no matching line name was found */
-    if (line == chip_info.lines)
-    {
-        close(fd);
-        return _gpio_error(gpio, GPIO_ERROR_NOT_FOUND, 0, "GPIO line \"%s\" not found by name", name);
-    }
+    int ret;
 
-    if (close(fd) < 0)
-        return _gpio_error(gpio, GPIO_ERROR_CLOSE, errno, "Closing GPIO chip");
+    /* Resolve the name through the process-wide index (gpio_name_cache.c);
+     * a NULL path searches every chip */
+    if ((ret = _gpio_name_cache_lookup(gpio, path, name, path ? NULL : chip_path, sizeof(chip_path), &line)) < 0)
+        return ret;
 
-    return gpio_open_advanced(gpio, path, line, config);
+    return gpio_open_advanced(gpio, path ? path : chip_path, line, config);
 }
 
 int gpio_open(gpio_t *gpio, const char *path, unsigned int line, gpio_direction_t direction)
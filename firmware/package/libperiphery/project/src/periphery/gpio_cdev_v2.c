@@ -27,7 +27,7 @@
 
 #if PERIPHERY_GPIO_CDEV_SUPPORT == 2
 
-static int _gpio_cdev_reopen(gpio_t *gpio, gpio_direction_t direction, gpio_edge_t edge, gpio_bias_t bias, gpio_drive_t drive, bool inverted)
+static int _gpio_cdev_reopen(gpio_t *gpio, gpio_direction_t direction, gpio_edge_t edge, gpio_event_clock_t event_clock, uint32_t debounce_us, gpio_bias_t bias, gpio_drive_t drive, bool inverted)
 {
     uint32_t flags = 0;
 
@@ -66,7 +66,12 @@ static int _gpio_cdev_reopen(gpio_t *gpio, gpio_direction_t direction, gpio_edge
         flags |= (edge == GPIO_EDGE_RISING) ? GPIO_V2_LINE_FLAG_EDGE_RISING : (edge == GPIO_EDGE_FALLING) ? GPIO_V2_LINE_FLAG_EDGE_FALLING
                                                                           : (edge == GPIO_EDGE_BOTH)      ? (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING)
                                                                                                           : 0;
-        flags |= (edge != GPIO_EDGE_NONE) ? GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME : 0;
+
+        /* Without a flag events are stamped with the monotonic clock */
+        if (edge != GPIO_EDGE_NONE && event_clock == GPIO_EVENT_CLOCK_REALTIME)
+            flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME;
+        else if (edge != GPIO_EDGE_NONE && event_clock == GPIO_EVENT_CLOCK_HTE)
+            flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_HTE;
 
         line_request.offsets[0] = gpio->u.cdev.line;
         strncpy(line_request.consumer, gpio->u.cdev.label, sizeof(line_request.consumer) - 1);
@@ -74,6 +79,15 @@ static int _gpio_cdev_reopen(gpio_t *gpio, gpio_direction_t direction, gpio_edge
         line_request.config.flags = flags;
         line_request.num_lines = 1;
 
+        /* The kernel debounces both the value and the edge events */
+        if (debounce_us)
+        {
+            line_request.config.num_attrs = 1;
+            line_request.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+            line_request.config.attrs[0].attr.debounce_period_us = debounce_us;
+            line_request.config.attrs[0].mask = 1;
+        }
+
         if (ioctl(gpio->u.cdev.chip_fd, GPIO_V2_GET_LINE_IOCTL, &line_request) < 0)
             return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening input line handle");
 
@@ -106,6 +120,8 @@ static int _gpio_cdev_reopen(gpio_t *gpio, gpio_direction_t direction, gpio_edge
 
     gpio->u.cdev.direction = (direction == GPIO_DIR_IN) ? GPIO_DIR_IN : GPIO_DIR_OUT;
     gpio->u.cdev.edge = edge;
+    gpio->u.cdev.event_clock = event_clock;
+    gpio->u.cdev.debounce_us = (direction == GPIO_DIR_IN) ? debounce_us : 0;
     gpio->u.cdev.bias = bias;
     gpio->u.cdev.drive = drive;
     gpio->u.cdev.inverted = inverted;
@@ -215,6 +231,18 @@ static int gpio_cdev_get_edge(gpio_t *gpio, gpio_edge_t *edge)
     return 0;
 }
 
+static int gpio_cdev_get_event_clock(gpio_t *gpio, gpio_event_clock_t *event_clock)
+{
+    *event_clock = gpio->u.cdev.event_clock;
+    return 0;
+}
+
+static int gpio_cdev_get_debounce_us(gpio_t *gpio, uint32_t *debounce_us)
+{
+    *debounce_us = gpio->u.cdev.debounce_us;
+    return 0;
+}
+
 static int gpio_cdev_get_bias(gpio_t *gpio, gpio_bias_t *bias)
 {
     *bias = gpio->u.cdev.bias;
@@ -241,7 +269,7 @@ static int gpio_cdev_set_direction(gpio_t *gpio, gpio_direction_t direction)
     if (gpio->u.cdev.direction == direction)
         return 0;
 
-    return _gpio_cdev_reopen(gpio, direction, GPIO_EDGE_NONE, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
+    return _gpio_cdev_reopen(gpio, direction, GPIO_EDGE_NONE, gpio->u.cdev.event_clock, 0, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
 }
 
 static int gpio_cdev_set_edge(gpio_t *gpio, gpio_edge_t edge)
@@ -255,7 +283,32 @@ static int gpio_cdev_set_edge(gpio_t *gpio, gpio_edge_t edge)
     if (gpio->u.cdev.edge == edge)
         return 0;
 
-    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, edge, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, edge, gpio->u.cdev.event_clock, gpio->u.cdev.debounce_us, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
+}
+
+static int gpio_cdev_set_event_clock(gpio_t *gpio, gpio_event_clock_t event_clock)
+{
+    if (event_clock != GPIO_EVENT_CLOCK_REALTIME && event_clock != GPIO_EVENT_CLOCK_MONOTONIC && event_clock != GPIO_EVENT_CLOCK_HTE)
+        return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO event clock (can be realtime, monotonic, hte)");
+
+    if (gpio->u.cdev.direction != GPIO_DIR_IN)
+        return _gpio_error(gpio, GPIO_ERROR_INVALID_OPERATION, 0, "Invalid operation: cannot set event clock on output GPIO");
+
+    if (gpio->u.cdev.event_clock == event_clock)
+        return 0;
+
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, event_clock, gpio->u.cdev.debounce_us, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
+}
+
+static int gpio_cdev_set_debounce_us(gpio_t *gpio, uint32_t debounce_us)
+{
+    if (gpio->u.cdev.direction != GPIO_DIR_IN)
+        return _gpio_error(gpio, GPIO_ERROR_INVALID_OPERATION, 0, "Invalid operation: cannot set debounce on output GPIO");
+
+    if (gpio->u.cdev.debounce_us == debounce_us)
+        return 0;
+
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.event_clock, debounce_us, gpio->u.cdev.bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
 }
 
 static int gpio_cdev_set_bias(gpio_t *gpio, gpio_bias_t bias)
@@ -266,7 +319,7 @@ static int gpio_cdev_set_bias(gpio_t *gpio, gpio_bias_t bias)
     if (gpio->u.cdev.bias == bias)
         return 0;
 
-    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.event_clock, gpio->u.cdev.debounce_us, bias, gpio->u.cdev.drive, gpio->u.cdev.inverted);
 }
 
 static int gpio_cdev_set_drive(gpio_t *gpio, gpio_drive_t drive)
@@ -280,7 +333,7 @@ static int gpio_cdev_set_drive(gpio_t *gpio, gpio_drive_t drive)
     if (gpio->u.cdev.drive == drive)
         return 0;
 
-    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.bias, drive, gpio->u.cdev.inverted);
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.event_clock, gpio->u.cdev.debounce_us, gpio->u.cdev.bias, drive, gpio->u.cdev.inverted);
 }
 
 static int gpio_cdev_set_inverted(gpio_t *gpio, bool inverted)
@@ -288,7 +341,7 @@ static int gpio_cdev_set_inverted(gpio_t *gpio, bool inverted)
     if (gpio->u.cdev.inverted == inverted)
         return 0;
 
-    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.bias, gpio->u.cdev.drive, inverted);
+    return _gpio_cdev_reopen(gpio, gpio->u.cdev.direction, gpio->u.cdev.edge, gpio->u.cdev.event_clock, gpio->u.cdev.debounce_us, gpio->u.cdev.bias, gpio->u.cdev.drive, inverted);
 }
 
 static unsigned int gpio_cdev_line(gpio_t *gpio)
@@ -380,6 +433,8 @@ static int gpio_cdev_tostring(gpio_t *gpio, char *str, size_t len)
     const char *direction_str;
     gpio_edge_t edge;
     const char *edge_str;
+    gpio_event_clock_t event_clock;
+    const char *event_clock_str;
     gpio_bias_t bias;
     const char *bias_str;
     gpio_drive_t drive;
@@ -409,6 +464,13 @@ static int gpio_cdev_tostring(gpio_t *gpio, char *str, size_t len)
                                                    : (edge == GPIO_EDGE_BOTH)     ? "both"
                                                                                   : "unknown";
 
+    if (gpio_cdev_get_event_clock(gpio, &event_clock) < 0)
+        event_clock_str = "<error>";
+    else
+        event_clock_str = (event_clock == GPIO_EVENT_CLOCK_REALTIME) ? "realtime" : (event_clock == GPIO_EVENT_CLOCK_MONOTONIC) ? "monotonic"
+                                                                    : (event_clock == GPIO_EVENT_CLOCK_HTE)       ? "hte"
+                                                                                                                  : "unknown";
+
     if (gpio_cdev_get_bias(gpio, &bias) < 0)
         bias_str = "<error>";
     else
@@ -449,8 +511,8 @@ static int gpio_cdev_tostring(gpio_t *gpio, char *str, size_t len)
     else
         chip_label_str = chip_label;
 
-    return snprintf(str, len, "GPIO %u (name=\"%s\", label=\"%s\", line_fd=%d, chip_fd=%d, direction=%s, edge=%s, bias=%s, drive=%s, inverted=%s, chip_name=\"%s\", chip_label=\"%s\", type=cdev)",
-                    gpio->u.cdev.line, line_name_str, line_label_str, gpio->u.cdev.line_fd, gpio->u.cdev.chip_fd, direction_str, edge_str, bias_str, drive_str, inverted_str, chip_name_str, chip_label_str);
+    return snprintf(str, len, "GPIO %u (name=\"%s\", label=\"%s\", line_fd=%d, chip_fd=%d, direction=%s, edge=%s, event_clock=%s, debounce_us=%u, bias=%s, drive=%s, inverted=%s, chip_name=\"%s\", chip_label=\"%s\", type=cdev)",
+                    gpio->u.cdev.line, line_name_str, line_label_str, gpio->u.cdev.line_fd, gpio->u.cdev.chip_fd, direction_str, edge_str, event_clock_str, gpio->u.cdev.debounce_us, bias_str, drive_str, inverted_str, chip_name_str, chip_label_str);
 }
 
 const struct gpio_ops gpio_cdev_ops = {
@@ -461,11 +523,15 @@ const struct gpio_ops gpio_cdev_ops = {
     .close = gpio_cdev_close,
     .get_direction = gpio_cdev_get_direction,
     .get_edge = gpio_cdev_get_edge,
+    .get_event_clock = gpio_cdev_get_event_clock,
+    .get_debounce_us = gpio_cdev_get_debounce_us,
     .get_bias = gpio_cdev_get_bias,
     .get_drive = gpio_cdev_get_drive,
     .get_inverted = gpio_cdev_get_inverted,
     .set_direction = gpio_cdev_set_direction,
     .set_edge = gpio_cdev_set_edge,
+    .set_event_clock = gpio_cdev_set_event_clock,
+    .set_debounce_us = gpio_cdev_set_debounce_us,
     .set_bias = gpio_cdev_set_bias,
     .set_drive = gpio_cdev_set_drive,
     .set_inverted = gpio_cdev_set_inverted,
@@ -492,6 +558,12 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
     if (config->direction != GPIO_DIR_IN && config->edge != GPIO_EDGE_NONE)
         return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO edge for output GPIO");
 
+    if (config->event_clock != GPIO_EVENT_CLOCK_REALTIME && config->event_clock != GPIO_EVENT_CLOCK_MONOTONIC && config->event_clock != GPIO_EVENT_CLOCK_HTE)
+        return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO event clock (can be realtime, monotonic, hte)");
+
+    if (config->direction != GPIO_DIR_IN && config->debounce_us != 0)
+        return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO debounce for output GPIO");
+
     if (config->bias != GPIO_BIAS_DEFAULT && config->bias != GPIO_BIAS_PULL_UP && config->bias != GPIO_BIAS_PULL_DOWN && config->bias != GPIO_BIAS_DISABLE)
         return _gpio_error(gpio, GPIO_ERROR_ARG, 0, "Invalid GPIO line bias (can be default, pull_up, pull_down, disable)");
 
@@ -505,7 +577,9 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
     if ((fd = open(path, 0)) < 0)
         return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening GPIO chip");
 
+    PERIPHERY_STATS_CLOSE(gpio);
     memset(gpio, 0, sizeof(gpio_t));
+    PERIPHERY_STATS_INIT(gpio, "gpio", _gpio_stats_tostring);
     gpio->ops = &gpio_cdev_ops;
     gpio->u.cdev.line = line;
     gpio->u.cdev.line_fd = -1;
@@ -514,7 +588,7 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
     gpio->u.cdev.label[sizeof(gpio->u.cdev.label) - 1] = '\0';
 
     /* Open GPIO line */
-    ret = _gpio_cdev_reopen(gpio, config->direction, config->edge, config->bias, config->drive, config->inverted);
+    ret = _gpio_cdev_reopen(gpio, config->direction, config->edge, config->event_clock, config->debounce_us, config->bias, config->drive, config->inverted);
     if (ret < 0)
     {
         close(gpio->u.cdev.chip_fd);
@@ -527,52 +601,16 @@ int gpio_open_advanced(gpio_t *gpio, const char *path, unsigned int line, const
 
 int gpio_open_name_advanced(gpio_t *gpio, const char *path, const char *name, const gpio_config_t *config)
 {
-    int fd;
-
-    /* Open GPIO chip */
-    if ((fd = open(path, 0)) < 0)
-        return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening GPIO chip");
-
-    /* Get chip info for number of lines */
-    struct gpiochip_info chip_info = {0};
-    if (ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info) < 0)
-    {
-        int errsv = errno;
-        close(fd);
-        return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO chip info");
-    }
-
-    /* Loop through every line */
-    struct gpio_v2_line_info line_info = {0};
+    char chip_path[64];
     unsigned int line;
-    for (line = 0; line < chip_info.lines; line++)
-    {
-        line_info.offset = line;
-
-        /* Get the line info */
-        if (ioctl(fd, GPIO_V2_GET_LINEINFO_IOCTL, &line_info) < 0)
-        {
-            int errsv = errno;
-            close(fd);
-            return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO line info for line %u", line);
-        }
-
-        /* Compare the name */
-        if (strcmp(line_info.name, name) == 0)
-            break;
-    }
-
-    /* If no matching line name was found */
-    if (line == chip_info.lines)
-    {
-        close(fd);
-        return _gpio_error(gpio, GPIO_ERROR_NOT_FOUND, 0, "GPIO line \"%s\" not found by name", name);
-    }
+    int ret;
 
-    if (close(fd) < 0)
-        return _gpio_error(gpio, GPIO_ERROR_CLOSE, errno, "Closing GPIO chip");
+    /* Resolve the name through the process-wide index (gpio_name_cache.c);
+     * a NULL path searches every chip */
+    if ((ret = _gpio_name_cache_lookup(gpio, path, name, path ? NULL : chip_path, sizeof(chip_path), &line)) < 0)
+        return ret;
 
-    return gpio_open_advanced(gpio, path, line, config);
+    return gpio_open_advanced(gpio, path ? path : chip_path, line, config);
 }
 
 int gpio_open(gpio_t *gpio, const char *path, unsigned int line, gpio_direction_t direction)
@@ -0,0 +1,631 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <errno.h>
+
+#include "periphery/gpio.h"
+#include "periphery/gpio_internal.h"
+
+#if PERIPHERY_GPIO_CDEV_SUPPORT
+#include <linux/gpio.h>
+#endif
+
+/*********************************************************************************/
+/* Line name index, shared by both character device ABIs */
+/*********************************************************************************/
+
+#if PERIPHERY_GPIO_CDEV_SUPPORT
+
+/* Chips considered by one scan of /dev */
+#define NAME_CACHE_MAX_SCAN 64
+
+/* Poll period while another thread holds the cache */
+#define NAME_CACHE_LOCK_SLEEP_NS 100000
+
+struct name_cache_chip
+{
+    char path[64];
+    char label[GPIO_MAX_NAME_SIZE];
+    unsigned int lines;
+    unsigned int number;    /* N of gpiochipN, orders duplicate names */
+};
+
+struct name_cache_line
+{
+    char name[GPIO_MAX_NAME_SIZE];
+    unsigned int chip;      /* Index in chips[] */
+    unsigned int offset;
+};
+
+/* Indexing a chip costs one line info ioctl per line; afterwards a lookup
+ * checks the chip's label and line count with one chip info ioctl and the
+ * name of the line it resolved to with one line info ioctl, and indexes the
+ * chip again if any of them changed. A name that is not in the index may
+ * have been given to a line since, so a miss indexes the chip (or every
+ * chip) again before it is reported. Unnamed lines are not kept. */
+static struct
+{
+    struct name_cache_chip *chips;
+    unsigned int num_chips, max_chips;
+
+    struct name_cache_line *lines;
+    unsigned int num_lines, max_lines;
+
+    /* Open addressing on the name: line index + 1, 0 for an empty slot */
+    unsigned int *slots;
+    unsigned int num_slots;     /* Power of two */
+} cache;
+
+static bool cache_busy;
+
+/* The holder may be indexing a chip, one ioctl per line: sleep rather than
+ * yield, so a SCHED_FIFO waiter does not starve a lower priority holder on a
+ * single core */
+static void _cache_lock(void)
+{
+    const struct timespec pause = {0, NAME_CACHE_LOCK_SLEEP_NS};
+
+    while (__atomic_test_and_set(&cache_busy, __ATOMIC_ACQUIRE))
+        nanosleep(&pause, NULL);
+}
+
+static void _cache_unlock(void)
+{
+    __atomic_clear(&cache_busy, __ATOMIC_RELEASE);
+}
+
+/* FNV-1a */
+static unsigned int _name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+
+    for (; *name; name++)
+        hash = (hash ^ (uint8_t)*name) * 16777619u;
+
+    return hash;
+}
+
+static unsigned int _chip_number(const char *path)
+{
+    const char *base = strrchr(path, '/');
+    unsigned int number;
+    char tail;
+
+    base = base ? base + 1 : path;
+    if (sscanf(base, "gpiochip%u%c", &number, &tail) != 1)
+        return UINT_MAX;
+
+    return number;
+}
+
+/* Refill the hash table; it only grows, so shrinking cannot fail */
+static int _cache_rehash(void)
+{
+    unsigned int num_slots = cache.num_slots ? cache.num_slots : 16;
+
+    while (num_slots < 2 * cache.num_lines)
+        num_slots *= 2;
+
+    if (num_slots != cache.num_slots || cache.slots == NULL)
+    {
+        unsigned int *slots = realloc(cache.slots, num_slots * sizeof(*slots));
+        if (slots == NULL)
+            return -1;
+        cache.slots = slots;
+        cache.num_slots = num_slots;
+    }
+
+    memset(cache.slots, 0, cache.num_slots * sizeof(*cache.slots));
+
+    for (unsigned int i = 0; i < cache.num_lines; i++)
+    {
+        unsigned int slot = _name_hash(cache.lines[i].name) & (cache.num_slots - 1);
+
+        while (cache.slots[slot])
+            slot = (slot + 1) & (cache.num_slots - 1);
+        cache.slots[slot] = i + 1;
+    }
+
+    return 0;
+}
+
+/* Index in lines[] of <name> on chip <chip>, or with chip -1 on the lowest
+ * numbered chip that has it; -1 if there is none */
+static int _cache_find(const char *name, int chip)
+{
+    int found = -1;
+
+    if (cache.num_slots == 0)
+        return -1;
+
+    for (unsigned int slot = _name_hash(name) & (cache.num_slots - 1); cache.slots[slot]; slot = (slot + 1) & (cache.num_slots - 1))
+    {
+        int i = (int)cache.slots[slot] - 1;
+        const struct name_cache_line *line = &cache.lines[i];
+
+        if (strcmp(line->name, name) != 0)
+            continue;
+
+        if (chip >= 0)
+        {
+            if ((int)line->chip == chip)
+                return i;
+        }
+        else if (found < 0 || cache.chips[line->chip].number < cache.chips[cache.lines[found].chip].number)
+        {
+            found = i;
+        }
+    }
+
+    return found;
+}
+
+static int _cache_find_chip(const char *path)
+{
+    for (unsigned int i = 0; i < cache.num_chips; i++)
+    {
+        if (strcmp(cache.chips[i].path, path) == 0)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+static int _cache_add_chip(const char *path, const char *label, unsigned int lines)
+{
+    struct name_cache_chip *chip;
+
+    if (strlen(path) >= sizeof(chip->path))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    if (cache.num_chips == cache.max_chips)
+    {
+        unsigned int max_chips = cache.max_chips ? 2 * cache.max_chips : 16;
+        struct name_cache_chip *chips = realloc(cache.chips, max_chips * sizeof(*chips));
+        if (chips == NULL)
+            return -1;
+        cache.chips = chips;
+        cache.max_chips = max_chips;
+    }
+
+    chip = &cache.chips[cache.num_chips];
+    snprintf(chip->path, sizeof(chip->path), "%s", path);
+    snprintf(chip->label, sizeof(chip->label), "%s", label);
+    chip->lines = lines;
+    chip->number = _chip_number(path);
+
+    return (int)cache.num_chips++;
+}
+
+/* Append a named line; the caller rehashes */
+static int _cache_add_line(unsigned int chip, unsigned int offset, const char *name)
+{
+    struct name_cache_line *line;
+
+    if (cache.num_lines == cache.max_lines)
+    {
+        unsigned int max_lines = cache.max_lines ? 2 * cache.max_lines : 64;
+        struct name_cache_line *lines = realloc(cache.lines, max_lines * sizeof(*lines));
+        if (lines == NULL)
+            return -1;
+        cache.lines = lines;
+        cache.max_lines = max_lines;
+    }
+
+    line = &cache.lines[cache.num_lines++];
+    snprintf(line->name, sizeof(line->name), "%s", name);
+    line->chip = chip;
+    line->offset = offset;
+
+    return 0;
+}
+
+/* Forget a chip and its lines */
+static void _cache_drop_chip(unsigned int chip)
+{
+    unsigned int kept = 0;
+
+    for (unsigned int i = 0; i < cache.num_lines; i++)
+    {
+        if (cache.lines[i].chip == chip)
+            continue;
+
+        cache.lines[kept] = cache.lines[i];
+        if (cache.lines[kept].chip > chip)
+            cache.lines[kept].chip--;
+        kept++;
+    }
+    cache.num_lines = kept;
+
+    memmove(&cache.chips[chip], &cache.chips[chip + 1], (cache.num_chips - chip - 1) * sizeof(cache.chips[0]));
+    cache.num_chips--;
+
+    _cache_rehash();
+}
+
+static int _line_name(int fd, unsigned int line, char *name)
+{
+#if PERIPHERY_GPIO_CDEV_SUPPORT == 2
+    struct gpio_v2_line_info line_info = {0};
+
+    line_info.offset = line;
+    if (ioctl(fd, GPIO_V2_GET_LINEINFO_IOCTL, &line_info) < 0)
+        return -1;
+#else
+    struct gpioline_info line_info = {0};
+
+    line_info.line_offset = line;
+    if (ioctl(fd, GPIO_GET_LINEINFO_IOCTL, &line_info) < 0)
+        return -1;
+#endif
+
+    memcpy(name, line_info.name, GPIO_MAX_NAME_SIZE);
+    name[GPIO_MAX_NAME_SIZE - 1] = '\0';
+
+    return 0;
+}
+
+static int _cache_index_chip(gpio_t *gpio, int fd, const char *path, const struct gpiochip_info *chip_info, int *chip)
+{
+    char name[GPIO_MAX_NAME_SIZE];
+    int index;
+
+    if ((index = _cache_add_chip(path, chip_info->label, chip_info->lines)) < 0)
+        return _gpio_error(gpio, GPIO_ERROR_QUERY, errno, "Indexing GPIO chip line names");
+
+    for (unsigned int line = 0; line < chip_info->lines; line++)
+    {
+        if (_line_name(fd, line, name) < 0)
+        {
+            int errsv = errno;
+            _cache_drop_chip(index);
+            return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO line info for line %u", line);
+        }
+
+        if (name[0] != '\0' && _cache_add_line(index, line, name) < 0)
+        {
+            int errsv = errno;
+            _cache_drop_chip(index);
+            return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Indexing GPIO chip line names");
+        }
+    }
+
+    if (_cache_rehash() < 0)
+    {
+        int errsv = errno;
+        _cache_drop_chip(index);
+        return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Indexing GPIO chip line names");
+    }
+
+    *chip = index;
+
+    return 0;
+}
+
+/* Bring the entry of the chip at <path> up to date: a chip whose label or
+ * line count changed, that was never seen, or on which the cached line of
+ * <name> (if not NULL) is now called differently, is indexed anew, as is
+ * any chip with <reindex>. Returns 1 if the chip was indexed, 0 if its entry
+ * was kept. */
+static int _cache_sync_chip(gpio_t *gpio, const char *path, const char *name, bool reindex, int *chip)
+{
+    struct gpiochip_info chip_info = {0};
+    char line_name[GPIO_MAX_NAME_SIZE];
+    int fd, index, found, ret = 0;
+
+    if ((fd = open(path, 0)) < 0)
+    {
+        int errsv = errno;
+        if ((index = _cache_find_chip(path)) >= 0)
+            _cache_drop_chip(index);
+        return _gpio_error(gpio, GPIO_ERROR_OPEN, errsv, "Opening GPIO chip");
+    }
+
+    if (ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info) < 0)
+    {
+        int errsv = errno;
+        close(fd);
+        return _gpio_error(gpio, GPIO_ERROR_QUERY, errsv, "Querying GPIO chip info");
+    }
+    chip_info.label[sizeof(chip_info.label) - 1] = '\0';
+
+    index = _cache_find_chip(path);
+    if (index >= 0 && (reindex || cache.chips[index].lines != chip_info.lines || strcmp(cache.chips[index].label, chip_info.label) != 0))
+    {
+        _cache_drop_chip(index);
+        index = -1;
+    }
+
+    /* Lines can be renamed without the chip changing, e.g. by a device tree
+     * overlay: a hit must still carry its name */
+    if (index >= 0 && name && (found = _cache_find(name, index)) >= 0)
+    {
+        if (_line_name(fd, cache.lines[found].offset, line_name) < 0 || strcmp(line_name, name) != 0)
+        {
+            _cache_drop_chip(index);
+            index = -1;
+        }
+    }
+
+    if (index < 0 && (ret = _cache_index_chip(gpio, fd, path, &chip_info, &index)) == 0)
+        ret = 1;
+
+    if (close(fd) < 0 && ret >= 0)
+        return _gpio_error(gpio, GPIO_ERROR_CLOSE, errno, "Closing GPIO chip");
+
+    *chip = index;
+
+    return ret;
+}
+
+static int _compare_numbers(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Sync every /dev/gpiochipN, with <reindex> indexing each anew; chips that
+ * fail are left out */
+static void _cache_scan(gpio_t *gpio, bool reindex)
+{
+    unsigned int numbers[NAME_CACHE_MAX_SCAN];
+    unsigned int count = 0;
+    struct dirent *entry;
+    DIR *dir;
+
+    if ((dir = opendir("/dev")) == NULL)
+        return;
+
+    while ((entry = readdir(dir)) != NULL && count < NAME_CACHE_MAX_SCAN)
+    {
+        unsigned int number;
+        char tail;
+
+        if (sscanf(entry->d_name, "gpiochip%u%c", &number, &tail) == 1)
+            numbers[count++] = number;
+    }
+
+    closedir(dir);
+
+    qsort(numbers, count, sizeof(numbers[0]), _compare_numbers);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        char path[32];
+        int chip;
+
+        snprintf(path, sizeof(path), "/dev/gpiochip%u", numbers[i]);
+        _cache_sync_chip(gpio, path, NULL, reindex, &chip);
+    }
+}
+
+int _gpio_name_cache_lookup(gpio_t *gpio, const char *path, const char *name, char *chip_path, size_t len, unsigned int *line)
+{
+    int chip, found = -1, ret = 0;
+
+    _cache_lock();
+
+    if (path)
+    {
+        if ((ret = _cache_sync_chip(gpio, path, name, false, &chip)) >= 0)
+        {
+            found = _cache_find(name, chip);
+
+            /* A miss on an entry that was kept is checked once more against
+             * the chip */
+            if (found < 0 && ret == 0 && (ret = _cache_sync_chip(gpio, path, name, true, &chip)) >= 0)
+                found = _cache_find(name, chip);
+        }
+        if (ret > 0)
+            ret = 0;
+    }
+    else
+    {
+        /* A hit is only trusted once its chip checks out; if the chip went
+         * away or no longer has the name, or there was no hit, look through
+         * all chips again */
+        if ((found = _cache_find(name, -1)) >= 0)
+        {
+            char hit[sizeof(cache.chips[0].path)];
+
+            memcpy(hit, cache.chips[cache.lines[found].chip].path, sizeof(hit));
+            if (_cache_sync_chip(gpio, hit, name, false, &chip) < 0)
+                found = -1;
+            else
+                found = _cache_find(name, chip);
+        }
+
+        if (found < 0)
+        {
+            _cache_scan(gpio, true);
+            found = _cache_find(name, -1);
+        }
+    }
+
+    if (ret == 0 && found < 0)
+    {
+        ret = _gpio_error(gpio, GPIO_ERROR_NOT_FOUND, 0, "GPIO line \"%s\" not found by name", name);
+    }
+    else if (ret == 0)
+    {
+        if (chip_path)
+            snprintf(chip_path, len, "%s", cache.chips[cache.lines[found].chip].path);
+        *line = cache.lines[found].offset;
+    }
+
+    _cache_unlock();
+
+    return ret;
+}
+
+void gpio_name_cache_clear(void)
+{
+    _cache_lock();
+
+    free(cache.chips);
+    free(cache.lines);
+    free(cache.slots);
+    memset(&cache, 0, sizeof(cache));
+
+    _cache_unlock();
+}
+
+/* Text file: a "chip <path> <label> <lines>" record per chip, followed by
+ * "<offset> <name>" records of its named lines, fields separated by single
+ * tabs; the label may be empty */
+int gpio_name_cache_save(const char *path)
+{
+    char tmp_path[256];
+    FILE *file;
+    int failed;
+
+    if ((size_t)snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= sizeof(tmp_path))
+    {
+        errno = ENAMETOOLONG;
+        return GPIO_ERROR_ARG;
+    }
+
+    if ((file = fopen(tmp_path, "w")) == NULL)
+        return GPIO_ERROR_OPEN;
+
+    _cache_lock();
+
+    fprintf(file, "# c-periphery GPIO line names\n");
+    for (unsigned int chip = 0; chip < cache.num_chips; chip++)
+    {
+        fprintf(file, "chip\t%s\t%s\t%u\n", cache.chips[chip].path, cache.chips[chip].label, cache.chips[chip].lines);
+
+        for (unsigned int i = 0; i < cache.num_lines; i++)
+        {
+            if (cache.lines[i].chip == chip && strpbrk(cache.lines[i].name, "\t\n") == NULL)
+                fprintf(file, "%u\t%s\n", cache.lines[i].offset, cache.lines[i].name);
+        }
+    }
+
+    _cache_unlock();
+
+    /* Replace the old file only once the new one is complete */
+    failed = ferror(file);
+    if (fclose(file) != 0 || failed || rename(tmp_path, path) < 0)
+    {
+        int errsv = failed ? EIO : errno;
+        unlink(tmp_path);
+        errno = errsv;
+        return GPIO_ERROR_IO;
+    }
+
+    return 0;
+}
+
+/* Entries read here are checked like any other on their first lookup */
+int gpio_name_cache_load(const char *path)
+{
+    char buf[256];
+    FILE *file;
+    int chip = -1, ret = 0;
+
+    if ((file = fopen(path, "r")) == NULL)
+        return GPIO_ERROR_OPEN;
+
+    _cache_lock();
+
+    while (ret == 0 && fgets(buf, sizeof(buf), file) != NULL)
+    {
+        char *fields[4];
+        char *field = buf;
+        unsigned int count = 0;
+
+        if (buf[0] == '#' || buf[0] == '\n')
+            continue;
+
+        /* Split on every tab, so empty fields keep their place */
+        buf[strcspn(buf, "\n")] = '\0';
+        while (field && count < 4)
+        {
+            char *tab = strchr(field, '\t');
+
+            if (tab)
+                *tab++ = '\0';
+            fields[count++] = field;
+            field = tab;
+        }
+        if (field)
+            count++;    /* Too many fields */
+
+        if (count == 4 && strcmp(fields[0], "chip") == 0)
+        {
+            int existing = _cache_find_chip(fields[1]);
+            if (existing >= 0)
+                _cache_drop_chip(existing);
+
+            if ((chip = _cache_add_chip(fields[1], fields[2], (unsigned int)strtoul(fields[3], NULL, 10))) < 0)
+                ret = GPIO_ERROR_IO;
+        }
+        else if (count == 2 && chip >= 0)
+        {
+            unsigned int offset = (unsigned int)strtoul(fields[0], NULL, 10);
+
+            if (offset < cache.chips[chip].lines && _cache_add_line(chip, offset, fields[1]) < 0)
+                ret = GPIO_ERROR_IO;
+        }
+        else
+        {
+            errno = EINVAL;
+            ret = GPIO_ERROR_ARG;
+        }
+    }
+
+    if (ret == 0 && ferror(file))
+    {
+        errno = EIO;
+        ret = GPIO_ERROR_IO;
+    }
+
+    if (_cache_rehash() < 0 && ret == 0)
+        ret = GPIO_ERROR_IO;
+
+    _cache_unlock();
+
+    fclose(file);
+
+    return ret;
+}
+
+#else
+
+void gpio_name_cache_clear(void)
+{
+}
+
+int gpio_name_cache_save(const char *path)
+{
+    (void)path;
+    errno = ENOTSUP;
+    return GPIO_ERROR_UNSUPPORTED;
+}
+
+int gpio_name_cache_load(const char *path)
+{
+    (void)path;
+    errno = ENOTSUP;
+    return GPIO_ERROR_UNSUPPORTED;
+}
+
+#endif
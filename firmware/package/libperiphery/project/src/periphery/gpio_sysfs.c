@@ -281,6 +281,30 @@ static int gpio_sysfs_get_edge(gpio_t *gpio, gpio_edge_t *edge)
     return 0;
 }
 
+static int gpio_sysfs_set_event_clock(gpio_t *gpio, gpio_event_clock_t event_clock)
+{
+    (void)event_clock;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO of type sysfs does not support event clock attribute");
+}
+
+static int gpio_sysfs_get_event_clock(gpio_t *gpio, gpio_event_clock_t *event_clock)
+{
+    (void)event_clock;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO of type sysfs does not support event clock attribute");
+}
+
+static int gpio_sysfs_set_debounce_us(gpio_t *gpio, uint32_t debounce_us)
+{
+    (void)debounce_us;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO of type sysfs does not support debounce attribute");
+}
+
+static int gpio_sysfs_get_debounce_us(gpio_t *gpio, uint32_t *debounce_us)
+{
+    (void)debounce_us;
+    return _gpio_error(gpio, GPIO_ERROR_UNSUPPORTED, 0, "GPIO of type sysfs does not support debounce attribute");
+}
+
 static int gpio_sysfs_set_bias(gpio_t *gpio, gpio_bias_t bias)
 {
     (void)bias;
@@ -514,11 +538,15 @@ const struct gpio_ops gpio_sysfs_ops = {
     .close = gpio_sysfs_close,
     .get_direction = gpio_sysfs_get_direction,
     .get_edge = gpio_sysfs_get_edge,
+    .get_event_clock = gpio_sysfs_get_event_clock,
+    .get_debounce_us = gpio_sysfs_get_debounce_us,
     .get_bias = gpio_sysfs_get_bias,
     .get_drive = gpio_sysfs_get_drive,
     .get_inverted = gpio_sysfs_get_inverted,
     .set_direction = gpio_sysfs_set_direction,
     .set_edge = gpio_sysfs_set_edge,
+    .set_event_clock = gpio_sysfs_set_event_clock,
+    .set_debounce_us = gpio_sysfs_set_debounce_us,
     .set_bias = gpio_sysfs_set_bias,
     .set_drive = gpio_sysfs_set_drive,
     .set_inverted = gpio_sysfs_set_inverted,
@@ -625,7 +653,9 @@ int gpio_open_sysfs(gpio_t *gpio, unsigned int line, gpio_direction_t direction)
     if ((fd = open(gpio_path, O_RDWR)) < 0)
         return _gpio_error(gpio, GPIO_ERROR_OPEN, errno, "Opening GPIO 'gpio%u/value'", line);
 
+    PERIPHERY_STATS_CLOSE(gpio);
     memset(gpio, 0, sizeof(gpio_t));
+    PERIPHERY_STATS_INIT(gpio, "gpio", _gpio_stats_tostring);
     gpio->ops = &gpio_sysfs_ops;
     gpio->u.sysfs.line = line;
     gpio->u.sysfs.line_fd = fd;
@@ -21,11 +21,16 @@
 #include <linux/i2c-dev.h>
 
 #include "periphery/i2c.h"
+#include "periphery/stats_internal.h"
 
 struct i2c_handle
 {
     int fd;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct
     {
         int c_errno;
@@ -54,6 +59,13 @@ static int _i2c_error(i2c_t *i2c, int code, int c_errno, const char *fmt, ...)
     return code;
 }
 
+#if PERIPHERY_STATS
+static int _i2c_stats_tostring(void *handle, char *str, size_t len)
+{
+    return i2c_tostring(handle, str, len);
+}
+#endif
+
 i2c_t *i2c_new(void)
 {
     i2c_t *i2c = calloc(1, sizeof(i2c_t));
@@ -62,11 +74,14 @@ i2c_t *i2c_new(void)
 
     i2c->fd = -1;
 
+    PERIPHERY_STATS_INIT(i2c, "i2c", _i2c_stats_tostring);
+
     return i2c;
 }
 
 void i2c_free(i2c_t *i2c)
 {
+    PERIPHERY_STATS_CLOSE(i2c);
     free(i2c);
 }
 
@@ -74,7 +89,9 @@ int i2c_open(i2c_t *i2c, const char *path)
 {
     unsigned long supported_funcs;
 
+    PERIPHERY_STATS_CLOSE(i2c);
     memset(i2c, 0, sizeof(i2c_t));
+    PERIPHERY_STATS_INIT(i2c, "i2c", _i2c_stats_tostring);
 
     /* Open device */
     if ((i2c->fd = open(path, O_RDWR)) < 0)
@@ -99,7 +116,7 @@ int i2c_open(i2c_t *i2c, const char *path)
     return 0;
 }
 
-int i2c_transfer(i2c_t *i2c, struct i2c_msg *msgs, size_t count)
+static int _i2c_transfer(i2c_t *i2c, struct i2c_msg *msgs, size_t count)
 {
     struct i2c_rdwr_ioctl_data i2c_rdwr_data;
 
@@ -115,8 +132,27 @@ int i2c_transfer(i2c_t *i2c, struct i2c_msg *msgs, size_t count)
     return 0;
 }
 
+#if PERIPHERY_STATS
+static uint64_t _i2c_msgs_bytes(const struct i2c_msg *msgs, size_t count)
+{
+    uint64_t bytes = 0;
+
+    for (size_t i = 0; i < count; i++)
+        bytes += msgs[i].len;
+
+    return bytes;
+}
+#endif
+
+int i2c_transfer(i2c_t *i2c, struct i2c_msg *msgs, size_t count)
+{
+    return PERIPHERY_STATS_CALL(i2c, _i2c_msgs_bytes(msgs, count), _i2c_transfer(i2c, msgs, count));
+}
+
 int i2c_close(i2c_t *i2c)
 {
+    PERIPHERY_STATS_CLOSE(i2c);
+
     if (i2c->fd < 0)
         return 0;
 
@@ -134,6 +170,12 @@ int i2c_tostring(i2c_t *i2c, char *str, size_t len)
     return snprintf(str, len, "I2C (fd=%d)", i2c->fd);
 }
 
+int i2c_stats(i2c_t *i2c, periphery_stats_t *stats)
+{
+    PERIPHERY_STATS_GET(i2c, stats);
+    return 0;
+}
+
 const char *i2c_errmsg(i2c_t *i2c)
 {
     return i2c->error.errmsg;
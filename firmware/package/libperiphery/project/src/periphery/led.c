@@ -16,6 +16,7 @@
 #include <errno.h>
 
 #include "periphery/led.h"
+#include "periphery/stats_internal.h"
 
 #define P_PATH_MAX 256
 
@@ -24,6 +25,10 @@ struct led_handle
     char name[64];
     unsigned int max_brightness;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct
     {
         int c_errno;
@@ -52,12 +57,24 @@ static int _led_error(led_t *led, int code, int c_errno, const char *fmt, ...)
     return code;
 }
 
+#if PERIPHERY_STATS
+/* Not led_tostring(), whose brightness reads would count as operations */
+static int _led_stats_tostring(void *handle, char *str, size_t len)
+{
+    led_t *led = handle;
+
+    return snprintf(str, len, "LED %s", led->name);
+}
+#endif
+
 led_t *led_new(void)
 {
     led_t *led = calloc(1, sizeof(led_t));
     if (led == NULL)
         return NULL;
 
+    PERIPHERY_STATS_INIT(led, "led", _led_stats_tostring);
+
     return led;
 }
 
@@ -103,15 +120,17 @@ int led_write(led_t *led, bool value)
 int led_close(led_t *led)
 {
     (void)led;
+    PERIPHERY_STATS_CLOSE(led);
     return 0;
 }
 
 void led_free(led_t *led)
 {
+    PERIPHERY_STATS_CLOSE(led);
     free(led);
 }
 
-int led_get_brightness(led_t *led, unsigned int *brightness)
+static int _led_get_brightness(led_t *led, unsigned int *brightness)
 {
     char led_path[P_PATH_MAX];
     char buf[16];
@@ -140,7 +159,12 @@ int led_get_brightness(led_t *led, unsigned int *brightness)
     return 0;
 }
 
-int led_get_max_brightness(led_t *led, unsigned int *max_brightness)
+int led_get_brightness(led_t *led, unsigned int *brightness)
+{
+    return PERIPHERY_STATS_CALL(led, 0, _led_get_brightness(led, brightness));
+}
+
+static int _led_get_max_brightness(led_t *led, unsigned int *max_brightness)
 {
     char led_path[P_PATH_MAX];
     char buf[16];
@@ -171,7 +195,12 @@ int led_get_max_brightness(led_t *led, unsigned int *max_brightness)
     return 0;
 }
 
-int led_set_brightness(led_t *led, unsigned int brightness)
+int led_get_max_brightness(led_t *led, unsigned int *max_brightness)
+{
+    return PERIPHERY_STATS_CALL(led, 0, _led_get_max_brightness(led, max_brightness));
+}
+
+static int _led_set_brightness(led_t *led, unsigned int brightness)
 {
     char led_path[P_PATH_MAX];
     char buf[16];
@@ -200,6 +229,11 @@ int led_set_brightness(led_t *led, unsigned int brightness)
     return 0;
 }
 
+int led_set_brightness(led_t *led, unsigned int brightness)
+{
+    return PERIPHERY_STATS_CALL(led, 0, _led_set_brightness(led, brightness));
+}
+
 int led_name(led_t *led, char *str, size_t len)
 {
     if (!len)
@@ -231,6 +265,12 @@ int led_tostring(led_t *led, char *str, size_t len)
     return snprintf(str, len, "LED %s (brightness=%s, max_brightness=%s)", led->name, brightness_str, max_brightness_str);
 }
 
+int led_stats(led_t *led, periphery_stats_t *stats)
+{
+    PERIPHERY_STATS_GET(led, stats);
+    return 0;
+}
+
 int led_errno(led_t *led)
 {
     return led->error.c_errno;
@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include "periphery/mmio.h"
+#include "periphery/stats_internal.h"
 
 struct mmio_handle
 {
@@ -24,6 +25,10 @@ struct mmio_handle
     size_t size, aligned_size;
     void *ptr;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct
     {
         int c_errno;
@@ -52,13 +57,27 @@ static int _mmio_error(mmio_t *mmio, int code, int c_errno, const char *fmt, ...
     return code;
 }
 
+#if PERIPHERY_STATS
+static int _mmio_stats_tostring(void *handle, char *str, size_t len)
+{
+    return mmio_tostring(handle, str, len);
+}
+#endif
+
 mmio_t *mmio_new(void)
 {
-    return calloc(1, sizeof(mmio_t));
+    mmio_t *mmio = calloc(1, sizeof(mmio_t));
+    if (mmio == NULL)
+        return NULL;
+
+    PERIPHERY_STATS_INIT(mmio, "mmio", _mmio_stats_tostring);
+
+    return mmio;
 }
 
 void mmio_free(mmio_t *mmio)
 {
+    PERIPHERY_STATS_CLOSE(mmio);
     free(mmio);
 }
 
@@ -71,7 +90,9 @@ int mmio_open_advanced(mmio_t *mmio, uintptr_t base, size_t size, const char *pa
 {
     int fd;
 
+    PERIPHERY_STATS_CLOSE(mmio);
     memset(mmio, 0, sizeof(mmio_t));
+    PERIPHERY_STATS_INIT(mmio, "mmio", _mmio_stats_tostring);
     mmio->base = base;
     mmio->size = size;
     mmio->aligned_base = mmio->base - (mmio->base % sysconf(_SC_PAGESIZE));
@@ -109,7 +130,7 @@ void *mmio_ptr(mmio_t *mmio)
 /* WARNING: These functions may trigger a bus fault on some CPUs if an
  * unaligned address is accessed! */
 
-int mmio_read32(mmio_t *mmio, uintptr_t offset, uint32_t *value)
+static int _mmio_read32(mmio_t *mmio, uintptr_t offset, uint32_t *value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 4) > mmio->aligned_size)
@@ -119,7 +140,12 @@ int mmio_read32(mmio_t *mmio, uintptr_t offset, uint32_t *value)
     return 0;
 }
 
-int mmio_read16(mmio_t *mmio, uintptr_t offset, uint16_t *value)
+int mmio_read32(mmio_t *mmio, uintptr_t offset, uint32_t *value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 4, _mmio_read32(mmio, offset, value));
+}
+
+static int _mmio_read16(mmio_t *mmio, uintptr_t offset, uint16_t *value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 2) > mmio->aligned_size)
@@ -129,7 +155,12 @@ int mmio_read16(mmio_t *mmio, uintptr_t offset, uint16_t *value)
     return 0;
 }
 
-int mmio_read8(mmio_t *mmio, uintptr_t offset, uint8_t *value)
+int mmio_read16(mmio_t *mmio, uintptr_t offset, uint16_t *value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 2, _mmio_read16(mmio, offset, value));
+}
+
+static int _mmio_read8(mmio_t *mmio, uintptr_t offset, uint8_t *value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 1) > mmio->aligned_size)
@@ -139,7 +170,12 @@ int mmio_read8(mmio_t *mmio, uintptr_t offset, uint8_t *value)
     return 0;
 }
 
-int mmio_read(mmio_t *mmio, uintptr_t offset, uint8_t *buf, size_t len)
+int mmio_read8(mmio_t *mmio, uintptr_t offset, uint8_t *value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 1, _mmio_read8(mmio, offset, value));
+}
+
+static int _mmio_read(mmio_t *mmio, uintptr_t offset, uint8_t *buf, size_t len)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + len) > mmio->aligned_size)
@@ -149,7 +185,12 @@ int mmio_read(mmio_t *mmio, uintptr_t offset, uint8_t *buf, size_t len)
     return 0;
 }
 
-int mmio_write32(mmio_t *mmio, uintptr_t offset, uint32_t value)
+int mmio_read(mmio_t *mmio, uintptr_t offset, uint8_t *buf, size_t len)
+{
+    return PERIPHERY_STATS_CALL(mmio, len, _mmio_read(mmio, offset, buf, len));
+}
+
+static int _mmio_write32(mmio_t *mmio, uintptr_t offset, uint32_t value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 4) > mmio->aligned_size)
@@ -159,7 +200,12 @@ int mmio_write32(mmio_t *mmio, uintptr_t offset, uint32_t value)
     return 0;
 }
 
-int mmio_write16(mmio_t *mmio, uintptr_t offset, uint16_t value)
+int mmio_write32(mmio_t *mmio, uintptr_t offset, uint32_t value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 4, _mmio_write32(mmio, offset, value));
+}
+
+static int _mmio_write16(mmio_t *mmio, uintptr_t offset, uint16_t value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 2) > mmio->aligned_size)
@@ -169,7 +215,12 @@ int mmio_write16(mmio_t *mmio, uintptr_t offset, uint16_t value)
     return 0;
 }
 
-int mmio_write8(mmio_t *mmio, uintptr_t offset, uint8_t value)
+int mmio_write16(mmio_t *mmio, uintptr_t offset, uint16_t value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 2, _mmio_write16(mmio, offset, value));
+}
+
+static int _mmio_write8(mmio_t *mmio, uintptr_t offset, uint8_t value)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + 1) > mmio->aligned_size)
@@ -179,7 +230,12 @@ int mmio_write8(mmio_t *mmio, uintptr_t offset, uint8_t value)
     return 0;
 }
 
-int mmio_write(mmio_t *mmio, uintptr_t offset, const uint8_t *buf, size_t len)
+int mmio_write8(mmio_t *mmio, uintptr_t offset, uint8_t value)
+{
+    return PERIPHERY_STATS_CALL(mmio, 1, _mmio_write8(mmio, offset, value));
+}
+
+static int _mmio_write(mmio_t *mmio, uintptr_t offset, const uint8_t *buf, size_t len)
 {
     offset += (mmio->base - mmio->aligned_base);
     if ((offset + len) > mmio->aligned_size)
@@ -189,8 +245,15 @@ int mmio_write(mmio_t *mmio, uintptr_t offset, const uint8_t *buf, size_t len)
     return 0;
 }
 
+int mmio_write(mmio_t *mmio, uintptr_t offset, const uint8_t *buf, size_t len)
+{
+    return PERIPHERY_STATS_CALL(mmio, len, _mmio_write(mmio, offset, buf, len));
+}
+
 int mmio_close(mmio_t *mmio)
 {
+    PERIPHERY_STATS_CLOSE(mmio);
+
     if (!mmio->ptr)
         return 0;
 
@@ -208,6 +271,12 @@ int mmio_tostring(mmio_t *mmio, char *str, size_t len)
     return snprintf(str, len, "MMIO 0x%08zx (ptr=%p, size=%zu)", mmio->base, mmio->ptr, mmio->size);
 }
 
+int mmio_stats(mmio_t *mmio, periphery_stats_t *stats)
+{
+    PERIPHERY_STATS_GET(mmio, stats);
+    return 0;
+}
+
 const char *mmio_errmsg(mmio_t *mmio)
 {
     return mmio->error.errmsg;
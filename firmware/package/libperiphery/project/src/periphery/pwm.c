@@ -18,6 +18,7 @@
 #include <errno.h>
 
 #include "periphery/pwm.h"
+#include "periphery/stats_internal.h"
 
 #define P_PATH_MAX 256
 /* Delay between checks for successful PWM export (100ms) */
@@ -31,6 +32,10 @@ struct pwm_handle
     unsigned int channel;
     uint64_t period_ns;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct
     {
         int c_errno;
@@ -59,6 +64,16 @@ static int _pwm_error(pwm_t *pwm, int code, int c_errno, const char *fmt, ...)
     return code;
 }
 
+#if PERIPHERY_STATS
+/* Not pwm_tostring(), whose attribute reads would count as operations */
+static int _pwm_stats_tostring(void *handle, char *str, size_t len)
+{
+    pwm_t *pwm = handle;
+
+    return snprintf(str, len, "PWM %u, chip %u", pwm->channel, pwm->chip);
+}
+#endif
+
 pwm_t *pwm_new(void)
 {
     pwm_t *pwm = calloc(1, sizeof(pwm_t));
@@ -68,6 +83,8 @@ pwm_t *pwm_new(void)
     pwm->chip = -1;
     pwm->channel = -1;
 
+    PERIPHERY_STATS_INIT(pwm, "pwm", _pwm_stats_tostring);
+
     return pwm;
 }
 
@@ -140,7 +157,9 @@ int pwm_open(pwm_t *pwm, unsigned int chip, unsigned int channel)
         }
     }
 
+    PERIPHERY_STATS_CLOSE(pwm);
     memset(pwm, 0, sizeof(pwm_t));
+    PERIPHERY_STATS_INIT(pwm, "pwm", _pwm_stats_tostring);
     pwm->chip = chip;
     pwm->channel = channel;
 
@@ -163,6 +182,8 @@ int pwm_disable(pwm_t *pwm)
 
 int pwm_close(pwm_t *pwm)
 {
+    PERIPHERY_STATS_CLOSE(pwm);
+
     char path[P_PATH_MAX];
     char buf[16];
     int len;
@@ -197,10 +218,11 @@ int pwm_close(pwm_t *pwm)
 
 void pwm_free(pwm_t *pwm)
 {
+    PERIPHERY_STATS_CLOSE(pwm);
     free(pwm);
 }
 
-static int pwm_read_attribute(pwm_t *pwm, const char *name, char *buf, size_t len)
+static int _pwm_read_attribute(pwm_t *pwm, const char *name, char *buf, size_t len)
 {
     char path[P_PATH_MAX];
     int fd, ret;
@@ -225,7 +247,12 @@ static int pwm_read_attribute(pwm_t *pwm, const char *name, char *buf, size_t le
     return 0;
 }
 
-static int pwm_write_attribute(pwm_t *pwm, const char *name, const char *buf, size_t len)
+static int pwm_read_attribute(pwm_t *pwm, const char *name, char *buf, size_t len)
+{
+    return PERIPHERY_STATS_CALL(pwm, 0, _pwm_read_attribute(pwm, name, buf, len));
+}
+
+static int _pwm_write_attribute(pwm_t *pwm, const char *name, const char *buf, size_t len)
 {
     char path[P_PATH_MAX];
     int fd;
@@ -248,6 +275,11 @@ static int pwm_write_attribute(pwm_t *pwm, const char *name, const char *buf, si
     return 0;
 }
 
+static int pwm_write_attribute(pwm_t *pwm, const char *name, const char *buf, size_t len)
+{
+    return PERIPHERY_STATS_CALL(pwm, 0, _pwm_write_attribute(pwm, name, buf, len));
+}
+
 int pwm_get_enabled(pwm_t *pwm, bool *enabled)
 {
     char buf[2];
@@ -481,6 +513,12 @@ int pwm_tostring(pwm_t *pwm, char *str, size_t len)
     return snprintf(str, len, "PWM %u, chip %u (period=%s sec, duty_cycle=%s%%, polarity=%s, enabled=%s)", pwm->channel, pwm->chip, period_str, duty_cycle_str, polarity_str, enabled_str);
 }
 
+int pwm_stats(pwm_t *pwm, periphery_stats_t *stats)
+{
+    PERIPHERY_STATS_GET(pwm, stats);
+    return 0;
+}
+
 int pwm_errno(pwm_t *pwm)
 {
     return pwm->error.c_errno;
@@ -22,11 +22,16 @@
 #include <termios.h>
 
 #include "periphery/serial.h"
+#include "periphery/stats_internal.h"
 
 struct serial_handle {
     int fd;
     bool use_termios_timeout;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct {
         int c_errno;
         char errmsg[96];
@@ -52,6 +57,12 @@ static int _serial_error(serial_t *serial, int code, int c_errno, const char *fm
     return code;
 }
 
+#if PERIPHERY_STATS
+static int _serial_stats_tostring(void *handle, char *str, size_t len) {
+    return serial_tostring(handle, str, len);
+}
+#endif
+
 serial_t *serial_new(void) {
     serial_t *serial = calloc(1, sizeof(serial_t));
     if (serial == NULL)
@@ -59,10 +70,13 @@ serial_t *serial_new(void) {
 
     serial->fd = -1;
 
+    PERIPHERY_STATS_INIT(serial, "serial", _serial_stats_tostring);
+
     return serial;
 }
 
 void serial_free(serial_t *serial) {
+    PERIPHERY_STATS_CLOSE(serial);
     free(serial);
 }
 
@@ -170,7 +184,9 @@ int serial_open_advanced(serial_t *serial, const char *path, uint32_t baudrate,
     if (stopbits != 1 && stopbits != 2)
         return _serial_error(serial, SERIAL_ERROR_ARG, 0, "Invalid stop bits (can be 1,2)");
 
+    PERIPHERY_STATS_CLOSE(serial);
     memset(serial, 0, sizeof(serial_t));
+    PERIPHERY_STATS_INIT(serial, "serial", _serial_stats_tostring);
 
     /* Open serial port */
     if ((serial->fd = open(path, O_RDWR | O_NOCTTY)) < 0)
@@ -241,7 +257,7 @@ int serial_open_advanced(serial_t *serial, const char *path, uint32_t baudrate,
     return 0;
 }
 
-int serial_read(serial_t *serial, uint8_t *buf, size_t len, int timeout_ms) {
+static int _serial_read(serial_t *serial, uint8_t *buf, size_t len, int timeout_ms) {
     ssize_t ret;
 
     struct timeval tv_timeout;
@@ -279,7 +295,11 @@ int serial_read(serial_t *serial, uint8_t *buf, size_t len, int timeout_ms) {
     return bytes_read;
 }
 
-int serial_write(serial_t *serial, const uint8_t *buf, size_t len) {
+int serial_read(serial_t *serial, uint8_t *buf, size_t len, int timeout_ms) {
+    return PERIPHERY_STATS_CALL_COUNT(serial, _serial_read(serial, buf, len, timeout_ms));
+}
+
+static int _serial_write(serial_t *serial, const uint8_t *buf, size_t len) {
     ssize_t ret;
 
     if ((ret = write(serial->fd, buf, len)) < 0)
@@ -288,6 +308,10 @@ int serial_write(serial_t *serial, const uint8_t *buf, size_t len) {
     return ret;
 }
 
+int serial_write(serial_t *serial, const uint8_t *buf, size_t len) {
+    return PERIPHERY_STATS_CALL_COUNT(serial, _serial_write(serial, buf, len));
+}
+
 int serial_flush(serial_t *serial) {
 
     if (tcdrain(serial->fd) < 0)
@@ -328,6 +352,8 @@ int serial_poll(serial_t *serial, int timeout_ms) {
 }
 
 int serial_close(serial_t *serial) {
+    PERIPHERY_STATS_CLOSE(serial);
+
     if (serial->fd < 0)
         return 0;
 
@@ -658,6 +684,11 @@ int serial_tostring(serial_t *serial, char *str, size_t len) {
                     serial->fd, baudrate, databits_str, parity_str, stopbits_str, xonxoff_str, rtscts_str, vmin, vtime);
 }
 
+int serial_stats(serial_t *serial, periphery_stats_t *stats) {
+    PERIPHERY_STATS_GET(serial, stats);
+    return 0;
+}
+
 const char *serial_errmsg(serial_t *serial) {
     return serial->error.errmsg;
 }
@@ -20,10 +20,15 @@
 #include <linux/spi/spidev.h>
 
 #include "periphery/spi.h"
+#include "periphery/stats_internal.h"
 
 struct spi_handle {
     int fd;
 
+#if PERIPHERY_STATS
+    struct periphery_stats_entry stats;
+#endif
+
     struct {
         int c_errno;
         char errmsg[96];
@@ -49,6 +54,12 @@ static int _spi_error(spi_t *spi, int code, int c_errno, const char *fmt, ...) {
     return code;
 }
 
+#if PERIPHERY_STATS
+static int _spi_stats_tostring(void *handle, char *str, size_t len) {
+    return spi_tostring(handle, str, len);
+}
+#endif
+
 spi_t *spi_new(void) {
     spi_t *spi = calloc(1, sizeof(spi_t));
     if (spi == NULL)
@@ -56,10 +67,13 @@ spi_t *spi_new(void) {
 
     spi->fd = -1;
 
+    PERIPHERY_STATS_INIT(spi, "spi", _spi_stats_tostring);
+
     return spi;
 }
 
 void spi_free(spi_t *spi) {
+    PERIPHERY_STATS_CLOSE(spi);
     free(spi);
 }
 
@@ -85,7 +99,9 @@ int spi_open_advanced2(spi_t *spi, const char *path, unsigned int mode, uint32_t
         return _spi_error(spi, SPI_ERROR_UNSUPPORTED, 0, "Kernel version does not support 32-bit SPI mode flags");
 #endif
 
+    PERIPHERY_STATS_CLOSE(spi);
     memset(spi, 0, sizeof(spi_t));
+    PERIPHERY_STATS_INIT(spi, "spi", _spi_stats_tostring);
 
     /* Open device */
     if ((spi->fd = open(path, O_RDWR)) < 0)
@@ -144,7 +160,7 @@ int spi_open_advanced2(spi_t *spi, const char *path, unsigned int mode, uint32_t
     return 0;
 }
 
-int spi_transfer(spi_t *spi, const uint8_t *txbuf, uint8_t *rxbuf, size_t len) {
+static int _spi_transfer(spi_t *spi, const uint8_t *txbuf, uint8_t *rxbuf, size_t len) {
     struct spi_ioc_transfer spi_xfer;
 
     /* Prepare SPI transfer structure */
@@ -164,7 +180,13 @@ int spi_transfer(spi_t *spi, const uint8_t *txbuf, uint8_t *rxbuf, size_t len) {
     return 0;
 }
 
+int spi_transfer(spi_t *spi, const uint8_t *txbuf, uint8_t *rxbuf, size_t len) {
+    return PERIPHERY_STATS_CALL(spi, len, _spi_transfer(spi, txbuf, rxbuf, len));
+}
+
 int spi_close(spi_t *spi) {
+    PERIPHERY_STATS_CLOSE(spi);
+
     if (spi->fd < 0)
         return 0;
 
@@ -390,6 +412,11 @@ int spi_tostring(spi_t *spi, char *str, size_t len) {
     return snprintf(str, len, "SPI (fd=%d, mode=%s, max_speed=%s, bit_order=%s, bits_per_word=%s, extra_flags=%s)", spi->fd, mode_str, max_speed_str, bit_order_str, bits_per_word_str, extra_flags_str);
 }
 
+int spi_stats(spi_t *spi, periphery_stats_t *stats) {
+    PERIPHERY_STATS_GET(spi, stats);
+    return 0;
+}
+
 const char *spi_errmsg(spi_t *spi) {
     return spi->error.errmsg;
 }
@@ -0,0 +1,168 @@
+/*
+ * c-periphery
+ * https://github.com/vsergeev/c-periphery
+ * License: MIT
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <time.h>
+
+#include "periphery/stats.h"
+#include "periphery/stats_internal.h"
+
+#if PERIPHERY_STATS
+
+/* Poll period while another thread holds the registry */
+#define REGISTRY_LOCK_SLEEP_NS 100000
+
+/* Handles that have done I/O since they were opened. Handles are opened and
+ * closed from any thread, so the list takes a lock; the counters are only
+ * written by the thread using the handle and are read unlocked. The lock is
+ * only held to link, unlink or copy entries, never across I/O. */
+static struct periphery_stats_entry *registry;
+static unsigned int registry_count;
+static bool registry_lock;
+
+static void _registry_lock(void) {
+    const struct timespec pause = {0, REGISTRY_LOCK_SLEEP_NS};
+
+    /* Sleep rather than yield: a SCHED_FIFO thread spinning here would
+     * starve a lower priority holder on a single core */
+    while (__atomic_test_and_set(&registry_lock, __ATOMIC_ACQUIRE))
+        nanosleep(&pause, NULL);
+}
+
+static void _registry_unlock(void) {
+    __atomic_clear(&registry_lock, __ATOMIC_RELEASE);
+}
+
+void _periphery_stats_init(struct periphery_stats_entry *entry, const char *module, void *handle,
+                           int (*tostring)(void *handle, char *str, size_t len)) {
+    entry->counters = (periphery_stats_t){0};
+    entry->module = module;
+    entry->handle = handle;
+    entry->tostring = tostring;
+    entry->description[0] = '\0';
+    entry->registered = false;
+    entry->prev = entry->next = NULL;
+}
+
+void _periphery_stats_register(struct periphery_stats_entry *entry) {
+    /* Described by the thread using the handle, before it is listed, so the
+     * dump never touches a handle that may be closing */
+    if (!entry->registered && entry->tostring(entry->handle, entry->description, sizeof(entry->description)) < 0)
+        entry->description[0] = '\0';
+
+    _registry_lock();
+
+    if (!entry->registered) {
+        entry->prev = NULL;
+        entry->next = registry;
+        if (registry)
+            registry->prev = entry;
+        registry = entry;
+        registry_count++;
+        entry->registered = true;
+    }
+
+    _registry_unlock();
+}
+
+void _periphery_stats_unregister(struct periphery_stats_entry *entry) {
+    _registry_lock();
+
+    if (entry->registered) {
+        if (entry->prev)
+            entry->prev->next = entry->next;
+        else
+            registry = entry->next;
+        if (entry->next)
+            entry->next->prev = entry->prev;
+        entry->prev = entry->next = NULL;
+        registry_count--;
+        entry->registered = false;
+    }
+
+    _registry_unlock();
+}
+
+bool periphery_stats_enabled(void) {
+    return true;
+}
+
+int periphery_stats_dump(FILE *stream) {
+    struct periphery_stats_snapshot {
+        const char *module;
+        periphery_stats_t counters;
+        char description[PERIPHERY_STATS_DESCRIPTION_SIZE];
+    } *snapshot;
+    unsigned int count = 0;
+    int ret;
+
+    /* Copy the entries under the lock, format them after releasing it */
+    _registry_lock();
+
+    snapshot = malloc((registry_count ? registry_count : 1) * sizeof(*snapshot));
+    if (snapshot) {
+        for (struct periphery_stats_entry *entry = registry; entry; entry = entry->next, count++) {
+            snapshot[count].module = entry->module;
+            snapshot[count].counters = entry->counters;
+            memcpy(snapshot[count].description, entry->description, sizeof(snapshot[count].description));
+        }
+    }
+
+    _registry_unlock();
+
+    if (!snapshot)
+        return -1;
+
+    ret = fprintf(stream, "%-6s %12s %8s %12s %10s %10s  %s\n", "module", "ops", "errors", "bytes", "avg_ns", "max_ns", "handle") < 0 ? -1 : 0;
+
+    for (unsigned int i = 0; i < count && ret >= 0; i++) {
+        const periphery_stats_t *c = &snapshot[i].counters;
+
+        if (fprintf(stream, "%-6s %12llu %8llu %12llu %10llu %10llu  %s\n", snapshot[i].module,
+                    (unsigned long long)c->ops, (unsigned long long)c->errors, (unsigned long long)c->bytes,
+                    (unsigned long long)(c->ops ? c->total_ns / c->ops : 0), (unsigned long long)c->max_ns,
+                    snapshot[i].description) < 0)
+            ret = -1;
+        else
+            ret++;
+    }
+
+    free(snapshot);
+
+    return ret;
+}
+
+void periphery_stats_reset(void) {
+    _registry_lock();
+
+    for (struct periphery_stats_entry *entry = registry; entry; entry = entry->next)
+        entry->counters = (periphery_stats_t){0};
+
+    _registry_unlock();
+}
+
+#else
+
+bool periphery_stats_enabled(void) {
+    return false;
+}
+
+int periphery_stats_dump(FILE *stream) {
+    (void)stream;
+    return 0;
+}
+
+void periphery_stats_reset(void) {
+}
+
+#endif
+
@@ -0,0 +1,56 @@
+#!/bin/bash
+# Footprint of the c-periphery users in a Buildroot output directory: size
+# of each example binary, of libperiphery itself and of the initramfs, plus
+# the build time of each package from build/build-time.log. Run it on the
+# output of a build before and after a change to compare.
+#
+# Usage: footprint_report.sh [output-dir]   (default: output)
+
+OUT=${1:-output}
+PACKAGES="libperiphery ioexample1 ioexample2 ioexample3 ioexample4 ioexample5 ioexample6 ioexample7 ioexample8 ioexample9 sleepexample hellomk periphery-tools"
+
+if [ ! -d "$OUT/target" ]; then
+    echo "No Buildroot output in '$OUT'" >&2
+    exit 1
+fi
+
+echo "Target files:"
+total=0
+for pkg in $PACKAGES; do
+    for file in "$OUT/target/usr/bin/$pkg" "$OUT/target/usr/lib/$pkg.so.2"; do
+        [ -f "$file" ] || continue
+        size=$(stat -c %s "$file")
+        total=$((total + size))
+        printf "  %-40s %9d B\n" "${file#$OUT/target}" "$size"
+    done
+done
+printf "  %-40s %9d B\n" "total" "$total"
+
+if [ -f "$OUT/staging/usr/lib/libperiphery.a" ]; then
+    printf "  %-40s %9d B (staging, not installed)\n" "libperiphery.a" "$(stat -c %s "$OUT/staging/usr/lib/libperiphery.a")"
+fi
+
+for image in "$OUT"/images/rootfs.cpio* "$OUT"/images/xipImage; do
+    [ -f "$image" ] && printf "  %-40s %9d B\n" "images/${image##*/}" "$(stat -c %s "$image")"
+done
+
+# build-time.log has one "timestamp:start|end:step:package" line per edge
+LOG="$OUT/build/build-time.log"
+if [ -f "$LOG" ]; then
+    echo "Build time:"
+    awk -F: -v packages="$PACKAGES" '
+        BEGIN { n = split(packages, list, " "); for (i = 1; i <= n; i++) wanted[list[i]] = 1 }
+        {
+            gsub(/ /, "", $2); gsub(/ /, "", $3); gsub(/ /, "", $4)
+            if (!($4 in wanted)) next
+            if ($2 == "start") started[$4 ":" $3] = $1
+            else if ((($4 ":" $3) in started)) seconds[$4] += $1 - started[$4 ":" $3]
+        }
+        END {
+            for (i = 1; i <= n; i++) {
+                printf "  %-40s %9.2f s\n", list[i], seconds[list[i]]
+                total += seconds[list[i]]
+            }
+            printf "  %-40s %9.2f s\n", "total", total
+        }' "$LOG"
+fi
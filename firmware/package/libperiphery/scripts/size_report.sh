@@ -0,0 +1,70 @@
+#!/bin/bash
+# Size of libperiphery and of the examples linked against it for a few build
+# configurations: all modules without section garbage collection, with
+# -ffunction-sections/-fdata-sections and --gc-sections, with LTO on top,
+# and trimmed module/backend sets. Sizes are text+data as reported by size.
+#
+# Usage: size_report.sh [cc]   (default: gcc; pass the Buildroot cross
+#                               compiler, e.g. output/host/bin/arm-linux-gcc,
+#                               for target numbers)
+
+CC=${1:-gcc}
+AR=${CC%gcc}gcc-ar
+SIZE=${CC%gcc}size
+[ -x "$(command -v "$SIZE")" ] || SIZE=size
+
+PACKAGE_DIR=$(cd "$(dirname "$0")/../.." && pwd)
+LIB_DIR=$PACKAGE_DIR/libperiphery/project
+EXAMPLES="ioexample1:led ioexample2:gpio ioexample3:i2c ioexample4:spi ioexample5:mmio ioexample6:pwm ioexample7:serial ioexample9:adc sleepexample:mmio"
+ALL_MODULES="adc gpio i2c led mmio pwm serial spi"
+
+# name|cflags|ldflags|modules|gpio sysfs
+CONFIGS="
+baseline|-Os|-Os|$ALL_MODULES|y
+sections|-Os -ffunction-sections -fdata-sections|-Os -Wl,--gc-sections|$ALL_MODULES|y
+sections+lto|-Os -ffunction-sections -fdata-sections -flto -ffat-lto-objects|-Os -Wl,--gc-sections -flto|$ALL_MODULES|y
+gpio cdev only|-Os -ffunction-sections -fdata-sections -flto -ffat-lto-objects|-Os -Wl,--gc-sections -flto|gpio|n
+mmio only|-Os -ffunction-sections -fdata-sections -flto -ffat-lto-objects|-Os -Wl,--gc-sections -flto|mmio|y
+"
+
+# text+data of a binary or of all members of an archive
+footprint() {
+    "$SIZE" -t "$1" 2>/dev/null | awk 'END { print $1 + $2 }'
+}
+
+printf "%-16s %12s" "configuration" "archive"
+for entry in $EXAMPLES; do printf " %12s" "${entry%%:*}"; done
+printf "\n"
+
+echo "$CONFIGS" | while IFS='|' read -r name cflags ldflags modules sysfs; do
+    [ -n "$name" ] || continue
+    cflags="$cflags -DPERIPHERY_GPIO_CDEV_SUPPORT=2"
+    vars=(CC="$CC" AR="$AR" CFLAGS="$cflags" LDFLAGS="$ldflags" PERIPHERY_MODULES="$modules" PERIPHERY_GPIO_SYSFS="$sysfs")
+
+    make -s -C "$LIB_DIR" distclean
+    if ! make -s -C "$LIB_DIR" "${vars[@]}" >/dev/null 2>&1; then
+        printf "%-16s %12s\n" "$name" "failed"
+        continue
+    fi
+    printf "%-16s %12d" "$name" "$(footprint "$LIB_DIR/bin/libperiphery.a")"
+
+    for entry in $EXAMPLES; do
+        example=${entry%%:*}
+        module=${entry#*:}
+        case " $modules " in
+            *" $module "*) ;;
+            *) printf " %12s" "-"; continue ;;
+        esac
+        dir=$PACKAGE_DIR/$example/project
+        make -s -C "$dir" distclean
+        if make -s -C "$dir" "${vars[@]}" >/dev/null 2>&1; then
+            printf " %12d" "$(footprint "$dir/bin/$example")"
+        else
+            printf " %12s" "failed"
+        fi
+        make -s -C "$dir" distclean
+    done
+    printf "\n"
+done
+
+make -s -C "$LIB_DIR" distclean
@@ -0,0 +1,5 @@
+#!/bin/bash
+echo "Removing libperiphery from target and staging..."
+rm -f $(TARGET_DIR)/usr/lib/libperiphery.so*
+rm -f $(STAGING_DIR)/usr/lib/libperiphery.*
+rm -rf $(STAGING_DIR)/usr/include/periphery
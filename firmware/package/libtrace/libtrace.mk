@@ -0,0 +1,32 @@
+###############################################################################
+#
+# LIBTRACE package
+#
+###############################################################################
+
+# Package version and source location
+LIBTRACE_VERSION = 1.0
+LIBTRACE_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/libtrace/project
+LIBTRACE_SITE_METHOD = local
+
+# Header and archive go to staging, where the examples link against them
+LIBTRACE_INSTALL_STAGING = YES
+LIBTRACE_INSTALL_TARGET = NO
+
+# Build commands
+define LIBTRACE_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		AR="$(TARGET_AR)" \
+		CFLAGS="$(TARGET_CFLAGS) -ffunction-sections -fdata-sections" \
+		-C $(@D)
+endef
+
+# Install the header and archive for other packages to build against
+define LIBTRACE_INSTALL_STAGING_CMDS
+	$(INSTALL) -D -m 0644 $(@D)/include/libtrace/startup_trace.h $(STAGING_DIR)/usr/include/libtrace/startup_trace.h
+	$(INSTALL) -D -m 0644 $(@D)/bin/libtrace.a $(STAGING_DIR)/usr/lib/libtrace.a
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,50 @@
+// include/libtrace/startup_trace.h
+//
+// Startup profiling: timestamps at process entry, after each device open,
+// after configuration load and at the first I/O. They are kept in a static
+// array and written out as a single line once the first I/O has happened
+// (or at exit), so the trace adds no console traffic to the startup it
+// measures. The macros compile to nothing unless STARTUP_TRACE is defined;
+// the Makefiles define it for STARTUP_TRACE=y. The recorder is the libtrace
+// archive, so only programs that call it link it in.
+//
+// Trace line, times in microseconds since boot (entry) or since entry (+):
+//   startup-trace <comm> pid=<pid> exec=<us> entry=<us> <label>=+<us> ...
+// exec is the kernel's process start time, in clock ticks (10 ms at HZ=100).
+// STARTUP_TRACE_FILE=<path> in the environment appends the line to <path>
+// instead of writing it to stderr.
+
+#ifndef STARTUP_TRACE_H
+#define STARTUP_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STARTUP_TRACE_MAX_POINTS 16
+
+/* Labels must be string literals, only the pointer is stored */
+void startup_trace_point(const char *label);
+
+/* Records the point and writes the trace; later calls do nothing */
+void startup_trace_first_io(const char *label);
+
+void startup_trace_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef STARTUP_TRACE
+
+#define TRACE_POINT(label) startup_trace_point(label)
+#define TRACE_FIRST_IO(label) startup_trace_first_io(label)
+
+#else
+
+#define TRACE_POINT(label) ((void)0)
+#define TRACE_FIRST_IO(label) ((void)0)
+
+#endif
+
+#endif // STARTUP_TRACE_H
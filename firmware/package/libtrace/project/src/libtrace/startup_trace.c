@@ -0,0 +1,150 @@
+// src/libtrace/startup_trace.c
+//
+// Points are recorded with one clock_gettime() each and no locking: startup
+// is single-threaded in every example. Formatting, /proc reads and the write
+// itself are deferred to the flush. The entry timestamp is taken by a
+// constructor in this file, which the linker only pulls in together with the
+// functions below, i.e. when the program was built with STARTUP_TRACE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "libtrace/startup_trace.h"
+
+#define TRACE_LINE_LENGTH 512
+
+/* Same clock as the process start time in /proc/self/stat */
+#ifdef CLOCK_BOOTTIME
+#define TRACE_CLOCK CLOCK_BOOTTIME
+#else
+#define TRACE_CLOCK CLOCK_MONOTONIC
+#endif
+
+typedef struct trace_point {
+    const char *label;
+    uint64_t us;
+} trace_point_t;
+
+static trace_point_t points[STARTUP_TRACE_MAX_POINTS];
+static unsigned int point_count;
+static uint64_t entry_us;
+static bool first_io_seen;
+static bool flushed;
+
+static uint64_t boot_us(void)
+{
+    struct timespec ts;
+    clock_gettime(TRACE_CLOCK, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/* Runs before main(), as close to process entry as user space gets */
+__attribute__((constructor)) static void startup_trace_entry(void)
+{
+    entry_us = boot_us();
+    atexit(startup_trace_flush);
+}
+
+void startup_trace_point(const char *label)
+{
+    if (point_count < STARTUP_TRACE_MAX_POINTS)
+    {
+        points[point_count].label = label;
+        points[point_count].us = boot_us();
+        point_count++;
+    }
+}
+
+void startup_trace_first_io(const char *label)
+{
+    if (first_io_seen)
+        return;
+    first_io_seen = true;
+
+    startup_trace_point(label);
+    startup_trace_flush();
+}
+
+/**
+ * @brief Read the command name and start time from /proc/self/stat.
+ *
+ * @return 0 on success, -1 if /proc is not available.
+ */
+static int read_proc_stat(char *comm, size_t size, uint64_t *start_us)
+{
+    char buf[512];
+    int fd = open("/proc/self/stat", O_RDONLY);
+    ssize_t n;
+
+    if (fd < 0)
+        return -1;
+    n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return -1;
+    buf[n] = '\0';
+
+    /* "pid (comm) state ..." where comm may itself contain spaces or ')' */
+    char *open_paren = strchr(buf, '(');
+    char *close_paren = strrchr(buf, ')');
+    if (!open_paren || !close_paren || close_paren < open_paren)
+        return -1;
+    snprintf(comm, size, "%.*s", (int)(close_paren - open_paren - 1), open_paren + 1);
+
+    /* starttime is field 22; the field after comm is field 3 */
+    char *field = close_paren + 2;
+    for (int i = 3; i < 22 && field; i++)
+    {
+        field = strchr(field, ' ');
+        if (field)
+            field++;
+    }
+    if (!field)
+        return -1;
+
+    *start_us = strtoull(field, NULL, 10) * 1000000u / (uint64_t)sysconf(_SC_CLK_TCK);
+    return 0;
+}
+
+void startup_trace_flush(void)
+{
+    char line[TRACE_LINE_LENGTH];
+    char comm[32] = "?";
+    uint64_t start_us = 0;
+    const char *path;
+    size_t len;
+    int fd;
+
+    if (flushed)
+        return;
+    flushed = true;
+
+    read_proc_stat(comm, sizeof(comm), &start_us);
+    len = (size_t)snprintf(line, sizeof(line), "startup-trace %s pid=%d exec=%llu entry=%llu",
+                           comm, (int)getpid(), (unsigned long long)start_us, (unsigned long long)entry_us);
+
+    for (unsigned int i = 0; i < point_count && len < sizeof(line); i++)
+    {
+        len += (size_t)snprintf(line + len, sizeof(line) - len, " %s=+%llu", points[i].label,
+                                (unsigned long long)(points[i].us - entry_us));
+    }
+    if (len > sizeof(line) - 2)
+        len = sizeof(line) - 2;
+    line[len++] = '\n';
+
+    /* One write per line so runs appending to the same file do not interleave */
+    path = getenv("STARTUP_TRACE_FILE");
+    fd = path ? open(path, O_WRONLY | O_CREAT | O_APPEND, 0644) : STDERR_FILENO;
+    if (fd < 0)
+        return;
+    ssize_t written = write(fd, line, len);
+    (void)written;
+    if (fd != STDERR_FILENO)
+        close(fd);
+}
@@ -0,0 +1,35 @@
+###############################################################################
+#
+# PERIPHERY_BENCH package
+#
+###############################################################################
+
+# Package version and source location
+PERIPHERY_BENCH_VERSION = 1.0
+PERIPHERY_BENCH_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/periphery-bench/project
+PERIPHERY_BENCH_SITE_METHOD = local
+
+# c-periphery and the sample statistics come from the libperiphery and
+# libbench packages
+PERIPHERY_BENCH_DEPENDENCIES = libbench libperiphery
+
+# The GPIO cases are named after the ABI libperiphery was built for
+PERIPHERY_BENCH_DEFINES += -DPERIPHERY_GPIO_CDEV_SUPPORT=$(LIBPERIPHERY_GPIO_CDEV_SUPPORT)
+
+# Build commands
+define PERIPHERY_BENCH_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		CFLAGS="$(TARGET_CFLAGS) $(PERIPHERY_BENCH_DEFINES)" \
+		LDFLAGS="$(TARGET_LDFLAGS) $(LIBPERIPHERY_LDFLAGS)" \
+		SYSCOUNT=wrap \
+		-C $(@D)
+endef
+
+# Install the compiled binary to the target filesystem
+define PERIPHERY_BENCH_INSTALL_TARGET_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/periphery-bench $(TARGET_DIR)/usr/bin/periphery-bench
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
@@ -0,0 +1,41 @@
+// include/libbench/runner.h
+
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* One benchmark: <setup> opens the device, <run> performs <iterations>
+ * operations on it, <teardown> closes it. The runner picks the iteration
+ * count so that one repetition takes at least the configured minimum time,
+ * as Google Benchmark does. */
+typedef struct bench_case {
+    const char *name;           /* "spi_transfer/64", unique */
+    long arg;                   /* Case parameter, e.g. the transfer size */
+    uint64_t bytes_per_op;      /* Payload moved by one operation, 0 for none */
+
+    /* Returns a context for run/teardown, or NULL with *skip set to the
+     * reason the case cannot run here (missing device, wrong backend) */
+    void *(*setup)(const struct bench_case *bc, const char **skip);
+    /* Returns 0, or -1 after printing why an operation failed */
+    int (*run)(void *ctx, long arg, uint64_t iterations);
+    void (*teardown)(void *ctx);
+} bench_case_t;
+
+typedef struct bench_config {
+    const char *filter;         /* Substring of the names to run, NULL for all */
+    double min_time_s;          /* Minimum duration of one repetition */
+    unsigned int repetitions;   /* Timed repetitions after calibration */
+    FILE *table;                /* Human-readable results, NULL for none */
+    FILE *json;                 /* JSON results, NULL for none */
+    /* Extra "key", "value" string pairs for the JSON context, NULL ended */
+    const char *const *context;
+} bench_config_t;
+
+/* Run every case matching the filter and write one record per case to
+ * each output. Returns the number of failed cases, or -1 on invalid
+ * configuration. */
+int bench_run(const bench_case_t *cases, unsigned int count, const bench_config_t *config);
+
+#endif // RUNNER_H
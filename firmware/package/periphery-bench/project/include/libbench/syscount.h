@@ -0,0 +1,21 @@
+// include/libbench/syscount.h
+
+#ifndef SYSCOUNT_H
+#define SYSCOUNT_H
+
+/* Count of the file and device calls the program has made: open, close,
+ * read, write, lseek, poll, select and ioctl, i.e. the syscalls behind every
+ * periphery operation. The counter comes from one of:
+ *
+ *   SYSCOUNT_WRAP  the program is linked with -Wl,--wrap=<call> for those
+ *                  calls and syscount.c forwards them to libc (board builds)
+ *   SYSCOUNT_MOCK  the host mock, which wraps the same calls already
+ *   neither        no counting; syscount_available() is 0
+ *
+ * Calls libc makes internally (tcdrain(), printf()) are not seen. */
+
+int syscount_available(void);
+const char *syscount_source(void);
+unsigned long syscount_read(void);
+
+#endif // SYSCOUNT_H
@@ -0,0 +1,309 @@
+// src/libbench/runner.c
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/utsname.h>
+
+#include "libbench/runner.h"
+#include "libbench/stats.h"
+#include "libbench/syscount.h"
+
+/* Upper bound of the calibrated iteration count */
+#define MAX_ITERATIONS 1000000000ULL
+
+/* Upper bound of the repetitions kept for the summary */
+#define MAX_REPETITIONS 1000
+
+typedef struct bench_result {
+    const char *name;
+    const char *skipped;        /* Reason the case did not run, NULL if it ran */
+    int failed;                 /* An operation returned an error */
+    uint64_t iterations;        /* Operations per repetition */
+    unsigned int repetitions;
+    stats_summary_t elapsed_ns; /* Per repetition */
+    double syscalls_per_op;     /* < 0 when syscalls are not counted */
+    uint64_t bytes_per_op;
+} bench_result_t;
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* -------------------- Measurement -------------------- */
+
+/* One timed batch; returns the elapsed time or -1 if an operation failed */
+static int64_t time_batch(const bench_case_t *bc, void *ctx, uint64_t iterations)
+{
+    int64_t start = now_ns();
+
+    if (bc->run(ctx, bc->arg, iterations) < 0)
+        return -1;
+    return now_ns() - start;
+}
+
+/* Grow the batch until it lasts min_ns: tenfold while far off, then by the
+ * measured rate with 40 % headroom, like Google Benchmark */
+static uint64_t calibrate(const bench_case_t *bc, void *ctx, int64_t min_ns)
+{
+    uint64_t iterations = 1;
+
+    for (;;)
+    {
+        int64_t elapsed = time_batch(bc, ctx, iterations);
+        uint64_t next;
+
+        if (elapsed < 0)
+            return 0;
+        if (elapsed >= min_ns || iterations >= MAX_ITERATIONS)
+            return iterations;
+
+        if (elapsed <= min_ns / 10)
+            next = iterations * 10;
+        else
+            next = (uint64_t)((double)iterations * 1.4 * (double)min_ns / (double)elapsed);
+
+        if (next <= iterations)
+            next = iterations + 1;
+        iterations = (next > MAX_ITERATIONS) ? MAX_ITERATIONS : next;
+    }
+}
+
+static void measure(const bench_case_t *bc, const bench_config_t *config, bench_result_t *result)
+{
+    unsigned int repetitions = config->repetitions;
+    int64_t samples[MAX_REPETITIONS];
+    unsigned long syscalls;
+    void *ctx;
+
+    if (repetitions > MAX_REPETITIONS)
+        repetitions = MAX_REPETITIONS;
+
+    memset(result, 0, sizeof(*result));
+    result->name = bc->name;
+    result->bytes_per_op = bc->bytes_per_op;
+    result->syscalls_per_op = -1.0;
+
+    if ((ctx = bc->setup(bc, &result->skipped)) == NULL)
+    {
+        if (result->skipped == NULL)
+            result->skipped = "setup failed";
+        return;
+    }
+
+    result->iterations = calibrate(bc, ctx, (int64_t)(config->min_time_s * 1e9));
+    if (result->iterations == 0)
+    {
+        result->failed = 1;
+        bc->teardown(ctx);
+        return;
+    }
+
+    syscalls = syscount_read();
+    for (unsigned int r = 0; r < repetitions; r++)
+    {
+        if ((samples[r] = time_batch(bc, ctx, result->iterations)) < 0)
+        {
+            result->failed = 1;
+            bc->teardown(ctx);
+            return;
+        }
+    }
+    syscalls = syscount_read() - syscalls;
+
+    bc->teardown(ctx);
+
+    result->repetitions = repetitions;
+    stats_summarize(samples, repetitions, &result->elapsed_ns);
+    if (syscount_available())
+        result->syscalls_per_op = (double)syscalls / ((double)result->iterations * repetitions);
+}
+
+/* -------------------- Output -------------------- */
+
+static void emit_json_string(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; *s; s++)
+    {
+        if (*s == '"' || *s == '\\')
+            fprintf(out, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            fprintf(out, "\\u%04x", (unsigned char)*s);
+        else
+            fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+/* Scaled time, e.g. "152 ns" or "8.21 us" */
+static const char *format_time(double ns, char *buf, size_t len)
+{
+    if (ns < 1e3)
+        snprintf(buf, len, "%.1f ns", ns);
+    else if (ns < 1e6)
+        snprintf(buf, len, "%.2f us", ns / 1e3);
+    else if (ns < 1e9)
+        snprintf(buf, len, "%.2f ms", ns / 1e6);
+    else
+        snprintf(buf, len, "%.2f s", ns / 1e9);
+    return buf;
+}
+
+static void emit_header(const bench_config_t *config)
+{
+    FILE *table = config->table, *json = config->json;
+    struct utsname uts;
+    char date[32];
+    time_t t = time(NULL);
+
+    if (uname(&uts) != 0)
+        memset(&uts, 0, sizeof(uts));
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&t));
+
+    if (table)
+    {
+        fprintf(table, "%s %s %s, %s, syscalls counted by: %s\n",
+                uts.sysname, uts.release, uts.machine, date, syscount_source());
+        fprintf(table, "%-28s %12s %12s %12s %12s %12s\n",
+                "Benchmark", "Time/op", "Min/op", "Syscalls/op", "Iterations", "MB/s");
+        fprintf(table, "%.*s\n", 28 + 5 * 13, "--------------------------------------------------"
+                                              "--------------------------------------------------");
+    }
+
+    if (json)
+    {
+        fprintf(json, "{\n  \"context\": {\"date\": \"%s\", \"sysname\": \"%s\", \"release\": \"%s\", \"machine\": \"%s\", ",
+                date, uts.sysname, uts.release, uts.machine);
+        fprintf(json, "\"syscalls\": \"%s\", \"min_time_s\": %.3f, \"repetitions\": %u",
+                syscount_source(), config->min_time_s, config->repetitions);
+        for (const char *const *kv = config->context; kv && kv[0] && kv[1]; kv += 2)
+        {
+            fprintf(json, ", ");
+            emit_json_string(json, kv[0]);
+            fprintf(json, ": ");
+            emit_json_string(json, kv[1]);
+        }
+        fprintf(json, "},\n  \"benchmarks\": [");
+    }
+}
+
+static void emit_table(FILE *out, const bench_result_t *r)
+{
+    const stats_summary_t *s = &r->elapsed_ns;
+    double n = (double)r->iterations;
+    char median[24], min[24], syscalls[16] = "-", rate[16] = "-";
+
+    if (r->skipped)
+    {
+        fprintf(out, "%-28s SKIPPED: %s\n", r->name, r->skipped);
+        return;
+    }
+    if (r->failed)
+    {
+        fprintf(out, "%-28s FAILED\n", r->name);
+        return;
+    }
+
+    if (r->syscalls_per_op >= 0)
+        snprintf(syscalls, sizeof(syscalls), "%.2f", r->syscalls_per_op);
+    if (r->bytes_per_op)
+        snprintf(rate, sizeof(rate), "%.3f", (double)r->bytes_per_op * 1e3 / (s->median / n));
+    fprintf(out, "%-28s %12s %12s %12s %12llu %12s\n", r->name,
+            format_time(s->median / n, median, sizeof(median)), format_time(s->min / n, min, sizeof(min)),
+            syscalls, (unsigned long long)r->iterations, rate);
+    fflush(out);
+}
+
+static void emit_json(FILE *out, const bench_result_t *r, int first)
+{
+    const stats_summary_t *s = &r->elapsed_ns;
+    double n = (double)r->iterations;
+
+    fprintf(out, "%s\n    {\"name\": ", first ? "" : ",");
+    emit_json_string(out, r->name);
+
+    if (r->skipped)
+    {
+        fprintf(out, ", \"skipped\": ");
+        emit_json_string(out, r->skipped);
+    }
+    else if (r->failed)
+    {
+        fprintf(out, ", \"error\": true");
+    }
+    else
+    {
+        fprintf(out, ", \"iterations\": %llu, \"repetitions\": %u, "
+                     "\"ns_per_op\": {\"min\": %.3f, \"median\": %.3f, \"max\": %.3f, \"mean\": %.3f}, ",
+                (unsigned long long)r->iterations, r->repetitions,
+                s->min / n, s->median / n, s->max / n, s->mean / n);
+        if (r->syscalls_per_op >= 0)
+            fprintf(out, "\"syscalls_per_op\": %.3f, ", r->syscalls_per_op);
+        else
+            fprintf(out, "\"syscalls_per_op\": null, ");
+        fprintf(out, "\"bytes_per_op\": %llu", (unsigned long long)r->bytes_per_op);
+    }
+    fprintf(out, "}");
+}
+
+static void emit_footer(const bench_config_t *config, unsigned int ran, unsigned int skipped, unsigned int failed)
+{
+    if (config->table)
+    {
+        fprintf(config->table, "%u run, %u skipped, %u failed\n", ran, skipped, failed);
+        fflush(config->table);
+    }
+    if (config->json)
+    {
+        fprintf(config->json, "\n  ]\n}\n");
+        fflush(config->json);
+    }
+}
+
+/* -------------------- Runner -------------------- */
+
+/**
+ * @brief Run the matching cases in table order, one record each.
+ *
+ * Skipped cases are reported but do not count as failures.
+ */
+int bench_run(const bench_case_t *cases, unsigned int count, const bench_config_t *config)
+{
+    unsigned int ran = 0, skipped = 0, failed = 0;
+
+    if (config->min_time_s <= 0.0 || config->repetitions == 0)
+        return -1;
+
+    emit_header(config);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        bench_result_t result;
+
+        if (config->filter && strstr(cases[i].name, config->filter) == NULL)
+            continue;
+
+        measure(&cases[i], config, &result);
+        if (config->table)
+            emit_table(config->table, &result);
+        if (config->json)
+            emit_json(config->json, &result, ran + skipped + failed == 0);
+
+        if (result.skipped)
+            skipped++;
+        else if (result.failed)
+            failed++;
+        else
+            ran++;
+    }
+
+    emit_footer(config, ran, skipped, failed);
+    return (int)failed;
+}
@@ -0,0 +1,175 @@
+// src/libbench/syscount.c
+
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/types.h>
+
+#include "libbench/syscount.h"
+
+#if defined(SYSCOUNT_WRAP)
+
+static unsigned long syscalls;
+
+/* Real libc entry points, resolved by the linker's --wrap. lseek keeps the
+ * native long offset; with _FILE_OFFSET_BITS=64 the callers reach lseek64. */
+int __real_open(const char *path, int flags, ...);
+int __real_open64(const char *path, int flags, ...);
+int __real_close(int fd);
+ssize_t __real_read(int fd, void *buf, size_t count);
+ssize_t __real_write(int fd, const void *buf, size_t count);
+long __real_lseek(int fd, long offset, int whence);
+int64_t __real_lseek64(int fd, int64_t offset, int whence);
+int __real_poll(struct pollfd *fds, nfds_t nfds, int timeout);
+int __real_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout);
+int __real_ioctl(int fd, unsigned long request, ...);
+
+static mode_t open_mode(int flags, va_list ap)
+{
+#ifdef O_TMPFILE
+    if (flags & (O_CREAT | O_TMPFILE))
+#else
+    if (flags & O_CREAT)
+#endif
+        return (mode_t)va_arg(ap, int);
+    return 0;
+}
+
+int __wrap_open(const char *path, int flags, ...)
+{
+    va_list ap;
+    mode_t mode;
+
+    va_start(ap, flags);
+    mode = open_mode(flags, ap);
+    va_end(ap);
+
+    syscalls++;
+    return __real_open(path, flags, mode);
+}
+
+int __wrap_open64(const char *path, int flags, ...)
+{
+    va_list ap;
+    mode_t mode;
+
+    va_start(ap, flags);
+    mode = open_mode(flags, ap);
+    va_end(ap);
+
+    syscalls++;
+    return __real_open64(path, flags, mode);
+}
+
+int __wrap_close(int fd)
+{
+    syscalls++;
+    return __real_close(fd);
+}
+
+ssize_t __wrap_read(int fd, void *buf, size_t count)
+{
+    syscalls++;
+    return __real_read(fd, buf, count);
+}
+
+ssize_t __wrap_write(int fd, const void *buf, size_t count)
+{
+    syscalls++;
+    return __real_write(fd, buf, count);
+}
+
+long __wrap_lseek(int fd, long offset, int whence)
+{
+    syscalls++;
+    return __real_lseek(fd, offset, whence);
+}
+
+int64_t __wrap_lseek64(int fd, int64_t offset, int whence)
+{
+    syscalls++;
+    return __real_lseek64(fd, offset, whence);
+}
+
+int __wrap_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    syscalls++;
+    return __real_poll(fds, nfds, timeout);
+}
+
+int __wrap_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout)
+{
+    syscalls++;
+    return __real_select(nfds, readfds, writefds, exceptfds, timeout);
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...)
+{
+    va_list ap;
+    void *arg;
+
+    va_start(ap, request);
+    arg = va_arg(ap, void *);
+    va_end(ap);
+
+    syscalls++;
+    return __real_ioctl(fd, request, arg);
+}
+
+int syscount_available(void)
+{
+    return 1;
+}
+
+const char *syscount_source(void)
+{
+    return "wrap";
+}
+
+unsigned long syscount_read(void)
+{
+    return syscalls;
+}
+
+#elif defined(SYSCOUNT_MOCK)
+
+/* Provided by libmock.a of the host tests */
+unsigned long mock_syscalls(void);
+
+int syscount_available(void)
+{
+    return 1;
+}
+
+const char *syscount_source(void)
+{
+    return "mock";
+}
+
+unsigned long syscount_read(void)
+{
+    return mock_syscalls();
+}
+
+#else
+
+int syscount_available(void)
+{
+    return 0;
+}
+
+const char *syscount_source(void)
+{
+    return "none";
+}
+
+unsigned long syscount_read(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,732 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+
+#include "periphery/gpio.h"
+#include "periphery/i2c.h"
+#include "periphery/led.h"
+#include "periphery/mmio.h"
+#include "periphery/pwm.h"
+#include "periphery/serial.h"
+#include "periphery/spi.h"
+#include "periphery/version.h"
+#include "libbench/runner.h"
+#include "libbench/syscount.h"
+
+/* Name of the character device backend compiled into libperiphery */
+#if PERIPHERY_GPIO_CDEV_SUPPORT == 2
+#define GPIO_CDEV_NAME "cdev-v2"
+#elif PERIPHERY_GPIO_CDEV_SUPPORT == 1
+#define GPIO_CDEV_NAME "cdev-v1"
+#else
+#define GPIO_CDEV_NAME "cdev"
+#endif
+
+/* Board defaults: every operation below only reads registers or drives
+ * lines that are free on an STM32F429 Discovery */
+#define GPIO_OUT "G14"              /* Red LED, not claimed by the LED driver */
+#define GPIO_IN "A0"                /* User button */
+#define GPIO_LINE_NAME "PK15"       /* Named line for gpio_open_name */
+#define SPI_DEVICE "/dev/spidev0.0" /* L3GD20 gyroscope */
+#define SPI_MODE 3
+#define SPI_SPEED_HZ 1000000
+#define SPI_READ_WHOAMI 0xCF        /* Read, auto-increment, from WHO_AM_I */
+#define I2C_DEVICE "/dev/i2c-0"
+#define I2C_ADDRESS 0x41            /* STMPE811 touch controller */
+#define SERIAL_DEVICE "/dev/ttySTM1"
+#define SERIAL_BAUDRATE 115200
+#define SERIAL_TIMEOUT_MS 1000
+#define LED_NAME "led-green"
+#define PWM_CHIP 0
+#define PWM_CHANNEL 1
+#define PWM_PERIOD_S 1e-3
+#define RCC_BASE 0x40023800UL
+#define RCC_PLLCFGR 0x04
+
+#define MAX_TRANSFER 1024
+
+typedef struct
+{
+    const char *gpio_out;
+    const char *gpio_in;
+    const char *gpio_line_name;
+    const char *spi_device;
+    const char *i2c_device;
+    unsigned int i2c_address;
+    const char *serial_device;
+    const char *led_name;
+    unsigned int pwm_chip;
+    unsigned int pwm_channel;
+} options_t;
+
+static options_t options = {
+    .gpio_out = GPIO_OUT,
+    .gpio_in = GPIO_IN,
+    .gpio_line_name = GPIO_LINE_NAME,
+    .spi_device = SPI_DEVICE,
+    .i2c_device = I2C_DEVICE,
+    .i2c_address = I2C_ADDRESS,
+    .serial_device = SERIAL_DEVICE,
+    .led_name = LED_NAME,
+    .pwm_chip = PWM_CHIP,
+    .pwm_channel = PWM_CHANNEL,
+};
+
+/* Reason handed back by a failed setup; the runner prints it right away */
+static char skip_reason[160];
+
+static const char *skip(const char *what, const char *errmsg)
+{
+    snprintf(skip_reason, sizeof(skip_reason), "%s: %s", what, errmsg);
+    return skip_reason;
+}
+
+/*********************************************************************************/
+/* GPIO */
+/*********************************************************************************/
+
+/* Case arguments */
+enum
+{
+    GPIO_READ_SYSFS,
+    GPIO_READ_CDEV,
+    GPIO_WRITE_SYSFS,
+    GPIO_WRITE_CDEV,
+};
+
+/* "G14" -> bank 6, line 14 */
+static int parse_gpio(const char *name, unsigned int *bank, unsigned int *line)
+{
+    char *end;
+
+    if (name[0] < 'A' || name[0] > 'Z')
+        return -1;
+    *bank = (unsigned int)(name[0] - 'A');
+    *line = (unsigned int)strtoul(name + 1, &end, 10);
+    return (end == name + 1 || *end) ? -1 : 0;
+}
+
+static int read_attribute(const char *path, char *buf, size_t len)
+{
+    ssize_t n;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return -1;
+    n = read(fd, buf, len - 1);
+    close(fd);
+    if (n < 0)
+        return -1;
+    buf[n] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+    return 0;
+}
+
+/* sysfs number of a line: base of the gpiochip labelled "GPIO<bank>" plus
+ * the line, since the kernel may place the banks anywhere */
+static int sysfs_gpio_number(unsigned int bank, unsigned int line)
+{
+    char path[300], label[32], base[16], want[8];
+    struct dirent *entry;
+    int number = -1;
+    DIR *dir;
+
+    if ((dir = opendir("/sys/class/gpio")) == NULL)
+        return -1;
+
+    snprintf(want, sizeof(want), "GPIO%c", 'A' + bank);
+    while (number < 0 && (entry = readdir(dir)) != NULL)
+    {
+        if (strncmp(entry->d_name, "gpiochip", 8) != 0)
+            continue;
+
+        snprintf(path, sizeof(path), "/sys/class/gpio/%s/label", entry->d_name);
+        if (read_attribute(path, label, sizeof(label)) < 0 || strcmp(label, want) != 0)
+            continue;
+
+        snprintf(path, sizeof(path), "/sys/class/gpio/%s/base", entry->d_name);
+        if (read_attribute(path, base, sizeof(base)) == 0)
+            number = atoi(base) + (int)line;
+    }
+
+    closedir(dir);
+    return number;
+}
+
+static void *gpio_setup(const bench_case_t *bc, const char **reason)
+{
+    bool out = (bc->arg == GPIO_WRITE_SYSFS || bc->arg == GPIO_WRITE_CDEV);
+    bool sysfs = (bc->arg == GPIO_READ_SYSFS || bc->arg == GPIO_WRITE_SYSFS);
+    const char *name = out ? options.gpio_out : options.gpio_in;
+    gpio_direction_t direction = out ? GPIO_DIR_OUT_LOW : GPIO_DIR_IN;
+    unsigned int bank, line;
+    char chip[32];
+    gpio_t *gpio;
+    int ret;
+
+    if (parse_gpio(name, &bank, &line) < 0)
+    {
+        *reason = skip(name, "not a GPIO name like G14");
+        return NULL;
+    }
+
+    gpio = gpio_new();
+
+    if (sysfs)
+    {
+        int number = sysfs_gpio_number(bank, line);
+
+        if (number < 0)
+        {
+            gpio_free(gpio);
+            *reason = skip("/sys/class/gpio", "no gpiochip for this bank");
+            return NULL;
+        }
+        ret = gpio_open_sysfs(gpio, (unsigned int)number, direction);
+    }
+    else
+    {
+        snprintf(chip, sizeof(chip), "/dev/gpiochip%u", bank);
+        ret = gpio_open(gpio, chip, line, direction);
+    }
+
+    if (ret < 0)
+    {
+        *reason = skip(name, gpio_errmsg(gpio));
+        gpio_free(gpio);
+        return NULL;
+    }
+    return gpio;
+}
+
+static int gpio_read_run(void *ctx, long arg, uint64_t iterations)
+{
+    gpio_t *gpio = ctx;
+    bool value;
+
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (gpio_read(gpio, &value) < 0)
+        {
+            fprintf(stderr, "gpio_read(): %s\n", gpio_errmsg(gpio));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int gpio_write_run(void *ctx, long arg, uint64_t iterations)
+{
+    gpio_t *gpio = ctx;
+
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (gpio_write(gpio, i & 1) < 0)
+        {
+            fprintf(stderr, "gpio_write(): %s\n", gpio_errmsg(gpio));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void gpio_teardown(void *ctx)
+{
+    gpio_close(ctx);
+    gpio_free(ctx);
+}
+
+/* Resolving a line name through all chips and requesting the line: with
+ * the name cache emptied first, the cost of a scan of every line of every
+ * chip; with it warm, what an open by name costs afterwards. The board's
+ * device tree names no lines; on a kernel with gpio-sim, create named
+ * lines with scripts/gpio-sim-setup.sh and pass one with -n. */
+enum
+{
+    GPIO_OPEN_NAME_SCAN,
+    GPIO_OPEN_NAME_CACHED,
+};
+
+static void *gpio_open_name_setup(const bench_case_t *bc, const char **reason)
+{
+    gpio_t *gpio = gpio_new();
+
+    (void)bc;
+    gpio_name_cache_clear();
+    if (gpio_open_name(gpio, NULL, options.gpio_line_name, GPIO_DIR_IN) < 0)
+    {
+        *reason = skip(options.gpio_line_name, gpio_errmsg(gpio));
+        gpio_free(gpio);
+        return NULL;
+    }
+    gpio_close(gpio);
+    return gpio;
+}
+
+static int gpio_open_name_run(void *ctx, long arg, uint64_t iterations)
+{
+    gpio_t *gpio = ctx;
+
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (arg == GPIO_OPEN_NAME_SCAN)
+            gpio_name_cache_clear();
+        if (gpio_open_name(gpio, NULL, options.gpio_line_name, GPIO_DIR_IN) < 0)
+        {
+            fprintf(stderr, "gpio_open_name(): %s\n", gpio_errmsg(gpio));
+            return -1;
+        }
+        gpio_close(gpio);
+    }
+    return 0;
+}
+
+static void gpio_open_name_teardown(void *ctx)
+{
+    gpio_free(ctx);
+    gpio_name_cache_clear();
+}
+
+/*********************************************************************************/
+/* SPI */
+/*********************************************************************************/
+
+static uint8_t spi_tx[MAX_TRANSFER];
+static uint8_t spi_rx[MAX_TRANSFER];
+
+static void *spi_setup(const bench_case_t *bc, const char **reason)
+{
+    spi_t *spi = spi_new();
+
+    (void)bc;
+    if (spi_open(spi, options.spi_device, SPI_MODE, SPI_SPEED_HZ) < 0)
+    {
+        *reason = skip(options.spi_device, spi_errmsg(spi));
+        spi_free(spi);
+        return NULL;
+    }
+
+    /* A register read burst: the device only ever shifts data out */
+    memset(spi_tx, 0, sizeof(spi_tx));
+    spi_tx[0] = SPI_READ_WHOAMI;
+    return spi;
+}
+
+static int spi_transfer_run(void *ctx, long arg, uint64_t iterations)
+{
+    spi_t *spi = ctx;
+
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (spi_transfer(spi, spi_tx, spi_rx, (size_t)arg) < 0)
+        {
+            fprintf(stderr, "spi_transfer(): %s\n", spi_errmsg(spi));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void spi_teardown(void *ctx)
+{
+    spi_close(ctx);
+    spi_free(ctx);
+}
+
+/*********************************************************************************/
+/* I2C */
+/*********************************************************************************/
+
+static void *i2c_setup(const bench_case_t *bc, const char **reason)
+{
+    i2c_t *i2c = i2c_new();
+
+    (void)bc;
+    if (i2c_open(i2c, options.i2c_device) < 0)
+    {
+        *reason = skip(options.i2c_device, i2c_errmsg(i2c));
+        i2c_free(i2c);
+        return NULL;
+    }
+    return i2c;
+}
+
+/* Register read of <arg> bytes from register 0: a write and a read message */
+static int i2c_transfer_run(void *ctx, long arg, uint64_t iterations)
+{
+    i2c_t *i2c = ctx;
+    uint8_t reg = 0x00;
+    uint8_t data[MAX_TRANSFER];
+    struct i2c_msg msgs[2] = {
+        {.addr = options.i2c_address, .flags = 0, .len = 1, .buf = &reg},
+        {.addr = options.i2c_address, .flags = I2C_M_RD, .len = (uint16_t)arg, .buf = data},
+    };
+
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (i2c_transfer(i2c, msgs, 2) < 0)
+        {
+            fprintf(stderr, "i2c_transfer(): %s\n", i2c_errmsg(i2c));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void i2c_teardown(void *ctx)
+{
+    i2c_close(ctx);
+    i2c_free(ctx);
+}
+
+/*********************************************************************************/
+/* Serial */
+/*********************************************************************************/
+
+/* Needs TX wired to RX; without the loopback the first read times out */
+static void *serial_setup(const bench_case_t *bc, const char **reason)
+{
+    serial_t *serial = serial_new();
+    uint8_t probe = 0x55;
+
+    (void)bc;
+    if (serial_open(serial, options.serial_device, SERIAL_BAUDRATE) < 0)
+    {
+        *reason = skip(options.serial_device, serial_errmsg(serial));
+        serial_free(serial);
+        return NULL;
+    }
+
+    if (serial_write(serial, &probe, 1) != 1 || serial_read(serial, &probe, 1, SERIAL_TIMEOUT_MS) != 1)
+    {
+        *reason = skip(options.serial_device, "no loopback (TX not wired to RX)");
+        serial_close(serial);
+        serial_free(serial);
+        return NULL;
+    }
+    return serial;
+}
+
+static int serial_write_read_run(void *ctx, long arg, uint64_t iterations)
+{
+    serial_t *serial = ctx;
+    uint8_t tx[MAX_TRANSFER], rx[MAX_TRANSFER];
+
+    memset(tx, 0x55, (size_t)arg);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (serial_write(serial, tx, (size_t)arg) != arg)
+        {
+            fprintf(stderr, "serial_write(): %s\n", serial_errmsg(serial));
+            return -1;
+        }
+        if (serial_read(serial, rx, (size_t)arg, SERIAL_TIMEOUT_MS) != arg)
+        {
+            fprintf(stderr, "serial_read(): %s\n", serial_errmsg(serial));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void serial_teardown(void *ctx)
+{
+    serial_close(ctx);
+    serial_free(ctx);
+}
+
+/*********************************************************************************/
+/* MMIO */
+/*********************************************************************************/
+
+static void *mmio_setup(const bench_case_t *bc, const char **reason)
+{
+    mmio_t *mmio = mmio_new();
+
+    (void)bc;
+    if (mmio_open(mmio, RCC_BASE, 0x100) < 0)
+    {
+        *reason = skip("/dev/mem", mmio_errmsg(mmio));
+        mmio_free(mmio);
+        return NULL;
+    }
+    return mmio;
+}
+
+static int mmio_read32_run(void *ctx, long arg, uint64_t iterations)
+{
+    mmio_t *mmio = ctx;
+    uint32_t value;
+
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (mmio_read32(mmio, RCC_PLLCFGR, &value) < 0)
+        {
+            fprintf(stderr, "mmio_read32(): %s\n", mmio_errmsg(mmio));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void mmio_teardown(void *ctx)
+{
+    mmio_close(ctx);
+    mmio_free(ctx);
+}
+
+/*********************************************************************************/
+/* LED */
+/*********************************************************************************/
+
+static void *led_setup(const bench_case_t *bc, const char **reason)
+{
+    led_t *led = led_new();
+
+    (void)bc;
+    if (led_open(led, options.led_name) < 0)
+    {
+        *reason = skip(options.led_name, led_errmsg(led));
+        led_free(led);
+        return NULL;
+    }
+    return led;
+}
+
+static int led_write_run(void *ctx, long arg, uint64_t iterations)
+{
+    led_t *led = ctx;
+
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (led_write(led, i & 1) < 0)
+        {
+            fprintf(stderr, "led_write(): %s\n", led_errmsg(led));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void led_teardown(void *ctx)
+{
+    led_write(ctx, false);
+    led_close(ctx);
+    led_free(ctx);
+}
+
+/*********************************************************************************/
+/* PWM */
+/*********************************************************************************/
+
+static void *pwm_setup(const bench_case_t *bc, const char **reason)
+{
+    pwm_t *pwm = pwm_new();
+
+    (void)bc;
+    if (pwm_open(pwm, options.pwm_chip, options.pwm_channel) < 0 || pwm_set_period(pwm, PWM_PERIOD_S) < 0)
+    {
+        *reason = skip("pwm", pwm_errmsg(pwm));
+        pwm_close(pwm);
+        pwm_free(pwm);
+        return NULL;
+    }
+    return pwm;
+}
+
+static int pwm_set_duty_cycle_run(void *ctx, long arg, uint64_t iterations)
+{
+    pwm_t *pwm = ctx;
+
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (pwm_set_duty_cycle(pwm, (i & 1) ? PWM_PERIOD_S / 4 : PWM_PERIOD_S / 2) < 0)
+        {
+            fprintf(stderr, "pwm_set_duty_cycle(): %s\n", pwm_errmsg(pwm));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void pwm_teardown(void *ctx)
+{
+    pwm_close(ctx);
+    pwm_free(ctx);
+}
+
+/*********************************************************************************/
+/* Benchmarks */
+/*********************************************************************************/
+
+#define SPI_CASE(n) {"spi_transfer/" #n, n, n, spi_setup, spi_transfer_run, spi_teardown}
+#define I2C_CASE(n) {"i2c_transfer/" #n, n, n, i2c_setup, i2c_transfer_run, i2c_teardown}
+#define SERIAL_CASE(n) {"serial_write_read/" #n, n, 2 * n, serial_setup, serial_write_read_run, serial_teardown}
+
+static const bench_case_t cases[] = {
+    {"gpio_read/sysfs", GPIO_READ_SYSFS, 0, gpio_setup, gpio_read_run, gpio_teardown},
+    {"gpio_read/" GPIO_CDEV_NAME, GPIO_READ_CDEV, 0, gpio_setup, gpio_read_run, gpio_teardown},
+    {"gpio_write/sysfs", GPIO_WRITE_SYSFS, 0, gpio_setup, gpio_write_run, gpio_teardown},
+    {"gpio_write/" GPIO_CDEV_NAME, GPIO_WRITE_CDEV, 0, gpio_setup, gpio_write_run, gpio_teardown},
+    {"gpio_open_name/scan", GPIO_OPEN_NAME_SCAN, 0, gpio_open_name_setup, gpio_open_name_run, gpio_open_name_teardown},
+    {"gpio_open_name/cached", GPIO_OPEN_NAME_CACHED, 0, gpio_open_name_setup, gpio_open_name_run, gpio_open_name_teardown},
+    SPI_CASE(1),
+    SPI_CASE(4),
+    SPI_CASE(16),
+    SPI_CASE(64),
+    SPI_CASE(256),
+    SPI_CASE(1024),
+    I2C_CASE(1),
+    I2C_CASE(16),
+    SERIAL_CASE(1),
+    SERIAL_CASE(16),
+    SERIAL_CASE(64),
+    {"mmio_read32", 0, 4, mmio_setup, mmio_read32_run, mmio_teardown},
+    {"led_write", 0, 0, led_setup, led_write_run, led_teardown},
+    {"pwm_set_duty_cycle", 0, 0, pwm_setup, pwm_set_duty_cycle_run, pwm_teardown},
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+static void print_usage(const char *progname)
+{
+    printf("Usage: %s [options]\n", progname);
+    printf("Measures ns/op and syscalls/op of the libperiphery hot paths.\n\n");
+    printf("  -f <text>     Only run benchmarks whose name contains <text>\n");
+    printf("  -t <seconds>  Minimum time per repetition (default 0.5)\n");
+    printf("  -r <count>    Repetitions per benchmark (default 3)\n");
+    printf("  -j            Write JSON to stdout instead of the table\n");
+    printf("  -o <file>     Also write the results as JSON to <file>\n");
+    printf("  -l            List the benchmarks and exit\n");
+    printf("  -g <gpio>     Output line for gpio_write (default %s)\n", GPIO_OUT);
+    printf("  -i <gpio>     Input line for gpio_read (default %s)\n", GPIO_IN);
+    printf("  -n <name>     Line name for gpio_open_name (default %s)\n", GPIO_LINE_NAME);
+    printf("  -s <device>   SPI device (default %s)\n", SPI_DEVICE);
+    printf("  -I <device>   I2C bus (default %s)\n", I2C_DEVICE);
+    printf("  -a <address>  I2C slave address (default 0x%02x)\n", I2C_ADDRESS);
+    printf("  -S <device>   Serial port with TX wired to RX (default %s)\n", SERIAL_DEVICE);
+    printf("  -L <name>     LED name (default %s)\n", LED_NAME);
+    printf("  -p <c>:<n>    PWM chip and channel (default %d:%d)\n", PWM_CHIP, PWM_CHANNEL);
+    printf("  -h            Show this help\n\n");
+    printf("Cases that cannot open their device are reported as skipped.\n");
+}
+
+int main(int argc, char *argv[])
+{
+    bench_config_t config = {
+        .filter = NULL,
+        .min_time_s = 0.5,
+        .repetitions = 3,
+        .table = stdout,
+        .json = NULL,
+    };
+    bool json = false;
+    const char *output = NULL;
+    const char *context[] = {
+        "periphery_version", periphery_version(),
+        "gpio_cdev", GPIO_CDEV_NAME,
+        NULL, NULL,
+    };
+    int opt, failed;
+
+    while ((opt = getopt(argc, argv, "f:t:r:jo:lg:i:n:s:I:a:S:L:p:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            config.filter = optarg;
+            break;
+        case 't':
+            config.min_time_s = atof(optarg);
+            break;
+        case 'r':
+            config.repetitions = (unsigned int)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            json = true;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'l':
+            for (size_t i = 0; i < CASE_COUNT; i++)
+                printf("%s\n", cases[i].name);
+            return EXIT_SUCCESS;
+        case 'g':
+            options.gpio_out = optarg;
+            break;
+        case 'i':
+            options.gpio_in = optarg;
+            break;
+        case 'n':
+            options.gpio_line_name = optarg;
+            break;
+        case 's':
+            options.spi_device = optarg;
+            break;
+        case 'I':
+            options.i2c_device = optarg;
+            break;
+        case 'a':
+            options.i2c_address = (unsigned int)strtoul(optarg, NULL, 0);
+            break;
+        case 'S':
+            options.serial_device = optarg;
+            break;
+        case 'L':
+            options.led_name = optarg;
+            break;
+        case 'p':
+            if (sscanf(optarg, "%u:%u", &options.pwm_chip, &options.pwm_channel) != 2)
+            {
+                fprintf(stderr, "Invalid PWM chip:channel '%s'\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+            print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* JSON goes to the file next to the table on stdout, or replaces it */
+    if (output)
+    {
+        if ((config.json = fopen(output, "w")) == NULL)
+        {
+            fprintf(stderr, "Cannot open %s: %s\n", output, strerror(errno));
+            return EXIT_FAILURE;
+        }
+    }
+    else if (json)
+    {
+        config.json = stdout;
+        config.table = NULL;
+    }
+    config.context = context;
+
+    failed = bench_run(cases, CASE_COUNT, &config);
+
+    if (output)
+        fclose(config.json);
+
+    if (failed < 0)
+    {
+        fprintf(stderr, "Invalid minimum time or repetition count\n");
+        return EXIT_FAILURE;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
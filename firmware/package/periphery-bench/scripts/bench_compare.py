@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Compare two periphery-bench JSON results and flag regressions.
+
+Run the benchmarks before and after a change with "-o file.json" (on the
+board, or on the host with "make host-bench") and run:
+
+    bench_compare.py baseline.json current.json [--threshold 10]
+
+For every benchmark present in both files the median ns/op and the
+syscalls/op are compared. A benchmark regresses when its median time grows
+by more than the threshold (percent) or when it makes more syscalls per
+operation than before; the latter is deterministic and catches extra
+ioctl()s or reopened files even when host timings are noisy. The exit
+status is 1 if anything regressed, so the script can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Return (context, {name: record}) of a result file."""
+    with open(path) as f:
+        data = json.load(f)
+    return data.get("context", {}), {b["name"]: b for b in data.get("benchmarks", [])}
+
+
+def describe(record):
+    if "skipped" in record:
+        return "skipped"
+    if record.get("error"):
+        return "failed"
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="result file of the reference run")
+    parser.add_argument("current", help="result file to check")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed median slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    base_context, baseline = load(args.baseline)
+    context, current = load(args.current)
+
+    for key in ("machine", "syscalls", "gpio_cdev"):
+        if base_context.get(key) != context.get(key):
+            print("note: %s differs: %s -> %s" % (key, base_context.get(key), context.get(key)))
+
+    regressions = 0
+    print("%-28s %12s %12s %8s %10s %10s" % ("Benchmark", "Base ns/op", "ns/op", "Change", "Base sys", "Syscalls"))
+
+    for name, record in current.items():
+        base = baseline.get(name)
+        if base is None:
+            print("%-28s new" % name)
+            continue
+
+        state = describe(record) or describe(base)
+        if state:
+            flag = "REGRESSION" if describe(record) == "failed" and describe(base) is None else ""
+            regressions += bool(flag)
+            print("%-28s %s %s" % (name, state, flag))
+            continue
+
+        old_ns = base["ns_per_op"]["median"]
+        new_ns = record["ns_per_op"]["median"]
+        change = (new_ns - old_ns) / old_ns * 100.0 if old_ns else 0.0
+        old_sys = base.get("syscalls_per_op")
+        new_sys = record.get("syscalls_per_op")
+
+        flags = []
+        if change > args.threshold:
+            flags.append("slower")
+        if old_sys is not None and new_sys is not None and new_sys > old_sys + 0.005:
+            flags.append("more syscalls")
+        regressions += bool(flags)
+
+        print("%-28s %12.1f %12.1f %+7.1f%% %10s %10s %s" % (
+            name, old_ns, new_ns, change,
+            "-" if old_sys is None else "%.2f" % old_sys,
+            "-" if new_sys is None else "%.2f" % new_sys,
+            "REGRESSION (%s)" % ", ".join(flags) if flags else ""))
+
+    for name in baseline:
+        if name not in current:
+            print("%-28s missing" % name)
+
+    print("%d regression(s)" % regressions)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,64 @@
+#!/bin/sh
+# Create or remove gpio-sim chips with named lines, for benchmarking
+# gpio_open_name against more chips and lines than the board has. Needs a
+# kernel with CONFIG_GPIO_SIM and configfs mounted, and root.
+#
+# Usage: gpio-sim-setup.sh up [banks] [lines]   (default 8 banks of 64 lines)
+#        gpio-sim-setup.sh down
+#
+# Lines are named SIM<bank>_<line>; "up" prints the chips it created. Then
+# e.g.: periphery-bench -f gpio_open_name -n SIM7_63
+
+CONFIGFS=/sys/kernel/config/gpio-sim
+DEVICE=$CONFIGFS/periphery-bench
+
+up() {
+    banks=${1:-8}
+    lines=${2:-64}
+
+    [ -d "$CONFIGFS" ] || { echo "$CONFIGFS missing: no gpio-sim or configfs" >&2; exit 1; }
+    [ -d "$DEVICE" ] && down
+
+    mkdir "$DEVICE" || exit 1
+    bank=0
+    while [ $bank -lt "$banks" ]; do
+        mkdir "$DEVICE/bank$bank"
+        echo "$lines" > "$DEVICE/bank$bank/num_lines"
+        echo "periphery-bench.$bank" > "$DEVICE/bank$bank/label"
+        line=0
+        while [ $line -lt "$lines" ]; do
+            mkdir "$DEVICE/bank$bank/line$line"
+            echo "SIM${bank}_$line" > "$DEVICE/bank$bank/line$line/name"
+            line=$((line + 1))
+        done
+        bank=$((bank + 1))
+    done
+
+    echo 1 > "$DEVICE/live" || exit 1
+    for bank in "$DEVICE"/bank*; do
+        echo "/dev/$(cat "$bank/chip_name")"
+    done
+}
+
+down() {
+    [ -d "$DEVICE" ] || return 0
+    echo 0 > "$DEVICE/live"
+    for bank in "$DEVICE"/bank*; do
+        rmdir "$bank"/line* "$bank"
+    done
+    rmdir "$DEVICE"
+}
+
+case "$1" in
+up)
+    shift
+    up "$@"
+    ;;
+down)
+    down
+    ;;
+*)
+    echo "usage: $0 up [banks] [lines] | down" >&2
+    exit 1
+    ;;
+esac
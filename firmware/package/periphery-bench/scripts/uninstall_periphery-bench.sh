@@ -0,0 +1,3 @@
+#!/bin/bash
+echo "Removing periphery-bench from target..."
+rm -f $(TARGET_DIR)/usr/bin/periphery-bench
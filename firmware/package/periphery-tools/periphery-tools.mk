@@ -0,0 +1,60 @@
+###############################################################################
+#
+# PERIPHERY_TOOLS package
+#
+###############################################################################
+
+# Package version and source location
+PERIPHERY_TOOLS_VERSION = 1.0
+PERIPHERY_TOOLS_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/periphery-tools/project
+PERIPHERY_TOOLS_SITE_METHOD = local
+
+# c-periphery, the event loop, the DSP kernels, the sample statistics and the
+# hellomk configuration core come from their packages; the libhellocore INI
+# compiler pre-builds the configuration cache as in the hellomk package
+PERIPHERY_TOOLS_DEPENDENCIES = libbench libdsp libevloop libhellocore libperiphery libtrace host-libhellocore
+
+PERIPHERY_TOOLS_APPLETS = ioexample1 ioexample2 ioexample3 ioexample4 ioexample5 \
+	ioexample6 ioexample7 ioexample8 ioexample9 sleepexample hellomk
+
+# Applets whose standalone package is enabled keep their own binary
+PERIPHERY_TOOLS_LINKS = $(foreach applet,$(PERIPHERY_TOOLS_APPLETS),\
+	$(if $(BR2_PACKAGE_$(call UPPERCASE,$(applet))),,$(applet)))
+
+PERIPHERY_TOOLS_DEFINES += -DPERIPHERY_GPIO_CDEV_SUPPORT=$(LIBPERIPHERY_GPIO_CDEV_SUPPORT)
+
+# Build commands; the applet sources are read from their packages in the
+# external tree, the libraries are linked from staging
+define PERIPHERY_TOOLS_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		OBJCOPY="$(TARGET_OBJCOPY)" \
+		CFLAGS="$(TARGET_CFLAGS) $(PERIPHERY_TOOLS_DEFINES)" \
+		LDFLAGS="$(TARGET_LDFLAGS) $(LIBPERIPHERY_LDFLAGS)" \
+		PACKAGE_DIR="$(BR2_EXTERNAL_FIRMWARE_PATH)/package" \
+		PERIPHERY_DIR="$(STAGING_DIR)/usr" \
+		EVLOOP_DIR="$(STAGING_DIR)/usr" \
+		BENCH_DIR="$(STAGING_DIR)/usr" \
+		DSP_DIR="$(STAGING_DIR)/usr" \
+		HELLOCORE_DIR="$(STAGING_DIR)/usr" \
+		TRACE_DIR="$(STAGING_DIR)/usr" \
+		APPLETS="$(PERIPHERY_TOOLS_APPLETS)" \
+		-C $(@D)
+endef
+
+# Install the binary and a symlink for each applet
+define PERIPHERY_TOOLS_INSTALL_TARGET_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/periphery-tools $(TARGET_DIR)/usr/bin/periphery-tools
+	for applet in $(PERIPHERY_TOOLS_LINKS); do \
+		ln -sf periphery-tools $(TARGET_DIR)/usr/bin/$$applet || exit 1; \
+	done
+	$(if $(filter hellomk,$(PERIPHERY_TOOLS_LINKS)),$(PERIPHERY_TOOLS_INSTALL_HELLOMK_CONFIG))
+endef
+
+define PERIPHERY_TOOLS_INSTALL_HELLOMK_CONFIG
+	$(INSTALL) -D -m 0644 $(BR2_EXTERNAL_FIRMWARE_PATH)/package/hellomk/project/hellomk.ini $(TARGET_DIR)/etc/hellomk.ini
+	$(HOST_DIR)/bin/ini2cache $(TARGET_DIR)/etc/hellomk.ini
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
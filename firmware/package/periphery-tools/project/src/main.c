@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * APPLET_LIST is provided by the Makefile as APPLET(name) entries, one for
+ * each example linked in. Each applet's main() was renamed to name_main.
+ */
+#ifndef APPLET_LIST
+#error "APPLET_LIST must be defined by the build"
+#endif
+
+#define APPLET(name) int name##_main(int argc, char *argv[]);
+APPLET_LIST
+#undef APPLET
+
+typedef struct applet {
+    const char *name;
+    int (*main)(int argc, char *argv[]);
+} applet_t;
+
+static const applet_t applets[] = {
+#define APPLET(name) {#name, name##_main},
+    APPLET_LIST
+#undef APPLET
+};
+
+#define APPLET_COUNT (sizeof(applets) / sizeof(applets[0]))
+
+/**
+ * @brief Find an applet by the name it was invoked as.
+ *
+ * @return The applet, or NULL if there is none with that name.
+ */
+static const applet_t *find_applet(const char *name)
+{
+    for (size_t i = 0; i < APPLET_COUNT; i++)
+    {
+        if (strcmp(applets[i].name, name) == 0)
+            return &applets[i];
+    }
+    return NULL;
+}
+
+static void usage(const char *self)
+{
+    fprintf(stderr, "Usage: %s <applet> [arguments...]\n"
+                    "   or: <applet> [arguments...]   (through a symlink to %s)\n\n"
+                    "Applets:\n",
+            self, self);
+    for (size_t i = 0; i < APPLET_COUNT; i++)
+        fprintf(stderr, "  %s\n", applets[i].name);
+}
+
+/**
+ * @brief Main entry point of the program.
+ *
+ * Runs the applet named by the basename of argv[0], so each symlink in
+ * /usr/bin behaves like the standalone example. Invoked under its own name,
+ * the first argument selects the applet instead.
+ *
+ * @return The exit status of the applet, EXIT_FAILURE if there is none.
+ */
+int main(int argc, char *argv[])
+{
+    const char *name = argc > 0 ? strrchr(argv[0], '/') : NULL;
+    const applet_t *applet;
+
+    if (argc == 0)
+        return EXIT_FAILURE;
+    name = name ? name + 1 : argv[0];
+
+    applet = find_applet(name);
+    if (!applet && argc > 1)
+    {
+        /* "periphery-tools ioexample1 ..." runs ioexample1 with argv[0] shifted */
+        applet = find_applet(argv[1]);
+        if (applet)
+        {
+            argc--;
+            argv++;
+        }
+    }
+
+    if (!applet)
+    {
+        usage(name);
+        return EXIT_FAILURE;
+    }
+
+    return applet->main(argc, argv);
+}
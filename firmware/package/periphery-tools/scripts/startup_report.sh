@@ -0,0 +1,49 @@
+#!/bin/sh
+# Startup latency of the examples: average time from exec to exit over a
+# number of runs, for applets that can be told to exit right after argument
+# parsing. Run it on the target once with the standalone packages and once
+# with periphery-tools to compare; with a directory argument it runs the
+# binaries or symlinks found there instead of /usr/bin.
+#
+# Usage: startup_report.sh [runs] [bin-dir]   (default: 100 /usr/bin)
+
+RUNS=${1:-100}
+BIN=${2:-/usr/bin}
+
+# applet|arguments that make it exit before touching any hardware
+PROBES="
+ioexample4|--invalid
+ioexample8|
+ioexample9|-?
+sleepexample|-?
+hellomk|
+"
+
+now_us() {
+    t=$(date +%s%N)
+    echo $((t / 1000))
+}
+
+printf "%-16s %12s %10s\n" "applet" "binary" "avg"
+echo "$PROBES" | while IFS='|' read -r applet args; do
+    [ -n "$applet" ] || continue
+    if [ ! -x "$BIN/$applet" ]; then
+        printf "%-16s %12s\n" "$applet" "missing"
+        continue
+    fi
+
+    # Symlinks point at the multi-call binary
+    target=$(readlink -f "$BIN/$applet")
+    size=$(wc -c < "$target")
+
+    start=$(now_us)
+    i=0
+    while [ $i -lt "$RUNS" ]; do
+        # shellcheck disable=SC2086
+        "$BIN/$applet" $args </dev/null >/dev/null 2>&1
+        i=$((i + 1))
+    done
+    end=$(now_us)
+
+    printf "%-16s %10d B %7d us\n" "$applet" "$size" $(((end - start) / RUNS))
+done
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Aggregate startup traces of the example binaries.
+
+Build a package with STARTUP_TRACE=y, run it repeatedly on the target with
+STARTUP_TRACE_FILE pointing at a log (or capture stderr), copy the log to
+the host and run:
+
+    startup_trace.py trace.log [more.log ...]
+
+Each trace line looks like
+
+    startup-trace ioexample2 pid=97 exec=4210000 entry=4243117 gpio_open=+1830 ...
+
+with exec/entry in microseconds since boot and every other point relative to
+entry. Per program the report shows, for each point, min/median/mean/p95/max
+over all runs, plus the time between points so slow steps stand out. A label
+that occurs more than once in a run (config_probe for every path tried) is
+numbered in order of occurrence.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+from collections import OrderedDict
+
+
+def parse_line(line):
+    """Return (program, OrderedDict label -> microseconds) or None."""
+    fields = line.split()
+    if len(fields) < 4 or fields[0] != "startup-trace":
+        return None
+
+    program = fields[1]
+    values = {}
+    points = OrderedDict()
+    seen = {}
+    for field in fields[2:]:
+        key, _, value = field.partition("=")
+        if not value:
+            continue
+        if value.startswith("+"):
+            seen[key] = seen.get(key, 0) + 1
+            label = key if seen[key] == 1 else "%s#%d" % (key, seen[key])
+            points[label] = int(value[1:])
+        else:
+            values[key] = int(value)
+
+    if "entry" not in values:
+        return None
+
+    # Absolute times first: boot to process entry, and the coarse exec time
+    run = OrderedDict()
+    if values.get("exec"):
+        run["exec->entry"] = values["entry"] - values["exec"]
+    run["boot->entry"] = values["entry"]
+    run.update(points)
+    return program, run
+
+
+def percentile(sorted_values, fraction):
+    index = min(len(sorted_values) - 1, int(round(fraction * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def summarize(samples):
+    ordered = sorted(samples)
+    return OrderedDict([
+        ("runs", len(ordered)),
+        ("min", ordered[0]),
+        ("median", statistics.median(ordered)),
+        ("mean", statistics.mean(ordered)),
+        ("p95", percentile(ordered, 0.95)),
+        ("max", ordered[-1]),
+    ])
+
+
+def aggregate(lines):
+    """program -> label -> {'at': [...], 'step': [...]}"""
+    programs = OrderedDict()
+    for line in lines:
+        parsed = parse_line(line)
+        if parsed is None:
+            continue
+        program, run = parsed
+        labels = programs.setdefault(program, OrderedDict())
+
+        previous = 0
+        for label, value in run.items():
+            entry = labels.setdefault(label, {"at": [], "step": []})
+            entry["at"].append(value)
+            if label in ("exec->entry", "boot->entry"):
+                continue
+            entry["step"].append(value - previous)
+            previous = value
+    return programs
+
+
+def print_report(programs):
+    header = "%-24s %5s %10s %10s %10s %10s %10s %10s" % (
+        "point", "runs", "min", "median", "mean", "p95", "max", "step")
+    for program, labels in programs.items():
+        print("%s (times in us, relative to process entry)" % program)
+        print(header)
+        for label, entry in labels.items():
+            s = summarize(entry["at"])
+            step = "%10.0f" % statistics.median(entry["step"]) if entry["step"] else "%10s" % "-"
+            print("%-24s %5d %10d %10.0f %10.0f %10d %10d %s" % (
+                label, s["runs"], s["min"], s["median"], s["mean"], s["p95"], s["max"], step))
+        print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="*", help="trace logs (default: stdin)")
+    parser.add_argument("--json", action="store_true", help="print the summary as JSON")
+    args = parser.parse_args()
+
+    lines = []
+    if args.logs:
+        for path in args.logs:
+            with open(path, encoding="utf-8", errors="replace") as log:
+                lines.extend(log)
+    else:
+        lines = sys.stdin.readlines()
+
+    programs = aggregate(lines)
+    if not programs:
+        print("No startup-trace lines found", file=sys.stderr)
+        return 1
+
+    if args.json:
+        summary = OrderedDict()
+        for program, labels in programs.items():
+            summary[program] = OrderedDict(
+                (label, summarize(entry["at"])) for label, entry in labels.items())
+        json.dump(summary, sys.stdout, indent=2)
+        print()
+    else:
+        print_report(programs)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
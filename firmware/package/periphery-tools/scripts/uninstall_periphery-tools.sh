@@ -0,0 +1,6 @@
+#!/bin/bash
+echo "Removing periphery-tools and its applet links from target..."
+for applet in ioexample1 ioexample2 ioexample3 ioexample4 ioexample5 ioexample6 ioexample7 ioexample8 ioexample9 sleepexample hellomk; do
+    [ -L $(TARGET_DIR)/usr/bin/$applet ] && rm -f $(TARGET_DIR)/usr/bin/$applet
+done
+rm -f $(TARGET_DIR)/usr/bin/periphery-tools
@@ -0,0 +1,16 @@
+// include/libbench/load.h
+
+#ifndef LOAD_H
+#define LOAD_H
+
+/* Background stress threads, SCHED_OTHER regardless of the caller's policy */
+#define LOAD_CPU 0x01           /* Integer arithmetic spin */
+#define LOAD_IO 0x02            /* Write/fsync/read/unlink a scratch file */
+
+#define LOAD_IO_PATH "/tmp/sleepexample.load"
+
+/* Returns 0 on success, -1 on error with errno set */
+int load_start(unsigned int kinds);
+void load_stop(void);
+
+#endif // LOAD_H
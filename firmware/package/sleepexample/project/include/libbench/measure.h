@@ -0,0 +1,40 @@
+// include/libbench/measure.h
+
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <stdint.h>
+
+/* Raw timestamps, converted and printed only after a run */
+typedef struct measure_stamp {
+    int64_t mono_ns;            /* CLOCK_MONOTONIC */
+    int64_t real_ns;            /* CLOCK_REALTIME */
+    uint64_t cycles;            /* Cycle counter, 0 when none is available */
+} measure_stamp_t;
+
+/* Cost of taking the stamps themselves, measured by measure_calibrate() */
+typedef struct measure_overhead {
+    int64_t stamp_ns;           /* One measure_now() call */
+    int64_t mono_ns;            /* One clock_gettime(CLOCK_MONOTONIC) call */
+    uint64_t cycles;            /* One measure_now() call in cycles */
+} measure_overhead_t;
+
+/* Select the cycle counter. DWT CYCCNT on Cortex-M is only used when
+ * <allow_dwt> is set: it is reached through /dev/mem and faults unless the
+ * kernel lets user code access the private peripheral bus. */
+int measure_init(int allow_dwt);
+void measure_close(void);
+const char *measure_counter_name(void);
+
+void measure_now(measure_stamp_t *stamp);
+int64_t measure_mono_ns(void);
+
+void measure_calibrate(unsigned int rounds);
+const measure_overhead_t *measure_overhead(void);
+
+/* Intervals with the calibrated stamp overhead removed */
+int64_t measure_elapsed_mono_ns(const measure_stamp_t *start, const measure_stamp_t *end);
+int64_t measure_elapsed_real_ns(const measure_stamp_t *start, const measure_stamp_t *end);
+uint64_t measure_elapsed_cycles(const measure_stamp_t *start, const measure_stamp_t *end);
+
+#endif // MEASURE_H
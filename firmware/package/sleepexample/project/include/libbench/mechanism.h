@@ -0,0 +1,23 @@
+// include/libbench/mechanism.h
+
+#ifndef MECHANISM_H
+#define MECHANISM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* One way of blocking the calling thread for a given time */
+typedef struct sleep_mechanism {
+    const char *name;
+    uint64_t granularity_us;    /* Unit of the API timeout; other durations are skipped */
+    int (*setup)(void);         /* Create fds/condvars outside the timed region, may be NULL */
+    int (*sleep)(uint64_t us);  /* 0 on success, -1 on error */
+    void (*teardown)(void);     /* May be NULL */
+} sleep_mechanism_t;
+
+extern const sleep_mechanism_t sleep_mechanisms[];
+extern const size_t sleep_mechanism_count;
+
+const sleep_mechanism_t *sleep_mechanism_find(const char *name);
+
+#endif // MECHANISM_H
@@ -0,0 +1,45 @@
+// include/libbench/periodic.h
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "libbench/sweep.h"
+
+/* Latency histogram: 1 us buckets, anything above goes to overflow */
+#define PERIODIC_HIST_BUCKETS 1000
+
+typedef enum periodic_method {
+    PERIODIC_ABSTIME,           /* clock_nanosleep(TIMER_ABSTIME) on a running deadline */
+    PERIODIC_TIMERFD,           /* Periodic timerfd, blocking read() */
+} periodic_method_t;
+
+typedef struct periodic_config {
+    periodic_method_t method;
+    unsigned int rate_hz;
+    unsigned int seconds;
+    int priority;               /* SCHED_FIFO priority, 0 keeps SCHED_OTHER */
+} periodic_config_t;
+
+/* Filled by periodic_run() without allocating; large, keep it off small stacks */
+typedef struct periodic_result {
+    uint64_t iterations;
+    uint64_t overruns;          /* Whole periods missed */
+    int64_t min_ns;
+    int64_t max_ns;
+    int64_t sum_ns;
+    uint32_t histogram[PERIODIC_HIST_BUCKETS];
+    uint32_t overflow;
+} periodic_result_t;
+
+const char *periodic_method_name(periodic_method_t method);
+
+/* Returns 0 on success, -1 on error with errno set */
+int periodic_run(const periodic_config_t *config, periodic_result_t *result);
+
+void periodic_report(const periodic_config_t *config, const periodic_result_t *result,
+                     sweep_format_t format, int histogram, FILE *out);
+
+#endif // PERIODIC_H
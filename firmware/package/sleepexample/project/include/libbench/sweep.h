@@ -0,0 +1,27 @@
+// include/libbench/sweep.h
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef enum sweep_format {
+    SWEEP_FORMAT_CSV,
+    SWEEP_FORMAT_JSON,
+} sweep_format_t;
+
+typedef struct sweep_config {
+    uint64_t min_us;            /* First duration of the 1-2-5 sweep */
+    uint64_t max_us;            /* Last duration (inclusive) */
+    unsigned int repeats;       /* Measured calls per duration */
+    const char *mechanisms;     /* Comma-separated names, NULL for all */
+    sweep_format_t format;
+    FILE *out;
+} sweep_config_t;
+
+/* Run the sweep, writing one record per mechanism and duration.
+ * Returns 0 on success, -1 on invalid configuration. */
+int sweep_run(const sweep_config_t *config);
+
+#endif // SWEEP_H
@@ -0,0 +1,129 @@
+// src/libbench/load.c
+//
+// Background load for the periodic mode. Threads (not processes, there is
+// no fork() on no-MMU) are created with an explicit SCHED_OTHER policy so a
+// SCHED_FIFO caller never starves them into doing nothing.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "libbench/load.h"
+
+#define LOAD_STACK_SIZE (16 * 1024)
+#define LOAD_IO_BLOCK 4096
+#define LOAD_IO_BLOCKS 16
+
+static volatile int load_running;
+static pthread_t load_threads[2];
+static unsigned int load_thread_count;
+
+/* -------------------- Workers -------------------- */
+
+static void *cpu_worker(void *arg)
+{
+    volatile uint32_t x = 1;
+
+    (void)arg;
+    while (load_running)
+        for (int i = 0; i < 10000; i++)
+            x = x * 1664525u + 1013904223u;
+
+    return NULL;
+}
+
+static void *io_worker(void *arg)
+{
+    static char block[LOAD_IO_BLOCK];
+
+    (void)arg;
+    memset(block, 0xA5, sizeof(block));
+
+    while (load_running)
+    {
+        int fd = open(LOAD_IO_PATH, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0)
+            break;
+
+        for (int i = 0; i < LOAD_IO_BLOCKS && load_running; i++)
+            if (write(fd, block, sizeof(block)) != (ssize_t)sizeof(block))
+                break;
+        fsync(fd);
+
+        lseek(fd, 0, SEEK_SET);
+        while (load_running && read(fd, block, sizeof(block)) > 0)
+            ;
+
+        close(fd);
+        unlink(LOAD_IO_PATH);
+    }
+
+    return NULL;
+}
+
+/* -------------------- Control -------------------- */
+
+static int spawn(void *(*worker)(void *))
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    int ret;
+
+    memset(&param, 0, sizeof(param));
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, LOAD_STACK_SIZE);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    pthread_attr_setschedparam(&attr, &param);
+
+    ret = pthread_create(&load_threads[load_thread_count], &attr, worker, NULL);
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0)
+    {
+        errno = ret;
+        return -1;
+    }
+    load_thread_count++;
+    return 0;
+}
+
+/**
+ * @brief Start the requested load generators.
+ *
+ * @param kinds Mask of LOAD_CPU / LOAD_IO.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int load_start(unsigned int kinds)
+{
+    load_running = 1;
+
+    if ((kinds & LOAD_CPU) && spawn(cpu_worker) < 0)
+        goto fail;
+    if ((kinds & LOAD_IO) && spawn(io_worker) < 0)
+        goto fail;
+    return 0;
+
+fail:
+    {
+        int saved_errno = errno;
+        load_stop();
+        errno = saved_errno;
+    }
+    return -1;
+}
+
+/**
+ * @brief Stop and join all load generators.
+ */
+void load_stop(void)
+{
+    load_running = 0;
+    while (load_thread_count > 0)
+        pthread_join(load_threads[--load_thread_count], NULL);
+}
@@ -0,0 +1,251 @@
+// src/libbench/measure.c
+//
+// Timestamp capture for the sleep measurements. A stamp is three raw counter
+// reads and nothing else; formatting happens after the run. The calibration
+// step times back-to-back stamps so their own cost can be subtracted.
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "periphery/mmio.h"
+#include "libbench/measure.h"
+#include "libbench/stats.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+/* Cortex-M debug registers */
+#define DWT_BASE 0xE0001000u
+#define DWT_CTRL 0x000u
+#define DWT_CYCCNT 0x004u
+#define DWT_CTRL_CYCCNTENA (1u << 0)
+#define SCB_DEMCR_BASE 0xE000EDFCu
+#define DEMCR_TRCENA (1u << 24)
+
+typedef enum measure_counter {
+    MEASURE_COUNTER_NONE,
+    MEASURE_COUNTER_TSC,
+    MEASURE_COUNTER_CNTVCT,
+    MEASURE_COUNTER_DWT,
+} measure_counter_t;
+
+static measure_counter_t counter = MEASURE_COUNTER_NONE;
+static mmio_t *dwt;
+static volatile const uint32_t *cyccnt;
+static measure_overhead_t overhead;
+
+/* -------------------- Counter Selection -------------------- */
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+static int open_dwt(void)
+{
+    mmio_t *demcr = mmio_new();
+    uint32_t value;
+    int ret = -1;
+
+    dwt = mmio_new();
+    if (!dwt || !demcr)
+        goto out;
+
+    if (mmio_open(demcr, SCB_DEMCR_BASE, sizeof(uint32_t)) < 0 ||
+        mmio_open(dwt, DWT_BASE, DWT_CYCCNT + sizeof(uint32_t)) < 0)
+        goto out;
+
+    mmio_read32(demcr, 0, &value);
+    mmio_write32(demcr, 0, value | DEMCR_TRCENA);
+    mmio_read32(dwt, DWT_CTRL, &value);
+    mmio_write32(dwt, DWT_CTRL, value | DWT_CTRL_CYCCNTENA);
+
+    cyccnt = (volatile const uint32_t *)((uint8_t *)mmio_ptr(dwt) + DWT_CYCCNT);
+    ret = 0;
+
+out:
+    if (demcr)
+    {
+        mmio_close(demcr);
+        mmio_free(demcr);
+    }
+    if (ret < 0 && dwt)
+    {
+        mmio_close(dwt);
+        mmio_free(dwt);
+        dwt = NULL;
+    }
+    return ret;
+}
+#endif
+
+/**
+ * @brief Pick the best cycle counter for this CPU.
+ *
+ * @param allow_dwt Map DWT CYCCNT on Cortex-M (see measure.h).
+ * @return 0 when a cycle counter is in use, -1 when stamps carry clocks only.
+ */
+int measure_init(int allow_dwt)
+{
+    (void)allow_dwt;
+    counter = MEASURE_COUNTER_NONE;
+
+#if defined(__x86_64__) || defined(__i386__)
+    counter = MEASURE_COUNTER_TSC;
+#elif defined(__aarch64__)
+    counter = MEASURE_COUNTER_CNTVCT;
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+    if (allow_dwt && open_dwt() == 0)
+        counter = MEASURE_COUNTER_DWT;
+#endif
+
+    return counter == MEASURE_COUNTER_NONE ? -1 : 0;
+}
+
+void measure_close(void)
+{
+    if (dwt)
+    {
+        mmio_close(dwt);
+        mmio_free(dwt);
+    }
+    dwt = NULL;
+    cyccnt = NULL;
+    counter = MEASURE_COUNTER_NONE;
+}
+
+const char *measure_counter_name(void)
+{
+    switch (counter)
+    {
+    case MEASURE_COUNTER_TSC:
+        return "tsc";
+    case MEASURE_COUNTER_CNTVCT:
+        return "cntvct";
+    case MEASURE_COUNTER_DWT:
+        return "dwt-cyccnt";
+    default:
+        return "none";
+    }
+}
+
+/* -------------------- Capture -------------------- */
+
+static inline uint64_t read_cycles(void)
+{
+    switch (counter)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+    case MEASURE_COUNTER_TSC:
+        return __rdtsc();
+#elif defined(__aarch64__)
+    case MEASURE_COUNTER_CNTVCT:
+    {
+        uint64_t value;
+        __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+    }
+#endif
+    case MEASURE_COUNTER_DWT:
+        return *cyccnt;
+    default:
+        return 0;
+    }
+}
+
+static inline int64_t clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * @brief Take a raw stamp: counter reads only, no conversion or output.
+ */
+void measure_now(measure_stamp_t *stamp)
+{
+    stamp->cycles = read_cycles();
+    stamp->mono_ns = clock_ns(CLOCK_MONOTONIC);
+    stamp->real_ns = clock_ns(CLOCK_REALTIME);
+}
+
+int64_t measure_mono_ns(void)
+{
+    return clock_ns(CLOCK_MONOTONIC);
+}
+
+/* -------------------- Calibration -------------------- */
+
+/**
+ * @brief Measure the cost of taking stamps.
+ *
+ * The median of <rounds> back-to-back pairs is used so that an interrupt
+ * during calibration does not inflate the correction.
+ */
+void measure_calibrate(unsigned int rounds)
+{
+    int64_t *stamp_ns = malloc(rounds * sizeof(int64_t));
+    int64_t *mono_ns = malloc(rounds * sizeof(int64_t));
+    int64_t *cycles = malloc(rounds * sizeof(int64_t));
+    stats_summary_t summary;
+
+    memset(&overhead, 0, sizeof(overhead));
+    if (rounds == 0 || !stamp_ns || !mono_ns || !cycles)
+        goto out;
+
+    for (unsigned int i = 0; i < rounds; i++)
+    {
+        measure_stamp_t a, b;
+
+        measure_now(&a);
+        measure_now(&b);
+        stamp_ns[i] = b.mono_ns - a.mono_ns;
+        cycles[i] = (int64_t)(counter == MEASURE_COUNTER_DWT ? (uint32_t)(b.cycles - a.cycles)
+                                                              : b.cycles - a.cycles);
+
+        int64_t t0 = clock_ns(CLOCK_MONOTONIC);
+        int64_t t1 = clock_ns(CLOCK_MONOTONIC);
+        mono_ns[i] = t1 - t0;
+    }
+
+    stats_summarize(stamp_ns, rounds, &summary);
+    overhead.stamp_ns = summary.median;
+    stats_summarize(mono_ns, rounds, &summary);
+    overhead.mono_ns = summary.median;
+    stats_summarize(cycles, rounds, &summary);
+    overhead.cycles = (uint64_t)summary.median;
+
+out:
+    free(stamp_ns);
+    free(mono_ns);
+    free(cycles);
+}
+
+const measure_overhead_t *measure_overhead(void)
+{
+    return &overhead;
+}
+
+/* -------------------- Intervals -------------------- */
+
+int64_t measure_elapsed_mono_ns(const measure_stamp_t *start, const measure_stamp_t *end)
+{
+    return end->mono_ns - start->mono_ns - overhead.stamp_ns;
+}
+
+int64_t measure_elapsed_real_ns(const measure_stamp_t *start, const measure_stamp_t *end)
+{
+    return end->real_ns - start->real_ns - overhead.stamp_ns;
+}
+
+/**
+ * @brief Elapsed cycles; the 32-bit DWT counter wraps every 2^32 cycles
+ * (about 23 s at 180 MHz), longer intervals are not representable.
+ */
+uint64_t measure_elapsed_cycles(const measure_stamp_t *start, const measure_stamp_t *end)
+{
+    uint64_t delta = counter == MEASURE_COUNTER_DWT ? (uint32_t)(end->cycles - start->cycles)
+                                                    : end->cycles - start->cycles;
+    return delta > overhead.cycles ? delta - overhead.cycles : 0;
+}
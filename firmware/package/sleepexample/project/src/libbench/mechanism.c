@@ -0,0 +1,239 @@
+// src/libbench/mechanism.c
+//
+// Every sleep primitive the interactive tests exercise, behind one signature
+// so the sweep can time them identically. Descriptors, condition variables
+// and timers are created in setup() so only the blocking call is measured.
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "libbench/mechanism.h"
+
+#define NSEC_PER_SEC 1000000000L
+
+static struct timespec us_to_timespec(uint64_t us)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(us / 1000000);
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    return ts;
+}
+
+/* -------------------- Plain Sleeps -------------------- */
+
+static int do_sleep(uint64_t us)
+{
+    return sleep((unsigned int)(us / 1000000)) == 0 ? 0 : -1;
+}
+
+static int do_usleep(uint64_t us)
+{
+    /* usleep() is only specified below one second */
+    if (us >= 1000000)
+    {
+        struct timespec ts = us_to_timespec(us);
+        return nanosleep(&ts, NULL);
+    }
+    return usleep((useconds_t)us);
+}
+
+static int do_nanosleep(uint64_t us)
+{
+    struct timespec ts = us_to_timespec(us);
+    return nanosleep(&ts, NULL);
+}
+
+static int do_clock_nanosleep(uint64_t us)
+{
+    struct timespec ts = us_to_timespec(us);
+    int ret = clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
+    if (ret != 0)
+    {
+        errno = ret;
+        return -1;
+    }
+    return 0;
+}
+
+/* -------------------- I/O Multiplexing -------------------- */
+
+static int do_select(uint64_t us)
+{
+    struct timeval tv;
+    tv.tv_sec = (time_t)(us / 1000000);
+    tv.tv_usec = (suseconds_t)(us % 1000000);
+    return select(0, NULL, NULL, NULL, &tv) < 0 ? -1 : 0;
+}
+
+static int do_pselect(uint64_t us)
+{
+    struct timespec ts = us_to_timespec(us);
+    return pselect(0, NULL, NULL, NULL, &ts, NULL) < 0 ? -1 : 0;
+}
+
+static int do_poll(uint64_t us)
+{
+    return poll(NULL, 0, (int)(us / 1000)) < 0 ? -1 : 0;
+}
+
+static int epoll_fd = -1;
+
+static int epoll_setup(void)
+{
+    epoll_fd = epoll_create1(0);
+    return epoll_fd < 0 ? -1 : 0;
+}
+
+static int do_epoll(uint64_t us)
+{
+    struct epoll_event ev;
+    return epoll_wait(epoll_fd, &ev, 1, (int)(us / 1000)) < 0 ? -1 : 0;
+}
+
+static void epoll_teardown(void)
+{
+    close(epoll_fd);
+    epoll_fd = -1;
+}
+
+/* -------------------- Timers & Condition Variables -------------------- */
+
+static int timer_fd = -1;
+
+static int timerfd_setup(void)
+{
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    return timer_fd < 0 ? -1 : 0;
+}
+
+static int do_timerfd(uint64_t us)
+{
+    struct itimerspec its;
+    uint64_t expirations;
+
+    memset(&its, 0, sizeof(its));
+    its.it_value = us_to_timespec(us);
+
+    if (timerfd_settime(timer_fd, 0, &its, NULL) < 0)
+        return -1;
+    return read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations) ? 0 : -1;
+}
+
+static void timerfd_teardown(void)
+{
+    close(timer_fd);
+    timer_fd = -1;
+}
+
+static pthread_mutex_t cond_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond;
+
+static int cond_setup(void)
+{
+    pthread_condattr_t attr;
+    int ret;
+
+    if (pthread_condattr_init(&attr) != 0)
+        return -1;
+    ret = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (ret == 0)
+        ret = pthread_cond_init(&cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    if (ret != 0)
+    {
+        errno = ret;
+        return -1;
+    }
+    return 0;
+}
+
+static int do_cond_timedwait(uint64_t us)
+{
+    struct timespec deadline;
+    int ret;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t)(us / 1000000);
+    deadline.tv_nsec += (long)(us % 1000000) * 1000;
+    if (deadline.tv_nsec >= NSEC_PER_SEC)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= NSEC_PER_SEC;
+    }
+
+    pthread_mutex_lock(&cond_mutex);
+    do
+        ret = pthread_cond_timedwait(&cond, &cond_mutex, &deadline);
+    while (ret == 0); /* Spurious wakeup, nobody signals */
+    pthread_mutex_unlock(&cond_mutex);
+
+    if (ret != ETIMEDOUT)
+    {
+        errno = ret;
+        return -1;
+    }
+    return 0;
+}
+
+static void cond_teardown(void)
+{
+    pthread_cond_destroy(&cond);
+}
+
+/* -------------------- Busy Wait -------------------- */
+
+static int do_busy(uint64_t us)
+{
+    struct timespec start, now;
+    int64_t target = (int64_t)us * 1000;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &start) != 0)
+        return -1;
+
+    do
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    while ((int64_t)(now.tv_sec - start.tv_sec) * NSEC_PER_SEC + (now.tv_nsec - start.tv_nsec) < target);
+
+    return 0;
+}
+
+/* -------------------- Table -------------------- */
+
+const sleep_mechanism_t sleep_mechanisms[] = {
+    {"sleep",                  1000000, NULL,          do_sleep,           NULL},
+    {"usleep",                 1,       NULL,          do_usleep,          NULL},
+    {"nanosleep",              1,       NULL,          do_nanosleep,       NULL},
+    {"clock_nanosleep",        1,       NULL,          do_clock_nanosleep, NULL},
+    {"select",                 1,       NULL,          do_select,          NULL},
+    {"pselect",                1,       NULL,          do_pselect,         NULL},
+    {"poll",                   1000,    NULL,          do_poll,            NULL},
+    {"epoll_wait",             1000,    epoll_setup,   do_epoll,           epoll_teardown},
+    {"pthread_cond_timedwait", 1,       cond_setup,    do_cond_timedwait,  cond_teardown},
+    {"timerfd",                1,       timerfd_setup, do_timerfd,         timerfd_teardown},
+    {"busy",                   1,       NULL,          do_busy,            NULL},
+};
+
+const size_t sleep_mechanism_count = sizeof(sleep_mechanisms) / sizeof(sleep_mechanisms[0]);
+
+/**
+ * @brief Look up a mechanism by name.
+ *
+ * @return Descriptor, or NULL if @p name is unknown.
+ */
+const sleep_mechanism_t *sleep_mechanism_find(const char *name)
+{
+    for (size_t i = 0; i < sleep_mechanism_count; i++)
+        if (strcmp(sleep_mechanisms[i].name, name) == 0)
+            return &sleep_mechanisms[i];
+    return NULL;
+}
@@ -0,0 +1,256 @@
+// src/libbench/periodic.c
+//
+// cyclictest-style periodic loop. The thread wakes on an absolute schedule;
+// wakeup latency is the difference between the intended and the observed
+// wakeup time. The hot loop only reads the clock and updates counters in a
+// caller-provided result, so nothing allocates or prints while measuring.
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+
+#include "libbench/periodic.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+static int64_t timespec_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static struct timespec ns_timespec(int64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / NSEC_PER_SEC);
+    ts.tv_nsec = (long)(ns % NSEC_PER_SEC);
+    return ts;
+}
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec_ns(&ts);
+}
+
+const char *periodic_method_name(periodic_method_t method)
+{
+    return method == PERIODIC_TIMERFD ? "timerfd" : "abstime";
+}
+
+/* -------------------- Recording -------------------- */
+
+static void record(periodic_result_t *result, int64_t latency_ns)
+{
+    uint64_t bucket = latency_ns > 0 ? (uint64_t)latency_ns / 1000 : 0;
+
+    if (bucket < PERIODIC_HIST_BUCKETS)
+        result->histogram[bucket]++;
+    else
+        result->overflow++;
+
+    if (result->iterations == 0 || latency_ns < result->min_ns)
+        result->min_ns = latency_ns;
+    if (result->iterations == 0 || latency_ns > result->max_ns)
+        result->max_ns = latency_ns;
+    result->sum_ns += latency_ns;
+    result->iterations++;
+}
+
+/* -------------------- Loops -------------------- */
+
+/**
+ * @brief clock_nanosleep(TIMER_ABSTIME) loop.
+ *
+ * A wakeup later than a full period counts the missed periods as overruns
+ * and moves the schedule past them instead of firing a burst to catch up.
+ */
+static int run_abstime(int64_t period_ns, uint64_t count, periodic_result_t *result)
+{
+    int64_t next = now_ns() + period_ns;
+
+    while (result->iterations < count)
+    {
+        struct timespec deadline = ns_timespec(next);
+        int ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        if (ret == EINTR)
+            continue;
+        if (ret != 0)
+        {
+            errno = ret;
+            return -1;
+        }
+
+        int64_t latency = now_ns() - next;
+        record(result, latency);
+
+        int64_t missed = latency / period_ns;
+        result->overruns += (uint64_t)missed;
+        next += (missed + 1) * period_ns;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Periodic timerfd loop; the expiration count reports overruns.
+ */
+static int run_timerfd(int64_t period_ns, uint64_t count, periodic_result_t *result)
+{
+    struct itimerspec its;
+    int64_t expected = now_ns() + period_ns;
+    int ret = 0;
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (fd < 0)
+        return -1;
+
+    its.it_value = ns_timespec(expected);
+    its.it_interval = ns_timespec(period_ns);
+    if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+    {
+        ret = -1;
+        goto out;
+    }
+
+    while (result->iterations < count)
+    {
+        uint64_t expirations;
+        ssize_t n = read(fd, &expirations, sizeof(expirations));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n != sizeof(expirations))
+        {
+            ret = -1;
+            goto out;
+        }
+
+        /* Latency is measured against the most recent expiry */
+        expected += (int64_t)(expirations - 1) * period_ns;
+        record(result, now_ns() - expected);
+        result->overruns += expirations - 1;
+        expected += period_ns;
+    }
+
+out:
+    close(fd);
+    return ret;
+}
+
+/**
+ * @brief Run one periodic measurement.
+ *
+ * The calling thread is switched to SCHED_FIFO for the run when a priority
+ * is given and restored afterwards; memory is locked where supported.
+ *
+ * @return 0 on success, -1 on error with errno set (EPERM without privileges).
+ */
+int periodic_run(const periodic_config_t *config, periodic_result_t *result)
+{
+    struct sched_param saved_param, param;
+    int saved_policy;
+    int ret;
+
+    if (config->rate_hz == 0 || config->seconds == 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    memset(result, 0, sizeof(*result));
+
+    /* No-op on no-MMU kernels, avoids page faults in the loop elsewhere */
+    mlockall(MCL_CURRENT | MCL_FUTURE);
+
+    pthread_getschedparam(pthread_self(), &saved_policy, &saved_param);
+    if (config->priority > 0)
+    {
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = config->priority;
+        ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret != 0)
+        {
+            errno = ret;
+            return -1;
+        }
+    }
+
+    int64_t period_ns = NSEC_PER_SEC / config->rate_hz;
+    uint64_t count = (uint64_t)config->rate_hz * config->seconds;
+
+    if (config->method == PERIODIC_TIMERFD)
+        ret = run_timerfd(period_ns, count, result);
+    else
+        ret = run_abstime(period_ns, count, result);
+
+    int saved_errno = errno;
+    if (config->priority > 0)
+        pthread_setschedparam(pthread_self(), saved_policy, &saved_param);
+    munlockall();
+    errno = saved_errno;
+
+    return ret;
+}
+
+/* -------------------- Report -------------------- */
+
+/**
+ * @brief Print a run summary and optionally the non-empty histogram buckets.
+ *
+ * CSV output is one block per run; JSON output is one object per line.
+ */
+void periodic_report(const periodic_config_t *config, const periodic_result_t *result,
+                     sweep_format_t format, int histogram, FILE *out)
+{
+    double avg_us = result->iterations ? (double)result->sum_ns / result->iterations / 1e3 : 0.0;
+    const char *method = periodic_method_name(config->method);
+
+    if (format == SWEEP_FORMAT_CSV)
+    {
+        fprintf(out, "method,rate_hz,priority,iterations,overruns,min_us,avg_us,max_us,over_%uus\n",
+                PERIODIC_HIST_BUCKETS);
+        fprintf(out, "%s,%u,%d,%llu,%llu,%.3f,%.3f,%.3f,%u\n", method, config->rate_hz, config->priority,
+                (unsigned long long)result->iterations, (unsigned long long)result->overruns,
+                result->min_ns / 1e3, avg_us, result->max_ns / 1e3, result->overflow);
+
+        if (histogram)
+        {
+            fprintf(out, "latency_us,count\n");
+            for (unsigned int i = 0; i < PERIODIC_HIST_BUCKETS; i++)
+                if (result->histogram[i])
+                    fprintf(out, "%u,%u\n", i, result->histogram[i]);
+        }
+        fprintf(out, "\n");
+    }
+    else
+    {
+        fprintf(out, "{\"method\": \"%s\", \"rate_hz\": %u, \"priority\": %d, \"iterations\": %llu, "
+                     "\"overruns\": %llu, \"min_us\": %.3f, \"avg_us\": %.3f, \"max_us\": %.3f, "
+                     "\"overflow\": %u",
+                method, config->rate_hz, config->priority,
+                (unsigned long long)result->iterations, (unsigned long long)result->overruns,
+                result->min_ns / 1e3, avg_us, result->max_ns / 1e3, result->overflow);
+
+        if (histogram)
+        {
+            int first = 1;
+
+            fprintf(out, ", \"histogram_us\": {");
+            for (unsigned int i = 0; i < PERIODIC_HIST_BUCKETS; i++)
+            {
+                if (!result->histogram[i])
+                    continue;
+                fprintf(out, "%s\"%u\": %u", first ? "" : ", ", i, result->histogram[i]);
+                first = 0;
+            }
+            fprintf(out, "}");
+        }
+        fprintf(out, "}\n");
+    }
+    fflush(out);
+}
@@ -0,0 +1,251 @@
+// src/libbench/sweep.c
+//
+// Timer accuracy sweep: every mechanism is asked to sleep for a 1-2-5 series
+// of durations, N times each, and the overshoot (measured minus requested)
+// is summarised. Timestamps are taken directly around the blocking call, the
+// calibrated clock_gettime() cost is subtracted, and nothing is printed until
+// a duration has been fully measured.
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/utsname.h>
+
+#include "libbench/measure.h"
+#include "libbench/mechanism.h"
+#include "libbench/stats.h"
+#include "libbench/sweep.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+/* Result of one mechanism at one duration */
+typedef struct sweep_result {
+    const char *mechanism;
+    uint64_t requested_us;
+    unsigned int samples;
+    unsigned int errors;
+    stats_summary_t overshoot;  /* ns */
+    double cpu_ns;              /* Mean thread CPU time per call */
+} sweep_result_t;
+
+static int64_t timespec_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+/* -------------------- Selection -------------------- */
+
+/**
+ * @brief Check whether <name> appears in a comma-separated list.
+ */
+static int list_contains(const char *list, const char *name)
+{
+    size_t len = strlen(name);
+
+    if (!list)
+        return 1;
+
+    for (const char *p = list; *p;)
+    {
+        const char *end = strchr(p, ',');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+
+        if (n == len && strncmp(p, name, len) == 0)
+            return 1;
+        if (!end)
+            break;
+        p = end + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Next duration of the 1-2-5 series after <us>.
+ */
+static uint64_t next_duration(uint64_t us)
+{
+    uint64_t decade = 1;
+
+    while (decade * 10 <= us)
+        decade *= 10;
+
+    switch (us / decade)
+    {
+    case 1:
+        return 2 * decade;
+    case 2:
+        return 5 * decade;
+    default:
+        return 10 * decade;
+    }
+}
+
+/* -------------------- Output -------------------- */
+
+static void emit_header(const sweep_config_t *config)
+{
+    struct utsname uts;
+    struct timespec res = {0, 0};
+
+    if (uname(&uts) != 0)
+        memset(&uts, 0, sizeof(uts));
+    clock_getres(CLOCK_MONOTONIC, &res);
+
+    if (config->format == SWEEP_FORMAT_CSV)
+    {
+        fprintf(config->out, "# %s %s %s, CLOCK_MONOTONIC resolution %ld ns, overhead %lld ns, %u repeats\n",
+                uts.sysname, uts.release, uts.machine, res.tv_nsec,
+                (long long)measure_overhead()->mono_ns, config->repeats);
+        fprintf(config->out, "mechanism,requested_us,samples,errors,"
+                             "min_us,median_us,p99_us,max_us,mean_us,cpu_us\n");
+        return;
+    }
+
+    fprintf(config->out, "{\n  \"system\": {\"sysname\": \"%s\", \"release\": \"%s\", \"machine\": \"%s\"},\n",
+            uts.sysname, uts.release, uts.machine);
+    fprintf(config->out, "  \"clock_resolution_ns\": %ld,\n  \"clock_overhead_ns\": %lld,\n",
+            res.tv_nsec, (long long)measure_overhead()->mono_ns);
+    fprintf(config->out, "  \"repeats\": %u,\n  \"results\": [", config->repeats);
+}
+
+static void emit_result(const sweep_config_t *config, const sweep_result_t *r, int first)
+{
+    const stats_summary_t *s = &r->overshoot;
+
+    if (config->format == SWEEP_FORMAT_CSV)
+    {
+        fprintf(config->out, "%s,%llu,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                r->mechanism, (unsigned long long)r->requested_us, r->samples, r->errors,
+                s->min / 1e3, s->median / 1e3, s->p99 / 1e3, s->max / 1e3, s->mean / 1e3, r->cpu_ns / 1e3);
+    }
+    else
+    {
+        fprintf(config->out,
+                "%s\n    {\"mechanism\": \"%s\", \"requested_us\": %llu, \"samples\": %u, \"errors\": %u, "
+                "\"overshoot_us\": {\"min\": %.3f, \"median\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f}, "
+                "\"cpu_us\": %.3f}",
+                first ? "" : ",", r->mechanism, (unsigned long long)r->requested_us, r->samples, r->errors,
+                s->min / 1e3, s->median / 1e3, s->p99 / 1e3, s->max / 1e3, s->mean / 1e3, r->cpu_ns / 1e3);
+    }
+    fflush(config->out);
+}
+
+static void emit_footer(const sweep_config_t *config)
+{
+    if (config->format == SWEEP_FORMAT_JSON)
+        fprintf(config->out, "\n  ]\n}\n");
+    fflush(config->out);
+}
+
+/* -------------------- Measurement -------------------- */
+
+/**
+ * @brief Time <repeats> calls of one mechanism at one duration.
+ *
+ * One untimed warm-up call faults in code and settles the timer path.
+ */
+static void measure(const sleep_mechanism_t *mech, uint64_t us, unsigned int repeats,
+                    int64_t *samples, sweep_result_t *result)
+{
+    struct timespec c0, c1;
+    int64_t overhead = measure_overhead()->mono_ns;
+    int64_t cpu_total = 0;
+
+    memset(result, 0, sizeof(*result));
+    result->mechanism = mech->name;
+    result->requested_us = us;
+
+    mech->sleep(us);
+
+    for (unsigned int i = 0; i < repeats; i++)
+    {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c0);
+        int64_t t0 = measure_mono_ns();
+        int ret = mech->sleep(us);
+        int64_t t1 = measure_mono_ns();
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c1);
+
+        if (ret != 0)
+        {
+            result->errors++;
+            continue;
+        }
+
+        samples[result->samples++] = t1 - t0 - overhead - (int64_t)us * 1000;
+        cpu_total += timespec_ns(&c1) - timespec_ns(&c0);
+    }
+
+    stats_summarize(samples, result->samples, &result->overshoot);
+    if (result->samples)
+        result->cpu_ns = (double)cpu_total / result->samples;
+}
+
+/**
+ * @brief Run the sweep described by <config>.
+ *
+ * Results are written as soon as each duration finishes so that a long run
+ * on the target can be followed on the console.
+ *
+ * @return 0 on success, -1 on invalid configuration (errno EINVAL/ENOMEM).
+ */
+int sweep_run(const sweep_config_t *config)
+{
+    int64_t *samples;
+    int first = 1;
+
+    if (config->repeats == 0 || config->min_us == 0 || config->min_us > config->max_us)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (size_t i = 0; i < sleep_mechanism_count; i++)
+        if (list_contains(config->mechanisms, sleep_mechanisms[i].name))
+            goto selected;
+    errno = EINVAL;
+    return -1;
+
+selected:
+    samples = malloc(config->repeats * sizeof(samples[0]));
+    if (!samples)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    emit_header(config);
+
+    for (size_t i = 0; i < sleep_mechanism_count; i++)
+    {
+        const sleep_mechanism_t *mech = &sleep_mechanisms[i];
+
+        if (!list_contains(config->mechanisms, mech->name))
+            continue;
+
+        if (mech->setup && mech->setup() != 0)
+        {
+            fprintf(stderr, "%s: setup failed: %s\n", mech->name, strerror(errno));
+            continue;
+        }
+
+        for (uint64_t us = config->min_us; us <= config->max_us; us = next_duration(us))
+        {
+            sweep_result_t result;
+
+            if (us % mech->granularity_us != 0)
+                continue;
+
+            measure(mech, us, config->repeats, samples, &result);
+            emit_result(config, &result, first);
+            first = 0;
+        }
+
+        if (mech->teardown)
+            mech->teardown();
+    }
+
+    emit_footer(config);
+    free(samples);
+    return 0;
+}
@@ -14,101 +14,145 @@
 #include <pthread.h>
 #include <sys/timerfd.h>
 #include <fcntl.h>
+#include <termios.h>
+#include <sched.h>
+
+#include "libbench/load.h"
+#include "libbench/measure.h"
+#include "libbench/mechanism.h"
+#include "libbench/periodic.h"
+#include "libbench/sweep.h"
+#include "libevloop/evloop.h"
 
 static const uint64_t SLEEP_TIME_US = 5500000ULL;
 
+// Benchmark sweep defaults: 10 us .. 1 s in 1-2-5 steps
+#define BENCH_MIN_US 10
+#define BENCH_MAX_US 1000000
+#define BENCH_REPEATS 20
+
+// Back-to-back stamp pairs used to measure the timestamp overhead
+#define MEASURE_CALIBRATION_ROUNDS 1000
+
+// Periodic mode defaults
+#define PERIODIC_SECONDS 10
+#define PERIODIC_MAX_RATES 8
+
 typedef struct
 {
-    struct timespec mono; // clock_gettime(CLOCK_MONOTONIC, &mono)
-    struct timespec real; // clock_gettime(CLOCK_REALTIME, &real)
-    time_t time;          // time(&time)
+    measure_stamp_t stamp; // Raw CLOCK_MONOTONIC/CLOCK_REALTIME/cycle counter
+    time_t time;           // time(&time)
 } custom_time_t;
 
-// Print elapsed time helper
-void print_elapsed(custom_time_t start, custom_time_t end)
+// One completed test, formatted after all tests have run
+typedef struct
 {
-    double end_mono = (double)(end.mono.tv_sec) + (double)(end.mono.tv_nsec) / 1e9;
-    double start_mono = (double)(start.mono.tv_sec) + (double)(start.mono.tv_nsec) / 1e9;
+    const char *name;
+    custom_time_t start;
+    custom_time_t end;
+    const char *call; // Failed call, NULL on success
+    int error;        // errno/return code of the failed call
+} test_record_t;
 
-    double end_real = (double)(end.real.tv_sec) + (double)(end.real.tv_nsec) / 1e9;
-    double start_real = (double)(start.real.tv_sec) + (double)(start.real.tv_nsec) / 1e9;
+#define MAX_TEST_RECORDS 16
 
-    printf("Elapsed (MONOTONIC): %.6f seconds\n", end_mono - start_mono);
-    printf("Elapsed (REALTIME):  %.6f seconds\n", end_real - start_real);
-    printf("Elapsed (time):      %.6f seconds\n", difftime(end.time, start.time));
+static test_record_t records[MAX_TEST_RECORDS];
+static int record_count;
+
+// Print elapsed time helper
+void print_elapsed(const custom_time_t *start, const custom_time_t *end)
+{
+    printf("Elapsed (MONOTONIC): %.6f seconds\n", measure_elapsed_mono_ns(&start->stamp, &end->stamp) / 1e9);
+    printf("Elapsed (REALTIME):  %.6f seconds\n", measure_elapsed_real_ns(&start->stamp, &end->stamp) / 1e9);
+    printf("Elapsed (time):      %.6f seconds\n", difftime(end->time, start->time));
+    if (start->stamp.cycles || end->stamp.cycles)
+        printf("Elapsed (%s): %llu cycles\n", measure_counter_name(),
+               (unsigned long long)measure_elapsed_cycles(&start->stamp, &end->stamp));
 }
 
-// Print current time
-void print_current_time()
+// Print a CLOCK_REALTIME stamp as local time
+void print_stamp_time(const char *label, const custom_time_t *ts)
 {
     char buf[64];
-    time_t now = time(NULL);
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
-    printf("Current time: %s\n", buf);
+    time_t sec = (time_t)(ts->stamp.real_ns / 1000000000LL);
+    struct tm tm;
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime_r(&sec, &tm));
+    printf("%s %s.%06ld\n", label, buf, (long)(ts->stamp.real_ns % 1000000000LL / 1000));
 }
 
-// Capture timestamps
-void capture_timestamp(custom_time_t *ts)
+// Capture timestamps: raw counters only, nothing is formatted or printed
+static inline void capture_timestamp(custom_time_t *ts)
 {
-    if (!ts)
-        return;
-
-    print_current_time();
+    measure_now(&ts->stamp);
+    ts->time = time(NULL);
+}
 
-    if (clock_gettime(CLOCK_MONOTONIC, &ts->mono) != 0)
-        printf("clock_gettime(CLOCK_MONOTONIC) failed: %s\n", strerror(errno));
+// Store a finished test; <call> names the failed call or is NULL
+static void record_test(const char *name, const custom_time_t *start, const custom_time_t *end,
+                        const char *call, int error)
+{
+    if (record_count == MAX_TEST_RECORDS)
+        return;
 
-    if (clock_gettime(CLOCK_REALTIME, &ts->real) != 0)
-        printf("clock_gettime(CLOCK_REALTIME) failed: %s\n", strerror(errno));
+    test_record_t *r = &records[record_count++];
+    r->name = name;
+    r->start = *start;
+    r->end = *end;
+    r->call = call;
+    r->error = error;
+}
 
-    if (time(&ts->time) == ((time_t)-1))
-        printf("time() failed: %s\n", strerror(errno));
+void print_results(void)
+{
+    for (int i = 0; i < record_count; i++)
+    {
+        const test_record_t *r = &records[i];
+
+        printf("=== Testing %s ===\n", r->name);
+        print_stamp_time("Started:", &r->start);
+        print_stamp_time("Ended:  ", &r->end);
+        if (r->call)
+            printf("%s failed: %s\n", r->call, strerror(r->error));
+        print_elapsed(&r->start, &r->end);
+        printf("\n");
+    }
 }
 
 void test_sleep()
 {
-    printf("=== Testing sleep() ===\n");
     custom_time_t start, end;
     capture_timestamp(&start);
-    int ret = sleep(SLEEP_TIME_US / 1000000);
-    if (ret != 0)
-        printf("sleep returned early with %d seconds left\n", ret);
+    unsigned int left = sleep(SLEEP_TIME_US / 1000000);
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("sleep()", &start, &end, left ? "sleep (returned early)" : NULL, left ? EINTR : 0);
 }
 
 void test_usleep()
 {
-    printf("=== Testing usleep() ===\n");
     custom_time_t start, end;
     capture_timestamp(&start);
-    if (usleep(SLEEP_TIME_US) != 0)
-        printf("usleep failed: %s\n", strerror(errno));
+    int ret = usleep(SLEEP_TIME_US);
+    int err = errno;
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("usleep()", &start, &end, ret ? "usleep" : NULL, err);
 }
 
 void test_nanosleep()
 {
-    printf("=== Testing nanosleep() ===\n");
     struct timespec ts;
     ts.tv_sec = (SLEEP_TIME_US) / 1000000;
     ts.tv_nsec = 1000 * ((SLEEP_TIME_US) % 1000000);
 
     custom_time_t start, end;
     capture_timestamp(&start);
-    if (nanosleep(&ts, NULL) != 0)
-        printf("nanosleep failed: %s\n", strerror(errno));
+    int ret = nanosleep(&ts, NULL);
+    int err = errno;
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("nanosleep()", &start, &end, ret ? "nanosleep" : NULL, err);
 }
 
 void test_clock_nanosleep()
 {
-    printf("=== Testing clock_nanosleep() ===\n");
     struct timespec ts;
     ts.tv_sec = (SLEEP_TIME_US) / 1000000;
     ts.tv_nsec = 1000 * ((SLEEP_TIME_US) % 1000000);
@@ -116,16 +160,12 @@ void test_clock_nanosleep()
     custom_time_t start, end;
     capture_timestamp(&start);
     int ret = clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
-    if (ret != 0)
-        printf("clock_nanosleep failed: %s\n", strerror(ret));
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("clock_nanosleep()", &start, &end, ret ? "clock_nanosleep" : NULL, ret);
 }
 
 void test_select_delay()
 {
-    printf("=== Testing select() ===\n");
     struct timeval tv;
     tv.tv_sec = SLEEP_TIME_US / 1000000;
     tv.tv_usec = SLEEP_TIME_US % 1000000;
@@ -133,49 +173,41 @@ void test_select_delay()
     custom_time_t start, end;
     capture_timestamp(&start);
     int ret = select(0, NULL, NULL, NULL, &tv);
-    if (ret < 0)
-        printf("select failed: %s\n", strerror(errno));
+    int err = errno;
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("select()", &start, &end, ret < 0 ? "select" : NULL, err);
 }
 
 void test_poll()
 {
-    printf("=== Testing poll() ===\n");
     custom_time_t start, end;
     capture_timestamp(&start);
     int ret = poll(NULL, 0, SLEEP_TIME_US / 1000);
-    if (ret < 0)
-        printf("poll failed: %s\n", strerror(errno));
+    int err = errno;
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("poll()", &start, &end, ret < 0 ? "poll" : NULL, err);
 }
 
 void test_epoll()
 {
-    printf("=== Testing epoll_wait() ===\n");
     int epfd = epoll_create1(0);
     if (epfd == -1)
     {
         printf("epoll_create1 failed: %s\n", strerror(errno));
         return;
     }
+    struct epoll_event ev;
     custom_time_t start, end;
     capture_timestamp(&start);
-    int ret = epoll_wait(epfd, NULL, 0, SLEEP_TIME_US / 1000);
-    if (ret < 0)
-        printf("epoll_wait failed: %s\n", strerror(errno));
+    int ret = epoll_wait(epfd, &ev, 1, SLEEP_TIME_US / 1000);
+    int err = errno;
     capture_timestamp(&end);
     close(epfd);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("epoll_wait()", &start, &end, ret < 0 ? "epoll_wait" : NULL, err);
 }
 
 void test_pselect()
 {
-    printf("=== Testing pselect() ===\n");
     struct timespec timeout;
     timeout.tv_sec = (SLEEP_TIME_US) / 1000000;
     timeout.tv_nsec = 1000 * ((SLEEP_TIME_US) % 1000000);
@@ -183,17 +215,13 @@ void test_pselect()
     custom_time_t start, end;
     capture_timestamp(&start);
     int ret = pselect(0, NULL, NULL, NULL, &timeout, NULL);
-    if (ret < 0)
-        printf("pselect failed: %s\n", strerror(errno));
+    int err = errno;
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("pselect()", &start, &end, ret < 0 ? "pselect" : NULL, err);
 }
 
 void test_pthread_cond_timedwait()
 {
-    printf("=== Testing pthread_cond_timedwait() ===\n");
-
     pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
     pthread_condattr_t attr;
     pthread_cond_t cond;
@@ -226,20 +254,17 @@ void test_pthread_cond_timedwait()
     custom_time_t start, end;
     capture_timestamp(&start);
     int ret = pthread_cond_timedwait(&cond, &mutex, &future);
-    if (ret != 0 && ret != ETIMEDOUT)
-        printf("pthread_cond_timedwait failed: %s\n", strerror(ret));
     capture_timestamp(&end);
 
     pthread_mutex_unlock(&mutex);
     pthread_cond_destroy(&cond);
 
-    print_elapsed(start, end);
-    printf("\n");
+    int failed = ret != 0 && ret != ETIMEDOUT;
+    record_test("pthread_cond_timedwait()", &start, &end, failed ? "pthread_cond_timedwait" : NULL, ret);
 }
 
 void test_timerfd()
 {
-    printf("=== Testing timerfd_settime() ===\n");
     int tfd = timerfd_create(CLOCK_MONOTONIC, 0);
     if (tfd == -1)
     {
@@ -265,50 +290,33 @@ void test_timerfd()
 
     uint64_t expirations;
     ssize_t s = read(tfd, &expirations, sizeof(expirations));
-    if (s == -1)
-        printf("read(timerfd) failed: %s\n", strerror(errno));
-    else if (s != sizeof(expirations))
-        printf("read(timerfd) returned unexpected size: %zd\n", s);
+    int err = s < 0 ? errno : EIO;
 
     capture_timestamp(&end);
     close(tfd);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("timerfd_settime()", &start, &end, s != sizeof(expirations) ? "read(timerfd)" : NULL, err);
 }
 
 void test_busy_sleep(void)
 {
-    printf("=== Testing busy sleep with clock_gettime(CLOCK_MONOTONIC) ===\n");
     custom_time_t start, end;
     capture_timestamp(&start);
     struct timespec sleep_start, now;
     int ret = clock_gettime(CLOCK_MONOTONIC, &sleep_start);
-    if (ret != 0)
-        printf("clock_gettime failed: %s\n", strerror(errno));
-    else
-        printf("CLOCK_MONOTONIC start: %lld.%09ld\n",
-               (long long)sleep_start.tv_sec, sleep_start.tv_nsec);
+    int err = errno;
 
-    do
+    if (ret == 0)
     {
-        ret = clock_gettime(CLOCK_MONOTONIC, &now);
-        if (ret != 0)
+        do
         {
-            printf("clock_gettime failed during busy loop: %s\n", strerror(errno));
-            break;
-        }
-    } while ((now.tv_sec - sleep_start.tv_sec) < (SLEEP_TIME_US / 1000000));
-
-    ret = clock_gettime(CLOCK_MONOTONIC, &now);
-    if (ret != 0)
-        printf("clock_gettime failed: %s\n", strerror(errno));
-    else
-        printf("CLOCK_MONOTONIC end: %lld.%09ld\n",
-               (long long)now.tv_sec, now.tv_nsec);
+            ret = clock_gettime(CLOCK_MONOTONIC, &now);
+            err = errno;
+        } while (ret == 0 && (now.tv_sec - sleep_start.tv_sec) < (SLEEP_TIME_US / 1000000));
+    }
 
     capture_timestamp(&end);
-    print_elapsed(start, end);
-    printf("\n");
+    record_test("busy sleep with clock_gettime(CLOCK_MONOTONIC)", &start, &end,
+                ret != 0 ? "clock_gettime" : NULL, err);
 }
 
 int test_set_system_time(int year, int mon, int day, int hour, int min, int sec)
@@ -392,9 +400,152 @@ void test_set_time_hwclock(void)
     printf("\n");
 }
 
-int main()
+static int parse_uint(const char *str, unsigned long *value)
+{
+    char *endptr;
+    errno = 0;
+    unsigned long val = strtoul(str, &endptr, 10);
+    if (errno || *endptr != '\0' || str[0] == '-')
+        return -1;
+    *value = val;
+    return 0;
+}
+
+static void print_help(const char *progname)
+{
+    printf("\nUsage: %s [options]\n", progname);
+    printf("  (no options) Run the interactive sleep/time tests\n");
+    printf("  -b           Run the timer accuracy sweep instead\n");
+    printf("  -n <n>       Repeats per duration (default %u)\n", BENCH_REPEATS);
+    printf("  -l <us>      Shortest duration (default %u)\n", BENCH_MIN_US);
+    printf("  -u <us>      Longest duration (default %u)\n", BENCH_MAX_US);
+    printf("  -m <list>    Comma-separated mechanisms (default all)\n");
+    printf("  -f csv|json  Output format (default csv)\n");
+    printf("  -o <file>    Write results to a file instead of stdout\n");
+    printf("  -p <hz,...>  Run periodic loops at these rates instead\n");
+    printf("  -M <method>  abstime, timerfd or both (default both)\n");
+    printf("  -P <prio>    SCHED_FIFO priority, 0 for SCHED_OTHER (default 0)\n");
+    printf("  -d <s>       Seconds per periodic run (default %u)\n", PERIODIC_SECONDS);
+    printf("  -L <list>    Background load while looping: cpu,io\n");
+    printf("  -H           Include the 1 us latency histogram\n");
+    printf("  -E <n>       Benchmark the evloop timer wheel with n timers\n");
+    printf("  -C           Use the Cortex-M DWT cycle counter via /dev/mem\n");
+    printf("               (faults unless user code may access the PPB)\n");
+    printf("--------------------------------------------------------\n");
+    printf("Mechanisms:");
+    for (size_t i = 0; i < sleep_mechanism_count; i++)
+        printf("%s %s", i % 4 ? "" : "\n ", sleep_mechanisms[i].name);
+    printf("\n");
+    printf("The sweep reports min/median/p99/max overshoot and the\n");
+    printf("CPU time per call for every mechanism and duration.\n");
+    printf("Periodic mode reports wakeup latency and overruns\n");
+    printf("(cyclictest-style, one CSV block or JSON line per run).\n");
+    printf("--------------------------------------------------------\n\n");
+}
+
+/**
+ * @brief Parse a comma-separated list of rates in Hz.
+ *
+ * @return Number of rates, or -1 on invalid input.
+ */
+static int parse_rates(const char *str, unsigned int *rates, int max)
 {
-    printf("Starting sleep/time tests with detailed error logging\n\n");
+    char buf[128];
+    int count = 0;
+
+    if (strlen(str) >= sizeof(buf))
+        return -1;
+    strcpy(buf, str);
+
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ","))
+    {
+        unsigned long value;
+        if (count == max || parse_uint(tok, &value) < 0 || value == 0 || value > 1000000)
+            return -1;
+        rates[count++] = (unsigned int)value;
+    }
+    return count;
+}
+
+/**
+ * @brief Parse a background load list ("cpu", "io", "cpu,io").
+ *
+ * @return LOAD_* mask, or -1 on invalid input.
+ */
+static int parse_load(const char *str)
+{
+    char buf[32];
+    int kinds = 0;
+
+    if (strlen(str) >= sizeof(buf))
+        return -1;
+    strcpy(buf, str);
+
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ","))
+    {
+        if (strcmp(tok, "cpu") == 0)
+            kinds |= LOAD_CPU;
+        else if (strcmp(tok, "io") == 0)
+            kinds |= LOAD_IO;
+        else
+            return -1;
+    }
+    return kinds;
+}
+
+/**
+ * @brief Run every requested method at every rate.
+ */
+static int run_periodic(periodic_config_t *config, const unsigned int *rates, int rate_count,
+                        int methods, unsigned int load, sweep_format_t format, int histogram, FILE *out)
+{
+    // Too large for the small thread stacks on no-MMU targets
+    static periodic_result_t result;
+    int ret = 0;
+
+    if (load && load_start(load) < 0)
+    {
+        fprintf(stderr, "Failed to start load generators: %s\n", strerror(errno));
+        return -1;
+    }
+
+    for (int i = 0; i < rate_count && ret == 0; i++)
+    {
+        for (int m = PERIODIC_ABSTIME; m <= PERIODIC_TIMERFD && ret == 0; m++)
+        {
+            if (!(methods & (1 << m)))
+                continue;
+
+            config->method = (periodic_method_t)m;
+            config->rate_hz = rates[i];
+            fprintf(stderr, "Running %s at %u Hz for %u s...\n",
+                    periodic_method_name(config->method), config->rate_hz, config->seconds);
+
+            ret = periodic_run(config, &result);
+            if (ret < 0)
+                fprintf(stderr, "Periodic run failed: %s\n", strerror(errno));
+            else
+                periodic_report(config, &result, format, histogram, out);
+        }
+    }
+
+    if (load)
+        load_stop();
+    return ret;
+}
+
+static void run_tests(void)
+{
+    const measure_overhead_t *overhead = measure_overhead();
+
+    printf("Starting sleep/time tests with detailed error logging\n");
+    printf("Timestamp overhead: %lld ns per stamp, %llu cycles (%s)\n",
+           (long long)overhead->stamp_ns, (unsigned long long)overhead->cycles, measure_counter_name());
+    printf("Running 11 sleep tests of %.1f s each, results follow...\n\n", SLEEP_TIME_US / 1e6);
+    fflush(stdout);
+
+    // Let the UART drain before the first measurement
+    tcdrain(STDOUT_FILENO);
 
     test_sleep();
     test_usleep();
@@ -408,12 +559,179 @@ int main()
     test_timerfd();
     test_busy_sleep();
 
+    print_results();
+
     // Set system time to a fixed date/time (example: 2020-01-01 12:00:00)
     test_set_system_time(2020, 1, 1, 12, 0, 0);
     test_set_system_settimeofday(2020, 1, 1, 12, 0, 0);
     test_set_time_hwclock();
 
     printf("Tests completed.\n");
+}
 
-    return 0;
+int main(int argc, char *argv[])
+{
+    sweep_config_t config = {
+        .min_us = BENCH_MIN_US,
+        .max_us = BENCH_MAX_US,
+        .repeats = BENCH_REPEATS,
+        .mechanisms = NULL,
+        .format = SWEEP_FORMAT_CSV,
+        .out = stdout,
+    };
+    periodic_config_t periodic = {
+        .seconds = PERIODIC_SECONDS,
+        .priority = 0,
+    };
+    unsigned int rates[PERIODIC_MAX_RATES];
+    int rate_count = 0;
+    int methods = 1 << PERIODIC_ABSTIME | 1 << PERIODIC_TIMERFD;
+    int load = 0;
+    int histogram = 0;
+    int allow_dwt = 0;
+    const char *output = NULL;
+    unsigned long value;
+    int bench = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "bn:l:u:m:f:o:p:M:P:d:L:HE:Ch")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            bench = 1;
+            break;
+        case 'n':
+            if (parse_uint(optarg, &value) < 0 || value == 0 || value > 1000000)
+            {
+                fprintf(stderr, "Invalid repeat count: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            config.repeats = (unsigned int)value;
+            break;
+        case 'l':
+        case 'u':
+            if (parse_uint(optarg, &value) < 0 || value == 0)
+            {
+                fprintf(stderr, "Invalid duration: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            if (opt == 'l')
+                config.min_us = value;
+            else
+                config.max_us = value;
+            break;
+        case 'm':
+            config.mechanisms = optarg;
+            break;
+        case 'f':
+            if (strcmp(optarg, "csv") == 0)
+                config.format = SWEEP_FORMAT_CSV;
+            else if (strcmp(optarg, "json") == 0)
+                config.format = SWEEP_FORMAT_JSON;
+            else
+            {
+                fprintf(stderr, "Unknown format: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'p':
+            rate_count = parse_rates(optarg, rates, PERIODIC_MAX_RATES);
+            if (rate_count <= 0)
+            {
+                fprintf(stderr, "Invalid rate list: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'M':
+            if (strcmp(optarg, "abstime") == 0)
+                methods = 1 << PERIODIC_ABSTIME;
+            else if (strcmp(optarg, "timerfd") == 0)
+                methods = 1 << PERIODIC_TIMERFD;
+            else if (strcmp(optarg, "both") == 0)
+                methods = 1 << PERIODIC_ABSTIME | 1 << PERIODIC_TIMERFD;
+            else
+            {
+                fprintf(stderr, "Unknown method: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'P':
+            if (parse_uint(optarg, &value) < 0 || (int)value > sched_get_priority_max(SCHED_FIFO))
+            {
+                fprintf(stderr, "Invalid priority: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            periodic.priority = (int)value;
+            break;
+        case 'd':
+            if (parse_uint(optarg, &value) < 0 || value == 0)
+            {
+                fprintf(stderr, "Invalid duration: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            periodic.seconds = (unsigned int)value;
+            break;
+        case 'L':
+            load = parse_load(optarg);
+            if (load < 0)
+            {
+                fprintf(stderr, "Invalid load list: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'H':
+            histogram = 1;
+            break;
+        case 'E':
+            if (parse_uint(optarg, &value) < 0 || value == 0 || value > 1000000)
+            {
+                fprintf(stderr, "Invalid timer count: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            return evloop_bench((unsigned int)value) < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+        case 'C':
+            allow_dwt = 1;
+            break;
+        default:
+            print_help(argv[0]);
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    measure_init(allow_dwt);
+    measure_calibrate(MEASURE_CALIBRATION_ROUNDS);
+
+    if (!bench && rate_count == 0)
+    {
+        run_tests();
+        return 0;
+    }
+
+    if (output && !(config.out = fopen(output, "w")))
+    {
+        fprintf(stderr, "%s: %s\n", output, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    int ret;
+    if (rate_count > 0)
+    {
+        ret = run_periodic(&periodic, rates, rate_count, methods, (unsigned int)load,
+                           config.format, histogram, config.out);
+    }
+    else
+    {
+        ret = sweep_run(&config);
+        if (ret < 0)
+            fprintf(stderr, "Benchmark failed: %s (check -l/-u/-m)\n", strerror(errno));
+    }
+
+    if (output)
+        fclose(config.out);
+
+    return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,38 @@
+// include/fb/framebuffer.h
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "image/image.h"
+
+/* Memory-mapped framebuffer, either an fbdev node or a plain file */
+typedef struct framebuffer {
+    int fd;
+    uint8_t *mem;               /* Whole mapping */
+    size_t size;
+    uint8_t *visible;           /* First pixel of the visible area */
+    uint16_t *rows;             /* Three RGB565 scratch rows */
+    unsigned int width;
+    unsigned int height;
+    unsigned int bpp;           /* 16 (RGB565) or 32 (XRGB8888) */
+    unsigned int stride;        /* Bytes per line */
+    bool is_file;
+} framebuffer_t;
+
+#define FB_ALPHA_MAX 32         /* Crossfade weight for the target image */
+
+/* Open and map <path>. If it is not an fbdev node, it is treated as a raw
+ * file of width x height x bpp, created or resized as needed. */
+int fb_open(framebuffer_t *fb, const char *path, unsigned int width, unsigned int height, unsigned int bpp);
+void fb_close(framebuffer_t *fb);
+
+void fb_clear(framebuffer_t *fb);
+void fb_blit(framebuffer_t *fb, const image_t *img);
+void fb_crossfade(framebuffer_t *fb, const image_t *from, const image_t *to, unsigned int alpha);
+int fb_stream(framebuffer_t *fb, const char *path, unsigned int weight);
+
+#endif // FRAMEBUFFER_H
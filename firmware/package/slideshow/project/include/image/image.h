@@ -0,0 +1,78 @@
+// include/image/image.h
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* PNG decoding is compiled in with SLIDESHOW_PNG=1; without it only
+ * pre-converted .rgb565 files load */
+#ifndef SLIDESHOW_PNG
+#define SLIDESHOW_PNG 0
+#endif
+
+/* Decoded image in the panel's native RGB565 format, rows packed */
+typedef struct image {
+    unsigned int width;
+    unsigned int height;
+    uint16_t *pixels;
+} image_t;
+
+/*
+ * Pre-converted RGB565 asset (.rgb565), produced at build time by png2rgb565.
+ * A 16-byte little-endian header is followed by <height> rows of pixels,
+ * either raw or RLE-compressed. RLE packets never span rows: a 16-bit word
+ * with bit 15 set repeats the following pixel (count - 1 in bits 0..14),
+ * otherwise that many literal pixels follow.
+ */
+#define IMAGE_RGB565_MAGIC "R565"
+#define IMAGE_RGB565_VERSION 1
+#define IMAGE_RGB565_FLAG_RLE 0x01
+#define IMAGE_RGB565_RUN 0x8000
+#define IMAGE_RGB565_MAX_PACKET 0x8000
+
+typedef struct image_rgb565_header {
+    char magic[4];
+    uint16_t width;
+    uint16_t height;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t payload_size;      /* Bytes following the header */
+} image_rgb565_header_t;
+
+/* Row-by-row reader for .rgb565 files, no full-image buffer */
+typedef struct image_stream {
+    FILE *fp;
+    image_rgb565_header_t header;
+    unsigned int width;
+    unsigned int height;
+    unsigned int row;           /* Next row to decode */
+} image_stream_t;
+
+/* Decode an image file, dispatching on its extension. Returns 0 on success,
+ * -1 on error (including unsupported formats). */
+int image_load(const char *path, image_t *img);
+void image_free(image_t *img);
+size_t image_size(const image_t *img);
+
+/* Format-specific loaders */
+#if SLIDESHOW_PNG
+int image_load_png(const char *path, image_t *img);
+#endif
+int image_load_rgb565(const char *path, image_t *img);
+
+/* Streaming .rgb565 decoder */
+int image_stream_open(image_stream_t *stream, const char *path);
+int image_stream_read_row(image_stream_t *stream, uint16_t *dst);
+void image_stream_close(image_stream_t *stream);
+
+/* Pack 8-bit RGB into RGB565 */
+static inline uint16_t image_rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+#endif // IMAGE_H
@@ -0,0 +1,340 @@
+// src/fb/framebuffer.c
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+
+#include "fb/framebuffer.h"
+
+/* -------------------- Open & Close -------------------- */
+
+/**
+ * @brief Open and memory-map a framebuffer.
+ *
+ * @param fb Framebuffer to fill.
+ * @param path fbdev node (e.g. /dev/fb0) or a regular file.
+ * @param width Width of a file-backed framebuffer, ignored for fbdev.
+ * @param height Height of a file-backed framebuffer, ignored for fbdev.
+ * @param bpp Bits per pixel of a file-backed framebuffer, ignored for fbdev.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int fb_open(framebuffer_t *fb, const char *path, unsigned int width, unsigned int height, unsigned int bpp)
+{
+    struct fb_var_screeninfo var;
+    struct fb_fix_screeninfo fix;
+    size_t offset = 0;
+    int saved_errno;
+
+    memset(fb, 0, sizeof(*fb));
+
+    fb->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fb->fd < 0)
+        return -1;
+
+    if (ioctl(fb->fd, FBIOGET_VSCREENINFO, &var) == 0 && ioctl(fb->fd, FBIOGET_FSCREENINFO, &fix) == 0)
+    {
+        fb->width = var.xres;
+        fb->height = var.yres;
+        fb->bpp = var.bits_per_pixel;
+        fb->stride = fix.line_length;
+        fb->size = fix.smem_len;
+        offset = (size_t)var.yoffset * fix.line_length + (size_t)var.xoffset * (var.bits_per_pixel / 8);
+    }
+    else
+    {
+        /* Plain file standing in for the panel on a host */
+        if (width == 0 || height == 0)
+        {
+            errno = EINVAL;
+            goto fail;
+        }
+
+        fb->is_file = true;
+        fb->width = width;
+        fb->height = height;
+        fb->bpp = bpp;
+        fb->stride = width * (bpp / 8);
+        fb->size = (size_t)fb->stride * height;
+
+        if (ftruncate(fb->fd, (off_t)fb->size) < 0)
+            goto fail;
+    }
+
+    if (fb->bpp != 16 && fb->bpp != 32)
+    {
+        errno = ENOTSUP;
+        goto fail;
+    }
+
+    fb->rows = malloc(3 * fb->width * sizeof(uint16_t));
+    if (!fb->rows)
+        goto fail;
+
+    fb->mem = mmap(NULL, fb->size, PROT_READ | PROT_WRITE, MAP_SHARED, fb->fd, 0);
+    if (fb->mem == MAP_FAILED)
+    {
+        fb->mem = NULL;
+        goto fail;
+    }
+    fb->visible = fb->mem + offset;
+
+    return 0;
+
+fail:
+    saved_errno = errno;
+    free(fb->rows);
+    close(fb->fd);
+    fb->rows = NULL;
+    fb->fd = -1;
+    errno = saved_errno;
+    return -1;
+}
+
+/**
+ * @brief Unmap and close a framebuffer.
+ */
+void fb_close(framebuffer_t *fb)
+{
+    if (fb->mem)
+        munmap(fb->mem, fb->size);
+    if (fb->fd >= 0)
+        close(fb->fd);
+    free(fb->rows);
+
+    fb->mem = NULL;
+    fb->visible = NULL;
+    fb->rows = NULL;
+    fb->fd = -1;
+}
+
+/* -------------------- Row Helpers -------------------- */
+
+/**
+ * @brief Centre a source row of <width> pixels horizontally on the panel.
+ *
+ * Rows that already match the panel width are returned in place; anything
+ * else is clipped or padded with black into <scratch>.
+ *
+ * @return Pointer to fb->width RGB565 pixels.
+ */
+static const uint16_t *fb_place_row(const framebuffer_t *fb, const uint16_t *src, unsigned int width, uint16_t *scratch)
+{
+    if (width == fb->width)
+        return src;
+
+    int dx = ((int)fb->width - (int)width) / 2;
+    unsigned int n = width < fb->width ? width : fb->width;
+
+    memset(scratch, 0, fb->width * sizeof(uint16_t));
+    if (dx >= 0)
+        memcpy(scratch + dx, src, n * sizeof(uint16_t));
+    else
+        memcpy(scratch, src - dx, n * sizeof(uint16_t));
+
+    return scratch;
+}
+
+/**
+ * @brief Get line <y> of an image centred on the panel.
+ *
+ * @return Pointer to fb->width RGB565 pixels.
+ */
+static const uint16_t *fb_image_row(const framebuffer_t *fb, const image_t *img, unsigned int y, uint16_t *scratch)
+{
+    int sy = (int)y - ((int)fb->height - (int)img->height) / 2;
+
+    if (sy < 0 || sy >= (int)img->height)
+    {
+        memset(scratch, 0, fb->width * sizeof(uint16_t));
+        return scratch;
+    }
+
+    return fb_place_row(fb, img->pixels + (size_t)sy * img->width, img->width, scratch);
+}
+
+/**
+ * @brief Blend two RGB565 pixels, <wb> out of FB_ALPHA_MAX towards <b>.
+ *
+ * Spreading a pixel over a 32-bit word as 00000GGGGGG00000RRRRR000000BBBBB
+ * (mask 0x07E0F81F) leaves enough headroom to scale all three channels by a
+ * 5-bit weight with one multiply.
+ */
+static inline uint16_t fb_blend565(uint16_t a, uint16_t b, uint32_t wb)
+{
+    uint32_t pa = (a | (uint32_t)a << 16) & 0x07E0F81Fu;
+    uint32_t pb = (b | (uint32_t)b << 16) & 0x07E0F81Fu;
+    uint32_t p = ((pa * (FB_ALPHA_MAX - wb) + pb * wb) >> 5) & 0x07E0F81Fu;
+
+    return (uint16_t)(p | p >> 16);
+}
+
+/**
+ * @brief Read one panel row back as RGB565.
+ */
+static const uint16_t *fb_read_row(const framebuffer_t *fb, unsigned int y, uint16_t *scratch)
+{
+    const uint8_t *src = fb->visible + (size_t)y * fb->stride;
+
+    if (fb->bpp == 16)
+        return (const uint16_t *)src;
+
+    const uint32_t *src32 = (const uint32_t *)src;
+    for (unsigned int x = 0; x < fb->width; x++)
+        scratch[x] = image_rgb565((uint8_t)(src32[x] >> 16), (uint8_t)(src32[x] >> 8), (uint8_t)src32[x]);
+
+    return scratch;
+}
+
+/**
+ * @brief Write one RGB565 row to the panel.
+ *
+ * Native 16 bpp panels get a single memcpy per row (the same unit a DMA2D
+ * memory-to-memory transfer would use); 32 bpp host framebuffers are expanded.
+ */
+static void fb_write_row(framebuffer_t *fb, unsigned int y, const uint16_t *row)
+{
+    uint8_t *dst = fb->visible + (size_t)y * fb->stride;
+
+    if (fb->bpp == 16)
+    {
+        memcpy(dst, row, fb->width * sizeof(uint16_t));
+        return;
+    }
+
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (unsigned int x = 0; x < fb->width; x++)
+    {
+        uint32_t c = row[x];
+        uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        dst32[x] = (r << 19 | r << 14) & 0xFF0000u;
+        dst32[x] |= (g << 10 | g << 4) & 0x00FF00u;
+        dst32[x] |= (b << 3 | b >> 2);
+    }
+}
+
+/* -------------------- Drawing -------------------- */
+
+/**
+ * @brief Fill the visible area with black.
+ */
+void fb_clear(framebuffer_t *fb)
+{
+    for (unsigned int y = 0; y < fb->height; y++)
+        memset(fb->visible + (size_t)y * fb->stride, 0, fb->width * (fb->bpp / 8));
+}
+
+/**
+ * @brief Draw an image centred on the panel.
+ */
+void fb_blit(framebuffer_t *fb, const image_t *img)
+{
+    for (unsigned int y = 0; y < fb->height; y++)
+        fb_write_row(fb, y, fb_image_row(fb, img, y, fb->rows));
+}
+
+/**
+ * @brief Draw one crossfade frame.
+ *
+ * @param fb Framebuffer.
+ * @param from Image fading out.
+ * @param to Image fading in.
+ * @param alpha Weight of @p to, 0..FB_ALPHA_MAX.
+ */
+void fb_crossfade(framebuffer_t *fb, const image_t *from, const image_t *to, unsigned int alpha)
+{
+    uint16_t *out = fb->rows + 2 * fb->width;
+
+    for (unsigned int y = 0; y < fb->height; y++)
+    {
+        const uint16_t *a = fb_image_row(fb, from, y, fb->rows);
+        const uint16_t *b = fb_image_row(fb, to, y, fb->rows + fb->width);
+
+        for (unsigned int x = 0; x < fb->width; x++)
+            out[x] = fb_blend565(a[x], b[x], alpha);
+
+        fb_write_row(fb, y, out);
+    }
+}
+
+/**
+ * @brief Stream a .rgb565 file onto the panel without decoding it to memory.
+ *
+ * With @p weight == FB_ALPHA_MAX the image replaces the panel contents; when
+ * its rows match a 16 bpp panel they are decoded directly into the mapped
+ * framebuffer. Smaller weights blend the image over what is already shown,
+ * which lets a sequence of frames crossfade with only row-sized buffers.
+ *
+ * @param fb Framebuffer.
+ * @param path .rgb565 file.
+ * @param weight Weight of the streamed image, 0..FB_ALPHA_MAX.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int fb_stream(framebuffer_t *fb, const char *path, unsigned int weight)
+{
+    image_stream_t stream;
+    uint16_t *row;
+    int ret = 0;
+
+    if (image_stream_open(&stream, path) < 0)
+        return -1;
+
+    row = malloc(stream.width * sizeof(uint16_t));
+    if (!row)
+    {
+        image_stream_close(&stream);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    int oy = ((int)fb->height - (int)stream.height) / 2;
+    bool direct = fb->bpp == 16 && stream.width == fb->width && weight >= FB_ALPHA_MAX;
+
+    /* Rows above the panel when the image is taller */
+    for (int sy = 0; sy < -oy && ret == 0; sy++)
+        ret = image_stream_read_row(&stream, row);
+
+    for (unsigned int y = 0; y < fb->height && ret == 0; y++)
+    {
+        int sy = (int)y - oy;
+        const uint16_t *src;
+
+        if (sy < 0 || sy >= (int)stream.height)
+        {
+            memset(fb->rows, 0, fb->width * sizeof(uint16_t));
+            src = fb->rows;
+        }
+        else if (direct)
+        {
+            ret = image_stream_read_row(&stream, (uint16_t *)(fb->visible + (size_t)y * fb->stride));
+            continue;
+        }
+        else
+        {
+            ret = image_stream_read_row(&stream, row);
+            src = fb_place_row(fb, row, stream.width, fb->rows);
+        }
+
+        if (ret == 0 && weight < FB_ALPHA_MAX)
+        {
+            const uint16_t *cur = fb_read_row(fb, y, fb->rows + fb->width);
+            uint16_t *out = fb->rows + 2 * fb->width;
+
+            for (unsigned int x = 0; x < fb->width; x++)
+                out[x] = fb_blend565(cur[x], src[x], weight);
+            src = out;
+        }
+
+        if (ret == 0)
+            fb_write_row(fb, y, src);
+    }
+
+    free(row);
+    image_stream_close(&stream);
+    return ret;
+}
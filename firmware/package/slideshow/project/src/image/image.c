@@ -0,0 +1,51 @@
+// src/image/image.c
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include "image/image.h"
+
+/**
+ * @brief Decode an image file into RGB565.
+ *
+ * @param path Image file path.
+ * @param img Image to fill; pixels are heap allocated.
+ * @return 0 on success, -1 on error with errno set (ENOTSUP for unknown formats).
+ */
+int image_load(const char *path, image_t *img)
+{
+    const char *ext = strrchr(path, '.');
+
+    memset(img, 0, sizeof(*img));
+
+#if SLIDESHOW_PNG
+    if (ext && strcasecmp(ext, ".png") == 0)
+        return image_load_png(path, img);
+#endif
+    if (ext && strcasecmp(ext, ".rgb565") == 0)
+        return image_load_rgb565(path, img);
+
+    errno = ENOTSUP;
+    return -1;
+}
+
+/**
+ * @brief Release the pixel buffer of an image.
+ */
+void image_free(image_t *img)
+{
+    free(img->pixels);
+    img->pixels = NULL;
+    img->width = 0;
+    img->height = 0;
+}
+
+/**
+ * @brief Bytes held by the decoded pixels.
+ */
+size_t image_size(const image_t *img)
+{
+    return (size_t)img->width * img->height * sizeof(uint16_t);
+}
@@ -0,0 +1,101 @@
+// src/image/image_png.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <png.h>
+
+#include "image/image.h"
+
+/**
+ * @brief Decode a PNG file into RGB565.
+ *
+ * Palette, grayscale and 16-bit images are normalised to 8-bit RGBA by
+ * libpng; alpha is composited onto black. Rows are decoded one at a time
+ * so the only full-size buffer is the RGB565 result.
+ *
+ * @param path PNG file path.
+ * @param img Image to fill.
+ * @return 0 on success, -1 on error.
+ */
+int image_load_png(const char *path, image_t *img)
+{
+    png_structp png = NULL;
+    png_infop info = NULL;
+    uint8_t *volatile row = NULL;
+    uint16_t *volatile pixels = NULL;
+    FILE *fp;
+
+    fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (png)
+        info = png_create_info_struct(png);
+    if (!png || !info)
+    {
+        png_destroy_read_struct(&png, NULL, NULL);
+        fclose(fp);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /* libpng reports decode errors by longjmp()ing back here */
+    if (setjmp(png_jmpbuf(png)))
+    {
+        free(row);
+        free(pixels);
+        png_destroy_read_struct(&png, &info, NULL);
+        fclose(fp);
+        errno = EINVAL;
+        return -1;
+    }
+
+    png_init_io(png, fp);
+    png_read_info(png, info);
+
+    if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE)
+        png_error(png, "interlaced PNGs are not supported");
+
+    png_set_expand(png);
+    png_set_strip_16(png);
+    png_set_gray_to_rgb(png);
+    png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+    png_read_update_info(png, info);
+
+    unsigned int width = png_get_image_width(png, info);
+    unsigned int height = png_get_image_height(png, info);
+
+    row = malloc(png_get_rowbytes(png, info));
+    pixels = malloc((size_t)width * height * sizeof(uint16_t));
+    if (!row || !pixels)
+        png_error(png, "out of memory");
+
+    for (unsigned int y = 0; y < height; y++)
+    {
+        uint16_t *dst = pixels + (size_t)y * width;
+        const uint8_t *src = row;
+
+        png_read_row(png, row, NULL);
+
+        for (unsigned int x = 0; x < width; x++, src += 4)
+        {
+            unsigned int a = src[3];
+            dst[x] = image_rgb565((uint8_t)(src[0] * a / 255),
+                                  (uint8_t)(src[1] * a / 255),
+                                  (uint8_t)(src[2] * a / 255));
+        }
+    }
+
+    png_read_end(png, NULL);
+    png_destroy_read_struct(&png, &info, NULL);
+    free(row);
+    fclose(fp);
+
+    img->width = width;
+    img->height = height;
+    img->pixels = pixels;
+    return 0;
+}
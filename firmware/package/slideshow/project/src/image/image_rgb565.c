@@ -0,0 +1,161 @@
+// src/image/image_rgb565.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "image/image.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The .rgb565 format is read in place and assumes a little-endian CPU"
+#endif
+
+_Static_assert(sizeof(image_rgb565_header_t) == 16, "unexpected .rgb565 header layout");
+
+/* -------------------- Streaming Decoder -------------------- */
+
+/**
+ * @brief Open a .rgb565 file and validate its header.
+ *
+ * @param stream Stream to initialize.
+ * @param path File path.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int image_stream_open(image_stream_t *stream, const char *path)
+{
+    image_rgb565_header_t *hdr = &stream->header;
+
+    memset(stream, 0, sizeof(*stream));
+
+    stream->fp = fopen(path, "rb");
+    if (!stream->fp)
+        return -1;
+
+    if (fread(hdr, sizeof(*hdr), 1, stream->fp) != 1 ||
+        memcmp(hdr->magic, IMAGE_RGB565_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->version != IMAGE_RGB565_VERSION || hdr->width == 0 || hdr->height == 0)
+    {
+        fclose(stream->fp);
+        stream->fp = NULL;
+        errno = EINVAL;
+        return -1;
+    }
+
+    stream->width = hdr->width;
+    stream->height = hdr->height;
+    return 0;
+}
+
+/**
+ * @brief Decode the next row.
+ *
+ * Literal pixels are read straight into @p dst, so passing a framebuffer
+ * line decodes the image without any intermediate copy.
+ *
+ * @param stream Open stream.
+ * @param dst Destination for stream->width pixels.
+ * @return 0 on success, -1 on truncated or corrupt data (errno EINVAL).
+ */
+int image_stream_read_row(image_stream_t *stream, uint16_t *dst)
+{
+    unsigned int width = stream->width;
+
+    if (stream->row >= stream->height)
+        goto corrupt;
+
+    if (!(stream->header.flags & IMAGE_RGB565_FLAG_RLE))
+    {
+        if (fread(dst, sizeof(uint16_t), width, stream->fp) != width)
+            goto corrupt;
+        stream->row++;
+        return 0;
+    }
+
+    for (unsigned int x = 0; x < width;)
+    {
+        uint16_t packet;
+
+        if (fread(&packet, sizeof(packet), 1, stream->fp) != 1)
+            goto corrupt;
+
+        unsigned int count = (packet & (IMAGE_RGB565_RUN - 1)) + 1;
+        if (count > width - x)
+            goto corrupt;
+
+        if (packet & IMAGE_RGB565_RUN)
+        {
+            uint16_t pixel;
+
+            if (fread(&pixel, sizeof(pixel), 1, stream->fp) != 1)
+                goto corrupt;
+            for (unsigned int i = 0; i < count; i++)
+                dst[x + i] = pixel;
+        }
+        else if (fread(&dst[x], sizeof(uint16_t), count, stream->fp) != count)
+        {
+            goto corrupt;
+        }
+
+        x += count;
+    }
+
+    stream->row++;
+    return 0;
+
+corrupt:
+    errno = EINVAL;
+    return -1;
+}
+
+/**
+ * @brief Close a stream.
+ */
+void image_stream_close(image_stream_t *stream)
+{
+    if (stream->fp)
+        fclose(stream->fp);
+    stream->fp = NULL;
+}
+
+/* -------------------- Full Image Loader -------------------- */
+
+/**
+ * @brief Decode a whole .rgb565 file into memory.
+ *
+ * @param path File path.
+ * @param img Image to fill.
+ * @return 0 on success, -1 on error with errno set.
+ */
+int image_load_rgb565(const char *path, image_t *img)
+{
+    image_stream_t stream;
+
+    if (image_stream_open(&stream, path) < 0)
+        return -1;
+
+    uint16_t *pixels = malloc((size_t)stream.width * stream.height * sizeof(uint16_t));
+    if (!pixels)
+    {
+        image_stream_close(&stream);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (unsigned int y = 0; y < stream.height; y++)
+    {
+        if (image_stream_read_row(&stream, pixels + (size_t)y * stream.width) < 0)
+        {
+            free(pixels);
+            image_stream_close(&stream);
+            return -1;
+        }
+    }
+
+    img->width = stream.width;
+    img->height = stream.height;
+    img->pixels = pixels;
+
+    image_stream_close(&stream);
+    return 0;
+}
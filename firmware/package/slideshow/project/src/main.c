@@ -0,0 +1,408 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "fb/framebuffer.h"
+#include "image/image.h"
+
+/* -------------------- Configuration -------------------- */
+#define FB_DEVICE "/dev/fb0"
+#define IMAGE_DIR "/usr/share/images"
+#define IMAGE_MAX 32
+#define SHOW_SECONDS 5
+#define FADE_MS 500
+#define FILE_WIDTH 240           /* Geometry of a file-backed framebuffer */
+#define FILE_HEIGHT 320
+#define FILE_BPP 16
+
+/* -------------------- Timing Statistics -------------------- */
+
+typedef struct frame_stats {
+    unsigned long frames;
+    double total;
+    double min;
+    double max;
+} frame_stats_t;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_signal(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+/**
+ * @brief Read CLOCK_MONOTONIC in seconds.
+ */
+static double monotonic_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void stats_add(frame_stats_t *stats, double seconds)
+{
+    if (stats->frames == 0 || seconds < stats->min)
+        stats->min = seconds;
+    if (seconds > stats->max)
+        stats->max = seconds;
+    stats->total += seconds;
+    stats->frames++;
+}
+
+static void stats_print(const char *name, const frame_stats_t *stats)
+{
+    if (stats->frames == 0)
+        return;
+
+    printf("  %-16s %6lu frames | avg %7.2f ms | min %7.2f ms | max %7.2f ms\n",
+           name, stats->frames, stats->total / stats->frames * 1e3, stats->min * 1e3, stats->max * 1e3);
+}
+
+/**
+ * @brief Print the memory lines of /proc/self/status.
+ *
+ * MMU kernels report VmRSS/VmHWM; no-MMU kernels report Mem/Slack instead.
+ */
+static void print_memory_usage(void)
+{
+    char line[128];
+    FILE *fp = fopen("/proc/self/status", "r");
+
+    if (!fp)
+        return;
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (strncmp(line, "VmHWM", 5) == 0 || strncmp(line, "VmRSS", 5) == 0 ||
+            strncmp(line, "Mem:", 4) == 0 || strncmp(line, "Slack:", 6) == 0)
+            printf("  %s", line);
+    }
+
+    fclose(fp);
+}
+
+/* -------------------- Utility Functions -------------------- */
+
+/**
+ * @brief Parse an unsigned command-line value.
+ *
+ * @param str Input string.
+ * @param value Pointer to store the parsed value.
+ * @return 0 on success, -1 on invalid input.
+ */
+static int parse_uint(const char *str, unsigned long *value)
+{
+    char *endptr;
+    errno = 0;
+    unsigned long val = strtoul(str, &endptr, 10);
+    if (errno || *endptr != '\0' || str[0] == '-')
+        return -1;
+    *value = val;
+    return 0;
+}
+
+/**
+ * @brief Sleep for a number of milliseconds unless a stop is requested.
+ */
+static void sleep_ms(unsigned long ms)
+{
+    struct timespec ts = {.tv_sec = (time_t)(ms / 1000), .tv_nsec = (long)(ms % 1000) * 1000000L};
+
+    while (!stop_requested && nanosleep(&ts, &ts) < 0 && errno == EINTR)
+        ;
+}
+
+static int compare_names(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* One slideshow entry: decoded pixels, or just the path when streaming */
+typedef struct slide {
+    char path[256];
+    image_t image;
+} slide_t;
+
+/**
+ * @brief Check whether a file name ends with the given extension.
+ */
+static int has_extension(const char *name, const char *ext)
+{
+    const char *dot = strrchr(name, '.');
+    return dot && strcmp(dot, ext) == 0;
+}
+
+/**
+ * @brief Collect the images in a directory, in name order.
+ *
+ * In cached mode every supported image is decoded once into RAM. In
+ * streaming mode only pre-converted .rgb565 files are kept and nothing is
+ * decoded until it is drawn.
+ *
+ * @return Number of slides.
+ */
+static int load_slides(const char *dir, slide_t *slides, int max_slides, int stream)
+{
+    char *names[IMAGE_MAX];
+    int count = 0;
+    int loaded = 0;
+    struct dirent *entry;
+    DIR *dp = opendir(dir);
+
+    if (!dp)
+    {
+        fprintf(stderr, "opendir(%s): %s\n", dir, strerror(errno));
+        return 0;
+    }
+
+    while ((entry = readdir(dp)) != NULL && count < max_slides)
+    {
+        if (entry->d_name[0] != '.')
+            names[count++] = strdup(entry->d_name);
+    }
+    closedir(dp);
+
+    qsort(names, count, sizeof(names[0]), compare_names);
+
+    for (int i = 0; i < count; i++)
+    {
+        slide_t *slide = &slides[loaded];
+        double start = monotonic_seconds();
+
+        snprintf(slide->path, sizeof(slide->path), "%s/%s", dir, names[i]);
+        memset(&slide->image, 0, sizeof(slide->image));
+
+        if (stream)
+        {
+            if (has_extension(names[i], ".rgb565"))
+                loaded++;
+        }
+        else if (image_load(slide->path, &slide->image) == 0)
+        {
+            printf("Loaded %s (%ux%u, %zu KiB, %.1f ms)\n", slide->path, slide->image.width, slide->image.height,
+                   image_size(&slide->image) / 1024, (monotonic_seconds() - start) * 1e3);
+            loaded++;
+        }
+        else if (errno != ENOTSUP)
+        {
+            fprintf(stderr, "[WARN] Skipping %s: %s\n", slide->path, strerror(errno));
+        }
+        free(names[i]);
+    }
+
+    return loaded;
+}
+
+/**
+ * @brief Draw a slide, replacing the panel contents.
+ */
+static void show_slide(framebuffer_t *fb, slide_t *slide, int stream)
+{
+    if (!stream)
+        fb_blit(fb, &slide->image);
+    else if (fb_stream(fb, slide->path, FB_ALPHA_MAX) < 0)
+        fprintf(stderr, "[WARN] %s: %s\n", slide->path, strerror(errno));
+}
+
+/**
+ * @brief Crossfade from one slide to the next over <fade_ms>.
+ *
+ * Renders as many frames as the CPU allows. Cached slides are mixed from
+ * their decoded pixels. Streamed slides are blended over the panel contents;
+ * the per-frame weight w = (a - shown) / (1 - shown) keeps the on-screen mix
+ * following the same linear ramp without holding either image in RAM.
+ */
+static void crossfade_slides(framebuffer_t *fb, slide_t *from, slide_t *to, unsigned long fade_ms,
+                             int stream, frame_stats_t *stats)
+{
+    double start = monotonic_seconds();
+    double shown = 0.0;
+    double elapsed;
+
+    while (!stop_requested && (elapsed = monotonic_seconds() - start) * 1e3 < (double)fade_ms)
+    {
+        double target = elapsed * 1e3 / (double)fade_ms;
+        double t0 = monotonic_seconds();
+
+        if (!stream)
+        {
+            fb_crossfade(fb, &from->image, &to->image, (unsigned int)(target * FB_ALPHA_MAX));
+        }
+        else
+        {
+            if (shown >= 1.0)
+                break;
+
+            unsigned int weight = (unsigned int)((target - shown) / (1.0 - shown) * FB_ALPHA_MAX + 0.5);
+
+            if (weight == 0)
+                continue;
+            if (fb_stream(fb, to->path, weight) < 0)
+                break;
+            shown += (1.0 - shown) * weight / FB_ALPHA_MAX;
+        }
+
+        stats_add(stats, monotonic_seconds() - t0);
+    }
+}
+
+/**
+ * @brief Parse a WxH or WxHxBPP geometry string.
+ */
+static int parse_geometry(const char *str, unsigned int *width, unsigned int *height, unsigned int *bpp)
+{
+    int n = sscanf(str, "%ux%ux%u", width, height, bpp);
+    return (n == 2 || n == 3) && *width > 0 && *height > 0 ? 0 : -1;
+}
+
+static void print_help(const char *progname)
+{
+    printf("\nUsage: %s [options]\n", progname);
+    printf("  -d <path>  Framebuffer device or raw file (default %s)\n", FB_DEVICE);
+    printf("  -i <dir>   Image directory (default %s)\n", IMAGE_DIR);
+    printf("  -t <s>     Seconds per image (default %u)\n", SHOW_SECONDS);
+    printf("  -f <ms>    Crossfade duration, 0 for hard cuts (default %u)\n", FADE_MS);
+    printf("  -n <n>     Stop after n cycles, 0 runs forever (default 0)\n");
+    printf("  -g <WxH[xBPP]> Geometry when -d is a plain file (default %ux%ux%u)\n", FILE_WIDTH, FILE_HEIGHT, FILE_BPP);
+    printf("  -S         Stream .rgb565 files from disk instead of caching\n");
+    printf("--------------------------------------------------------\n");
+    printf("Decodes all images once into RGB565, then blits and\n");
+    printf("crossfades them on the memory-mapped framebuffer. With -S,\n");
+    printf("pre-converted images are decoded row by row at draw time.\n");
+    printf("--------------------------------------------------------\n\n");
+}
+
+/* -------------------- Main Program -------------------- */
+
+int main(int argc, char *argv[])
+{
+    const char *device = FB_DEVICE;
+    const char *image_dir = IMAGE_DIR;
+    unsigned long show_seconds = SHOW_SECONDS;
+    unsigned long fade_ms = FADE_MS;
+    unsigned long cycles = 0;
+    unsigned int file_width = FILE_WIDTH, file_height = FILE_HEIGHT, file_bpp = FILE_BPP;
+    int stream = 0;
+    static slide_t slides[IMAGE_MAX];
+    framebuffer_t fb;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:i:t:f:n:g:Sh")) != -1)
+    {
+        unsigned long val;
+
+        switch (opt)
+        {
+        case 't':
+        case 'f':
+        case 'n':
+            if (parse_uint(optarg, &val) < 0)
+            {
+                fprintf(stderr, "Invalid value for -%c: '%s'\n", opt, optarg);
+                return EXIT_FAILURE;
+            }
+            if (opt == 't')
+                show_seconds = val;
+            else if (opt == 'f')
+                fade_ms = val;
+            else
+                cycles = val;
+            break;
+        case 'd':
+            device = optarg;
+            break;
+        case 'i':
+            image_dir = optarg;
+            break;
+        case 'g':
+            if (parse_geometry(optarg, &file_width, &file_height, &file_bpp) < 0)
+            {
+                fprintf(stderr, "Invalid geometry: '%s'\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'S':
+            stream = 1;
+            break;
+        default:
+            print_help(argv[0]);
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    if (fb_open(&fb, device, file_width, file_height, file_bpp) < 0)
+    {
+        fprintf(stderr, "fb_open(%s): %s\n", device, strerror(errno));
+        return EXIT_FAILURE;
+    }
+    printf("Framebuffer %s: %ux%u, %u bpp, stride %u%s\n", device, fb.width, fb.height, fb.bpp, fb.stride,
+           fb.is_file ? " (file)" : "");
+
+    int count = load_slides(image_dir, slides, IMAGE_MAX, stream);
+    if (count == 0)
+    {
+        fprintf(stderr, "No %simages found in %s\n", stream ? ".rgb565 " : "", image_dir);
+        fb_close(&fb);
+        return EXIT_FAILURE;
+    }
+
+    size_t cache_bytes = 0;
+    for (int i = 0; i < count; i++)
+        cache_bytes += image_size(&slides[i].image);
+
+    frame_stats_t blit_stats = {0};
+    frame_stats_t fade_stats = {0};
+    int current = 0;
+    double t0;
+
+    fb_clear(&fb);
+    t0 = monotonic_seconds();
+    show_slide(&fb, &slides[current], stream);
+    stats_add(&blit_stats, monotonic_seconds() - t0);
+
+    for (unsigned long cycle = 0; !stop_requested && (cycles == 0 || cycle < cycles);)
+    {
+        sleep_ms(show_seconds * 1000);
+        if (stop_requested)
+            break;
+
+        int next = (current + 1) % count;
+
+        if (fade_ms > 0 && count > 1)
+            crossfade_slides(&fb, &slides[current], &slides[next], fade_ms, stream, &fade_stats);
+
+        t0 = monotonic_seconds();
+        show_slide(&fb, &slides[next], stream);
+        stats_add(&blit_stats, monotonic_seconds() - t0);
+
+        current = next;
+        if (current == 0)
+            cycle++;
+    }
+
+    printf("\nFrame times:\n");
+    stats_print(stream ? "stream blit" : "blit", &blit_stats);
+    stats_print("crossfade", &fade_stats);
+    printf("Memory:\n");
+    printf("  decoded images   %zu KiB (%d images)\n", cache_bytes / 1024, count);
+    printf("  framebuffer map  %zu KiB\n", fb.size / 1024);
+    print_memory_usage();
+
+    for (int i = 0; i < count; i++)
+        image_free(&slides[i].image);
+    fb_close(&fb);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+// tools/png2rgb565.c
+//
+// Build-host converter from PNG to the slideshow's .rgb565 format. It shares
+// the PNG decoder with the target binary so both produce identical pixels.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <zlib.h>
+
+#include "image/image.h"
+
+/* -------------------- Configuration -------------------- */
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 320
+
+/* -------------------- Output Buffer -------------------- */
+
+typedef struct out_buffer {
+    uint8_t *data;
+    size_t len;
+    size_t cap;
+} out_buffer_t;
+
+static int out_append(out_buffer_t *out, const void *data, size_t len)
+{
+    if (out->len + len > out->cap)
+    {
+        size_t cap = out->cap ? out->cap * 2 : 64 * 1024;
+        while (cap < out->len + len)
+            cap *= 2;
+
+        uint8_t *grown = realloc(out->data, cap);
+        if (!grown)
+            return -1;
+        out->data = grown;
+        out->cap = cap;
+    }
+
+    memcpy(out->data + out->len, data, len);
+    out->len += len;
+    return 0;
+}
+
+static int out_append_u16(out_buffer_t *out, uint16_t value)
+{
+    uint8_t le[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+    return out_append(out, le, sizeof(le));
+}
+
+/* -------------------- Encoding -------------------- */
+
+/**
+ * @brief Centre an image on a black panel-sized canvas.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int fit_to_panel(const image_t *src, image_t *dst, unsigned int width, unsigned int height)
+{
+    dst->width = width;
+    dst->height = height;
+    dst->pixels = calloc((size_t)width * height, sizeof(uint16_t));
+    if (!dst->pixels)
+        return -1;
+
+    int dx = ((int)width - (int)src->width) / 2;
+    int dy = ((int)height - (int)src->height) / 2;
+
+    for (unsigned int y = 0; y < height; y++)
+    {
+        int sy = (int)y - dy;
+        if (sy < 0 || sy >= (int)src->height)
+            continue;
+
+        for (unsigned int x = 0; x < width; x++)
+        {
+            int sx = (int)x - dx;
+            if (sx >= 0 && sx < (int)src->width)
+                dst->pixels[(size_t)y * width + x] = src->pixels[(size_t)sy * src->width + sx];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Length of the run of identical pixels starting at <x>.
+ */
+static unsigned int run_length(const uint16_t *row, unsigned int x, unsigned int width)
+{
+    unsigned int n = 1;
+
+    while (x + n < width && n < IMAGE_RGB565_MAX_PACKET && row[x + n] == row[x])
+        n++;
+    return n;
+}
+
+/**
+ * @brief RLE-encode one row; packets never cross the row boundary.
+ *
+ * Runs shorter than 3 pixels cost more as a run packet than as literals, so
+ * they are folded into the surrounding literal packet.
+ */
+static int encode_row_rle(out_buffer_t *out, const uint16_t *row, unsigned int width)
+{
+    unsigned int x = 0;
+
+    while (x < width)
+    {
+        unsigned int run = run_length(row, x, width);
+
+        if (run >= 3)
+        {
+            if (out_append_u16(out, (uint16_t)(IMAGE_RGB565_RUN | (run - 1))) < 0 ||
+                out_append_u16(out, row[x]) < 0)
+                return -1;
+            x += run;
+            continue;
+        }
+
+        unsigned int start = x;
+        while (x < width && x - start < IMAGE_RGB565_MAX_PACKET && run_length(row, x, width) < 3)
+            x++;
+
+        if (out_append_u16(out, (uint16_t)(x - start - 1)) < 0)
+            return -1;
+        for (unsigned int i = start; i < x; i++)
+            if (out_append_u16(out, row[i]) < 0)
+                return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Encode an image as a complete .rgb565 file in memory.
+ */
+static int encode_image(out_buffer_t *out, const image_t *img, int rle)
+{
+    image_rgb565_header_t header = {
+        .magic = {'R', '5', '6', '5'},
+        .width = (uint16_t)img->width,
+        .height = (uint16_t)img->height,
+        .version = IMAGE_RGB565_VERSION,
+        .flags = rle ? IMAGE_RGB565_FLAG_RLE : 0,
+    };
+
+    out->len = 0;
+    if (out_append(out, &header, sizeof(header)) < 0)
+        return -1;
+
+    for (unsigned int y = 0; y < img->height; y++)
+    {
+        const uint16_t *row = img->pixels + (size_t)y * img->width;
+
+        if (rle)
+        {
+            if (encode_row_rle(out, row, img->width) < 0)
+                return -1;
+        }
+        else
+        {
+            for (unsigned int x = 0; x < img->width; x++)
+                if (out_append_u16(out, row[x]) < 0)
+                    return -1;
+        }
+    }
+
+    /* The header is written in host order; image_rgb565.c rejects big-endian builds */
+    header.payload_size = (uint32_t)(out->len - sizeof(header));
+    memcpy(out->data, &header, sizeof(header));
+
+    return 0;
+}
+
+/**
+ * @brief Size of a buffer after deflate, as a proxy for compressed images.
+ */
+static unsigned long deflated_size(const uint8_t *data, size_t len)
+{
+    uLongf size = compressBound(len);
+    uint8_t *buf = malloc(size);
+
+    if (!buf || compress2(buf, &size, data, len, 9) != Z_OK)
+        size = 0;
+    free(buf);
+    return size;
+}
+
+/* -------------------- Main Program -------------------- */
+
+static double monotonic_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_help(const char *progname)
+{
+    printf("\nUsage: %s [options] <input.png> <output.rgb565>\n", progname);
+    printf("  -r         RLE-compress rows (default: raw)\n");
+    printf("  -W <px>    Canvas width, image is centred (default %u)\n", PANEL_WIDTH);
+    printf("  -H <px>    Canvas height (default %u)\n", PANEL_HEIGHT);
+    printf("--------------------------------------------------------\n");
+    printf("Converts a PNG into the slideshow's pre-decoded RGB565\n");
+    printf("format and reports the size against the PNG and the raw\n");
+    printf("and RLE encodings.\n");
+    printf("--------------------------------------------------------\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int width = PANEL_WIDTH;
+    unsigned int height = PANEL_HEIGHT;
+    int rle = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "rW:H:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r':
+            rle = 1;
+            break;
+        case 'W':
+            width = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'H':
+            height = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        default:
+            print_help(argv[0]);
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 2 || width == 0 || height == 0 || width > UINT16_MAX || height > UINT16_MAX)
+    {
+        print_help(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *input = argv[optind];
+    const char *output = argv[optind + 1];
+    image_t decoded, canvas;
+    struct stat st;
+
+    double start = monotonic_seconds();
+    if (image_load_png(input, &decoded) < 0)
+    {
+        fprintf(stderr, "%s: %s\n", input, strerror(errno));
+        return EXIT_FAILURE;
+    }
+    double decode_ms = (monotonic_seconds() - start) * 1e3;
+
+    if (fit_to_panel(&decoded, &canvas, width, height) < 0)
+    {
+        fprintf(stderr, "Out of memory\n");
+        image_free(&decoded);
+        return EXIT_FAILURE;
+    }
+    image_free(&decoded);
+
+    out_buffer_t raw = {0}, packed = {0};
+    if (encode_image(&raw, &canvas, 0) < 0 || encode_image(&packed, &canvas, 1) < 0)
+    {
+        fprintf(stderr, "Out of memory\n");
+        image_free(&canvas);
+        return EXIT_FAILURE;
+    }
+    image_free(&canvas);
+
+    const out_buffer_t *chosen = rle ? &packed : &raw;
+    FILE *fp = fopen(output, "wb");
+    if (!fp || fwrite(chosen->data, 1, chosen->len, fp) != chosen->len || fclose(fp) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", output, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    long png_size = stat(input, &st) == 0 ? (long)st.st_size : -1;
+
+    printf("%s -> %s (%ux%u, %s)\n", input, output, width, height, rle ? "RLE" : "raw");
+    printf("  PNG %ld B (host decode %.2f ms) | raw %zu B (deflated %lu B) | RLE %zu B (deflated %lu B)\n",
+           png_size, decode_ms, raw.len, deflated_size(raw.data, raw.len),
+           packed.len, deflated_size(packed.data, packed.len));
+
+    free(raw.data);
+    free(packed.data);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,3 @@
+#!/bin/bash
+echo "Removing slideshow from target..."
+rm -f $(TARGET_DIR)/usr/bin/slideshow
\ No newline at end of file
@@ -0,0 +1,56 @@
+###############################################################################
+#
+# SLIDESHOW package
+#
+###############################################################################
+
+# Package version and source location
+SLIDESHOW_VERSION = 1.0
+SLIDESHOW_SITE = $(BR2_EXTERNAL_FIRMWARE_PATH)/package/slideshow/project
+SLIDESHOW_SITE_METHOD = local
+SLIDESHOW_DEPENDENCIES = host-slideshow
+
+# PNG decoding on the target is optional: post-build.sh already converts
+# every image, so by default neither libpng nor zlib goes into the rootfs
+ifeq ($(BR2_PACKAGE_SLIDESHOW_PNG),y)
+SLIDESHOW_DEPENDENCIES += libpng host-pkgconf
+# libpng/zlib link flags come from the staging pkg-config
+SLIDESHOW_PNG_LIBS = PNG_LIBS="`$(PKG_CONFIG_HOST_BINARY) --libs libpng`"
+endif
+
+# Build commands
+define SLIDESHOW_BUILD_CMDS
+	$(MAKE) \
+		CC="$(TARGET_CC)" \
+		CFLAGS="$(TARGET_CFLAGS)" \
+		LDFLAGS="$(TARGET_LDFLAGS)" \
+		SLIDESHOW_PNG=$(if $(BR2_PACKAGE_SLIDESHOW_PNG),y,n) \
+		$(SLIDESHOW_PNG_LIBS) \
+		-C $(@D)
+endef
+
+# Install the compiled binary to the target filesystem
+define SLIDESHOW_INSTALL_TARGET_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/slideshow $(TARGET_DIR)/usr/bin/slideshow
+endef
+
+# Host build provides png2rgb565, used by post-build.sh to pre-convert images
+HOST_SLIDESHOW_DEPENDENCIES = host-libpng host-zlib
+
+define HOST_SLIDESHOW_BUILD_CMDS
+	$(MAKE) \
+		CC="$(HOSTCC)" \
+		CFLAGS="$(HOST_CFLAGS)" \
+		LDFLAGS="$(HOST_LDFLAGS)" \
+		PNG_LIBS="-lpng -lz" \
+		LIBS="-lm" \
+		-C $(@D) tools
+endef
+
+define HOST_SLIDESHOW_INSTALL_CMDS
+	$(INSTALL) -D -m 0755 $(@D)/bin/png2rgb565 $(HOST_DIR)/bin/png2rgb565
+endef
+
+# Evaluate the generic package infrastructure
+$(eval $(generic-package))
+$(eval $(host-generic-package))